@@ -0,0 +1,51 @@
+# =============================================================================
+# Generate a C++ header embedding compiled SPIR-V as uint32_t arrays
+#
+# Run in script mode:
+#   cmake -DOUTPUT=<header> -DSPIRV_FILES="<name>=<file.spv>;..." -P EmbedSpirv.cmake
+#
+# Each entry becomes `inline constexpr uint32_t <name>[]` in
+# namespace finegui::backend::shaders.
+# =============================================================================
+
+if(NOT OUTPUT OR NOT SPIRV_FILES)
+    message(FATAL_ERROR "EmbedSpirv.cmake: OUTPUT and SPIRV_FILES are required")
+endif()
+
+set(content "#pragma once\n\n")
+string(APPEND content "// Generated by cmake/EmbedSpirv.cmake from the finegui_shaders target. Do not edit.\n\n")
+string(APPEND content "#include <cstdint>\n\n")
+string(APPEND content "namespace finegui {\nnamespace backend {\nnamespace shaders {\n")
+
+foreach(entry IN LISTS SPIRV_FILES)
+    string(REPLACE "=" ";" parts "${entry}")
+    list(GET parts 0 name)
+    list(GET parts 1 path)
+
+    file(READ "${path}" hex HEX)
+    string(LENGTH "${hex}" hexLength)
+    math(EXPR remainder "${hexLength} % 8")
+    if(hexLength EQUAL 0 OR NOT remainder EQUAL 0)
+        message(FATAL_ERROR "EmbedSpirv.cmake: ${path} is not a SPIR-V binary")
+    endif()
+
+    # SPIR-V files are little-endian words; reverse each group of four bytes
+    string(REGEX REPLACE "(..)(..)(..)(..)" "0x\\4\\3\\2\\1u," words "${hex}")
+    # Eight words per line
+    string(REPEAT "0x[0-9a-f]+u," 8 line)
+    string(REGEX REPLACE "(${line})" "\\1\n    " words "${words}")
+    string(REGEX REPLACE "\n    $" "" words "${words}")
+
+    string(APPEND content "\ninline constexpr uint32_t ${name}[] = {\n    ${words}\n};\n")
+endforeach()
+
+string(APPEND content "\n} // namespace shaders\n} // namespace backend\n} // namespace finegui\n")
+
+# Only touch the header when the shaders changed, to avoid needless rebuilds
+if(EXISTS "${OUTPUT}")
+    file(READ "${OUTPUT}" existing)
+    if(existing STREQUAL content)
+        return()
+    endif()
+endif()
+file(WRITE "${OUTPUT}" "${content}")
@@ -295,19 +295,19 @@ int main() {
             auto* p7 = guiRenderer.get(phase7Id);
             if (p7 && p7->children.size() >= 10) {
                 // "Open Context Menu" button (index 4) opens popup (index 5)
-                p7->children[4].onClick = [p7](finegui::WidgetNode&) {
+                p7->children[4].callbacksMut().onClick = [p7](finegui::WidgetNode&) {
                     p7->children[5].boolValue = true;
                 };
                 // "Open Modal" button (index 8) opens modal (index 9)
-                p7->children[8].onClick = [p7](finegui::WidgetNode&) {
+                p7->children[8].callbacksMut().onClick = [p7](finegui::WidgetNode&) {
                     p7->children[9].boolValue = true;
                 };
                 // OK button inside modal closes it
-                p7->children[9].children[2].onClick = [](finegui::WidgetNode&) {
+                p7->children[9].children[2].callbacksMut().onClick = [](finegui::WidgetNode&) {
                     ImGui::CloseCurrentPopup();
                 };
                 // Cancel button inside modal closes it
-                p7->children[9].children[3].onClick = [](finegui::WidgetNode&) {
+                p7->children[9].children[3].callbacksMut().onClick = [](finegui::WidgetNode&) {
                     ImGui::CloseCurrentPopup();
                 };
             }
@@ -0,0 +1,50 @@
+#pragma once
+
+/**
+ * @file compact_vertex.hpp
+ * @brief Quantized 12-byte GUI vertex format
+ *
+ * Used by the backend when GuiConfig::compactVertices is set. Exposed so the
+ * encoding can be inspected and tested without a device.
+ */
+
+#include <imgui.h>
+#include <cstddef>
+#include <cstdint>
+
+namespace finegui {
+
+/**
+ * @brief Compact vertex: fixed-point position, unorm16 UV, packed color
+ *
+ * Positions are stored relative to an origin (the display position) in
+ * steps of 1/kCompactPositionScale pixel, giving a range of +/-8192 pixels.
+ */
+struct CompactDrawVert {
+    int16_t pos[2];   ///< Position in 1/4 pixel steps (R16G16_SINT)
+    uint16_t uv[2];   ///< Texture coordinates in [0, 1] (R16G16_UNORM)
+    ImU32 col;        ///< Color, same packing as ImDrawVert::col (R8G8B8A8_UNORM)
+};
+
+static_assert(sizeof(CompactDrawVert) == 12, "CompactDrawVert must stay tightly packed");
+
+/// Position steps per pixel (must match gui_compact.vert)
+constexpr float kCompactPositionScale = 4.0f;
+
+/**
+ * @brief Check whether vertices can be encoded without clamping
+ * @return false if a position is out of range of @p origin or a UV lies outside [0, 1]
+ */
+bool fitsCompactVertices(const ImDrawVert* src, size_t count, ImVec2 origin);
+
+/**
+ * @brief Encode vertices (out-of-range values are clamped)
+ */
+void packCompactVertices(const ImDrawVert* src, size_t count, ImVec2 origin, CompactDrawVert* dst);
+
+/**
+ * @brief Decode one vertex (as the compact vertex shader sees it)
+ */
+ImDrawVert unpackCompactVertex(const CompactDrawVert& vertex, ImVec2 origin);
+
+} // namespace finegui
@@ -0,0 +1,83 @@
+#pragma once
+
+/**
+ * @file draw_data_channel.hpp
+ * @brief Lock-free triple-buffered handoff of GuiDrawData between threads
+ *
+ * Used by GuiSystem when GuiConfig::enableDrawDataCapture is set: endFrame()
+ * captures into the write buffer and publishes it, and getDrawData() (on
+ * the render thread) acquires the newest published frame. Usable on its
+ * own for any single-producer, single-consumer pair.
+ */
+
+#include "gui_draw_data.hpp"
+
+#include <atomic>
+#include <cstdint>
+
+namespace finegui {
+
+/**
+ * @brief Single-producer, single-consumer latest-frame channel
+ *
+ * Three buffers rotate between the writer, the reader and a shared middle
+ * slot, exchanged with one atomic swap each, so neither side ever waits
+ * and no buffer is read while it is being written. The writer never falls
+ * behind: a frame published before the reader picked up the previous one
+ * replaces it (counted by overwritten()). Buffers keep their capacity as
+ * they rotate.
+ */
+class DrawDataChannel {
+public:
+    DrawDataChannel() = default;
+
+    DrawDataChannel(const DrawDataChannel&) = delete;
+    DrawDataChannel& operator=(const DrawDataChannel&) = delete;
+
+    /**
+     * @brief The writer's buffer (writer thread only)
+     *
+     * Holds an older frame's data; fill it completely before publish().
+     */
+    [[nodiscard]] GuiDrawData& writeBuffer() { return buffers_[writeIndex_]; }
+
+    /**
+     * @brief Make the write buffer the newest frame (writer thread only)
+     *
+     * writeBuffer() then returns a different buffer.
+     */
+    void publish();
+
+    /**
+     * @brief Take the newest published frame (reader thread only)
+     *
+     * Returns the same frame again if nothing was published since the last
+     * call, and an empty frame before the first publish(). The reference
+     * stays valid and unmodified until the next acquire().
+     *
+     * @param isNew Set to whether the frame was published since the last call
+     */
+    const GuiDrawData& acquire(bool* isNew = nullptr);
+
+    /// Frames published so far
+    [[nodiscard]] uint64_t published() const { return published_.load(std::memory_order_relaxed); }
+
+    /// Frames replaced by a newer one before the reader acquired them
+    [[nodiscard]] uint64_t overwritten() const { return overwritten_.load(std::memory_order_relaxed); }
+
+private:
+    // Middle slot index in the low bits, plus a flag set by publish() and
+    // cleared by acquire()
+    static constexpr uint32_t kIndexMask = 0x3;
+    static constexpr uint32_t kFresh = 0x4;
+
+    GuiDrawData buffers_[3];
+    std::atomic<uint32_t> middle_{1};
+    uint32_t writeIndex_ = 0;  // Owned by the writer
+    uint32_t readIndex_ = 2;   // Owned by the reader
+
+    std::atomic<uint64_t> published_{0};
+    std::atomic<uint64_t> overwritten_{0};
+};
+
+} // namespace finegui
@@ -12,5 +12,13 @@
 #include "gui_config.hpp"
 #include "gui_state.hpp"
 #include "gui_draw_data.hpp"
+#include "draw_data_channel.hpp"
+#include "input_queue.hpp"
+#include "gui_thread.hpp"
+#include "session_recorder.hpp"
+#include "session_replayer.hpp"
+#include "gui_stats.hpp"
+#include "compact_vertex.hpp"
+#include "sdf_font.hpp"
 #include "input_adapter.hpp"
 #include "texture_handle.hpp"
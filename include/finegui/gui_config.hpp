@@ -8,6 +8,9 @@
 #include <vulkan/vulkan.h>
 #include <string>
 #include <cstdint>
+#include <mutex>
+#include <utility>
+#include <vector>
 
 namespace finegui {
 
@@ -41,6 +44,26 @@ struct GuiConfig {
     /// Font data size in bytes
     size_t fontDataSize = 0;
 
+    /// Bake glyphs once as signed distance fields (see sdf_font.hpp) and
+    /// threshold them in the fragment shader, so text stays sharp at any
+    /// size, window scale or DPI without re-rasterizing the atlas
+    bool sdfFonts = false;
+
+    /// Pixel size glyphs are baked at with sdfFonts; all text sizes are
+    /// drawn from this one bake
+    float sdfBakeSize = 48.0f;
+
+    /// Sample text (UTF-8) whose glyphs are queued for prewarming at
+    /// construction (see GuiSystem::prewarmGlyphs())
+    std::string prewarmText;
+
+    /// Codepoint ranges [first, last] queued for prewarming at construction
+    std::vector<std::pair<uint32_t, uint32_t>> prewarmRanges;
+
+    /// Queued glyphs rasterized at the end of every endFrame()
+    /// (0 = only when GuiSystem::prewarmGlyphs() is called)
+    uint32_t prewarmGlyphsPerFrame = 0;
+
     // ========================================================================
     // Behavior settings
     // ========================================================================
@@ -67,6 +90,43 @@ struct GuiConfig {
 
     /// MSAA sample count (must match render pass)
     VkSampleCountFlagBits msaaSamples = VK_SAMPLE_COUNT_1_BIT;
+
+    /// Address all GUI textures through one descriptor array, selected per
+    /// draw by push constant, instead of binding a descriptor set per texture.
+    /// Falls back to per-texture sets if the device lacks support.
+    bool bindlessTextures = false;
+
+    /// Upload 12-byte quantized vertices (1/4-pixel positions, unorm16 UVs)
+    /// instead of 20-byte ImDrawVert. Frames with a vertex out of range
+    /// (more than 8192 px from the display origin, or UVs outside [0, 1])
+    /// use the standard format.
+    bool compactVertices = false;
+
+    /// Measure GPU time of GUI rendering and SceneTexture scenes with
+    /// timestamp queries (see GuiSystem::gpuTimings()). Ignored on devices
+    /// without timestamp support.
+    bool gpuTiming = false;
+
+    /// File to load the Vulkan pipeline cache from and save it back to
+    /// (empty = no cache). Incompatible or missing files start cold.
+    std::string pipelineCachePath;
+
+    /// Render the GUI into an offscreen layer and only re-render it when
+    /// its draw data changes; other frames composite the cached image
+    /// (see GuiSystem::recordLayer() and invalidateLayer()). A GUI that
+    /// changes on several frames in a row is drawn directly until it
+    /// settles. Applies to render(cmd) after initialize(RenderSurface*);
+    /// threaded and secondary paths ignore it.
+    bool cachedLayer = false;
+
+    /// Pixel bytes of GuiSystem::registerTextureAsync() uploads submitted
+    /// per frame (a single larger texture still goes in one frame)
+    uint64_t asyncUploadBytesPerFrame = 4 * 1024 * 1024;
+
+    /// Mutex the application holds around its own vkQueueSubmit on the
+    /// graphics queue (may be null). Async uploads lock it for their
+    /// submissions, which run from the render calls on the render thread.
+    std::mutex* queueMutex = nullptr;
 };
 
 } // namespace finegui
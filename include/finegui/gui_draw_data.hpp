@@ -25,6 +25,29 @@ struct DrawCommand {
     glm::ivec4 scissorRect;    ///< Scissor rect (x, y, width, height)
 };
 
+/**
+ * @brief Font atlas change carried by captured frames (threaded mode)
+ *
+ * ImGui 1.92 adds glyphs to its atlas (and may replace the atlas texture)
+ * while frames are built. With draw data capture, endFrame() turns each
+ * texture request into one of these and marks the texture handled, so
+ * only the render thread touches GPU textures. A created texture gets a
+ * provisional ID, which the backend maps to the real one.
+ *
+ * Every captured frame carries all requests the render thread has not
+ * applied yet, so frames it skips lose nothing; each request is applied
+ * once, in sequence order.
+ */
+struct TextureRequest {
+    uint64_t sequence = 0;             ///< Increasing from 1
+    uint64_t textureId = 0;            ///< ID draw commands use for the texture
+    ImTextureStatus status = ImTextureStatus_OK;  ///< WantCreate, WantUpdates or WantDestroy
+    int width = 0;                     ///< Texture width (WantCreate)
+    int height = 0;                    ///< Texture height (WantCreate)
+    std::vector<ImTextureRect> rects;  ///< Changed rectangles (WantUpdates)
+    std::vector<uint8_t> pixels;       ///< RGBA8: the whole texture, or each rect's rows packed
+};
+
 /**
  * @brief Complete frame's draw data for threaded rendering
  *
@@ -36,6 +59,7 @@ struct GuiDrawData {
     std::vector<DrawCommand> commands;  ///< Draw commands
     glm::vec2 displaySize;              ///< Display size in pixels
     glm::vec2 framebufferScale;         ///< Framebuffer scale factor
+    std::vector<TextureRequest> textureRequests;  ///< Atlas changes to apply before drawing
 
     /// Check if there's anything to draw
     [[nodiscard]] bool empty() const { return commands.empty(); }
@@ -45,9 +69,23 @@ struct GuiDrawData {
         vertices.clear();
         indices.clear();
         commands.clear();
+        textureRequests.clear();
         displaySize = glm::vec2(0.0f);
         framebufferScale = glm::vec2(1.0f);
     }
 };
 
+/**
+ * @brief Flatten ImGui draw data into @p out, replacing its contents
+ *
+ * Each array is resized once to the frame's total and filled with one
+ * bulk copy per draw list, so a GuiDrawData reused across frames only
+ * allocates when a frame outgrows every earlier one. Draw lists are
+ * concatenated; command offsets are rebased accordingly. Texture
+ * requests are not captured (GuiSystem adds them; see TextureRequest).
+ *
+ * @param drawData ImGui draw data (null or empty gives an empty frame)
+ */
+void captureDrawData(const ImDrawData* drawData, GuiDrawData& out);
+
 } // namespace finegui
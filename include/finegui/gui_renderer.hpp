@@ -3,7 +3,10 @@
 #include "widget_node.hpp"
 #include "widget_state.hpp"
 #include "drag_drop_manager.hpp"
+#include <cstdint>
+#include <functional>
 #include <map>
+#include <memory>
 #include <string>
 
 namespace finegui {
@@ -24,6 +27,9 @@ class GuiSystem;
 ///   gui.endFrame();
 class GuiRenderer {
 public:
+    /// Builds a widget tree; used by the arena variants of show() / update().
+    using TreeBuilder = std::function<WidgetNode()>;
+
     explicit GuiRenderer(GuiSystem& gui);
 
     /// Register a widget tree to be rendered each frame.
@@ -49,6 +55,28 @@ public:
     /// Replace an existing widget tree.
     void update(int guiId, WidgetNode tree);
 
+    /// Update an existing tree to match a new one by patching it in place
+    /// (see WidgetNode::reconcile()) instead of replacing it. The warmup
+    /// frame is not repeated, and child lists whose ids and types didn't
+    /// change keep their nodes at the same addresses. Suits trees pushed
+    /// every network tick.
+    /// Returns the number of nodes changed, added or removed (0 if guiId
+    /// is unknown).
+    size_t reconcile(int guiId, WidgetNode tree);
+
+    /// Like show(), but the tree is built inside a per-tree WidgetArena:
+    /// node and child storage comes from a few large chunks instead of one
+    /// heap block per node, and is released in one shot when the tree is
+    /// replaced or hidden. Suits large trees that are rebuilt often.
+    /// Don't move nodes out of such a tree (copy them instead); one moved
+    /// out anyway keeps its arena's storage alive.
+    int showInArena(const TreeBuilder& build, bool immediate = false);
+
+    /// Replace a tree, building the new one inside the tree's arena.
+    /// The tree's two arenas alternate, so the old tree stays intact while
+    /// the new one is built. Works on any tree, not only showInArena() ones.
+    void updateInArena(int guiId, const TreeBuilder& build);
+
     /// Remove a widget tree.
     void hide(int guiId);
 
@@ -89,7 +117,17 @@ public:
     /// Restore widget state across all trees.
     void loadState(const WidgetStateMap& state);
 
+    /// The GuiSystem this renderer draws through.
+    GuiSystem& guiSystem() { return gui_; }
+
+    /// Frames whose VirtualList / VirtualTable rows outlived renderAll(),
+    /// e.g. because a row provider cached what it returned. Those rows
+    /// keep that frame's row arena; later frames build in a new one. This
+    /// should stay 0: a growing count means rows are being kept.
+    uint64_t escapedRowFrames() const { return escapedRowFrames_; }
+
 private:
+    static WidgetNode buildInArena(WidgetArena& arena, const TreeBuilder& build);
     static WidgetNode* findByIdRecursive(WidgetNode& node, const std::string& widgetId);
     static void collectState(WidgetNode& node, WidgetStateMap& out);
     static void applyState(WidgetNode& node, const WidgetStateMap& state);
@@ -99,6 +137,9 @@ private:
     int nextId_ = 1;
 
     struct Entry {
+        // Declared before the tree, which is destroyed first
+        std::unique_ptr<WidgetArena> arena;       // holds the tree (null = heap)
+        std::unique_ptr<WidgetArena> spareArena;  // next updateInArena() builds here
         WidgetNode tree;
         int warmupFrames = 0;  // >0 = warming up, 0 = normal, -1 = staged
     };
@@ -109,7 +150,14 @@ private:
     std::string lastFocusedId_;
     std::string currentFocusedId_;
 
+    // VirtualList / VirtualTable rows only live for the frame they are drawn in
+    std::unique_ptr<WidgetArena> rowArena_ = std::make_unique<WidgetArena>();
+    uint64_t escapedRowFrames_ = 0;
+
     void renderNode(WidgetNode& node);
+
+    // Render node's children; uniform row lists only submit the rows in view
+    void renderChildRows(WidgetNode& node, bool clip);
     void renderWindow(WidgetNode& node);
     void renderText(WidgetNode& node);
     void renderButton(WidgetNode& node);
@@ -204,6 +252,13 @@ private:
     void renderPushTheme(WidgetNode& node);
     void renderPopTheme(WidgetNode& node);
 
+    // Virtual (data-source-backed) lists
+    void renderVirtualList(WidgetNode& node);
+    void renderVirtualTable(WidgetNode& node);
+    void renderVirtualRows(WidgetNode& node);
+    void renderVirtualRow(WidgetNode& node, int row);
+    WidgetNode buildVirtualRow(const WidgetNode& node, int row);
+
     // Drag-and-drop
     void handleDragDrop(WidgetNode& node);
 };
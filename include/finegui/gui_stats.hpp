@@ -0,0 +1,170 @@
+#pragma once
+
+/**
+ * @file gui_stats.hpp
+ * @brief Rendering statistics reported by GuiSystem
+ */
+
+#include <cstdint>
+
+namespace finegui {
+
+/**
+ * @brief Backend rendering statistics
+ *
+ * Returned by GuiSystem::renderStats(). Sizes are in bytes.
+ */
+struct GuiRenderStats {
+    // ========================================================================
+    // Vertex/index streaming (ring buffer shared by all frames in flight)
+    // ========================================================================
+
+    uint64_t streamCapacity = 0;        ///< Current ring buffer size
+    uint64_t streamUsed = 0;            ///< Bytes held by frames still in flight
+    uint64_t streamHighWater = 0;       ///< Decaying high-water mark of streamUsed
+    uint64_t streamReallocations = 0;   ///< Times the ring was grown or trimmed
+    uint64_t uploadsSkipped = 0;        ///< Render calls that reused identical geometry (cumulative)
+    uint64_t uploadBytesSkipped = 0;    ///< Geometry bytes not re-uploaded as a result (cumulative)
+    uint64_t geometryBytesHashed = 0;   ///< Bytes fingerprinted to detect unchanged frames (cumulative)
+    uint64_t geometryHashMicros = 0;    ///< Time spent fingerprinting them (cumulative)
+    uint64_t compactUploads = 0;        ///< Uploads in the compact vertex format (cumulative)
+
+    // ========================================================================
+    // Texture registration
+    // ========================================================================
+
+    uint32_t registeredTextures = 0;    ///< Distinct (view, sampler) pairs registered
+    uint64_t textureCacheHits = 0;      ///< Registrations that reused an existing entry
+    uint32_t descriptorSetsLive = 0;    ///< Per-texture descriptor sets allocated
+    uint32_t descriptorPools = 0;       ///< Pools in the descriptor pool chain
+
+    // ========================================================================
+    // Bindless texture table (zero when GuiConfig::bindlessTextures is off
+    // or unsupported by the device)
+    // ========================================================================
+
+    uint32_t bindlessCapacity = 0;      ///< Slots in the texture array
+    uint32_t bindlessSlotsUsed = 0;     ///< Slots held by live textures
+
+    // ========================================================================
+    // Texture updates (cumulative)
+    // ========================================================================
+
+    uint64_t textureUploadBytes = 0;    ///< Bytes copied by partial (dirty-rect) updates
+    uint64_t textureRegionUpdates = 0;  ///< Dirty rectangles uploaded
+
+    // ========================================================================
+    // Async texture uploads (GuiSystem::registerTextureAsync)
+    // ========================================================================
+
+    uint32_t pendingUploads = 0;          ///< Uploads queued or in flight
+    uint64_t asyncUploadBytes = 0;        ///< Pixel bytes submitted (cumulative)
+    uint64_t asyncUploadsCompleted = 0;   ///< Uploads finished (cumulative)
+    uint32_t asyncUploadMemoryBlocks = 0; ///< Device memory allocations holding their images
+
+    // ========================================================================
+    // Secondary command buffers (cumulative, GuiSystem::recordSecondary)
+    // ========================================================================
+
+    uint64_t secondaryRecords = 0;      ///< Secondary buffers (re)recorded
+    uint64_t secondaryReuses = 0;       ///< Calls that kept the existing recording
+    uint64_t secondaryExecutes = 0;     ///< Recordings executed into a primary
+
+    // ========================================================================
+    // Cached GUI layer (cumulative, GuiConfig::cachedLayer)
+    // ========================================================================
+
+    uint64_t layerRenders = 0;          ///< Frames that re-rendered the layer
+    uint64_t layerReuses = 0;           ///< Frames that composited the cached layer
+    uint64_t layerBypasses = 0;         ///< Frames drawn directly because the GUI kept changing
+
+    // ========================================================================
+    // Startup (set once by initialize())
+    // ========================================================================
+
+    uint64_t pipelineCreateMicros = 0;      ///< Time spent creating the GUI pipelines
+    uint64_t pipelineCacheLoadedBytes = 0;  ///< Pipeline cache data reused from GuiConfig::pipelineCachePath (0 = cold)
+
+    // ========================================================================
+    // Draw submission (most recent render call)
+    // ========================================================================
+
+    uint32_t drawCommands = 0;      ///< Visible draw commands before batching
+    uint32_t drawCalls = 0;         ///< drawIndexed calls recorded after batching
+    uint32_t descriptorBinds = 0;   ///< Texture descriptor binds recorded
+    uint32_t textureSwitches = 0;   ///< Texture changes (binds, or index pushes in bindless mode)
+    uint32_t scissorChanges = 0;    ///< Scissor updates recorded
+};
+
+/**
+ * @brief GPU time measured with timestamp queries
+ *
+ * Returned by GuiSystem::gpuTimings(). Times are in microseconds,
+ * exponentially smoothed over recent frames.
+ */
+struct GpuTimings {
+    bool supported = false;     ///< GuiConfig::gpuTiming is set and the device has timestamps
+    float guiMicros = 0.0f;     ///< render()/renderDrawData() per frame
+    float sceneMicros = 0.0f;   ///< All SceneTexture scenes per frame (frames that rendered any)
+    uint64_t guiSamples = 0;    ///< Frames measured so far
+    uint64_t sceneSamples = 0;  ///< Frames with scenes measured so far
+};
+
+/**
+ * @brief Glyph prewarming counters
+ *
+ * Returned by GuiSystem::glyphPrewarmStats(). Counts cover the default font
+ * at its default size, which is what prewarming fills.
+ */
+struct GlyphPrewarmStats {
+    uint64_t prewarmed = 0;     ///< Glyphs rasterized ahead of time
+    uint64_t unavailable = 0;   ///< Queued codepoints the font has no glyph for
+    uint64_t missed = 0;        ///< Glyphs still rasterized lazily during a frame
+    size_t pending = 0;         ///< Codepoints still queued
+};
+
+/**
+ * @brief Input ingestion counters
+ *
+ * Returned per batch by GuiSystem::processInputBatch() and cumulatively by
+ * GuiSystem::inputStats(). Emitted events are the ImGui input events queued
+ * after coalescing and modifier de-duplication.
+ */
+struct InputStats {
+    uint64_t ingested = 0;      ///< InputEvents passed in
+    uint64_t emitted = 0;       ///< ImGui input events queued
+    uint64_t coalesced = 0;     ///< MouseMove/MouseScroll events merged into the previous one
+};
+
+/**
+ * @brief Counters from the headless (null) backend
+ *
+ * Returned by GuiSystem::headlessStats(). Counts what the Vulkan backend
+ * would have uploaded and drawn; draw calls are before batching. Sizes are
+ * in bytes.
+ */
+struct HeadlessStats {
+    uint64_t frames = 0;                ///< Frames consumed by endFrame()
+
+    // Most recent frame
+    uint32_t drawLists = 0;             ///< ImGui draw lists
+    uint32_t vertices = 0;              ///< Vertices
+    uint32_t indices = 0;               ///< Indices
+    uint32_t drawCalls = 0;             ///< Non-empty draw commands
+
+    // Cumulative
+    uint64_t totalVertices = 0;
+    uint64_t totalIndices = 0;
+    uint64_t totalDrawCalls = 0;
+    uint64_t vertexBytes = 0;           ///< totalVertices * sizeof(ImDrawVert)
+    uint64_t indexBytes = 0;            ///< totalIndices * sizeof(ImDrawIdx)
+
+    // Texture lifecycle (font atlas and other ImGui-managed textures)
+    uint32_t texturesLive = 0;          ///< Textures currently created
+    uint64_t textureCreates = 0;        ///< Textures created (cumulative)
+    uint64_t textureDestroys = 0;       ///< Textures destroyed (cumulative)
+    uint64_t textureUpdates = 0;        ///< Dirty rectangles updated (cumulative)
+    uint64_t textureUploadBytes = 0;    ///< Bytes a GPU backend would upload (cumulative)
+};
+
+} // namespace finegui
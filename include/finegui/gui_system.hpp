@@ -8,6 +8,7 @@
 #include "gui_config.hpp"
 #include "gui_state.hpp"
 #include "gui_draw_data.hpp"
+#include "gui_stats.hpp"
 #include "input_adapter.hpp"
 #include "texture_handle.hpp"
 
@@ -15,12 +16,15 @@
 
 #include <imgui.h>
 
+#include <cstdint>
 #include <memory>
 #include <functional>
 #include <unordered_map>
 
 namespace finegui {
 
+class SessionRecorder;
+
 /**
  * @brief Controls how the GUI listener handles input consumption
  *
@@ -67,6 +71,18 @@ public:
      */
     explicit GuiSystem(finevk::LogicalDevice* device, const GuiConfig& config = {});
 
+    /**
+     * @brief Construct a headless GuiSystem (no device)
+     *
+     * Call initializeHeadless() instead of initialize(). Frames run through
+     * ImGui as usual, but endFrame() hands the draw data to a null backend
+     * that only counts it (see headlessStats()). Rendering and texture
+     * registration are unavailable. Intended for benchmarks and CI.
+     *
+     * @param config Configuration options (enableDrawDataCapture records frames)
+     */
+    explicit GuiSystem(const GuiConfig& config);
+
     /// Destructor
     ~GuiSystem();
 
@@ -121,8 +137,20 @@ public:
         initialize(&renderer, subpass);
     }
 
+    /**
+     * @brief Initialize a headless GuiSystem
+     * @param width Display width in pixels
+     * @param height Display height in pixels
+     */
+    void initializeHeadless(uint32_t width = 1280, uint32_t height = 720);
+
     /**
      * @brief Register a texture for use in GUI
+     *
+     * Registrations of the same image view and sampler share one descriptor
+     * and return equal handles. Each registration is reference counted, so
+     * call unregisterTexture() once per registerTexture().
+     *
      * @param texture The finevk texture
      * @param sampler Optional sampler (uses default if null)
      * @return Handle for use with ImGui::Image()
@@ -143,7 +171,34 @@ public:
                                   uint32_t width, uint32_t height);
 
     /**
-     * @brief Unregister a texture
+     * @brief Register RGBA8 pixels without waiting for their upload
+     *
+     * The pixels are copied and the handle is returned at once. The copy to
+     * the GPU is submitted by the next frame's first render call (render(),
+     * renderDrawData() or recordSecondary()), under GuiConfig::queueMutex
+     * if set, within
+     * GuiConfig::asyncUploadBytesPerFrame; until it completes, anything
+     * drawn with the handle is skipped (see textureReady()). Each call
+     * creates its own texture, released with unregisterTexture().
+     *
+     * @param pixels width * height RGBA8 pixels, rows tightly packed
+     * @param width Texture width in pixels
+     * @param height Texture height in pixels
+     * @param sampler Optional sampler (uses default if null)
+     * @return Handle for use with ImGui::Image()
+     */
+    TextureHandle registerTextureAsync(const void* pixels, uint32_t width, uint32_t height,
+                                       finevk::Sampler* sampler = nullptr);
+
+    /**
+     * @brief Check whether a texture's upload has completed
+     *
+     * Always true for textures registered with registerTexture().
+     */
+    [[nodiscard]] bool textureReady(TextureHandle handle) const;
+
+    /**
+     * @brief Unregister a texture (releases one registration)
      * @param handle The texture handle to unregister
      */
     void unregisterTexture(TextureHandle handle);
@@ -159,16 +214,29 @@ public:
     void processInput(const InputEvent& event);
 
     /**
-     * @brief Process multiple input events
+     * @brief Process multiple input events, dropping redundant ones
+     *
+     * Consecutive MouseMove events collapse into the last position and
+     * consecutive MouseScroll events into their sum, as long as the
+     * modifiers stay the same. Buttons, keys, characters and focus changes
+     * reach ImGui in their original order relative to the motion around
+     * them. Like processInput(), modifier key events are sent only when the
+     * modifier state changes.
+     *
      * @param events Container of input events
+     * @return Events ingested and ImGui input events emitted for this batch
      */
     template<typename Container>
-    void processInputBatch(const Container& events) {
+    InputStats processInputBatch(const Container& events) {
         for (const auto& e : events) {
-            processInput(e);
+            batchInput(e);
         }
+        return finishInputBatch();
     }
 
+    /// Get input counters accumulated over processInput() and processInputBatch()
+    [[nodiscard]] InputStats inputStats() const;
+
     // ========================================================================
     // InputManager Integration
     // ========================================================================
@@ -225,6 +293,7 @@ public:
      */
     template<typename T>
     void applyState(const T& update) {
+        recordState(update);
         auto it = stateHandlers_.find(T::staticTypeId());
         if (it != stateHandlers_.end()) {
             it->second(update);
@@ -242,6 +311,24 @@ public:
         };
     }
 
+    // ========================================================================
+    // Session Recording
+    // ========================================================================
+
+    /**
+     * @brief Log this GUI's session (see session_recorder.hpp)
+     *
+     * From then on, frame delta times and display size, every input event
+     * as given to ImGui (after batch coalescing) and state updates of types
+     * added to the recorder are logged. Pass nullptr to stop.
+     *
+     * @param recorder Recorder to write to; must outlive its attachment
+     */
+    void setSessionRecorder(SessionRecorder* recorder);
+
+    /// Get the attached session recorder (nullptr if none)
+    [[nodiscard]] SessionRecorder* sessionRecorder() const;
+
     // ========================================================================
     // Per-Frame: Rendering
     // ========================================================================
@@ -277,6 +364,10 @@ public:
      * @brief End frame and finalize draw data
      *
      * Call this after all ImGui widgets.
+     *
+     * With GuiConfig::cachedLayer, this only decides whether the frame
+     * changed the layer and marks it pending; recordLayer() re-renders it
+     * into the frame's command buffer.
      */
     void endFrame();
 
@@ -305,10 +396,16 @@ public:
 
     /**
      * @brief Get draw data for external rendering (threaded mode)
-     * @return Reference to the captured draw data
+     * @return The newest frame published by endFrame() (the previous one
+     *         again if none was published since; empty before the first)
      *
-     * Only valid between endFrame() and next beginFrame().
-     * Requires enableDrawDataCapture=true in config.
+     * endFrame() publishes through a lock-free triple buffer (see
+     * DrawDataChannel), so the GUI thread can run endFrame() while the
+     * render thread still uses the frame it got from here. Call from one
+     * thread only, the one that renders. The data stays valid until the
+     * next getDrawData(). Requires enableDrawDataCapture=true in config.
+     * Also starts the render thread's frame, so call it once per frame
+     * before renderDrawData() / recordSecondary().
      */
     const GuiDrawData& getDrawData() const;
 
@@ -317,6 +414,8 @@ public:
      * @param cmd Command buffer to record into
      * @param data Draw data from getDrawData()
      *
+     * Applies the font atlas changes the frame carries (new glyphs, see
+     * TextureRequest) before drawing; recordSecondary() does the same.
      * Gets frame index automatically from renderer.
      */
     void renderDrawData(finevk::CommandBuffer& cmd, const GuiDrawData& data);
@@ -329,6 +428,140 @@ public:
      */
     void renderDrawData(finevk::CommandBuffer& cmd, uint32_t frameIndex, const GuiDrawData& data);
 
+    // ========================================================================
+    // Per-Frame: Secondary command buffers
+    // ========================================================================
+
+    /**
+     * @brief Record draw data into this frame's GUI secondary command buffer (automatic)
+     * @param data Draw data from getDrawData()
+     * @param framebuffer Framebuffer the primary will use (VK_NULL_HANDLE if unknown)
+     *
+     * Each frame in flight owns one secondary command buffer. When the draws
+     * match what that buffer last recorded (same geometry placement, textures
+     * and layout), it is kept as-is. Call outside the render pass, then
+     * executeSecondary() inside it. Gets frame index from beginFrame().
+     */
+    void recordSecondary(const GuiDrawData& data, VkFramebuffer framebuffer = VK_NULL_HANDLE);
+
+    /**
+     * @brief Record draw data into a frame's GUI secondary command buffer (manual)
+     * @param frameIndex Current frame-in-flight index
+     * @param data Draw data from getDrawData()
+     * @param framebuffer Framebuffer the primary will use (VK_NULL_HANDLE if unknown)
+     */
+    void recordSecondary(uint32_t frameIndex, const GuiDrawData& data,
+                         VkFramebuffer framebuffer = VK_NULL_HANDLE);
+
+    /**
+     * @brief Like recordSecondary(), but records on a worker thread (automatic)
+     * @param data Draw data from getDrawData()
+     * @param framebuffer Framebuffer the primary will use (VK_NULL_HANDLE if unknown)
+     *
+     * Returns after uploading geometry, so recording overlaps whatever the
+     * caller records next. @p data must stay alive and unmodified, and no
+     * other GuiSystem rendering or texture calls may be made, until
+     * executeSecondary() has been called. (getDrawData() waits before it
+     * releases the frame it returned, so passing that is always safe.)
+     */
+    void recordSecondaryAsync(const GuiDrawData& data, VkFramebuffer framebuffer = VK_NULL_HANDLE);
+
+    /**
+     * @brief Like recordSecondary(), but records on a worker thread (manual)
+     * @param frameIndex Current frame-in-flight index
+     * @param data Draw data from getDrawData()
+     * @param framebuffer Framebuffer the primary will use (VK_NULL_HANDLE if unknown)
+     */
+    void recordSecondaryAsync(uint32_t frameIndex, const GuiDrawData& data,
+                              VkFramebuffer framebuffer = VK_NULL_HANDLE);
+
+    /**
+     * @brief Execute the GUI secondary command buffer (automatic)
+     * @param primary Primary command buffer inside a render pass begun with
+     *                VK_SUBPASS_CONTENTS_SECONDARY_COMMAND_BUFFERS
+     *
+     * Waits for an asynchronous recording to finish first. Does nothing if
+     * the frame had nothing to draw.
+     */
+    void executeSecondary(finevk::CommandBuffer& primary);
+
+    /**
+     * @brief Execute a frame's GUI secondary command buffer (manual)
+     * @param primary Primary command buffer inside the render pass
+     * @param frameIndex Frame-in-flight index passed to recordSecondary()
+     */
+    void executeSecondary(finevk::CommandBuffer& primary, uint32_t frameIndex);
+
+    /**
+     * @brief Collect last GPU times and re-arm the timestamps for this frame
+     *
+     * Needed only with GuiConfig::gpuTiming. Timestamp queries have to be
+     * reset outside a render pass, so record this on the frame's command
+     * buffer before beginning the pass that render() draws into. Frames
+     * without it are simply not measured. Never waits on the GPU.
+     *
+     * @param cmd Command buffer, outside any render pass
+     */
+    void resetGpuTimers(finevk::CommandBuffer& cmd);
+
+    /// Explicit frame index variant
+    void resetGpuTimers(finevk::CommandBuffer& cmd, uint32_t frameIndex);
+
+    /**
+     * @brief Re-render the cached GUI layer if this frame changed it
+     *
+     * Needed only with GuiConfig::cachedLayer. The layer has its own render
+     * pass, so record this on the frame's command buffer after endFrame()
+     * and before beginning the pass that render() draws into. Nothing is
+     * submitted or waited on. Frames without it make render() draw the GUI
+     * directly.
+     *
+     * @param cmd Command buffer, outside any render pass
+     */
+    void recordLayer(finevk::CommandBuffer& cmd);
+
+    /// Explicit frame index variant
+    void recordLayer(finevk::CommandBuffer& cmd, uint32_t frameIndex);
+
+    /// Get smoothed GPU times (supported is false unless timing is active)
+    [[nodiscard]] GpuTimings gpuTimings() const;
+
+    // ========================================================================
+    // Glyph prewarming
+    // ========================================================================
+
+    /// Queue the glyphs of a UTF-8 string for prewarming
+    void queueGlyphs(const std::string& utf8Text);
+
+    /// Queue the codepoints [first, last] for prewarming
+    void queueGlyphRange(uint32_t first, uint32_t last);
+
+    /**
+     * @brief Rasterize queued glyphs of the default font into the atlas now
+     *
+     * ImGui otherwise rasterizes glyphs on first use, stalling that frame.
+     * Call this on loading screens or in frames that can absorb the work
+     * (outside beginFrame()/endFrame()); the resulting atlas changes reach
+     * the GPU in one batch with the next render(). Glyphs already in the
+     * atlas are skipped without counting against @p maxGlyphs.
+     *
+     * @param maxGlyphs Most glyphs to rasterize in this call
+     * @return Number of glyphs rasterized
+     */
+    uint32_t prewarmGlyphs(uint32_t maxGlyphs = UINT32_MAX);
+
+    /// Get prewarmed / missed glyph counts
+    [[nodiscard]] GlyphPrewarmStats glyphPrewarmStats() const;
+
+    /**
+     * @brief Force the cached GUI layer to re-render on the next frames
+     *
+     * Changes in draw data are detected automatically. This is for content
+     * that changes behind an unchanged texture ID, such as a SceneTexture
+     * (which calls it from endScene()). No-op without GuiConfig::cachedLayer.
+     */
+    void invalidateLayer();
+
     // ========================================================================
     // Utilities
     // ========================================================================
@@ -345,13 +578,37 @@ public:
     /// Rebuild font atlas (call after modifying fonts via imguiContext())
     void rebuildFontAtlas();
 
-    /// Get the owning device
+    /// Get backend rendering statistics (zeroed before initialize())
+    [[nodiscard]] GuiRenderStats renderStats() const;
+
+    /// Get null backend counters (zeroed unless headless)
+    [[nodiscard]] HeadlessStats headlessStats() const;
+
+    /// Get the owning device (null when headless)
     [[nodiscard]] finevk::LogicalDevice* device() const;
 
     /// Check if initialized
     [[nodiscard]] bool isInitialized() const;
 
+    /// Check if running headless (initializeHeadless() was called)
+    [[nodiscard]] bool isHeadless() const;
+
+    /// Get the configuration this GuiSystem was created with
+    [[nodiscard]] const GuiConfig& config() const;
+
 private:
+    friend class SceneTexture;
+
+    /// Report a scene's GPU time (summed per frame until endFrame())
+    void addSceneGpuTime(float micros);
+
+    /// Log a state update to the session recorder, if one is attached
+    void recordState(const GuiStateUpdate& update);
+
+    /// processInputBatch() steps: coalesce one event, then send what is left
+    void batchInput(const InputEvent& event);
+    InputStats finishInputBatch();
+
     struct Impl;
     std::unique_ptr<Impl> impl_;
 
@@ -0,0 +1,151 @@
+#pragma once
+
+/**
+ * @file gui_thread.hpp
+ * @brief Runs a GuiSystem's frames on a dedicated thread
+ *
+ * The threaded mode of finegui-design.md: the main thread posts input,
+ * the GUI thread builds frames, and the render thread draws whatever frame
+ * is newest:
+ *
+ * @code
+ * GuiConfig config;
+ * config.enableDrawDataCapture = true;
+ * GuiSystem gui(device, config);
+ * gui.initialize(renderer);
+ *
+ * GuiThread guiThread(gui);
+ * guiThread.addFrameCallback([&](float) { guiRenderer.renderAll(); });
+ * guiThread.start();
+ *
+ * // Main thread:   guiThread.postInput(InputAdapter::fromFineVK(event));
+ * // Render thread: gui.renderDrawData(cmd, frameIndex, gui.getDrawData());
+ *
+ * guiThread.stop();
+ * @endcode
+ */
+
+#include "input_queue.hpp"
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace finegui {
+
+class GuiSystem;
+
+/**
+ * @brief Configuration for GuiThread
+ */
+struct GuiThreadConfig {
+    /// Frames per second the GUI thread builds (0 = as fast as it can)
+    float targetFrameRate = 60.0f;
+
+    /// InputEvents that can wait for the GUI thread before posts fail
+    size_t inputQueueCapacity = 1024;
+};
+
+/**
+ * @brief Dedicated GUI thread
+ *
+ * Each frame drains the input queue into GuiSystem::processInputBatch(), then
+ * runs beginFrame(), the frame callbacks in registration order, and
+ * endFrame(), which publishes the draw data to the render thread (requires
+ * GuiConfig::enableDrawDataCapture). While running, the GUI thread owns
+ * the ImGui context: other threads may only post input and use the
+ * render-thread calls of GuiSystem (getDrawData(), renderDrawData() and
+ * the secondary command buffer calls, with explicit frame indices).
+ * Font atlas changes (new glyphs) travel with the frames and are applied
+ * by renderDrawData() and recordSecondary() on the render thread.
+ */
+class GuiThread {
+public:
+    /// Called once per frame between beginFrame() and endFrame()
+    using FrameCallback = std::function<void(float deltaTime)>;
+
+    /**
+     * @brief Create the runner (the thread starts with start())
+     * @param gui GUI system to drive; must outlive this object
+     */
+    explicit GuiThread(GuiSystem& gui, GuiThreadConfig config = {});
+
+    /// Stops the thread; an exception it threw is discarded
+    ~GuiThread();
+
+    GuiThread(const GuiThread&) = delete;
+    GuiThread& operator=(const GuiThread&) = delete;
+
+    /**
+     * @brief Add a per-frame callback (e.g. GuiRenderer::renderAll)
+     * @throws std::runtime_error while the thread is running
+     */
+    void addFrameCallback(FrameCallback callback);
+
+    /**
+     * @brief Start building frames on the GUI thread
+     * @throws std::runtime_error if already running, or if the GuiSystem
+     *         was created without GuiConfig::enableDrawDataCapture or with
+     *         GuiConfig::cachedLayer (whose layer is rendered from the
+     *         GUI thread's ImGui state)
+     */
+    void start();
+
+    /**
+     * @brief Finish the current frame and join the thread
+     *
+     * Input still queued stays queued for a later start().
+     * @throws The exception that stopped the thread, if a frame threw one
+     */
+    void stop();
+
+    /// Check whether the thread is running (false once a frame has thrown)
+    [[nodiscard]] bool running() const { return running_.load(std::memory_order_acquire); }
+
+    /**
+     * @brief Queue an input event for the next frame (any thread, lock-free)
+     * @return false if the queue was full and the event was dropped
+     */
+    bool postInput(const InputEvent& event) { return input_.push(event); }
+
+    /// Frames built since construction
+    [[nodiscard]] uint64_t frames() const { return frames_.load(std::memory_order_relaxed); }
+
+    /// Input events passed to GuiSystem::processInputBatch() since construction
+    [[nodiscard]] uint64_t inputsProcessed() const { return inputsProcessed_.load(std::memory_order_relaxed); }
+
+    /// Input events dropped because the queue was full
+    [[nodiscard]] uint64_t inputsDropped() const { return input_.dropped(); }
+
+    /// Smoothed CPU time of one frame on the GUI thread, in microseconds
+    [[nodiscard]] float frameMicros() const { return frameMicros_.load(std::memory_order_relaxed); }
+
+private:
+    void run();
+
+    GuiSystem& gui_;
+    GuiThreadConfig config_;
+    InputQueue input_;
+    std::vector<InputEvent> inputBatch_;  // GUI thread only
+    std::vector<FrameCallback> callbacks_;
+
+    std::thread thread_;
+    std::atomic<bool> running_{false};
+    std::exception_ptr error_;
+
+    // Pacing sleeps wait on this so stop() does not wait out a frame interval
+    std::mutex stopMutex_;
+    std::condition_variable stopCv_;
+    bool stopRequested_ = false;
+
+    std::atomic<uint64_t> frames_{0};
+    std::atomic<uint64_t> inputsProcessed_{0};
+    std::atomic<float> frameMicros_{0.0f};
+};
+
+} // namespace finegui
@@ -0,0 +1,74 @@
+#pragma once
+
+/**
+ * @file input_queue.hpp
+ * @brief Lock-free multi-producer, single-consumer queue of InputEvents
+ *
+ * Carries input from the threads that collect it (window, network, replay)
+ * to the GUI thread (see GuiThread). Bounded and allocation-free after
+ * construction; a push to a full queue fails instead of blocking.
+ */
+
+#include "input_adapter.hpp"
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+namespace finegui {
+
+/**
+ * @brief Bounded MPSC ring of InputEvents
+ *
+ * Producers claim a cell by advancing a shared position with a CAS; each
+ * cell's sequence number tells whether it is free for the claimer or
+ * holds an event for the consumer. Events from one producer are popped
+ * in the order that producer pushed them.
+ */
+class InputQueue {
+public:
+    /**
+     * @brief Create the ring
+     * @param capacity Maximum queued events (rounded up to a power of two)
+     */
+    explicit InputQueue(size_t capacity = 1024);
+    ~InputQueue();
+
+    InputQueue(const InputQueue&) = delete;
+    InputQueue& operator=(const InputQueue&) = delete;
+
+    /**
+     * @brief Queue an event (any thread)
+     * @return false if the queue was full; the event is dropped and counted
+     */
+    bool push(const InputEvent& event);
+
+    /**
+     * @brief Take the oldest event (consumer thread only)
+     * @return false if no event was ready
+     */
+    bool pop(InputEvent& event);
+
+    /// Number of cells
+    [[nodiscard]] size_t capacity() const { return mask_ + 1; }
+
+    /// Events rejected because the queue was full
+    [[nodiscard]] uint64_t dropped() const { return dropped_.load(std::memory_order_relaxed); }
+
+private:
+    struct Cell {
+        std::atomic<size_t> sequence{0};
+        InputEvent event{};
+    };
+
+    std::unique_ptr<Cell[]> cells_;
+    size_t mask_ = 0;
+
+    // Producers and the consumer touch separate cache lines
+    alignas(64) std::atomic<size_t> enqueuePos_{0};
+    alignas(64) size_t dequeuePos_ = 0;
+    std::atomic<uint64_t> dropped_{0};
+};
+
+} // namespace finegui
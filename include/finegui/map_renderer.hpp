@@ -6,8 +6,10 @@
 #include <finescript/value.h>
 #include <finescript/script_engine.h>
 #include <finescript/execution_context.h>
+#include <cstdint>
 #include <map>
 #include <string>
+#include <unordered_map>
 #include <vector>
 
 namespace finegui {
@@ -124,6 +126,18 @@ private:
     std::string lastFocusedId_;
     std::string currentFocusedId_;
 
+    // hasUniformRows() results by children array. Checked again when the
+    // array's size or first row changes, and dropped when a row the clipper
+    // draws no longer qualifies; entries not used in a frame are pruned.
+    struct UniformRows {
+        const void* firstRow = nullptr;
+        size_t size = 0;
+        bool uniform = false;
+        uint64_t frame = 0;
+    };
+    std::unordered_map<const void*, UniformRows> uniformRows_;
+    uint64_t frame_ = 0;
+
     void renderNode(finescript::MapData& map, finescript::ExecutionContext& ctx);
 
     // Per-widget render methods
@@ -224,12 +238,24 @@ private:
     void renderPushTheme(finescript::MapData& m);
     void renderPopTheme(finescript::MapData& m);
 
+    // Virtual (data-source-backed) lists
+    void renderVirtualList(finescript::MapData& m, finescript::ExecutionContext& ctx);
+    void renderVirtualTable(finescript::MapData& m, finescript::ExecutionContext& ctx);
+    void renderVirtualRows(finescript::MapData& m, bool inTable, finescript::ExecutionContext& ctx);
+
     // Window flags parsing
     int parseWindowFlags(finescript::MapData& m);
 
     // Drag-and-drop
     void handleDragDrop(finescript::MapData& m, finescript::ExecutionContext& ctx);
 
+    // List clipping: uniform row lists only submit the rows in view
+    void renderChildRows(finescript::Value& childrenVal, uint32_t rowType,
+                         finescript::ExecutionContext& ctx);
+    bool hasUniformRows(finescript::Value& childrenVal, uint32_t rowType);
+    bool isUniformRow(finescript::Value& row, uint32_t rowType);
+    bool isChildRowType(uint32_t sym) const;
+
     // Helpers
     std::string getStringField(finescript::MapData& m, uint32_t key, const char* def = "");
     double getNumericField(finescript::MapData& m, uint32_t key, double def = 0.0);
@@ -37,6 +37,10 @@ namespace finegui {
 
 class GuiSystem;
 
+namespace backend {
+class GpuTimer;
+}
+
 /**
  * @brief Manages an offscreen render surface and its ImGui texture registration.
  *
@@ -109,6 +113,14 @@ public:
      */
     void endScene();
 
+    /**
+     * @brief Get the smoothed GPU time of the scene pass in microseconds
+     *
+     * Measured with timestamps when GuiConfig::gpuTiming is active (0
+     * otherwise). Also summed into GuiSystem::gpuTimings().sceneMicros.
+     */
+    [[nodiscard]] float gpuMicros() const { return gpuMicros_; }
+
     // ========================================================================
     // Display
     // ========================================================================
@@ -156,6 +168,11 @@ private:
     uint32_t width_ = 0;
     uint32_t height_ = 0;
     bool rendering_ = false;
+
+    // Timestamps around the scene pass (GuiConfig::gpuTiming only)
+    std::unique_ptr<backend::GpuTimer> gpuTimer_;
+    float gpuMicros_ = 0.0f;
+    uint64_t gpuSamples_ = 0;
 };
 
 } // namespace finegui
@@ -13,6 +13,7 @@ namespace finegui {
 
 class MapRenderer;
 class HotkeyManager;
+class SessionRecorder;
 
 /// A single GUI driven by a finescript script.
 ///
@@ -59,6 +60,12 @@ public:
     /// Process queued messages. Call once per frame on GUI thread.
     void processPendingMessages();
 
+    /// Log every delivered message to a session recorder (nullptr stops).
+    /// Recorded with this GUI's ID as the target; see script_session.hpp.
+    /// Don't also attach the recorder to a ScriptGuiManager that delivers
+    /// to this GUI, or its messages are logged twice.
+    void setSessionRecorder(SessionRecorder* recorder);
+
     /// Close this GUI (removes widget tree from renderer).
     void close();
 
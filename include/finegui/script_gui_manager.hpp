@@ -12,6 +12,7 @@
 namespace finegui {
 
 class MapRenderer;
+class SessionRecorder;
 
 /// Manages multiple ScriptGui instances. Provides broadcast messaging,
 /// lifetime management, and a single processPendingMessages() call per frame.
@@ -43,6 +44,10 @@ public:
     /// Process all pending messages across all GUIs. Call once per frame on GUI thread.
     void processPendingMessages();
 
+    /// Log deliverMessage() and broadcast traffic to a session recorder
+    /// (nullptr stops). Replay it with replayScriptMessages().
+    void setSessionRecorder(SessionRecorder* recorder);
+
     /// Close a specific GUI by its renderer ID.
     void close(int guiId);
 
@@ -62,6 +67,7 @@ private:
     finescript::ScriptEngine& engine_;
     MapRenderer& renderer_;
     std::vector<std::unique_ptr<ScriptGui>> guis_;
+    SessionRecorder* recorder_ = nullptr;
 
     struct PendingBroadcast {
         uint32_t type;
@@ -0,0 +1,44 @@
+#pragma once
+
+#include <finegui/session_recorder.hpp>
+#include <finescript/script_engine.h>
+#include <finescript/value.h>
+#include <cstdint>
+#include <utility>
+
+namespace finegui {
+
+class ScriptGui;
+class ScriptGuiManager;
+class SessionReplayer;
+
+/// Session log encoding of script messages.
+///
+/// Symbols are interned per engine, so the message type and any symbol or
+/// map key in the data are written by name and re-interned on replay.
+/// Values with no portable form (closures, native functions) are written
+/// as nil.
+
+/// Write a message (type and data) as a session Message payload.
+void writeScriptMessage(SessionWriter& out, finescript::ScriptEngine& engine,
+                        uint32_t messageType, const finescript::Value& data);
+
+/// Read a message written by writeScriptMessage(): {messageType, data}.
+std::pair<uint32_t, finescript::Value> readScriptMessage(SessionReader& in,
+                                                         finescript::ScriptEngine& engine);
+
+/// Write / read a single value.
+void writeScriptValue(SessionWriter& out, finescript::ScriptEngine& engine,
+                      const finescript::Value& value);
+finescript::Value readScriptValue(SessionReader& in, finescript::ScriptEngine& engine);
+
+/// Replay recorded messages into a manager: broadcasts are broadcast again,
+/// the rest delivered to the GUI with the recorded ID.
+void replayScriptMessages(SessionReplayer& replayer, finescript::ScriptEngine& engine,
+                          ScriptGuiManager& manager);
+
+/// Replay recorded messages into a single GUI, whatever their target.
+void replayScriptMessages(SessionReplayer& replayer, finescript::ScriptEngine& engine,
+                          ScriptGui& gui);
+
+} // namespace finegui
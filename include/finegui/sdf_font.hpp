@@ -0,0 +1,47 @@
+#pragma once
+
+/**
+ * @file sdf_font.hpp
+ * @brief Signed-distance-field glyphs for scale-independent text
+ *
+ * Used when GuiConfig::sdfFonts is set: glyphs are rasterized once at
+ * GuiConfig::sdfBakeSize and their coverage is turned into a distance
+ * field, which the backend's SDF fragment shader thresholds at any scale.
+ * Exposed so the encoding can be inspected and tested without a device.
+ */
+
+#include <cstdint>
+
+struct ImFontLoader;
+
+namespace finegui {
+
+/// Distance in baked pixels covered by the [0, 1] value range (must match
+/// the SDF fragment shaders' expectations: 0.5 is the glyph edge)
+constexpr int kSdfSpread = 4;
+
+/**
+ * @brief Replace 8-bit coverage with a signed distance field, in place
+ *
+ * Values above 0.5 (128) are inside the glyph, below are outside; one unit
+ * of distance is 1 / (2 * spread). Pixels whose coverage is partial keep
+ * their coverage as a sub-pixel estimate of the edge position.
+ *
+ * @param pixels First coverage byte (e.g. the alpha byte of an RGBA pixel)
+ * @param width, height Region size in pixels
+ * @param pitch Bytes between rows
+ * @param stride Bytes between pixels in a row
+ * @param spread Distance in pixels mapped to the full value range
+ */
+void coverageToDistanceField(uint8_t* pixels, int width, int height,
+                             int pitch, int stride, int spread = kSdfSpread);
+
+/**
+ * @brief Font loader that rasterizes like ImGui's stb_truetype loader, then
+ *        converts each glyph to a distance field
+ *
+ * Install with ImFontAtlas::SetFontLoader() before adding fonts.
+ */
+const ImFontLoader* sdfFontLoader();
+
+} // namespace finegui
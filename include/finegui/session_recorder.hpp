@@ -0,0 +1,224 @@
+#pragma once
+
+/**
+ * @file session_recorder.hpp
+ * @brief Compact binary log of everything that drives a GUI session
+ *
+ * A SessionRecorder attached to a GuiSystem logs frame delta times, the
+ * input ImGui was given, state updates and (through the script layer)
+ * script message traffic, in order. SessionReplayer plays the log back
+ * frame-exactly, headless or not, for offline profiling and bug reports:
+ *
+ * @code
+ * finegui::SessionRecorder recorder("session.fgs");
+ * recorder.addStateType<HealthUpdate>(1, [](const HealthUpdate& u, finegui::SessionWriter& w) {
+ *     w.f32(u.current);
+ *     w.f32(u.max);
+ * });
+ * gui.setSessionRecorder(&recorder);
+ * @endcode
+ *
+ * Record layout (after the "FGS" magic and a version byte): a type byte,
+ * then FrameBegin (f32 delta time, flags, changed display size), FrameEnd,
+ * Input (event type, modifier/flag bits, type-specific fields), State
+ * (stable tag, length, payload) or Message (target, length, payload).
+ * Integers are LEB128 varints.
+ */
+
+#include "gui_state.hpp"
+#include "input_adapter.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <iosfwd>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+namespace finegui {
+
+// ============================================================================
+// Binary encoding
+// ============================================================================
+
+/**
+ * @brief Appends little-endian values and varints to a byte buffer
+ */
+class SessionWriter {
+public:
+    explicit SessionWriter(std::vector<uint8_t>& out) : out_(out) {}
+
+    void u8(uint8_t value) { out_.push_back(value); }
+    void varint(uint64_t value);
+    void svarint(int64_t value);      ///< Zigzag-encoded, small magnitudes stay short
+    void f32(float value);
+    void f64(double value);
+    void bytes(const void* data, size_t size);
+    void string(std::string_view value);  ///< Length-prefixed
+
+private:
+    std::vector<uint8_t>& out_;
+};
+
+/**
+ * @brief Reads what SessionWriter wrote
+ *
+ * Every read is bounds checked; running past the end throws
+ * std::runtime_error.
+ */
+class SessionReader {
+public:
+    SessionReader(const uint8_t* data, size_t size) : data_(data), size_(size) {}
+
+    uint8_t u8();
+    uint64_t varint();
+    int64_t svarint();
+    float f32();
+    double f64();
+    const uint8_t* bytes(size_t size);
+    std::string string();
+
+    [[nodiscard]] size_t remaining() const { return size_ - pos_; }
+    [[nodiscard]] bool atEnd() const { return pos_ == size_; }
+
+private:
+    const uint8_t* data_;
+    size_t size_;
+    size_t pos_ = 0;
+};
+
+/// Record types in a session log
+enum class SessionRecordType : uint8_t {
+    FrameBegin = 1,
+    FrameEnd = 2,
+    Input = 3,
+    State = 4,
+    Message = 5
+};
+
+/// Message target for broadcasts (otherwise the receiving GUI's ID)
+constexpr int kSessionBroadcast = -1;
+
+/// Session log magic and format version
+constexpr char kSessionMagic[3] = {'F', 'G', 'S'};
+constexpr uint8_t kSessionVersion = 1;
+
+namespace detail {
+
+// Input record flag bits (the low four are ctrl/shift/alt/super)
+constexpr uint8_t kSessionInputHasTime = 1 << 4;
+constexpr uint8_t kSessionInputFlag = 1 << 5;  // pressed / keyPressed / focused
+
+// FrameBegin flag bits
+constexpr uint8_t kSessionFrameDisplaySize = 1 << 0;
+
+} // namespace detail
+
+// ============================================================================
+// SessionRecorder
+// ============================================================================
+
+/**
+ * @brief Writes a session log
+ *
+ * Used from the GUI thread only. Records are buffered and written to the
+ * stream once per frame.
+ */
+class SessionRecorder {
+public:
+    /// Encodes one state update's fields
+    template<typename T>
+    using StateEncoder = std::function<void(const T& update, SessionWriter& out)>;
+
+    /// Record into a stream (must outlive the recorder)
+    explicit SessionRecorder(std::ostream& out);
+
+    /**
+     * @brief Record into a file
+     * @throws std::runtime_error if the file cannot be created
+     */
+    explicit SessionRecorder(const std::string& path);
+
+    /// Flushes what is buffered
+    ~SessionRecorder();
+
+    SessionRecorder(const SessionRecorder&) = delete;
+    SessionRecorder& operator=(const SessionRecorder&) = delete;
+
+    /**
+     * @brief Record applyState() calls of type T
+     *
+     * State types have no portable identity, so each recorded type gets a
+     * tag chosen by the application; SessionReplayer::addStateType() maps it
+     * back. Updates of types never added are not recorded (see
+     * unrecordedStates()).
+     */
+    template<typename T>
+    void addStateType(uint32_t tag, StateEncoder<T> encode) {
+        stateTypes_[T::staticTypeId()] = StateType{tag,
+            [encode = std::move(encode)](const GuiStateUpdate& update, SessionWriter& out) {
+                encode(static_cast<const T&>(update), out);
+            }};
+    }
+
+    // ========================================================================
+    // Recording (called by GuiSystem and the script layer)
+    // ========================================================================
+
+    /// Start of a frame: effective delta time and display size in pixels
+    void recordFrameBegin(float deltaTime, int displayWidth, int displayHeight);
+
+    /// End of a frame; flushes the frame's records to the stream
+    void recordFrameEnd();
+
+    /// An input event as given to ImGui
+    void recordInput(const InputEvent& event);
+
+    /// A state update (skipped if its type was not added)
+    void recordState(const GuiStateUpdate& update);
+
+    /**
+     * @brief A script message
+     * @param target Receiving GUI ID, or kSessionBroadcast
+     * @param writePayload Writes the message (see script_session.hpp)
+     */
+    void recordMessage(int target, const std::function<void(SessionWriter&)>& writePayload);
+
+    /// Write buffered records to the stream now
+    void flush();
+
+    /// Frames recorded
+    [[nodiscard]] uint64_t frames() const { return frames_; }
+
+    /// Bytes written to the stream, including the header
+    [[nodiscard]] uint64_t bytesWritten() const { return bytesWritten_; }
+
+    /// State updates not recorded because their type was not added
+    [[nodiscard]] uint64_t unrecordedStates() const { return unrecordedStates_; }
+
+private:
+    struct StateType {
+        uint32_t tag;
+        std::function<void(const GuiStateUpdate&, SessionWriter&)> encode;
+    };
+
+    void writeHeader();
+    void writePayload(const std::function<void(SessionWriter&)>& write);
+
+    std::unique_ptr<std::ofstream> file_;
+    std::ostream* out_ = nullptr;
+    std::vector<uint8_t> buffer_;
+    std::vector<uint8_t> payload_;
+    std::unordered_map<uint32_t, StateType> stateTypes_;
+
+    int displayWidth_ = -1;
+    int displayHeight_ = -1;
+    uint64_t frames_ = 0;
+    uint64_t bytesWritten_ = 0;
+    uint64_t unrecordedStates_ = 0;
+};
+
+} // namespace finegui
@@ -0,0 +1,120 @@
+#pragma once
+
+/**
+ * @file session_replayer.hpp
+ * @brief Plays a session log back into a GuiSystem
+ *
+ * @code
+ * finegui::GuiSystem gui(config);           // Same fonts and dpiScale as recorded
+ * gui.initializeHeadless(1920, 1080);
+ *
+ * finegui::SessionReplayer replayer("session.fgs");
+ * replayer.addStateType<HealthUpdate>(1, [](finegui::SessionReader& r) {
+ *     HealthUpdate u;
+ *     u.current = r.f32();
+ *     u.max = r.f32();
+ *     return u;
+ * });
+ * while (replayer.replayFrame(gui, [&](float) { guiRenderer.renderAll(); })) {
+ * }
+ * @endcode
+ */
+
+#include "gui_system.hpp"
+#include "session_recorder.hpp"
+
+#include <cstdint>
+#include <functional>
+#include <iosfwd>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace finegui {
+
+/**
+ * @brief Replays a log written by SessionRecorder
+ *
+ * Each replayFrame() feeds the records that preceded the next frame to the
+ * GuiSystem, then runs beginFrame() with the recorded delta time, the
+ * records logged during that frame, the frame callback, and endFrame().
+ * With the same GUI setup (fonts, dpiScale, widget code) every frame sees
+ * exactly the input, timing and updates it saw when recorded.
+ */
+class SessionReplayer {
+public:
+    /// Decodes one state update's fields
+    template<typename T>
+    using StateDecoder = std::function<T(SessionReader& in)>;
+
+    /// Receives a recorded script message (target is a GUI ID or kSessionBroadcast)
+    using MessageHandler = std::function<void(int target, SessionReader& payload)>;
+
+    /// Builds the GUI between beginFrame() and endFrame()
+    using FrameCallback = std::function<void(float deltaTime)>;
+
+    /**
+     * @brief Load a log from a stream
+     * @throws std::runtime_error if it is not a session log of a known version
+     */
+    explicit SessionReplayer(std::istream& in);
+
+    /**
+     * @brief Load a log from a file
+     * @throws std::runtime_error if the file cannot be read or is not a session log
+     */
+    explicit SessionReplayer(const std::string& path);
+
+    /**
+     * @brief Replay State records with @p tag through GuiSystem::applyState<T>()
+     *
+     * Records with tags that were never added are skipped (see skippedRecords()).
+     */
+    template<typename T>
+    void addStateType(uint32_t tag, StateDecoder<T> decode) {
+        stateTypes_[tag] = [decode = std::move(decode)](GuiSystem& gui, SessionReader& in) {
+            gui.applyState(decode(in));
+        };
+    }
+
+    /// Set the receiver of Message records (see script_session.hpp)
+    void setMessageHandler(MessageHandler handler) { messageHandler_ = std::move(handler); }
+
+    /**
+     * @brief Replay the next frame
+     * @return false once the log has no more frames
+     * @throws std::runtime_error if the log is truncated or corrupt
+     */
+    bool replayFrame(GuiSystem& gui, const FrameCallback& buildFrame = {});
+
+    /// Replay every remaining frame; returns the number replayed
+    uint64_t replayAll(GuiSystem& gui, const FrameCallback& buildFrame = {});
+
+    /// Restart from the first frame
+    void rewind();
+
+    /// Has the whole log been replayed?
+    [[nodiscard]] bool finished() const { return pos_ >= data_.size(); }
+
+    /// Frames replayed since construction or rewind()
+    [[nodiscard]] uint64_t frames() const { return frames_; }
+
+    /// State and Message records with no decoder or handler
+    [[nodiscard]] uint64_t skippedRecords() const { return skippedRecords_; }
+
+private:
+    void load(std::istream& in);
+
+    /// Apply one record; returns its type
+    SessionRecordType dispatch(GuiSystem& gui, SessionReader& in, float& deltaTime);
+
+    std::vector<uint8_t> data_;
+    size_t start_ = 0;      // First record, after the header
+    size_t pos_ = 0;
+    std::unordered_map<uint32_t, std::function<void(GuiSystem&, SessionReader&)>> stateTypes_;
+    MessageHandler messageHandler_;
+    uint64_t frames_ = 0;
+    uint64_t skippedRecords_ = 0;
+};
+
+} // namespace finegui
@@ -0,0 +1,146 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <vector>
+
+namespace finegui {
+
+class WidgetArena;
+
+namespace detail {
+
+struct ArenaState;
+
+/// Allocate WidgetNode storage from the current arena, or the heap if no
+/// WidgetArena::Scope is active. The block remembers where it came from.
+void* allocateNodeStorage(size_t size);
+
+/// Free a block from allocateNodeStorage().
+void freeNodeStorage(void* ptr) noexcept;
+
+} // namespace detail
+
+/// Bump allocator for widget tree storage.
+///
+/// While a WidgetArena::Scope is active on a thread, every child list and
+/// side storage block a WidgetNode allocates on that thread comes from the
+/// arena instead of the heap. Freeing such a block does nothing; the
+/// memory comes back all at once with reset(), which keeps the chunks for
+/// the next tree. GuiRenderer::showInArena() / updateInArena() manage this
+/// per tree.
+///
+/// Usage:
+///   WidgetArena arena;
+///   WidgetNode tree;
+///   {
+///       WidgetArena::Scope scope(arena);
+///       tree = WidgetNode::window("Inventory", { ... });
+///   }
+///   // ... use tree ...
+///   tree = {};          // destroy the nodes (cheap, nothing is freed)
+///   arena.reset();      // release the storage in one shot
+///
+/// String contents longer than the small-string buffer and large callback
+/// captures still live on the heap. Nodes built in an arena must not be
+/// moved into a tree that outlives the next reset() - copy them instead.
+/// An arena destroyed while such nodes are alive hands its chunks over to
+/// them; the last one to go frees them.
+class WidgetArena {
+public:
+    static constexpr size_t kDefaultChunkSize = 64 * 1024;
+
+    /// Every allocation is aligned to this.
+    static constexpr size_t kAlignment = alignof(std::max_align_t);
+
+    explicit WidgetArena(size_t chunkSize = kDefaultChunkSize);
+
+    /// Frees the chunks, or leaves them to blocks still in use.
+    ~WidgetArena();
+
+    WidgetArena(const WidgetArena&) = delete;
+    WidgetArena& operator=(const WidgetArena&) = delete;
+
+    /// Allocate size bytes. Large requests get a chunk of their own.
+    void* allocate(size_t size);
+
+    /// Rewind to empty, keeping the chunks.
+    /// Throws std::runtime_error if blocks handed out through the node
+    /// allocator are still in use (a tree built here has not been destroyed);
+    /// check liveBlocks() first where that can happen.
+    void reset();
+
+    /// Bytes handed out since the last reset().
+    [[nodiscard]] size_t bytesUsed() const { return bytesUsed_; }
+
+    /// Bytes held in chunks.
+    [[nodiscard]] size_t bytesReserved() const { return bytesReserved_; }
+
+    /// Node storage blocks allocated here and not yet freed.
+    [[nodiscard]] size_t liveBlocks() const;
+
+    /// Routes node allocations on the current thread to an arena for its
+    /// lifetime. Scopes nest; the previous arena is restored on exit.
+    class Scope {
+    public:
+        explicit Scope(WidgetArena& arena);
+        ~Scope();
+
+        Scope(const Scope&) = delete;
+        Scope& operator=(const Scope&) = delete;
+
+    private:
+        WidgetArena* previous_;
+    };
+
+    /// The arena node allocations on this thread go to, or nullptr (heap).
+    static WidgetArena* current();
+
+private:
+    friend void* detail::allocateNodeStorage(size_t size);
+    friend void detail::freeNodeStorage(void* ptr) noexcept;
+
+    size_t chunkSize_;
+    detail::ArenaState* state_;  // chunks and live block count
+    size_t chunkIndex_ = 0;      // chunk currently being filled
+    size_t chunkOffset_ = 0;     // bytes used in it
+    size_t bytesUsed_ = 0;
+    size_t bytesReserved_ = 0;
+};
+
+namespace detail {
+
+/// Allocator for WidgetNode child lists. Stateless, so lists built in an
+/// arena and on the heap can be moved and swapped freely; each block
+/// records its own origin.
+template<typename T>
+struct NodeAllocator {
+    using value_type = T;
+    using is_always_equal = std::true_type;
+
+    NodeAllocator() noexcept = default;
+    template<typename U>
+    NodeAllocator(const NodeAllocator<U>&) noexcept {}
+
+    T* allocate(size_t n) {
+        static_assert(alignof(T) <= WidgetArena::kAlignment, "NodeAllocator: over-aligned type");
+        if (n > SIZE_MAX / sizeof(T)) throw std::bad_array_new_length();
+        return static_cast<T*>(allocateNodeStorage(n * sizeof(T)));
+    }
+
+    void deallocate(T* ptr, size_t) noexcept {
+        freeNodeStorage(ptr);
+    }
+
+    template<typename U>
+    bool operator==(const NodeAllocator<U>&) const noexcept { return true; }
+    template<typename U>
+    bool operator!=(const NodeAllocator<U>&) const noexcept { return false; }
+};
+
+} // namespace detail
+
+} // namespace finegui
@@ -117,6 +117,13 @@ struct ConverterSymbols {
     // Type name symbols - Style & Theming (Named presets)
     uint32_t sym_push_theme = 0, sym_pop_theme = 0;
 
+    // Type name symbols - Virtual lists
+    uint32_t sym_virtual_list = 0, sym_virtual_table = 0;
+
+    // Virtual list field keys
+    uint32_t row_count = 0, row_fn = 0, row_height = 0;
+    uint32_t sort_column = 0, sort_ascending = 0, on_sort = 0;
+
     // Phase 12 field keys
     uint32_t hint = 0;
 
@@ -3,8 +3,12 @@
 #include <string>
 #include <vector>
 #include <functional>
+#include <new>
+#include <iterator>
 #include <cfloat>
+#include <cstdint>
 #include "texture_handle.hpp"
+#include "widget_arena.hpp"
 
 namespace finegui {
 
@@ -14,10 +18,100 @@ struct WidgetNode;
 /// The callback receives the widget node that triggered it.
 using WidgetCallback = std::function<void(WidgetNode& widget)>;
 
+/// Row source for VirtualList / VirtualTable. Called once per visible row
+/// per frame with the row index; returns the widgets to draw for it.
+using RowProvider = std::function<WidgetNode(int row)>;
+
+/// Child list of a WidgetNode. A std::vector whose storage comes from the
+/// current WidgetArena, if any, instead of the heap. Converts implicitly
+/// from std::vector<WidgetNode>, so builders still take plain vectors.
+class WidgetList : public std::vector<WidgetNode, detail::NodeAllocator<WidgetNode>> {
+    using Base = std::vector<WidgetNode, detail::NodeAllocator<WidgetNode>>;
+public:
+    using Base::Base;
+    WidgetList() = default;
+    WidgetList(const std::vector<WidgetNode>& nodes);
+    WidgetList(std::vector<WidgetNode>&& nodes);
+};
+
+namespace detail {
+
+/// Owning pointer to a block of WidgetNode side storage. Copies deeply;
+/// reads of an unallocated block see a shared default-constructed one,
+/// and the block is allocated on first write. Blocks come from the
+/// current WidgetArena, if any (see widget_arena.hpp).
+template<typename T>
+class SideStorage {
+public:
+    SideStorage() = default;
+    SideStorage(const SideStorage& other)
+        : ptr_(other.ptr_ ? create(other.ptr_) : nullptr) {}
+    SideStorage(SideStorage&& other) noexcept : ptr_(other.ptr_) { other.ptr_ = nullptr; }
+    ~SideStorage() { destroy(); }
+
+    SideStorage& operator=(const SideStorage& other) {
+        if (this != &other) {
+            T* copy = other.ptr_ ? create(other.ptr_) : nullptr;
+            destroy();
+            ptr_ = copy;
+        }
+        return *this;
+    }
+    SideStorage& operator=(SideStorage&& other) noexcept {
+        if (this != &other) {
+            destroy();
+            ptr_ = other.ptr_;
+            other.ptr_ = nullptr;
+        }
+        return *this;
+    }
+
+    const T& get() const {
+        static const T defaults{};
+        return ptr_ ? *ptr_ : defaults;
+    }
+
+    T& mut() {
+        if (!ptr_) ptr_ = create(nullptr);
+        return *ptr_;
+    }
+
+    [[nodiscard]] bool allocated() const { return ptr_ != nullptr; }
+
+private:
+    static T* create(const T* from) {
+        static_assert(alignof(T) <= WidgetArena::kAlignment, "SideStorage: over-aligned type");
+        void* mem = allocateNodeStorage(sizeof(T));
+        try {
+            return from ? new (mem) T(*from) : new (mem) T();
+        } catch (...) {
+            freeNodeStorage(mem);
+            throw;
+        }
+    }
+
+    void destroy() noexcept {
+        if (ptr_) {
+            ptr_->~T();
+            freeNodeStorage(ptr_);
+            ptr_ = nullptr;
+        }
+    }
+
+    T* ptr_ = nullptr;
+};
+
+} // namespace detail
+
 /// A single node in the retained-mode widget tree.
+///
+/// Fields read by nearly every node every frame live inline. Rarely used
+/// properties (props()) and callbacks (callbacks()) live in side storage
+/// that is only allocated for nodes that set them, so large trees of
+/// text, separators and layout nodes stay small.
 struct WidgetNode {
     /// Widget type - determines which ImGui calls to make.
-    enum class Type {
+    enum class Type : uint8_t {
         // Phase 1 - Core widgets
         Window, Text, Button, Checkbox, Slider, SliderInt,
         InputText, InputInt, InputFloat,
@@ -54,73 +148,153 @@ struct WidgetNode {
         // Phase 15 - Display (plots)
         PlotLines, PlotHistogram,
         // Style & Theming - Named presets
-        PushTheme, PopTheme
+        PushTheme, PopTheme,
+        // Virtual (data-source-backed) lists
+        VirtualList, VirtualTable
     };
 
-    Type type;
+    /// Rarely used properties - which fields are used depends on type.
+    struct Props {
+        /// Text value (InputText variants).
+        std::string stringValue;
 
-    /// Display properties - which fields are used depends on type.
-    std::string label;              // button text, window title, etc.
-    std::string textContent;        // static text content
-    std::string id;                 // ImGui ID (for disambiguating widgets)
+        /// Range constraints (sliders, drags).
+        float minFloat = 0.0f, maxFloat = 1.0f;
+        int minInt = 0, maxInt = 100;
 
-    /// Value storage - widgets that hold state use these.
-    float floatValue = 0.0f;
-    int intValue = 0;
-    bool boolValue = false;
-    std::string stringValue;
-    int selectedIndex = -1;         // for Combo, ListBox
+        /// Column count (Columns, Table).
+        int columnCount = 1;
 
-    /// Range constraints (sliders, drags).
-    float minFloat = 0.0f, maxFloat = 1.0f;
-    int minInt = 0, maxInt = 100;
+        /// Items list (for Combo, ListBox).
+        std::vector<std::string> items;
 
-    /// Layout properties.
-    float width = 0.0f;            // 0 = auto
-    float height = 0.0f;
-    int columnCount = 1;
+        /// Texture handle (for Image widgets).
+        TextureHandle texture{};
+        float imageWidth = 0.0f;
+        float imageHeight = 0.0f;
 
-    /// Items list (for Combo, ListBox).
-    std::vector<std::string> items;
+        /// Color (for TextColored, ProgressBar overlay, etc.) - RGBA 0-1.
+        float colorR = 1.0f, colorG = 1.0f, colorB = 1.0f, colorA = 1.0f;
 
-    /// Children (for Window, Group, Columns, TabBar, etc.)
-    std::vector<WidgetNode> children;
+        /// Overlay text (for ProgressBar).
+        std::string overlayText;
+
+        /// Offset (for SameLine).
+        float offsetX = 0.0f;
+
+        /// Animation: window alpha (1.0 = fully opaque).
+        float alpha = 1.0f;
+        /// Animation: explicit window position (FLT_MAX = ImGui auto-positioning).
+        float windowPosX = FLT_MAX;
+        float windowPosY = FLT_MAX;
+        /// Animation: window scale (1.0 = normal size, 0.0 = collapsed to center).
+        float scaleX = 1.0f;
+        float scaleY = 1.0f;
+        /// Animation: Y-axis rotation in radians (0 = facing forward, PI = flipped).
+        float rotationY = 0.0f;
+
+        /// MenuItem shortcut text.
+        std::string shortcutText;
+
+        /// Table properties.
+        int tableFlags = 0;        // ImGuiTableFlags bitmask
+
+        /// Window properties.
+        int windowFlags = 0;       // ImGuiWindowFlags bitmask
+        /// Programmatic window size (0 = ImGui auto-size).
+        float windowSizeW = 0.0f;
+        float windowSizeH = 0.0f;
+        /// Window position pivot (0,0 = top-left, 0.5,0.5 = center).
+        float windowPivotX = 0.0f;
+        float windowPivotY = 0.0f;
+
+        /// Drag widget properties.
+        float dragSpeed = 1.0f;
+
+        /// Format string for sliders/drags (e.g. "%.2f", "%d"). Empty = ImGui default.
+        std::string formatString;
+
+        /// DragFloat3 values (3-component vector).
+        float floatX = 0.0f, floatY = 0.0f, floatZ = 0.0f;
+
+        /// Hint text (for InputTextWithHint placeholder).
+        std::string hintText;
+
+        /// Plot data values (for PlotLines, PlotHistogram).
+        std::vector<float> plotValues;
+
+        /// ListBox properties.
+        int heightInItems = -1;   // -1 = auto height
+
+        /// DnD type string (e.g., "item"). Empty = not a drag source.
+        std::string dragType;
+
+        /// Payload data string carried during drag.
+        std::string dragData;
+
+        /// Accepted DnD type. Empty = not a drop target.
+        std::string dropAcceptType;
+
+        /// Drag mode: 0 = both traditional + click-to-pick-up,
+        ///            1 = traditional drag only,
+        ///            2 = click-to-pick-up only.
+        int dragMode = 0;
+
+        /// VirtualList / VirtualTable properties.
+        int rowCount = 0;
+        float rowHeight = 0.0f;    // 0 = measured from the first row
+        bool rowSelection = false; // rows are selectable (selectedIndex)
+        int sortColumn = -1;       // -1 = unsorted
+        bool sortAscending = true;
+
+        bool operator==(const Props& other) const;
+        bool operator!=(const Props& other) const { return !(*this == other); }
+    };
+
+    /// Callbacks - invoked by GuiRenderer when interactions occur.
+    struct Callbacks {
+        WidgetCallback onClick;         // Button, MenuItem, Image
+        WidgetCallback onChange;        // Checkbox, Slider, Input, Combo, ColorEdit
+        WidgetCallback onSubmit;        // InputText (Enter pressed)
+        WidgetCallback onClose;         // Window close button
+        WidgetCallback onHistory;       // InputText (Up/Down arrow history)
+
+        /// Canvas callback - called each frame to do custom drawing.
+        /// User can call ImGui::GetWindowDrawList() in the callback.
+        WidgetCallback onDraw;
+
+        /// Called on the DROP TARGET when an item is delivered.
+        /// props().dragData will contain the delivered payload data.
+        WidgetCallback onDrop;
+
+        /// Called on the DRAG SOURCE when a drag/pick-up begins.
+        WidgetCallback onDragBegin;
+
+        /// Called when this widget gains keyboard focus.
+        WidgetCallback onFocus;
+
+        /// Called when this widget loses keyboard focus.
+        WidgetCallback onBlur;
+
+        /// VirtualList / VirtualTable row source.
+        RowProvider rowProvider;
+
+        /// VirtualTable: sort column or direction changed. The new order is
+        /// in props().sortColumn / sortAscending; reorder the data source.
+        WidgetCallback onSort;
+    };
+
+    // -- Hot fields ----------------------------------------------------------
+    // Read by nearly every node every frame; kept small and inline.
+
+    Type type;
 
     /// Visibility / enabled state.
     bool visible = true;
     bool enabled = true;
 
-    /// Callbacks - invoked by GuiRenderer when interactions occur.
-    WidgetCallback onClick;         // Button, MenuItem, Image
-    WidgetCallback onChange;        // Checkbox, Slider, Input, Combo, ColorEdit
-    WidgetCallback onSubmit;        // InputText (Enter pressed)
-    WidgetCallback onClose;         // Window close button
-    WidgetCallback onHistory;       // InputText (Up/Down arrow history)
-
-    /// Texture handle (for Image widgets).
-    TextureHandle texture{};
-    float imageWidth = 0.0f;
-    float imageHeight = 0.0f;
-
-    /// Color (for TextColored, ProgressBar overlay, etc.) - RGBA 0-1.
-    float colorR = 1.0f, colorG = 1.0f, colorB = 1.0f, colorA = 1.0f;
-
-    /// Overlay text (for ProgressBar).
-    std::string overlayText;
-
-    /// Offset (for SameLine).
-    float offsetX = 0.0f;
-
-    /// Animation: window alpha (1.0 = fully opaque).
-    float alpha = 1.0f;
-    /// Animation: explicit window position (FLT_MAX = ImGui auto-positioning).
-    float windowPosX = FLT_MAX;
-    float windowPosY = FLT_MAX;
-    /// Animation: window scale (1.0 = normal size, 0.0 = collapsed to center).
-    float scaleX = 1.0f;
-    float scaleY = 1.0f;
-    /// Animation: Y-axis rotation in radians (0 = facing forward, PI = flipped).
-    float rotationY = 0.0f;
+    /// Boolean value (Checkbox, Selectable).
+    bool boolValue = false;
 
     /// Default-open state (for CollapsingHeader, TreeNode).
     bool defaultOpen = false;
@@ -133,87 +307,71 @@ struct WidgetNode {
     bool leaf = false;
 
     /// MenuItem properties.
-    std::string shortcutText;
     bool checked = false;
 
-    /// Table properties.
-    int tableFlags = 0;        // ImGuiTableFlags bitmask
-
-    /// Window properties.
-    int windowFlags = 0;       // ImGuiWindowFlags bitmask
-    /// Programmatic window size (0 = ImGui auto-size).
-    float windowSizeW = 0.0f;
-    float windowSizeH = 0.0f;
-    /// Window position pivot (0,0 = top-left, 0.5,0.5 = center).
-    float windowPivotX = 0.0f;
-    float windowPivotY = 0.0f;
-
-    /// Drag widget properties.
-    float dragSpeed = 1.0f;
-
-    /// Format string for sliders/drags (e.g. "%.2f", "%d"). Empty = ImGui default.
-    std::string formatString;
-
-    /// DragFloat3 values (3-component vector).
-    float floatX = 0.0f, floatY = 0.0f, floatZ = 0.0f;
-
-    /// Hint text (for InputTextWithHint placeholder).
-    std::string hintText;
-
-    /// Plot data values (for PlotLines, PlotHistogram).
-    std::vector<float> plotValues;
+    /// Whether this widget participates in tab navigation (default: true).
+    /// Set to false to skip this widget when tabbing.
+    bool focusable = true;
 
-    /// ListBox properties.
-    int heightInItems = -1;   // -1 = auto height
+    /// Focus this widget when its parent window first appears.
+    bool autoFocus = false;
 
-    /// Canvas callback - called each frame to do custom drawing.
-    /// User can call ImGui::GetWindowDrawList() in the callback.
-    WidgetCallback onDraw;
+    /// Value storage - widgets that hold state use these.
+    float floatValue = 0.0f;
+    int intValue = 0;
+    int selectedIndex = -1;         // for Combo, ListBox, VirtualList/Table
 
-    // -- Drag and Drop --------------------------------------------------------
+    /// Layout properties.
+    float width = 0.0f;            // 0 = auto
+    float height = 0.0f;
 
-    /// DnD type string (e.g., "item"). Empty = not a drag source.
-    std::string dragType;
+    /// Display properties - which fields are used depends on type.
+    std::string label;              // button text, window title, etc.
+    std::string textContent;        // static text content
+    std::string id;                 // ImGui ID (for disambiguating widgets)
 
-    /// Payload data string carried during drag.
-    std::string dragData;
+    /// Children (for Window, Group, Columns, TabBar, etc.)
+    WidgetList children;
 
-    /// Accepted DnD type. Empty = not a drop target.
-    std::string dropAcceptType;
+    // -- Side storage --------------------------------------------------------
 
-    /// Called on the DROP TARGET when an item is delivered.
-    /// node.dragData will contain the delivered payload data.
-    WidgetCallback onDrop;
+    /// Read rarely used properties. Returns defaults (and allocates nothing)
+    /// if the node never wrote one.
+    const Props& props() const { return props_.get(); }
 
-    /// Called on the DRAG SOURCE when a drag/pick-up begins.
-    WidgetCallback onDragBegin;
+    /// Write rarely used properties; allocates them on first use.
+    Props& propsMut() { return props_.mut(); }
 
-    /// Drag mode: 0 = both traditional + click-to-pick-up,
-    ///            1 = traditional drag only,
-    ///            2 = click-to-pick-up only.
-    int dragMode = 0;
+    /// Read callbacks. Returns empty callbacks if none were ever set.
+    const Callbacks& callbacks() const { return callbacks_.get(); }
 
-    // -- Focus management ----------------------------------------------------
+    /// Set callbacks; allocates them on first use.
+    Callbacks& callbacksMut() { return callbacks_.mut(); }
 
-    /// Whether this widget participates in tab navigation (default: true).
-    /// Set to false to skip this widget when tabbing.
-    bool focusable = true;
+    /// Whether property / callback side storage has been allocated.
+    [[nodiscard]] bool hasProps() const { return props_.allocated(); }
+    [[nodiscard]] bool hasCallbacks() const { return callbacks_.allocated(); }
 
-    /// Focus this widget when its parent window first appears.
-    bool autoFocus = false;
+    // -- Reconciliation ------------------------------------------------------
 
-    /// Called when this widget gains keyboard focus.
-    WidgetCallback onFocus;
+    /// Make this subtree equal to next, keeping matching nodes in place.
+    /// Children match by id when they have one, otherwise by position among
+    /// the children without an id; either way the type must match too.
+    /// Matched nodes only have their changed fields written and are patched
+    /// recursively; the rest are added or removed. Callbacks are always
+    /// taken from next, since they can't be compared.
+    /// Returns the number of nodes changed, added or removed.
+    size_t reconcile(WidgetNode&& next);
 
-    /// Called when this widget loses keyboard focus.
-    WidgetCallback onBlur;
+    /// Number of nodes in this subtree, this one included.
+    [[nodiscard]] size_t subtreeSize() const;
 
     // -- Convenience builders ------------------------------------------------
 
-    static WidgetNode window(std::string title, std::vector<WidgetNode> children = {},
+    static WidgetNode window(std::string title, WidgetList children = {},
                              int flags = 0);
     static WidgetNode window(std::string title, float width, float height,
-                             std::vector<WidgetNode> children = {}, int flags = 0);
+                             WidgetList children = {}, int flags = 0);
     static WidgetNode text(std::string content);
     static WidgetNode button(std::string label, WidgetCallback onClick = {});
     static WidgetNode checkbox(std::string label, bool value, WidgetCallback onChange = {});
@@ -228,8 +386,8 @@ struct WidgetNode {
     static WidgetNode combo(std::string label, std::vector<std::string> items,
                             int selected, WidgetCallback onChange = {});
     static WidgetNode separator();
-    static WidgetNode group(std::vector<WidgetNode> children);
-    static WidgetNode columns(int count, std::vector<WidgetNode> children);
+    static WidgetNode group(WidgetList children);
+    static WidgetNode columns(int count, WidgetList children);
     static WidgetNode image(TextureHandle texture, float width, float height);
 
     // Phase 3 builders
@@ -240,19 +398,19 @@ struct WidgetNode {
     static WidgetNode textDisabled(std::string content);
     static WidgetNode progressBar(float fraction, float width = 0.0f, float height = 0.0f,
                                   std::string overlay = "");
-    static WidgetNode collapsingHeader(std::string label, std::vector<WidgetNode> children = {},
+    static WidgetNode collapsingHeader(std::string label, WidgetList children = {},
                                        bool defaultOpen = false);
 
     // Phase 4 builders
-    static WidgetNode tabBar(std::string id, std::vector<WidgetNode> children = {});
-    static WidgetNode tabItem(std::string label, std::vector<WidgetNode> children = {});
-    static WidgetNode treeNode(std::string label, std::vector<WidgetNode> children = {},
+    static WidgetNode tabBar(std::string id, WidgetList children = {});
+    static WidgetNode tabItem(std::string label, WidgetList children = {});
+    static WidgetNode treeNode(std::string label, WidgetList children = {},
                                bool defaultOpen = false, bool leaf = false);
     static WidgetNode child(std::string id, float width = 0.0f, float height = 0.0f,
                             bool border = false, bool autoScroll = false,
-                            std::vector<WidgetNode> children = {});
-    static WidgetNode menuBar(std::vector<WidgetNode> children = {});
-    static WidgetNode menu(std::string label, std::vector<WidgetNode> children = {});
+                            WidgetList children = {});
+    static WidgetNode menuBar(WidgetList children = {});
+    static WidgetNode menu(std::string label, WidgetList children = {});
     static WidgetNode menuItem(std::string label, WidgetCallback onClick = {},
                                std::string shortcut = "", bool checked = false);
 
@@ -274,8 +432,8 @@ struct WidgetNode {
     static WidgetNode listBox(std::string label, std::vector<std::string> items,
                               int selected = 0, int heightInItems = -1,
                               WidgetCallback onChange = {});
-    static WidgetNode popup(std::string id, std::vector<WidgetNode> children = {});
-    static WidgetNode modal(std::string title, std::vector<WidgetNode> children = {},
+    static WidgetNode popup(std::string id, WidgetList children = {});
+    static WidgetNode modal(std::string title, WidgetList children = {},
                             WidgetCallback onClose = {});
 
     // Phase 8 builders
@@ -287,14 +445,14 @@ struct WidgetNode {
                              TextureHandle texture,
                              WidgetCallback onClick = {});
     static WidgetNode tooltip(std::string text);
-    static WidgetNode tooltip(std::vector<WidgetNode> children);
+    static WidgetNode tooltip(WidgetList children);
 
     // Phase 5 builders
     static WidgetNode table(std::string id, int numColumns,
                             std::vector<std::string> headers = {},
-                            std::vector<WidgetNode> children = {},
+                            WidgetList children = {},
                             int flags = 0);
-    static WidgetNode tableRow(std::vector<WidgetNode> children = {});
+    static WidgetNode tableRow(WidgetList children = {});
     static WidgetNode tableNextColumn();
 
     // Phase 9 builders
@@ -338,12 +496,12 @@ struct WidgetNode {
                                    WidgetCallback onClick = {});
 
     // Phase 13 - Menus & Popups (continued)
-    static WidgetNode contextMenu(std::vector<WidgetNode> children = {});
-    static WidgetNode mainMenuBar(std::vector<WidgetNode> children = {});
+    static WidgetNode contextMenu(WidgetList children = {});
+    static WidgetNode mainMenuBar(WidgetList children = {});
 
     // Phase 14 - Tooltips & Images (continued)
     static WidgetNode itemTooltip(std::string text);
-    static WidgetNode itemTooltip(std::vector<WidgetNode> children);
+    static WidgetNode itemTooltip(WidgetList children);
     static WidgetNode imageButton(std::string id, TextureHandle texture,
                                    float width, float height,
                                    WidgetCallback onClick = {});
@@ -352,6 +510,16 @@ struct WidgetNode {
     static WidgetNode pushTheme(std::string name);
     static WidgetNode popTheme(std::string name);
 
+    // Virtual (data-source-backed) lists: only visible rows are built.
+    // onSelect turns on row selection and fires with selectedIndex set.
+    static WidgetNode virtualList(std::string id, int rowCount, RowProvider rowProvider,
+                                  float height = 0.0f, WidgetCallback onSelect = {});
+    static WidgetNode virtualTable(std::string id, int numColumns,
+                                   std::vector<std::string> headers,
+                                   int rowCount, RowProvider rowProvider,
+                                   int flags = 0, WidgetCallback onSelect = {},
+                                   WidgetCallback onSort = {});
+
     // Phase 15 - Display (plots)
     static WidgetNode plotLines(std::string label, std::vector<float> values,
                                 std::string overlay = "",
@@ -361,9 +529,22 @@ struct WidgetNode {
                                     std::string overlay = "",
                                     float scaleMin = FLT_MAX, float scaleMax = FLT_MAX,
                                     float width = 0.0f, float height = 0.0f);
+
+private:
+    bool patchFields(WidgetNode& next);
+
+    detail::SideStorage<Props> props_;
+    detail::SideStorage<Callbacks> callbacks_;
 };
 
 /// Returns a human-readable name for a widget type (for debug/placeholder text).
 const char* widgetTypeName(WidgetNode::Type type);
 
+// Defined here because they need the complete WidgetNode
+inline WidgetList::WidgetList(const std::vector<WidgetNode>& nodes)
+    : Base(nodes.begin(), nodes.end()) {}
+
+inline WidgetList::WidgetList(std::vector<WidgetNode>&& nodes)
+    : Base(std::make_move_iterator(nodes.begin()), std::make_move_iterator(nodes.end())) {}
+
 } // namespace finegui
@@ -0,0 +1,175 @@
+/**
+ * @file bindless_table.cpp
+ * @brief Descriptor-indexed texture table for bindless GUI rendering
+ */
+
+#include "bindless_table.hpp"
+
+#include <stdexcept>
+
+namespace finegui {
+namespace backend {
+
+bool BindlessTextureTable::supported(finevk::LogicalDevice* device) {
+    VkPhysicalDevice physical = device->physicalDevice()->handle();
+
+    VkPhysicalDeviceFeatures features{};
+    vkGetPhysicalDeviceFeatures(physical, &features);
+    if (!features.shaderSampledImageArrayDynamicIndexing) {
+        return false;
+    }
+
+    VkPhysicalDeviceProperties props{};
+    vkGetPhysicalDeviceProperties(physical, &props);
+    const VkPhysicalDeviceLimits& limits = props.limits;
+    return limits.maxPerStageDescriptorSamplers >= kCapacity &&
+           limits.maxPerStageDescriptorSampledImages >= kCapacity &&
+           limits.maxDescriptorSetSamplers >= kCapacity &&
+           limits.maxDescriptorSetSampledImages >= kCapacity;
+}
+
+BindlessTextureTable::BindlessTextureTable(finevk::LogicalDevice* device,
+                                           uint32_t framesInFlight,
+                                           VkImageView placeholderView,
+                                           VkSampler placeholderSampler)
+    : device_(device->handle())
+{
+    placeholder_.imageView = placeholderView;
+    placeholder_.sampler = placeholderSampler;
+    placeholder_.imageLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
+
+    VkDescriptorSetLayoutBinding binding{};
+    binding.binding = 0;
+    binding.descriptorType = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
+    binding.descriptorCount = kCapacity;
+    binding.stageFlags = VK_SHADER_STAGE_FRAGMENT_BIT;
+
+    VkDescriptorSetLayoutCreateInfo layoutInfo{};
+    layoutInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_CREATE_INFO;
+    layoutInfo.bindingCount = 1;
+    layoutInfo.pBindings = &binding;
+    if (vkCreateDescriptorSetLayout(device_, &layoutInfo, nullptr, &layout_) != VK_SUCCESS) {
+        throw std::runtime_error("BindlessTextureTable: failed to create descriptor set layout");
+    }
+
+    VkDescriptorPoolSize poolSize{};
+    poolSize.type = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
+    poolSize.descriptorCount = kCapacity * framesInFlight;
+
+    VkDescriptorPoolCreateInfo poolInfo{};
+    poolInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO;
+    poolInfo.maxSets = framesInFlight;
+    poolInfo.poolSizeCount = 1;
+    poolInfo.pPoolSizes = &poolSize;
+    if (vkCreateDescriptorPool(device_, &poolInfo, nullptr, &pool_) != VK_SUCCESS) {
+        vkDestroyDescriptorSetLayout(device_, layout_, nullptr);
+        throw std::runtime_error("BindlessTextureTable: failed to create descriptor pool");
+    }
+
+    std::vector<VkDescriptorSetLayout> layouts(framesInFlight, layout_);
+    sets_.resize(framesInFlight);
+
+    VkDescriptorSetAllocateInfo allocInfo{};
+    allocInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO;
+    allocInfo.descriptorPool = pool_;
+    allocInfo.descriptorSetCount = framesInFlight;
+    allocInfo.pSetLayouts = layouts.data();
+    if (vkAllocateDescriptorSets(device_, &allocInfo, sets_.data()) != VK_SUCCESS) {
+        vkDestroyDescriptorPool(device_, pool_, nullptr);
+        vkDestroyDescriptorSetLayout(device_, layout_, nullptr);
+        throw std::runtime_error("BindlessTextureTable: failed to allocate descriptor sets");
+    }
+
+    // Every slot starts (and ends up again when released) as the placeholder
+    images_.assign(kCapacity, placeholder_);
+
+    std::vector<VkWriteDescriptorSet> writes(framesInFlight);
+    for (uint32_t i = 0; i < framesInFlight; i++) {
+        writes[i].sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+        writes[i].dstSet = sets_[i];
+        writes[i].dstBinding = 0;
+        writes[i].dstArrayElement = 0;
+        writes[i].descriptorCount = kCapacity;
+        writes[i].descriptorType = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
+        writes[i].pImageInfo = images_.data();
+    }
+    vkUpdateDescriptorSets(device_, framesInFlight, writes.data(), 0, nullptr);
+
+    dirty_.resize(framesInFlight);
+
+    // Hand out low slots first; slot 0 stays reserved
+    freeSlots_.reserve(kCapacity - 1);
+    for (uint32_t slot = kCapacity - 1; slot >= 1; slot--) {
+        freeSlots_.push_back(slot);
+    }
+}
+
+BindlessTextureTable::~BindlessTextureTable() {
+    // Destroying the pool frees its sets
+    vkDestroyDescriptorPool(device_, pool_, nullptr);
+    vkDestroyDescriptorSetLayout(device_, layout_, nullptr);
+}
+
+uint32_t BindlessTextureTable::allocate(VkImageView view, VkSampler sampler) {
+    if (freeSlots_.empty()) {
+        throw std::runtime_error("BindlessTextureTable::allocate: all texture slots in use");
+    }
+
+    uint32_t slot = freeSlots_.back();
+    freeSlots_.pop_back();
+
+    assign(slot, view, sampler);
+
+    liveSlots_++;
+    return slot;
+}
+
+void BindlessTextureTable::assign(uint32_t slot, VkImageView view, VkSampler sampler) {
+    images_[slot].imageView = view;
+    images_[slot].sampler = sampler;
+    images_[slot].imageLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
+    markDirty(slot);
+}
+
+void BindlessTextureTable::release(uint32_t slot) {
+    if (slot == 0 || slot >= kCapacity) {
+        return;
+    }
+
+    images_[slot] = placeholder_;
+    markDirty(slot);
+
+    freeSlots_.push_back(slot);
+    liveSlots_--;
+}
+
+bool BindlessTextureTable::update(uint32_t frameIndex) {
+    std::vector<uint32_t>& pending = dirty_[frameIndex];
+    if (pending.empty()) {
+        return false;
+    }
+
+    std::vector<VkWriteDescriptorSet> writes(pending.size());
+    for (size_t i = 0; i < pending.size(); i++) {
+        writes[i].sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+        writes[i].dstSet = sets_[frameIndex];
+        writes[i].dstBinding = 0;
+        writes[i].dstArrayElement = pending[i];
+        writes[i].descriptorCount = 1;
+        writes[i].descriptorType = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
+        writes[i].pImageInfo = &images_[pending[i]];
+    }
+    vkUpdateDescriptorSets(device_, static_cast<uint32_t>(writes.size()), writes.data(), 0, nullptr);
+
+    pending.clear();
+    return true;
+}
+
+void BindlessTextureTable::markDirty(uint32_t slot) {
+    for (auto& pending : dirty_) {
+        pending.push_back(slot);
+    }
+}
+
+} // namespace backend
+} // namespace finegui
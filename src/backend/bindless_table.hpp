@@ -0,0 +1,107 @@
+#pragma once
+
+/**
+ * @file bindless_table.hpp
+ * @brief Descriptor-indexed texture table for bindless GUI rendering
+ *
+ * Internal to the finevk backend. All GUI textures live in one fixed-size
+ * combined-image-sampler array; draws select a slot via push constant, so a
+ * frame binds a single descriptor set regardless of how many textures it uses.
+ *
+ * Each frame in flight owns its own copy of the set. Slot changes are queued
+ * per frame and written when that frame is next rendered (its fence has been
+ * waited on), so no update-after-bind or partially-bound support is required:
+ * unused slots always hold a valid placeholder image.
+ */
+
+#include <finevk/finevk.hpp>
+
+#include <cstdint>
+#include <vector>
+
+namespace finegui {
+namespace backend {
+
+/**
+ * @brief Fixed-capacity bindless texture table
+ *
+ * Slot 0 is reserved for the placeholder so that a slot index can double as
+ * a non-zero ImTextureID.
+ */
+class BindlessTextureTable {
+public:
+    /// Array size; must match MAX_TEXTURES in gui_bindless.frag
+    static constexpr uint32_t kCapacity = 4096;
+
+    /**
+     * @brief Check whether the device can use the table
+     *
+     * Requires shaderSampledImageArrayDynamicIndexing and per-stage/per-set
+     * sampler limits of at least kCapacity.
+     */
+    static bool supported(finevk::LogicalDevice* device);
+
+    /**
+     * @brief Create the layout, pool and one set per frame in flight
+     * @param device Logical device
+     * @param framesInFlight Number of frames in flight
+     * @param placeholderView Image view written to every unused slot
+     * @param placeholderSampler Sampler for the placeholder
+     */
+    BindlessTextureTable(finevk::LogicalDevice* device,
+                         uint32_t framesInFlight,
+                         VkImageView placeholderView,
+                         VkSampler placeholderSampler);
+    ~BindlessTextureTable();
+
+    BindlessTextureTable(const BindlessTextureTable&) = delete;
+    BindlessTextureTable& operator=(const BindlessTextureTable&) = delete;
+
+    /**
+     * @brief Assign a slot to an image view/sampler pair
+     * @return Slot index (never 0)
+     */
+    uint32_t allocate(VkImageView view, VkSampler sampler);
+
+    /// Point an allocated slot at a different image view/sampler pair
+    void assign(uint32_t slot, VkImageView view, VkSampler sampler);
+
+    /// Return a slot to the free list (reverts it to the placeholder)
+    void release(uint32_t slot);
+
+    /**
+     * @brief Write queued slot changes into a frame's descriptor set
+     *
+     * Call before recording a frame that binds set(frameIndex).
+     * @return true if any descriptor was written, which invalidates
+     *         command buffers previously recorded against that set
+     */
+    bool update(uint32_t frameIndex);
+
+    [[nodiscard]] VkDescriptorSetLayout layout() const { return layout_; }
+    [[nodiscard]] VkDescriptorSet set(uint32_t frameIndex) const { return sets_[frameIndex]; }
+
+    /// Slots currently assigned (excluding the placeholder)
+    [[nodiscard]] uint32_t liveSlots() const { return liveSlots_; }
+
+private:
+    void markDirty(uint32_t slot);
+
+    VkDevice device_ = VK_NULL_HANDLE;
+    VkDescriptorSetLayout layout_ = VK_NULL_HANDLE;
+    VkDescriptorPool pool_ = VK_NULL_HANDLE;
+    std::vector<VkDescriptorSet> sets_;
+
+    // Current contents of every slot; per-frame sets converge to this
+    std::vector<VkDescriptorImageInfo> images_;
+    VkDescriptorImageInfo placeholder_{};
+
+    // Slots each frame's set still has to rewrite
+    std::vector<std::vector<uint32_t>> dirty_;
+
+    std::vector<uint32_t> freeSlots_;
+    uint32_t liveSlots_ = 0;
+};
+
+} // namespace backend
+} // namespace finegui
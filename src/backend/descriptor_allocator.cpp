@@ -0,0 +1,76 @@
+/**
+ * @file descriptor_allocator.cpp
+ * @brief Growable chain of descriptor pools for per-texture descriptor sets
+ */
+
+#include "descriptor_allocator.hpp"
+
+#include <stdexcept>
+
+namespace finegui {
+namespace backend {
+
+DescriptorAllocator::DescriptorAllocator(finevk::DescriptorSetLayout* layout,
+                                         finevk::RenderSurface* surface,
+                                         uint32_t initialSetsPerPool)
+    : layout_(layout)
+    , surface_(surface)
+    , nextPoolSize_(initialSetsPerPool)
+{
+    addPool();
+}
+
+finevk::DescriptorSetPtr DescriptorAllocator::allocate() {
+    // The current pool usually has room; otherwise older pools may have
+    // regained space from frees before we pay for a new one
+    if (auto set = tryAllocate(currentPool_)) {
+        liveSets_++;
+        return set;
+    }
+    for (size_t i = 0; i < pools_.size(); i++) {
+        if (i == currentPool_) {
+            continue;
+        }
+        if (auto set = tryAllocate(i)) {
+            currentPool_ = i;
+            liveSets_++;
+            return set;
+        }
+    }
+
+    addPool();
+    currentPool_ = pools_.size() - 1;
+    auto set = tryAllocate(currentPool_);
+    if (!set) {
+        throw std::runtime_error("DescriptorAllocator::allocate: allocation failed from a new pool");
+    }
+    liveSets_++;
+    return set;
+}
+
+void DescriptorAllocator::free(finevk::DescriptorSetPtr set) {
+    if (!set) {
+        return;
+    }
+    surface_->deferDelete(std::move(set));
+    liveSets_--;
+}
+
+finevk::DescriptorSetPtr DescriptorAllocator::tryAllocate(size_t poolIndex) {
+    // Exhausted or fragmented pools report failure by throwing
+    try {
+        return pools_[poolIndex]->allocateManaged(layout_);
+    } catch (const std::runtime_error&) {
+        return nullptr;
+    }
+}
+
+void DescriptorAllocator::addPool() {
+    pools_.push_back(finevk::DescriptorPool::fromLayout(layout_, nextPoolSize_)
+        .allowFree()
+        .build());
+    nextPoolSize_ *= 2;
+}
+
+} // namespace backend
+} // namespace finegui
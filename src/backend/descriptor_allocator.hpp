@@ -0,0 +1,65 @@
+#pragma once
+
+/**
+ * @file descriptor_allocator.hpp
+ * @brief Growable chain of descriptor pools for per-texture descriptor sets
+ *
+ * Internal to the finevk backend. Sets are allocated from the most recently
+ * successful pool; when every pool is exhausted a new one, twice the size of
+ * the last, is appended. Pools are never released before the allocator.
+ */
+
+#include <finevk/finevk.hpp>
+
+#include <cstdint>
+#include <vector>
+
+namespace finegui {
+namespace backend {
+
+/**
+ * @brief Allocates descriptor sets of one layout from a chain of pools
+ */
+class DescriptorAllocator {
+public:
+    /**
+     * @param layout Layout of every set allocated
+     * @param surface Surface used to defer frees until the GPU is done
+     * @param initialSetsPerPool Size of the first pool
+     */
+    DescriptorAllocator(finevk::DescriptorSetLayout* layout,
+                        finevk::RenderSurface* surface,
+                        uint32_t initialSetsPerPool);
+
+    DescriptorAllocator(const DescriptorAllocator&) = delete;
+    DescriptorAllocator& operator=(const DescriptorAllocator&) = delete;
+
+    /**
+     * @brief Allocate a set, growing the chain if needed
+     * @throws std::runtime_error if a fresh pool cannot satisfy the request
+     */
+    finevk::DescriptorSetPtr allocate();
+
+    /**
+     * @brief Free a set once frames in flight no longer reference it
+     */
+    void free(finevk::DescriptorSetPtr set);
+
+    [[nodiscard]] uint32_t liveSets() const { return liveSets_; }
+    [[nodiscard]] uint32_t poolCount() const { return static_cast<uint32_t>(pools_.size()); }
+
+private:
+    finevk::DescriptorSetPtr tryAllocate(size_t poolIndex);
+    void addPool();
+
+    finevk::DescriptorSetLayout* layout_;
+    finevk::RenderSurface* surface_;
+
+    std::vector<finevk::DescriptorPoolPtr> pools_;
+    uint32_t nextPoolSize_;
+    size_t currentPool_ = 0;
+    uint32_t liveSets_ = 0;
+};
+
+} // namespace backend
+} // namespace finegui
@@ -0,0 +1,115 @@
+/**
+ * @file draw_batcher.cpp
+ * @brief Draw-call merging and redundant state elimination
+ */
+
+#include "draw_batcher.hpp"
+
+#include <algorithm>
+
+namespace finegui {
+namespace backend {
+
+namespace {
+
+bool sameRect(const VkRect2D& a, const VkRect2D& b) {
+    return a.offset.x == b.offset.x && a.offset.y == b.offset.y &&
+           a.extent.width == b.extent.width && a.extent.height == b.extent.height;
+}
+
+} // namespace
+
+DrawBatcher::DrawBatcher(finevk::CommandBuffer& cmd, finevk::PipelineLayout& layout,
+                         int32_t bindlessIndexOffset,
+                         int32_t sdfFlagOffset,
+                         const std::vector<uint64_t>* sdfTextures)
+    : cmd_(cmd)
+    , layout_(layout)
+    , bindlessIndexOffset_(bindlessIndexOffset)
+    , sdfFlagOffset_(sdfTextures ? sdfFlagOffset : -1)
+    , sdfTextures_(sdfTextures)
+{
+}
+
+void DrawBatcher::draw(const VkRect2D& scissor, uint64_t texture,
+                       uint32_t firstIndex, uint32_t indexCount, int32_t vertexOffset)
+{
+    stats_.commands++;
+
+    if (hasPending_ &&
+        pending_.texture == texture &&
+        pending_.vertexOffset == vertexOffset &&
+        pending_.firstIndex + pending_.indexCount == firstIndex &&
+        sameRect(pending_.scissor, scissor)) {
+        pending_.indexCount += indexCount;
+        return;
+    }
+
+    flush();
+    pending_ = Draw{scissor, texture, firstIndex, indexCount, vertexOffset};
+    hasPending_ = true;
+}
+
+void DrawBatcher::flush() {
+    if (!hasPending_) {
+        return;
+    }
+    hasPending_ = false;
+
+    if (!scissorBound_ || !sameRect(boundScissor_, pending_.scissor)) {
+        cmd_.setScissor(pending_.scissor.offset.x,
+                        pending_.scissor.offset.y,
+                        pending_.scissor.extent.width,
+                        pending_.scissor.extent.height);
+        boundScissor_ = pending_.scissor;
+        scissorBound_ = true;
+        stats_.scissorChanges++;
+    }
+
+    if (!textureBound_ || boundTexture_ != pending_.texture) {
+        if (bindlessIndexOffset_ >= 0) {
+            uint32_t slot = static_cast<uint32_t>(pending_.texture);
+            cmd_.pushConstants(layout_.handle(),
+                               VK_SHADER_STAGE_FRAGMENT_BIT,
+                               static_cast<uint32_t>(bindlessIndexOffset_),
+                               sizeof(uint32_t), &slot);
+        } else {
+            cmd_.bindDescriptorSet(layout_, reinterpret_cast<VkDescriptorSet>(pending_.texture), 0);
+            stats_.descriptorBinds++;
+        }
+        boundTexture_ = pending_.texture;
+        textureBound_ = true;
+        stats_.textureSwitches++;
+
+        // Text and most widget backgrounds share the atlas, so this flag
+        // only changes around user images
+        if (sdfFlagOffset_ >= 0) {
+            uint32_t sdf = std::find(sdfTextures_->begin(), sdfTextures_->end(),
+                                     pending_.texture) != sdfTextures_->end() ? 1u : 0u;
+            if (!sdfBound_ || boundSdf_ != sdf) {
+                cmd_.pushConstants(layout_.handle(),
+                                   VK_SHADER_STAGE_FRAGMENT_BIT,
+                                   static_cast<uint32_t>(sdfFlagOffset_),
+                                   sizeof(uint32_t), &sdf);
+                boundSdf_ = sdf;
+                sdfBound_ = true;
+            }
+        }
+    }
+
+    cmd_.drawIndexed(pending_.indexCount,
+                     1,
+                     pending_.firstIndex,
+                     pending_.vertexOffset,
+                     0);
+    stats_.drawCalls++;
+}
+
+void DrawBatcher::invalidate() {
+    textureBound_ = false;
+    sdfBound_ = false;
+    scissorBound_ = false;
+}
+
+} // namespace backend
+} // namespace finegui
@@ -0,0 +1,109 @@
+#pragma once
+
+/**
+ * @file draw_batcher.hpp
+ * @brief Draw-call merging and redundant state elimination
+ *
+ * Internal to the finevk backend. Both render paths feed their clipped
+ * draw commands through a DrawBatcher, which merges consecutive commands
+ * that share texture, scissor and vertex offset and cover contiguous index
+ * ranges, and only records scissor/texture changes when state differs
+ * from what is already bound.
+ *
+ * Textures are identified by their ImTextureID value: a VkDescriptorSet
+ * handle normally, or a bindless slot index that is pushed as a fragment
+ * push constant instead of binding a set. With SDF fonts, a fragment push
+ * constant also tells the shader whether the texture is a font atlas.
+ */
+
+#include <finevk/finevk.hpp>
+
+#include <cstdint>
+#include <vector>
+
+namespace finegui {
+namespace backend {
+
+/**
+ * @brief Counters for one render call
+ */
+struct DrawBatchStats {
+    uint32_t commands = 0;          ///< Draw commands submitted to the batcher
+    uint32_t drawCalls = 0;         ///< drawIndexed calls actually recorded
+    uint32_t descriptorBinds = 0;   ///< Descriptor set binds recorded
+    uint32_t textureSwitches = 0;   ///< Texture changes (binds or bindless index pushes)
+    uint32_t scissorChanges = 0;    ///< setScissor calls recorded
+};
+
+/**
+ * @brief Records draws into a command buffer, merging where possible
+ *
+ * Only adjacent commands are merged, so submission order (and therefore
+ * blending order) is preserved.
+ */
+class DrawBatcher {
+public:
+    /**
+     * @param cmd Command buffer to record into
+     * @param layout Pipeline layout for binds/push constants
+     * @param bindlessIndexOffset Push constant offset of the texture index,
+     *        or -1 to bind a descriptor set per texture
+     * @param sdfFlagOffset Push constant offset of the SDF flag, or -1
+     *        without SDF fonts
+     * @param sdfTextures Texture IDs holding distance fields (must stay
+     *        valid while the batcher is used if @p sdfFlagOffset is set)
+     */
+    DrawBatcher(finevk::CommandBuffer& cmd, finevk::PipelineLayout& layout,
+                int32_t bindlessIndexOffset = -1,
+                int32_t sdfFlagOffset = -1,
+                const std::vector<uint64_t>* sdfTextures = nullptr);
+
+    /**
+     * @brief Submit one clipped draw command
+     * @param scissor Clamped, non-empty scissor rect in framebuffer pixels
+     * @param texture Texture ID (descriptor set handle or bindless slot)
+     * @param firstIndex First index in the bound index buffer
+     * @param indexCount Number of indices
+     * @param vertexOffset Value added to each index
+     */
+    void draw(const VkRect2D& scissor, uint64_t texture,
+              uint32_t firstIndex, uint32_t indexCount, int32_t vertexOffset);
+
+    /// Record the pending merged draw, if any
+    void flush();
+
+    /// Forget tracked state (after a user callback may have changed it)
+    void invalidate();
+
+    [[nodiscard]] const DrawBatchStats& stats() const { return stats_; }
+
+private:
+    struct Draw {
+        VkRect2D scissor;
+        uint64_t texture;
+        uint32_t firstIndex;
+        uint32_t indexCount;
+        int32_t vertexOffset;
+    };
+
+    finevk::CommandBuffer& cmd_;
+    finevk::PipelineLayout& layout_;
+    int32_t bindlessIndexOffset_;
+    int32_t sdfFlagOffset_;
+    const std::vector<uint64_t>* sdfTextures_;
+
+    Draw pending_{};
+    bool hasPending_ = false;
+
+    uint64_t boundTexture_ = 0;
+    bool textureBound_ = false;
+    uint32_t boundSdf_ = 0;
+    bool sdfBound_ = false;
+    VkRect2D boundScissor_{};
+    bool scissorBound_ = false;
+
+    DrawBatchStats stats_;
+};
+
+} // namespace backend
+} // namespace finegui
@@ -0,0 +1,114 @@
+/**
+ * @file gpu_timer.cpp
+ * @brief Timestamp queries for measuring GPU time of recorded work
+ */
+
+#include "gpu_timer.hpp"
+
+#include <algorithm>
+#include <stdexcept>
+
+namespace finegui {
+namespace backend {
+
+namespace {
+
+// Smallest timestamp width among graphics-capable queue families (the
+// graphics queue is one of them); 0 if any of them cannot write timestamps
+uint32_t graphicsTimestampBits(VkPhysicalDevice physical) {
+    uint32_t count = 0;
+    vkGetPhysicalDeviceQueueFamilyProperties(physical, &count, nullptr);
+    std::vector<VkQueueFamilyProperties> families(count);
+    vkGetPhysicalDeviceQueueFamilyProperties(physical, &count, families.data());
+
+    uint32_t bits = 64;
+    bool found = false;
+    for (const VkQueueFamilyProperties& family : families) {
+        if (family.queueFlags & VK_QUEUE_GRAPHICS_BIT) {
+            bits = std::min(bits, family.timestampValidBits);
+            found = true;
+        }
+    }
+    return found ? bits : 0;
+}
+
+} // namespace
+
+bool GpuTimer::supported(finevk::LogicalDevice* device) {
+    VkPhysicalDevice physical = device->physicalDevice()->handle();
+
+    VkPhysicalDeviceProperties props{};
+    vkGetPhysicalDeviceProperties(physical, &props);
+    return props.limits.timestampPeriod > 0.0f && graphicsTimestampBits(physical) > 0;
+}
+
+GpuTimer::GpuTimer(finevk::LogicalDevice* device, uint32_t slots)
+    : device_(device->handle())
+    , slots_(slots, SlotState::Idle)
+{
+    VkPhysicalDevice physical = device->physicalDevice()->handle();
+
+    VkPhysicalDeviceProperties props{};
+    vkGetPhysicalDeviceProperties(physical, &props);
+    nanosPerTick_ = props.limits.timestampPeriod;
+
+    uint32_t bits = graphicsTimestampBits(physical);
+    tickMask_ = bits >= 64 ? ~0ull : (1ull << bits) - 1;
+
+    VkQueryPoolCreateInfo info{};
+    info.sType = VK_STRUCTURE_TYPE_QUERY_POOL_CREATE_INFO;
+    info.queryType = VK_QUERY_TYPE_TIMESTAMP;
+    info.queryCount = slots * 2;
+    if (vkCreateQueryPool(device_, &info, nullptr, &pool_) != VK_SUCCESS) {
+        throw std::runtime_error("GpuTimer: failed to create query pool");
+    }
+}
+
+GpuTimer::~GpuTimer() {
+    vkDestroyQueryPool(device_, pool_, nullptr);
+}
+
+bool GpuTimer::reset(VkCommandBuffer cmd, uint32_t slot, float& micros) {
+    bool result = slots_[slot] == SlotState::Written && read(slot, micros);
+
+    vkCmdResetQueryPool(cmd, pool_, slot * 2, 2);
+    slots_[slot] = SlotState::Reset;
+    return result;
+}
+
+bool GpuTimer::begin(VkCommandBuffer cmd, uint32_t slot) {
+    if (slots_[slot] != SlotState::Reset) {
+        return false;
+    }
+    vkCmdWriteTimestamp(cmd, VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT, pool_, slot * 2);
+    slots_[slot] = SlotState::Begun;
+    return true;
+}
+
+void GpuTimer::end(VkCommandBuffer cmd, uint32_t slot) {
+    vkCmdWriteTimestamp(cmd, VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT, pool_, slot * 2 + 1);
+    slots_[slot] = SlotState::Written;
+}
+
+bool GpuTimer::read(uint32_t slot, float& micros) {
+    if (slots_[slot] != SlotState::Written) {
+        return false;
+    }
+
+    // Value/availability pairs for the begin and end queries
+    uint64_t data[4] = {};
+    VkResult result = vkGetQueryPoolResults(
+        device_, pool_, slot * 2, 2, sizeof(data), data, 2 * sizeof(uint64_t),
+        VK_QUERY_RESULT_64_BIT | VK_QUERY_RESULT_WITH_AVAILABILITY_BIT);
+    if ((result != VK_SUCCESS && result != VK_NOT_READY) || data[1] == 0 || data[3] == 0) {
+        return false;
+    }
+
+    slots_[slot] = SlotState::Read;
+    uint64_t ticks = ((data[2] & tickMask_) - (data[0] & tickMask_)) & tickMask_;
+    micros = static_cast<float>(static_cast<double>(ticks) * nanosPerTick_ / 1000.0);
+    return true;
+}
+
+} // namespace backend
+} // namespace finegui
@@ -0,0 +1,97 @@
+#pragma once
+
+/**
+ * @file gpu_timer.hpp
+ * @brief Timestamp queries for measuring GPU time of recorded work
+ *
+ * Internal. Each slot (one per frame in flight) holds a begin/end timestamp
+ * pair. A slot has to be reset outside a render pass before it can be
+ * written again, and its previous result is read back at that point, when
+ * the caller has already waited on that frame's fence. Results are never
+ * waited for: a result that is not available yet is dropped.
+ */
+
+#include <finevk/finevk.hpp>
+
+#include <cstdint>
+#include <vector>
+
+namespace finegui {
+namespace backend {
+
+/// Weight of a new sample in the exponentially smoothed GPU times
+constexpr float kGpuTimeSmoothing = 0.1f;
+
+/// Fold a sample into a smoothed GPU time (the first sample is taken as is)
+inline float smoothGpuTime(float smoothed, float sample, bool first) {
+    return first ? sample : smoothed + (sample - smoothed) * kGpuTimeSmoothing;
+}
+
+/**
+ * @brief Per-slot begin/end timestamp pairs
+ */
+class GpuTimer {
+public:
+    /**
+     * @brief Check whether graphics queues can write timestamps
+     */
+    static bool supported(finevk::LogicalDevice* device);
+
+    /**
+     * @brief Create the query pool
+     * @param device Logical device (must be supported())
+     * @param slots Number of independent timestamp pairs
+     */
+    GpuTimer(finevk::LogicalDevice* device, uint32_t slots);
+    ~GpuTimer();
+
+    GpuTimer(const GpuTimer&) = delete;
+    GpuTimer& operator=(const GpuTimer&) = delete;
+
+    /**
+     * @brief Read the slot's previous result, then record a reset of it
+     *
+     * Must be recorded outside a render pass, after the work that last
+     * wrote the slot has completed.
+     * @param micros Receives the previous result, if one was available
+     * @return true if @p micros was written
+     */
+    bool reset(VkCommandBuffer cmd, uint32_t slot, float& micros);
+
+    /**
+     * @brief Record the begin timestamp (allowed inside a render pass)
+     * @return false if the slot was not reset since it was last used, in
+     *         which case end() must not be called
+     */
+    bool begin(VkCommandBuffer cmd, uint32_t slot);
+
+    /// Record the end timestamp
+    void end(VkCommandBuffer cmd, uint32_t slot);
+
+    /**
+     * @brief Read a result without resetting the slot
+     *
+     * For work the caller has waited on (e.g. a submitted and fenced
+     * offscreen frame). The slot stays written until reset().
+     * @return true if @p micros was written
+     */
+    bool read(uint32_t slot, float& micros);
+
+private:
+    enum class SlotState : uint8_t {
+        Idle,     // Needs a reset before use
+        Reset,    // Reset recorded; begin() allowed
+        Begun,    // Begin timestamp recorded
+        Written,  // Both timestamps recorded
+        Read      // Result consumed by read()
+    };
+
+    VkDevice device_ = VK_NULL_HANDLE;
+    VkQueryPool pool_ = VK_NULL_HANDLE;
+    float nanosPerTick_ = 1.0f;
+    uint64_t tickMask_ = ~0ull;
+    std::vector<SlotState> slots_;
+};
+
+} // namespace backend
+} // namespace finegui
@@ -6,15 +6,78 @@
  */
 
 #include "imgui_impl_finevk.hpp"
+#include "pipeline_cache.hpp"
+
+#ifdef FINEGUI_EMBEDDED_SHADERS
+#include "embedded_shaders.hpp"
+#endif
 
 #include <finegui/gui_draw_data.hpp>
 
 #include <stdexcept>
+#include <chrono>
 #include <cstring>
+#include <numeric>
+#include <algorithm>
 
 namespace finegui {
 namespace backend {
 
+namespace {
+
+// Starting size of the geometry ring, and the floor it trims back to
+constexpr VkDeviceSize kInitialStreamCapacity = 256 * 1024;
+
+// Descriptor sets in the first pool; later pools double
+constexpr uint32_t kInitialSetsPerPool = 100;
+
+// Starting size of the texture update staging buffer
+constexpr VkDeviceSize kInitialStagingCapacity = 64 * 1024;
+
+// Seed for geometry content hashes
+constexpr uint64_t kHashSeed = 0xcbf29ce484222325ull;
+
+// Word-at-a-time 64-bit hash for detecting unchanged geometry
+uint64_t hashBytes(const void* data, size_t size, uint64_t hash) {
+    constexpr uint64_t kMul = 0x9E3779B97F4A7C15ull;
+    const auto* bytes = static_cast<const uint8_t*>(data);
+    while (size >= sizeof(uint64_t)) {
+        uint64_t word;
+        std::memcpy(&word, bytes, sizeof(word));
+        hash = (hash ^ word) * kMul;
+        hash ^= hash >> 32;
+        bytes += sizeof(word);
+        size -= sizeof(word);
+    }
+    uint64_t tail = 0;
+    if (size > 0) {
+        std::memcpy(&tail, bytes, size);
+    }
+    hash = (hash ^ tail ^ (static_cast<uint64_t>(size) << 56)) * kMul;
+    return hash ^ (hash >> 29);
+}
+
+// Whether indices can be rebased onto a single per-frame vertex offset
+bool indicesFitFrame(size_t vertexCount) {
+    return sizeof(ImDrawIdx) >= 4 || vertexCount <= 65536;
+}
+
+// Hash of the layout choices, so a format change never matches old bytes
+uint64_t formatSeed(const GeometryFormat& format) {
+    uint8_t flags[2] = {format.rebase ? uint8_t(1) : uint8_t(0),
+                        format.compact ? uint8_t(1) : uint8_t(0)};
+    return hashBytes(flags, sizeof(flags), kHashSeed);
+}
+
+#ifdef FINEGUI_EMBEDDED_SHADERS
+template <size_t N>
+finevk::ShaderModulePtr embeddedShader(finevk::LogicalDevice* device, const uint32_t (&code)[N]) {
+    return finevk::ShaderModule::create(device, code, sizeof(code));
+}
+#endif
+
+} // namespace
+
 // ============================================================================
 // Constructor/Destructor
 // ============================================================================
@@ -34,12 +97,17 @@ ImGuiBackend::ImGuiBackend(finevk::RenderSurface* surface)
 #else
     shaderDir_ = "shaders";
 #endif
-
-    // Initialize per-frame data
-    frameData_.resize(framesInFlight_);
 }
 
 ImGuiBackend::~ImGuiBackend() {
+    // Finish any in-flight recording; its failure no longer matters
+    if (recordWorker_) {
+        try {
+            recordWorker_->wait();
+        } catch (...) {
+        }
+    }
+
     if (device_) {
         device_->waitIdle();
 
@@ -48,16 +116,18 @@ ImGuiBackend::~ImGuiBackend() {
         if (ctx != nullptr) {
             ImGuiPlatformIO& platform_io = ImGui::GetPlatformIO();
             for (ImTextureData* tex : platform_io.Textures) {
-                if (tex->BackendUserData != nullptr) {
-                    auto* backendTex = static_cast<BackendTextureData*>(tex->BackendUserData);
-                    IM_DELETE(backendTex);
-
-                    tex->SetTexID(ImTextureID_Invalid);
-                    tex->BackendUserData = nullptr;
-                }
+                tex->SetTexID(ImTextureID_Invalid);
+                tex->BackendUserData = nullptr;
             }
         }
 
+        // Including those created from captured requests, which no
+        // ImTextureData points at
+        for (auto& [id, backendTex] : managedTextures_) {
+            IM_DELETE(backendTex);
+        }
+        managedTextures_.clear();
+
         // Clean up user-registered textures (DescriptorSetPtr handles freeing)
         textures_.clear();
     }
@@ -70,16 +140,18 @@ ImGuiBackend::~ImGuiBackend() {
 void ImGuiBackend::initialize(finevk::RenderPass* renderPass,
                                finevk::CommandPool* commandPool,
                                uint32_t subpass,
-                               VkSampleCountFlagBits msaaSamples)
+                               const GuiConfig& config)
 {
     if (!renderPass || !commandPool) {
         throw std::runtime_error("ImGuiBackend::initialize: renderPass and commandPool required");
     }
 
     commandPool_ = commandPool;
-
-    createDescriptorResources();
-    createPipeline(renderPass, subpass, msaaSamples);
+    renderPass_ = renderPass;
+    subpass_ = subpass;
+    msaaSamples_ = config.msaaSamples;
+    uploadBytesPerFrame_ = config.asyncUploadBytesPerFrame;
+    queueMutex_ = config.queueMutex;
 
     // Create default sampler for ImGui textures
     defaultSampler_ = finevk::Sampler::create(device_)
@@ -87,6 +159,57 @@ void ImGuiBackend::initialize(finevk::RenderPass* renderPass,
         .addressMode(VK_SAMPLER_ADDRESS_MODE_CLAMP_TO_EDGE)
         .build();
 
+    // Bindless mode silently falls back to per-texture sets on devices
+    // without dynamic sampler array indexing or enough sampler slots
+    if (config.bindlessTextures && BindlessTextureTable::supported(device_)) {
+        createBindlessResources();
+    } else {
+        createDescriptorResources();
+    }
+    compactVertices_ = config.compactVertices;
+    sdfFonts_ = config.sdfFonts;
+
+    // Pipelines are only created here, so the cache is saved right away
+    // rather than at shutdown (which a crash would skip)
+    std::unique_ptr<PipelineCache> pipelineCache;
+    if (!config.pipelineCachePath.empty()) {
+        pipelineCache = std::make_unique<PipelineCache>(device_, config.pipelineCachePath);
+        pipelineCacheLoadedBytes_ = pipelineCache->loadedBytes();
+    }
+
+    auto pipelineStart = std::chrono::steady_clock::now();
+    createPipelines(renderPass, subpass, config.msaaSamples,
+                    pipelineCache ? pipelineCache->handle() : VK_NULL_HANDLE);
+    pipelineCreateMicros_ = static_cast<uint64_t>(
+        std::chrono::duration_cast<std::chrono::microseconds>(
+            std::chrono::steady_clock::now() - pipelineStart).count());
+
+    if (pipelineCache) {
+        pipelineCache->save();  // Failure only costs the next startup time
+    }
+
+    // Vertex and index data share one ring. Allocations are aligned to every
+    // vertex stride in use so each region can be addressed by
+    // vertexOffset/firstIndex with the buffer bound at offset 0 (each stride
+    // is a multiple of the index size).
+    VkDeviceSize alignment = sizeof(ImDrawVert);
+    if (compactVertices_) {
+        alignment = std::lcm(alignment, static_cast<VkDeviceSize>(sizeof(CompactDrawVert)));
+    }
+    alignment = std::lcm(alignment, static_cast<VkDeviceSize>(sizeof(ImDrawIdx)));
+
+    geometryStream_ = std::make_unique<StreamBuffer>(
+        device_,
+        VK_BUFFER_USAGE_VERTEX_BUFFER_BIT | VK_BUFFER_USAGE_INDEX_BUFFER_BIT,
+        alignment,
+        framesInFlight_,
+        kInitialStreamCapacity);
+
+    // Timing quietly stays off on devices without timestamp support
+    if (config.gpuTiming && GpuTimer::supported(device_)) {
+        gpuTimer_ = std::make_unique<GpuTimer>(device_, framesInFlight_);
+    }
+
     // Set ImGui backend flags to indicate we support the new texture system
     ImGuiIO& io = ImGui::GetIO();
     io.BackendFlags |= ImGuiBackendFlags_RendererHasVtxOffset;
@@ -101,41 +224,141 @@ void ImGuiBackend::createDescriptorResources() {
         .combinedImageSampler(0, VK_SHADER_STAGE_FRAGMENT_BIT)
         .build();
 
-    // Create descriptor pool from layout (auto-sizes pool types)
-    descriptorPool_ = finevk::DescriptorPool::fromLayout(
-        descriptorSetLayout_.get(), 100)
-        .allowFree()
-        .build();
+    // Pools are sized from the layout and chained as registrations grow
+    descriptorAllocator_ = std::make_unique<DescriptorAllocator>(
+        descriptorSetLayout_.get(), surface_, kInitialSetsPerPool);
+}
+
+void ImGuiBackend::createBindlessResources() {
+    // Unused slots sample an opaque white pixel
+    const uint32_t white = 0xFFFFFFFFu;
+    placeholderTexture_ = finevk::Texture::fromMemory(
+        device_, &white, 1, 1, commandPool_,
+        false,  // No mipmaps
+        false   // Not sRGB
+    );
+
+    bindless_ = std::make_unique<BindlessTextureTable>(
+        device_, framesInFlight_,
+        placeholderTexture_->view()->handle(), defaultSampler_->handle());
 }
 
-void ImGuiBackend::createPipeline(finevk::RenderPass* renderPass,
-                                   uint32_t subpass,
-                                   VkSampleCountFlagBits msaaSamples)
+void ImGuiBackend::createPipelines(finevk::RenderPass* renderPass,
+                                    uint32_t subpass,
+                                    VkSampleCountFlagBits msaaSamples,
+                                    VkPipelineCache cache)
 {
-    // Create pipeline layout with push constants
-    pipelineLayout_ = finevk::PipelineLayout::create(device_)
-        .addDescriptorSetLayout(descriptorSetLayout_->handle())
-        .addPushConstantRange(VK_SHADER_STAGE_VERTEX_BIT, 0, sizeof(PushConstantBlock))
-        .build();
+    // Create pipeline layout with push constants. Bindless mode adds the
+    // texture index as a fragment-stage range after the transform, and SDF
+    // fonts extend that range with the distance-field flag.
+    uint32_t fragmentPushSize = sdfFonts_ ? sizeof(SdfPushConstantBlock)
+                              : bindless_ ? sizeof(BindlessPushConstantBlock)
+                              : 0;
+    auto layoutBuilder = finevk::PipelineLayout::create(device_);
+    if (bindless_) {
+        layoutBuilder.addDescriptorSetLayout(bindless_->layout());
+    } else {
+        layoutBuilder.addDescriptorSetLayout(descriptorSetLayout_->handle());
+    }
+    layoutBuilder.addPushConstantRange(VK_SHADER_STAGE_VERTEX_BIT, 0, sizeof(PushConstantBlock));
+    if (fragmentPushSize > 0) {
+        layoutBuilder.addPushConstantRange(VK_SHADER_STAGE_FRAGMENT_BIT, sizeof(PushConstantBlock),
+                                           fragmentPushSize);
+    }
+    pipelineLayout_ = layoutBuilder.build();
+
+    pipelines_ = createPipelineSet(renderPass, subpass, msaaSamples, BlendMode::Straight, cache);
+}
+
+PipelineSet ImGuiBackend::createPipelineSet(finevk::RenderPass* renderPass,
+                                            uint32_t subpass,
+                                            VkSampleCountFlagBits msaaSamples,
+                                            BlendMode blend,
+                                            VkPipelineCache cache)
+{
+    // The standard pipeline is always built: compact mode falls back to it
+    // for frames whose vertices do not fit the compact encoding
+    PipelineSet set;
+    set.standard = createPipeline(renderPass, subpass, msaaSamples, false, blend, cache);
+    if (compactVertices_) {
+        set.compact = createPipeline(renderPass, subpass, msaaSamples, true, blend, cache);
+    }
+    return set;
+}
 
+finevk::GraphicsPipelinePtr ImGuiBackend::createPipeline(finevk::RenderPass* renderPass,
+                                                         uint32_t subpass,
+                                                         VkSampleCountFlagBits msaaSamples,
+                                                         bool compact,
+                                                         BlendMode blend,
+                                                         VkPipelineCache cache)
+{
+    auto builder = finevk::GraphicsPipeline::create(device_, renderPass, pipelineLayout_.get());
+
+#ifdef FINEGUI_EMBEDDED_SHADERS
+    // Modules only need to outlive build()
+    auto vertModule = compact ? embeddedShader(device_, shaders::gui_compact_vert)
+                              : embeddedShader(device_, shaders::gui_vert);
+    auto fragModule = bindless_ ? (sdfFonts_ ? embeddedShader(device_, shaders::gui_bindless_sdf_frag)
+                                             : embeddedShader(device_, shaders::gui_bindless_frag))
+                                : (sdfFonts_ ? embeddedShader(device_, shaders::gui_sdf_frag)
+                                             : embeddedShader(device_, shaders::gui_frag));
+    builder.vertexShader(vertModule.get())
+        .fragmentShader(fragModule.get());
+#else
     // Build shader paths
-    std::string vertPath = shaderDir_ + "/gui.vert.spv";
-    std::string fragPath = shaderDir_ + "/gui.frag.spv";
+    std::string vertPath = shaderDir_ + (compact ? "/gui_compact.vert.spv" : "/gui.vert.spv");
+    std::string fragPath = shaderDir_ + (bindless_ ? (sdfFonts_ ? "/gui_bindless_sdf.frag.spv"
+                                                                 : "/gui_bindless.frag.spv")
+                                                   : (sdfFonts_ ? "/gui_sdf.frag.spv"
+                                                                : "/gui.frag.spv"));
+
+    builder.vertexShader(vertPath)
+        .fragmentShader(fragPath);
+#endif
+
+    if (cache != VK_NULL_HANDLE) {
+        builder.pipelineCache(cache);
+    }
 
-    // Create graphics pipeline
-    pipeline_ = finevk::GraphicsPipeline::create(device_, renderPass, pipelineLayout_.get())
-        .vertexShader(vertPath)
-        .fragmentShader(fragPath)
+    if (compact) {
+        // Vertex input matching CompactDrawVert
+        builder.vertexBinding(0, sizeof(CompactDrawVert), VK_VERTEX_INPUT_RATE_VERTEX)
+            .vertexAttribute(0, 0, VK_FORMAT_R16G16_SINT, offsetof(CompactDrawVert, pos))
+            .vertexAttribute(1, 0, VK_FORMAT_R16G16_UNORM, offsetof(CompactDrawVert, uv))
+            .vertexAttribute(2, 0, VK_FORMAT_R8G8B8A8_UNORM, offsetof(CompactDrawVert, col));
+    } else {
         // Vertex input matching ImDrawVert
-        .vertexBinding(0, sizeof(ImDrawVert), VK_VERTEX_INPUT_RATE_VERTEX)
-        .vertexAttribute(0, 0, VK_FORMAT_R32G32_SFLOAT, offsetof(ImDrawVert, pos))
-        .vertexAttribute(1, 0, VK_FORMAT_R32G32_SFLOAT, offsetof(ImDrawVert, uv))
-        .vertexAttribute(2, 0, VK_FORMAT_R8G8B8A8_UNORM, offsetof(ImDrawVert, col))
+        builder.vertexBinding(0, sizeof(ImDrawVert), VK_VERTEX_INPUT_RATE_VERTEX)
+            .vertexAttribute(0, 0, VK_FORMAT_R32G32_SFLOAT, offsetof(ImDrawVert, pos))
+            .vertexAttribute(1, 0, VK_FORMAT_R32G32_SFLOAT, offsetof(ImDrawVert, uv))
+            .vertexAttribute(2, 0, VK_FORMAT_R8G8B8A8_UNORM, offsetof(ImDrawVert, col));
+    }
+
+    if (blend == BlendMode::Straight) {
+        builder.alphaBlending();
+    } else {
+        // The layer keeps ImGui's color blend but accumulates coverage as
+        // 1 - (1 - a_dst)(1 - a_src), leaving premultiplied color and alpha
+        // that composite exactly like the original draws
+        VkPipelineColorBlendAttachmentState state{};
+        state.blendEnable = VK_TRUE;
+        state.srcColorBlendFactor = blend == BlendMode::IntoLayer ? VK_BLEND_FACTOR_SRC_ALPHA
+                                                                  : VK_BLEND_FACTOR_ONE;
+        state.dstColorBlendFactor = VK_BLEND_FACTOR_ONE_MINUS_SRC_ALPHA;
+        state.colorBlendOp = VK_BLEND_OP_ADD;
+        state.srcAlphaBlendFactor = VK_BLEND_FACTOR_ONE;
+        state.dstAlphaBlendFactor = VK_BLEND_FACTOR_ONE_MINUS_SRC_ALPHA;
+        state.alphaBlendOp = VK_BLEND_OP_ADD;
+        state.colorWriteMask = VK_COLOR_COMPONENT_R_BIT | VK_COLOR_COMPONENT_G_BIT |
+                               VK_COLOR_COMPONENT_B_BIT | VK_COLOR_COMPONENT_A_BIT;
+        builder.colorBlendAttachment(state);
+    }
+
+    return builder
         // Rasterization
         .cullNone()
         .topology(VK_PRIMITIVE_TOPOLOGY_TRIANGLE_LIST)
-        // Blending (premultiplied alpha)
-        .alphaBlending()
         // Depth
         .depthTest(false)
         .depthWrite(false)
@@ -166,76 +389,238 @@ void ImGuiBackend::updateTexture(ImTextureData* tex) {
         IM_ASSERT(tex->TexID == ImTextureID_Invalid && tex->BackendUserData == nullptr);
         IM_ASSERT(tex->Format == ImTextureFormat_RGBA32);
 
-        auto* backendTex = IM_NEW(BackendTextureData)();
-        tex->BackendUserData = backendTex;
-
-        // Create texture from ImGui's pixel data
-        backendTex->texture = finevk::Texture::fromMemory(
-            device_,
-            tex->GetPixels(),
-            static_cast<uint32_t>(tex->Width),
-            static_cast<uint32_t>(tex->Height),
-            commandPool_,
-            false,  // No mipmaps
-            false   // Not sRGB
-        );
-
-        // Allocate descriptor set
-        backendTex->descriptorSet = allocateTextureDescriptor(
-            backendTex->texture.get(), defaultSampler_.get());
-
-        // Store texture ID (raw handle for ImGui draw commands)
-        tex->SetTexID(reinterpret_cast<ImTextureID>(backendTex->descriptorSet->handle()));
+        uint64_t id = createManagedTexture(tex->GetPixels(), tex->Width, tex->Height);
+        tex->BackendUserData = managedTextures_.at(id);
+        tex->SetTexID(static_cast<ImTextureID>(id));
     }
     else if (tex->Status == ImTextureStatus_WantUpdates) {
-        // ImGui 1.92+ lazily rasterizes font glyphs. When new glyphs are needed,
-        // the atlas is updated and we must re-upload the texture data.
+        // ImGui 1.92+ lazily rasterizes font glyphs. Only the dirty rectangles
+        // are copied into the existing image, so the descriptor set (and the
+        // TexID that draw commands reference) stays the same.
         IM_ASSERT(tex->BackendUserData != nullptr);
         auto* backendTex = static_cast<BackendTextureData*>(tex->BackendUserData);
+        uploadTextureRegions(tex, backendTex);
+    }
+
+    // Mark as OK after processing
+    tex->SetStatus(ImTextureStatus_OK);
+}
 
-        // Defer old resources for GPU-safe deletion
-        surface_->deferDelete(std::move(backendTex->descriptorSet));
-        surface_->deferDelete(std::move(backendTex->texture));
-
-        // Recreate texture from updated pixel data
-        backendTex->texture = finevk::Texture::fromMemory(
-            device_,
-            tex->GetPixels(),
-            static_cast<uint32_t>(tex->Width),
-            static_cast<uint32_t>(tex->Height),
-            commandPool_,
-            false,  // No mipmaps
-            false   // Not sRGB
-        );
-
-        // Reallocate descriptor set for new texture
+uint64_t ImGuiBackend::createManagedTexture(const void* pixels, int width, int height) {
+    auto* backendTex = IM_NEW(BackendTextureData)();
+
+    // Create texture from ImGui's pixel data
+    backendTex->texture = finevk::Texture::fromMemory(
+        device_,
+        pixels,
+        static_cast<uint32_t>(width),
+        static_cast<uint32_t>(height),
+        commandPool_,
+        false,  // No mipmaps
+        false   // Not sRGB
+    );
+
+    uint64_t id;
+    if (bindless_) {
+        // Texture ID is the slot in the bindless array
+        backendTex->bindlessSlot = bindless_->allocate(
+            backendTex->texture->view()->handle(), defaultSampler_->handle());
+        id = backendTex->bindlessSlot;
+    } else {
+        // Allocate descriptor set; its raw handle is the ID draw commands use
         backendTex->descriptorSet = allocateTextureDescriptor(
             backendTex->texture.get(), defaultSampler_.get());
+        id = reinterpret_cast<uint64_t>(backendTex->descriptorSet->handle());
+    }
+    managedTextures_[id] = backendTex;
+    sdfTextures_.push_back(id);
+    return id;
+}
 
-        // Update texture ID
-        tex->SetTexID(reinterpret_cast<ImTextureID>(backendTex->descriptorSet->handle()));
+void ImGuiBackend::uploadTextureRegions(ImTextureData* tex, BackendTextureData* backendTex) {
+    IM_ASSERT(backendTex->texture->width() == static_cast<uint32_t>(tex->Width) &&
+              backendTex->texture->height() == static_cast<uint32_t>(tex->Height));
+
+    // Prefer the individual update rects; fall back to their bounding box
+    const ImTextureRect* rects = tex->Updates.Data;
+    int rectCount = tex->Updates.Size;
+    if (rectCount == 0) {
+        rects = &tex->UpdateRect;
+        rectCount = (tex->UpdateRect.w > 0 && tex->UpdateRect.h > 0) ? 1 : 0;
+    }
+    if (rectCount == 0) {
+        return;
     }
 
-    // Mark as OK after processing
-    tex->SetStatus(ImTextureStatus_OK);
+    VkDeviceSize totalBytes = 0;
+    for (int i = 0; i < rectCount; i++) {
+        const ImTextureRect& r = rects[i];
+        totalBytes += static_cast<VkDeviceSize>(r.w) * r.h * tex->BytesPerPixel;
+    }
+
+    // Pack each rect's rows tightly
+    uint8_t* staging = reserveStaging(totalBytes);
+    VkDeviceSize offset = 0;
+    for (int i = 0; i < rectCount; i++) {
+        const ImTextureRect& r = rects[i];
+        const size_t rowBytes = static_cast<size_t>(r.w) * tex->BytesPerPixel;
+        for (int y = 0; y < r.h; y++) {
+            std::memcpy(staging + offset, tex->GetPixelsAt(r.x, r.y + y), rowBytes);
+            offset += rowBytes;
+        }
+    }
+
+    copyStagedRegions(backendTex, rects, rectCount, static_cast<VkDeviceSize>(tex->BytesPerPixel));
 }
 
-void ImGuiBackend::destroyTexture(ImTextureData* tex) {
-    if (tex->BackendUserData != nullptr) {
-        auto* backendTex = static_cast<BackendTextureData*>(tex->BackendUserData);
+uint8_t* ImGuiBackend::reserveStaging(VkDeviceSize bytes) {
+    // Reuse the staging buffer across updates; grow geometrically when needed
+    if (bytes > stagingCapacity_) {
+        VkDeviceSize newCapacity = stagingCapacity_ ? stagingCapacity_ : kInitialStagingCapacity;
+        while (newCapacity < bytes) {
+            newCapacity *= 2;
+        }
+        stagingBuffer_ = finevk::Buffer::create(device_)
+            .size(newCapacity)
+            .usage(VK_BUFFER_USAGE_TRANSFER_SRC_BIT)
+            .memoryUsage(finevk::MemoryUsage::CpuToGpu)
+            .build();
+        stagingCapacity_ = newCapacity;
+    }
+    return static_cast<uint8_t*>(stagingBuffer_->mappedPtr());
+}
 
-        // Defer resources for GPU-safe deletion
-        surface_->deferDelete(std::move(backendTex->descriptorSet));
-        surface_->deferDelete(std::move(backendTex->texture));
+void ImGuiBackend::copyStagedRegions(BackendTextureData* backendTex, const ImTextureRect* rects,
+                                     int rectCount, VkDeviceSize bytesPerPixel)
+{
+    // One copy region per rect, packed back to back in the staging buffer
+    std::vector<VkBufferImageCopy> regions;
+    regions.reserve(static_cast<size_t>(rectCount));
+
+    VkDeviceSize offset = 0;
+    for (int i = 0; i < rectCount; i++) {
+        const ImTextureRect& r = rects[i];
+
+        VkBufferImageCopy region{};
+        region.bufferOffset = offset;
+        region.imageSubresource.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+        region.imageSubresource.layerCount = 1;
+        region.imageOffset = {static_cast<int32_t>(r.x), static_cast<int32_t>(r.y), 0};
+        region.imageExtent = {static_cast<uint32_t>(r.w), static_cast<uint32_t>(r.h), 1};
+        regions.push_back(region);
+
+        offset += static_cast<VkDeviceSize>(r.w) * r.h * bytesPerPixel;
+    }
 
-        IM_DELETE(backendTex);
+    // Frames already submitted may still sample the atlas. The barrier's
+    // source scope covers that earlier work on the queue, and ImGui only
+    // writes glyphs into space no existing draw references.
+    VkImageMemoryBarrier barrier{};
+    barrier.sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
+    barrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+    barrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+    barrier.image = backendTex->texture->image()->handle();
+    barrier.subresourceRange.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+    barrier.subresourceRange.levelCount = 1;
+    barrier.subresourceRange.layerCount = 1;
+
+    auto upload = commandPool_->beginImmediate();
+    VkCommandBuffer cmd = upload->handle();
+
+    barrier.oldLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
+    barrier.newLayout = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL;
+    barrier.srcAccessMask = VK_ACCESS_SHADER_READ_BIT;
+    barrier.dstAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+    vkCmdPipelineBarrier(cmd,
+                         VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT,
+                         VK_PIPELINE_STAGE_TRANSFER_BIT,
+                         0, 0, nullptr, 0, nullptr, 1, &barrier);
+
+    vkCmdCopyBufferToImage(cmd, stagingBuffer_->handle(), barrier.image,
+                           VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
+                           static_cast<uint32_t>(regions.size()), regions.data());
+
+    barrier.oldLayout = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL;
+    barrier.newLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
+    barrier.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+    barrier.dstAccessMask = VK_ACCESS_SHADER_READ_BIT;
+    vkCmdPipelineBarrier(cmd,
+                         VK_PIPELINE_STAGE_TRANSFER_BIT,
+                         VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT,
+                         0, 0, nullptr, 0, nullptr, 1, &barrier);
+
+    // Waits for completion, so the staging buffer is free for the next update
+    commandPool_->endImmediate(std::move(upload));
+
+    textureUploadBytes_ += offset;
+    textureRegionUpdates_ += static_cast<uint64_t>(rectCount);
+}
 
+void ImGuiBackend::destroyTexture(ImTextureData* tex) {
+    if (tex->BackendUserData != nullptr) {
+        destroyManagedTexture(static_cast<uint64_t>(tex->GetTexID()));
         tex->SetTexID(ImTextureID_Invalid);
         tex->BackendUserData = nullptr;
     }
     tex->SetStatus(ImTextureStatus_Destroyed);
 }
 
+void ImGuiBackend::destroyManagedTexture(uint64_t id) {
+    auto it = managedTextures_.find(id);
+    if (it == managedTextures_.end()) {
+        return;
+    }
+    BackendTextureData* backendTex = it->second;
+    managedTextures_.erase(it);
+
+    // Defer resources for GPU-safe deletion. A bindless slot reverts to
+    // the placeholder in each frame's set before that frame is recorded.
+    if (bindless_) {
+        bindless_->release(backendTex->bindlessSlot);
+    } else {
+        descriptorAllocator_->free(std::move(backendTex->descriptorSet));
+    }
+    surface_->deferDelete(std::move(backendTex->texture));
+    textureEpoch_++;
+
+    sdfTextures_.erase(std::remove(sdfTextures_.begin(), sdfTextures_.end(), id),
+                       sdfTextures_.end());
+
+    IM_DELETE(backendTex);
+}
+
+void ImGuiBackend::applyTextureRequests(const std::vector<TextureRequest>& requests) {
+    if (requests.empty() || requests.back().sequence <= appliedTextureRequest_) {
+        return;
+    }
+
+    // Descriptors may be freed below
+    waitForRecording();
+
+    for (const TextureRequest& request : requests) {
+        if (request.sequence <= appliedTextureRequest_) {
+            continue;
+        }
+        appliedTextureRequest_ = request.sequence;
+
+        if (request.status == ImTextureStatus_WantCreate) {
+            provisionalTextures_[request.textureId] =
+                createManagedTexture(request.pixels.data(), request.width, request.height);
+        } else if (request.status == ImTextureStatus_WantUpdates) {
+            auto it = managedTextures_.find(resolveTexture(request.textureId));
+            if (it != managedTextures_.end() && !request.rects.empty()) {
+                std::memcpy(reserveStaging(request.pixels.size()), request.pixels.data(),
+                            request.pixels.size());
+                copyStagedRegions(it->second, request.rects.data(),
+                                  static_cast<int>(request.rects.size()), 4);
+            }
+        } else if (request.status == ImTextureStatus_WantDestroy) {
+            destroyManagedTexture(resolveTexture(request.textureId));
+            provisionalTextures_.erase(request.textureId);
+        }
+    }
+}
+
 // ============================================================================
 // Texture management (user-registered textures)
 // ============================================================================
@@ -245,45 +630,142 @@ uint64_t ImGuiBackend::registerTexture(finevk::Texture* texture, finevk::Sampler
         throw std::runtime_error("ImGuiBackend::registerTexture: texture cannot be null");
     }
 
+    return acquireTexture(texture->view()->handle(), sampler, texture);
+}
+
+uint64_t ImGuiBackend::registerTexture(finevk::ImageView* imageView, finevk::Sampler* sampler) {
+    if (!imageView) {
+        throw std::runtime_error("ImGuiBackend::registerTexture: imageView cannot be null");
+    }
+
+    return acquireTexture(imageView->handle(), sampler, nullptr);
+}
+
+uint64_t ImGuiBackend::acquireTexture(VkImageView view, finevk::Sampler* sampler,
+                                      finevk::Texture* texture)
+{
     // Use default sampler if none provided
     finevk::Sampler* actualSampler = sampler ? sampler : defaultSampler_.get();
 
+    // Registering the same view/sampler pair again shares the existing entry
+    TextureKey key{view, actualSampler->handle()};
+    auto cached = textureCache_.find(key);
+    if (cached != textureCache_.end()) {
+        textures_[cached->second].refCount++;
+        textureCacheHits_++;
+        return cached->second;
+    }
+
     TextureEntry entry;
     entry.texture = texture;
     entry.sampler = actualSampler;
-    entry.descriptorSet = allocateTextureDescriptor(texture, actualSampler);
-
-    // Use VkDescriptorSet handle as the ID — ImGui uses ImTextureID directly
-    // as the descriptor set during rendering, so our ID must be the actual handle.
-    uint64_t id = reinterpret_cast<uint64_t>(entry.descriptorSet->handle());
+    entry.view = view;
+
+    uint64_t id;
+    if (bindless_) {
+        // The bindless slot is the ID; draws push it as the texture index
+        entry.bindlessSlot = bindless_->allocate(view, actualSampler->handle());
+        id = entry.bindlessSlot;
+    } else {
+        entry.descriptorSet = allocateTextureDescriptor(view, actualSampler->handle());
+
+        // Use VkDescriptorSet handle as the ID — ImGui uses ImTextureID directly
+        // as the descriptor set during rendering, so our ID must be the actual handle.
+        id = reinterpret_cast<uint64_t>(entry.descriptorSet->handle());
+    }
 
     textures_[id] = std::move(entry);
+    textureCache_[key] = id;
     return id;
 }
 
-uint64_t ImGuiBackend::registerTexture(finevk::ImageView* imageView, finevk::Sampler* sampler) {
-    if (!imageView) {
-        throw std::runtime_error("ImGuiBackend::registerTexture: imageView cannot be null");
+uint64_t ImGuiBackend::registerTextureAsync(const void* pixels, uint32_t width, uint32_t height,
+                                           finevk::Sampler* sampler)
+{
+    if (!uploader_) {
+        uploader_ = std::make_unique<TextureUploader>(device_, uploadBytesPerFrame_, queueMutex_);
     }
 
-    finevk::Sampler* actualSampler = sampler ? sampler : defaultSampler_.get();
-
     TextureEntry entry;
-    entry.texture = nullptr;
-    entry.sampler = actualSampler;
-    entry.descriptorSet = allocateTextureDescriptor(imageView->handle(), actualSampler->handle());
-
-    uint64_t id = reinterpret_cast<uint64_t>(entry.descriptorSet->handle());
+    entry.sampler = sampler ? sampler : defaultSampler_.get();
+    entry.upload = uploader_->enqueue(pixels, width, height);
+    entry.view = uploader_->view(entry.upload);
+
+    // The real view goes into the descriptor once the image holds its
+    // pixels; nothing binds the descriptor before then
+    uint64_t id;
+    if (bindless_) {
+        entry.bindlessSlot = bindless_->allocate(placeholderTexture_->view()->handle(),
+                                                 entry.sampler->handle());
+        id = entry.bindlessSlot;
+    } else {
+        entry.descriptorSet = descriptorAllocator_->allocate();
+        id = reinterpret_cast<uint64_t>(entry.descriptorSet->handle());
+    }
 
+    uploadTextures_[entry.upload] = id;
+    pendingTextures_.insert(id);
     textures_[id] = std::move(entry);
     return id;
 }
 
+void ImGuiBackend::updateUploads() {
+    if (!uploader_) {
+        return;
+    }
+
+    completedUploads_.clear();
+    uploader_->collect(completedUploads_);
+
+    for (uint32_t upload : completedUploads_) {
+        uint64_t id = uploadTextures_.at(upload);
+        uploadTextures_.erase(upload);
+        pendingTextures_.erase(id);
+
+        const TextureEntry& entry = textures_.at(id);
+        if (bindless_) {
+            bindless_->assign(entry.bindlessSlot, entry.view, entry.sampler->handle());
+        } else {
+            finevk::DescriptorWriter(device_)
+                .writeImage(entry.descriptorSet->handle(), 0, VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER,
+                            entry.view, entry.sampler->handle(),
+                            VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL)
+                .update();
+        }
+    }
+
+    // Draws that were skipped now record; cached recordings must not be reused
+    if (!completedUploads_.empty()) {
+        textureEpoch_++;
+    }
+}
+
 void ImGuiBackend::unregisterTexture(uint64_t textureId) {
     auto it = textures_.find(textureId);
-    if (it != textures_.end()) {
-        textures_.erase(it);  // DescriptorSetPtr handles freeing
+    if (it == textures_.end()) {
+        return;
     }
+
+    TextureEntry& entry = it->second;
+    if (--entry.refCount > 0) {
+        return;
+    }
+
+    if (entry.upload != 0) {
+        // The uploader keeps the image until frames using it have finished
+        uploader_->release(entry.upload);
+        uploadTextures_.erase(entry.upload);
+        pendingTextures_.erase(textureId);
+    } else {
+        textureCache_.erase(TextureKey{entry.view, entry.sampler->handle()});
+    }
+    if (bindless_) {
+        bindless_->release(entry.bindlessSlot);
+    } else {
+        descriptorAllocator_->free(std::move(entry.descriptorSet));
+    }
+    textures_.erase(it);
+    textureEpoch_++;
 }
 
 finevk::DescriptorSetPtr ImGuiBackend::allocateTextureDescriptor(finevk::Texture* texture,
@@ -294,7 +776,7 @@ finevk::DescriptorSetPtr ImGuiBackend::allocateTextureDescriptor(finevk::Texture
 
 finevk::DescriptorSetPtr ImGuiBackend::allocateTextureDescriptor(VkImageView view, VkSampler sampler)
 {
-    auto set = descriptorPool_->allocateManaged(descriptorSetLayout_.get());
+    auto set = descriptorAllocator_->allocate();
 
     finevk::DescriptorWriter(device_)
         .writeImage(set->handle(), 0, VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER,
@@ -309,47 +791,263 @@ finevk::DescriptorSetPtr ImGuiBackend::allocateTextureDescriptor(VkImageView vie
 // Buffer management
 // ============================================================================
 
-void ImGuiBackend::ensureBufferCapacity(uint32_t frameIndex,
-                                         size_t vertexCount,
-                                         size_t indexCount)
+StreamAllocation ImGuiBackend::allocateGeometry(uint32_t frameIndex,
+                                                size_t vertexCount,
+                                                size_t indexCount,
+                                                const GeometryFormat& format,
+                                                uint64_t contentHash,
+                                                bool& reused)
 {
-    auto& frame = frameData_[frameIndex];
+    VkDeviceSize vertexBytes = vertexCount * format.vertexStride();
+    VkDeviceSize indexBytes = indexCount * sizeof(ImDrawIdx);
+    VkDeviceSize bytes = vertexBytes + indexBytes;
+
+    // Identical geometry to the most recent upload: keep that region alive
+    // for this slot instead of writing the same bytes again
+    if (lastUpload_.valid() && lastUpload_.size == bytes && lastUploadHash_ == contentHash &&
+        geometryStream_->renewLast(frameIndex, lastUpload_)) {
+        reused = true;
+        uploadsSkipped_++;
+        uploadBytesSkipped_ += bytes;
+        return lastUpload_;
+    }
 
-    // Resize vertex buffer if needed
-    if (vertexCount > frame.vertexCapacity) {
-        frame.vertexCapacity = vertexCount + 5000;  // Growth buffer
-        VkDeviceSize size = frame.vertexCapacity * sizeof(ImDrawVert);
+    reused = false;
+    lastUpload_ = geometryStream_->allocate(frameIndex, bytes);
+    lastUploadHash_ = contentHash;
+    if (format.compact) {
+        compactUploads_++;
+    }
+    return lastUpload_;
+}
 
-        frame.vertexBuffer = finevk::Buffer::create(device_)
-            .size(size)
-            .usage(VK_BUFFER_USAGE_VERTEX_BUFFER_BIT)
-            .memoryUsage(finevk::MemoryUsage::CpuToGpu)
-            .build();
+void ImGuiBackend::uploadDrawLists(const ImDrawData* drawData,
+                                   const StreamAllocation& geometry,
+                                   const GeometryFormat& format)
+{
+    auto* vtxDst = static_cast<uint8_t*>(geometry.data);
+    ImDrawIdx* idxDst = reinterpret_cast<ImDrawIdx*>(
+        vtxDst + drawData->TotalVtxCount * format.vertexStride());
+
+    uint32_t listVtxStart = 0;
+    for (int n = 0; n < drawData->CmdListsCount; n++) {
+        const ImDrawList* cmdList = drawData->CmdLists[n];
+        if (format.compact) {
+            // Positions are stored relative to the display origin
+            packCompactVertices(cmdList->VtxBuffer.Data, static_cast<size_t>(cmdList->VtxBuffer.Size),
+                                drawData->DisplayPos, reinterpret_cast<CompactDrawVert*>(vtxDst));
+        } else {
+            std::memcpy(vtxDst, cmdList->VtxBuffer.Data, cmdList->VtxBuffer.Size * sizeof(ImDrawVert));
+        }
+
+        if (format.rebase) {
+            // Written once per index; never read back from mapped memory
+            for (const ImDrawCmd& drawCmd : cmdList->CmdBuffer) {
+                if (drawCmd.UserCallback != nullptr) {
+                    continue;
+                }
+                uint32_t bias = listVtxStart + drawCmd.VtxOffset;
+                const ImDrawIdx* src = cmdList->IdxBuffer.Data + drawCmd.IdxOffset;
+                ImDrawIdx* dst = idxDst + drawCmd.IdxOffset;
+                for (unsigned int i = 0; i < drawCmd.ElemCount; i++) {
+                    dst[i] = static_cast<ImDrawIdx>(src[i] + bias);
+                }
+            }
+        } else {
+            std::memcpy(idxDst, cmdList->IdxBuffer.Data, cmdList->IdxBuffer.Size * sizeof(ImDrawIdx));
+        }
+
+        vtxDst += cmdList->VtxBuffer.Size * format.vertexStride();
+        idxDst += cmdList->IdxBuffer.Size;
+        listVtxStart += static_cast<uint32_t>(cmdList->VtxBuffer.Size);
     }
+}
 
-    // Resize index buffer if needed
-    if (indexCount > frame.indexCapacity) {
-        frame.indexCapacity = indexCount + 10000;  // Growth buffer
-        VkDeviceSize size = frame.indexCapacity * sizeof(ImDrawIdx);
+void ImGuiBackend::uploadDrawData(const GuiDrawData& data,
+                                  const StreamAllocation& geometry,
+                                  const GeometryFormat& format)
+{
+    auto* vtxDst = static_cast<uint8_t*>(geometry.data);
+    ImDrawIdx* idxDst = reinterpret_cast<ImDrawIdx*>(
+        vtxDst + data.vertices.size() * format.vertexStride());
+    if (format.compact) {
+        // Captured positions are already relative to the display origin
+        packCompactVertices(data.vertices.data(), data.vertices.size(), ImVec2(0.0f, 0.0f),
+                            reinterpret_cast<CompactDrawVert*>(vtxDst));
+    } else {
+        std::memcpy(vtxDst, data.vertices.data(), data.vertices.size() * sizeof(ImDrawVert));
+    }
 
-        frame.indexBuffer = finevk::Buffer::create(device_)
-            .size(size)
-            .usage(VK_BUFFER_USAGE_INDEX_BUFFER_BIT)
-            .memoryUsage(finevk::MemoryUsage::CpuToGpu)
-            .build();
+    if (format.rebase) {
+        // Captured indices are relative to each command's vertexOffset;
+        // fold that offset in so adjacent commands can share one draw
+        for (const auto& drawCmd : data.commands) {
+            const ImDrawIdx* src = data.indices.data() + drawCmd.indexOffset;
+            ImDrawIdx* dst = idxDst + drawCmd.indexOffset;
+            for (uint32_t i = 0; i < drawCmd.indexCount; i++) {
+                dst[i] = static_cast<ImDrawIdx>(src[i] + drawCmd.vertexOffset);
+            }
+        }
+    } else {
+        std::memcpy(idxDst, data.indices.data(), data.indices.size() * sizeof(ImDrawIdx));
+    }
+}
+
+uint64_t ImGuiBackend::fingerprint(const ImDrawData* drawData, const GeometryFormat& format) {
+    // Covers everything that determines the uploaded bytes: each list's
+    // vertices and indices, plus the command ranges the index rebase uses
+    // (and the display origin compact positions are relative to)
+    uint64_t hash = formatSeed(format);
+    if (format.compact) {
+        hash = hashBytes(&drawData->DisplayPos, sizeof(drawData->DisplayPos), hash);
+    }
+    for (int n = 0; n < drawData->CmdListsCount; n++) {
+        const ImDrawList* cmdList = drawData->CmdLists[n];
+        hash = hashBytes(cmdList->VtxBuffer.Data, cmdList->VtxBuffer.Size * sizeof(ImDrawVert), hash);
+        hash = hashBytes(cmdList->IdxBuffer.Data, cmdList->IdxBuffer.Size * sizeof(ImDrawIdx), hash);
+        if (format.rebase) {
+            for (const ImDrawCmd& drawCmd : cmdList->CmdBuffer) {
+                uint32_t range[4] = {drawCmd.VtxOffset, drawCmd.IdxOffset, drawCmd.ElemCount,
+                                     drawCmd.UserCallback != nullptr ? 1u : 0u};
+                hash = hashBytes(range, sizeof(range), hash);
+            }
+        }
+    }
+    return hash;
+}
+
+uint64_t ImGuiBackend::fingerprint(const GuiDrawData& data, const GeometryFormat& format) {
+    uint64_t hash = formatSeed(format);
+    hash = hashBytes(data.vertices.data(), data.vertices.size() * sizeof(ImDrawVert), hash);
+    hash = hashBytes(data.indices.data(), data.indices.size() * sizeof(ImDrawIdx), hash);
+    if (format.rebase) {
+        for (const auto& drawCmd : data.commands) {
+            uint32_t range[3] = {drawCmd.vertexOffset, drawCmd.indexOffset, drawCmd.indexCount};
+            hash = hashBytes(range, sizeof(range), hash);
+        }
     }
+    return hash;
+}
+
+void ImGuiBackend::recordHashCost(std::chrono::steady_clock::time_point start,
+                                  size_t vertexCount, size_t indexCount)
+{
+    // The whole frame is hashed even when it turns out to have changed, so
+    // this is the price of upload skipping on busy frames
+    geometryHashNanos_ += static_cast<uint64_t>(
+        std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now() - start).count());
+    geometryBytesHashed_ += vertexCount * sizeof(ImDrawVert) + indexCount * sizeof(ImDrawIdx);
+}
+
+uint64_t ImGuiBackend::recordingKey(const GuiDrawData& data, const StreamAllocation& geometry,
+                                    const GeometryFormat& format, VkFramebuffer framebuffer)
+{
+    // Everything a secondary recording bakes in: where the geometry lives
+    // and in which format, the viewport, and each draw's texture, scissor
+    // and index range. Vertex contents are read at execution time, so they
+    // are not included.
+    uint64_t placement[4] = {geometry.offset, geometry.generation,
+                             static_cast<uint64_t>(data.vertices.size()),
+                             reinterpret_cast<uint64_t>(framebuffer)};
+    uint64_t hash = hashBytes(placement, sizeof(placement), formatSeed(format));
+
+    float view[4] = {data.displaySize.x, data.displaySize.y,
+                     data.framebufferScale.x, data.framebufferScale.y};
+    hash = hashBytes(view, sizeof(view), hash);
+
+    for (const auto& drawCmd : data.commands) {
+        uint32_t fields[7] = {drawCmd.indexOffset, drawCmd.indexCount, drawCmd.vertexOffset,
+                              static_cast<uint32_t>(drawCmd.scissorRect.x),
+                              static_cast<uint32_t>(drawCmd.scissorRect.y),
+                              static_cast<uint32_t>(drawCmd.scissorRect.z),
+                              static_cast<uint32_t>(drawCmd.scissorRect.w)};
+        hash = hashBytes(fields, sizeof(fields), hash);
+        hash = hashBytes(&drawCmd.texture.id, sizeof(drawCmd.texture.id), hash);
+    }
+    return hash;
+}
+
+GuiRenderStats ImGuiBackend::stats() const {
+    GuiRenderStats result;
+    if (geometryStream_) {
+        result.streamCapacity = geometryStream_->capacity();
+        result.streamUsed = geometryStream_->used();
+        result.streamHighWater = geometryStream_->highWaterMark();
+        result.streamReallocations = geometryStream_->reallocations();
+    }
+    if (bindless_) {
+        result.bindlessCapacity = BindlessTextureTable::kCapacity;
+        result.bindlessSlotsUsed = bindless_->liveSlots();
+    }
+    if (descriptorAllocator_) {
+        result.descriptorSetsLive = descriptorAllocator_->liveSets();
+        result.descriptorPools = descriptorAllocator_->poolCount();
+    }
+    result.registeredTextures = static_cast<uint32_t>(textures_.size());
+    result.textureCacheHits = textureCacheHits_;
+    result.uploadsSkipped = uploadsSkipped_;
+    result.uploadBytesSkipped = uploadBytesSkipped_;
+    result.geometryBytesHashed = geometryBytesHashed_;
+    result.geometryHashMicros = geometryHashNanos_ / 1000;
+    result.compactUploads = compactUploads_;
+    result.textureUploadBytes = textureUploadBytes_;
+    result.textureRegionUpdates = textureRegionUpdates_;
+    if (uploader_) {
+        result.pendingUploads = uploader_->pending();
+        result.asyncUploadBytes = uploader_->submittedBytes();
+        result.asyncUploadsCompleted = uploader_->completedUploads();
+        result.asyncUploadMemoryBlocks = uploader_->memoryBlocks();
+    }
+    result.drawCommands = lastBatchStats_.commands;
+    result.drawCalls = lastBatchStats_.drawCalls;
+    result.descriptorBinds = lastBatchStats_.descriptorBinds;
+    result.textureSwitches = lastBatchStats_.textureSwitches;
+    result.scissorChanges = lastBatchStats_.scissorChanges;
+    result.secondaryRecords = secondaryRecords_;
+    result.secondaryReuses = secondaryReuses_;
+    result.secondaryExecutes = secondaryExecutes_;
+    result.pipelineCreateMicros = pipelineCreateMicros_;
+    result.pipelineCacheLoadedBytes = pipelineCacheLoadedBytes_;
+    return result;
 }
 
 // ============================================================================
 // Rendering
 // ============================================================================
 
+void ImGuiBackend::bindBindlessSet(finevk::CommandBuffer& cmd, uint32_t frameIndex) {
+    if (bindless_) {
+        cmd.bindDescriptorSet(*pipelineLayout_, bindless_->set(frameIndex), 0);
+    }
+}
+
+void ImGuiBackend::submitUploads() {
+    if (uploader_) {
+        uploader_->submit();
+    }
+}
+
+void ImGuiBackend::beginFrame(uint32_t frameIndex) {
+    // A worker may still be recording against the ring's current buffer,
+    // which a trim would replace
+    waitForRecording();
+
+    // This slot's fence has been waited on, so its previous regions are free
+    geometryStream_->beginFrame(frameIndex);
+}
+
 void ImGuiBackend::render(finevk::CommandBuffer& cmd, uint32_t frameIndex) {
+    submitUploads();
+
     ImDrawData* drawData = ImGui::GetDrawData();
     if (!drawData || drawData->TotalVtxCount == 0) {
         return;
     }
 
+    // A worker may still be recording against the shared geometry ring
+    waitForRecording();
+
     // Process texture updates (ImGui 1.92+ texture lifecycle)
     if (drawData->Textures != nullptr) {
         for (ImTextureData* tex : *drawData->Textures) {
@@ -359,27 +1057,50 @@ void ImGuiBackend::render(finevk::CommandBuffer& cmd, uint32_t frameIndex) {
         }
     }
 
-    // Ensure buffers are large enough
-    ensureBufferCapacity(frameIndex,
-                         static_cast<size_t>(drawData->TotalVtxCount),
-                         static_cast<size_t>(drawData->TotalIdxCount));
-
-    auto& frame = frameData_[frameIndex];
+    // This slot's fence has been waited on, so its bindless set can be written
+    if (bindless_) {
+        bindless_->update(frameIndex);
+    }
 
-    // Upload vertex/index data
-    ImDrawVert* vtxDst = static_cast<ImDrawVert*>(frame.vertexBuffer->mappedPtr());
-    ImDrawIdx* idxDst = static_cast<ImDrawIdx*>(frame.indexBuffer->mappedPtr());
+    // Rebasing indices onto one frame-wide vertex offset lets draws from
+    // different command lists merge, as long as every index still fits
+    GeometryFormat format;
+    format.rebase = indicesFitFrame(static_cast<size_t>(drawData->TotalVtxCount));
+    if (compactVertices_) {
+        format.compact = true;
+        for (int n = 0; n < drawData->CmdListsCount && format.compact; n++) {
+            const ImDrawList* cmdList = drawData->CmdLists[n];
+            format.compact = fitsCompactVertices(cmdList->VtxBuffer.Data,
+                                                 static_cast<size_t>(cmdList->VtxBuffer.Size),
+                                                 drawData->DisplayPos);
+        }
+    }
 
-    for (int n = 0; n < drawData->CmdListsCount; n++) {
-        const ImDrawList* cmdList = drawData->CmdLists[n];
-        std::memcpy(vtxDst, cmdList->VtxBuffer.Data, cmdList->VtxBuffer.Size * sizeof(ImDrawVert));
-        std::memcpy(idxDst, cmdList->IdxBuffer.Data, cmdList->IdxBuffer.Size * sizeof(ImDrawIdx));
-        vtxDst += cmdList->VtxBuffer.Size;
-        idxDst += cmdList->IdxBuffer.Size;
+    // Sub-allocate this frame's vertices followed by its indices, unless the
+    // most recent upload already holds exactly this geometry
+    auto hashStart = std::chrono::steady_clock::now();
+    uint64_t contentHash = fingerprint(drawData, format);
+    recordHashCost(hashStart, static_cast<size_t>(drawData->TotalVtxCount),
+                   static_cast<size_t>(drawData->TotalIdxCount));
+
+    bool reused = false;
+    StreamAllocation geometry = allocateGeometry(frameIndex,
+                                                 static_cast<size_t>(drawData->TotalVtxCount),
+                                                 static_cast<size_t>(drawData->TotalIdxCount),
+                                                 format,
+                                                 contentHash,
+                                                 reused);
+    if (!reused) {
+        uploadDrawLists(drawData, geometry, format);
     }
 
+    // Only the first render call after resetGpuTimer() is timed, and never
+    // a layer render (its command buffer is submitted before the reset)
+    bool timed = gpuTimer_ && activePipelines_ != &layerPipelines_ &&
+                 gpuTimer_->begin(cmd.handle(), frameIndex);
+
     // Bind pipeline
-    cmd.bindPipeline(pipeline_.get());
+    cmd.bindPipeline(activePipelines_->get(format));
 
     // Set viewport
     cmd.setViewport(0, 0,
@@ -390,24 +1111,37 @@ void ImGuiBackend::render(finevk::CommandBuffer& cmd, uint32_t frameIndex) {
     PushConstantBlock pushConstants;
     pushConstants.scale[0] = 2.0f / drawData->DisplaySize.x;
     pushConstants.scale[1] = 2.0f / drawData->DisplaySize.y;
-    pushConstants.translate[0] = -1.0f - drawData->DisplayPos.x * pushConstants.scale[0];
-    pushConstants.translate[1] = -1.0f - drawData->DisplayPos.y * pushConstants.scale[1];
+    // Compact positions are already relative to DisplayPos
+    ImVec2 origin = format.compact ? ImVec2(0.0f, 0.0f) : drawData->DisplayPos;
+    pushConstants.translate[0] = -1.0f - origin.x * pushConstants.scale[0];
+    pushConstants.translate[1] = -1.0f - origin.y * pushConstants.scale[1];
 
     cmd.pushConstants(pipelineLayout_->handle(),
                       VK_SHADER_STAGE_VERTEX_BIT,
                       0, sizeof(PushConstantBlock), &pushConstants);
 
-    // Bind vertex/index buffers
-    cmd.bindVertexBuffer(*frame.vertexBuffer);
-    cmd.bindIndexBuffer(*frame.indexBuffer,
+    // Bind vertex/index buffers (both regions live in the geometry ring)
+    cmd.bindVertexBuffer(*geometryStream_->buffer());
+    cmd.bindIndexBuffer(*geometryStream_->buffer(),
                         sizeof(ImDrawIdx) == 2 ? VK_INDEX_TYPE_UINT16 : VK_INDEX_TYPE_UINT32);
 
-    // Render command lists
-    int globalVtxOffset = 0;
-    int globalIdxOffset = 0;
+    // Bindless mode binds every texture at once; draws only push an index
+    bindBindlessSet(cmd, frameIndex);
+
+    // Render command lists, offset to this frame's region of the ring
+    int baseVertex = static_cast<int>(geometry.offset / format.vertexStride());
+    int globalVtxOffset = baseVertex;
+    int globalIdxOffset = static_cast<int>(
+        (geometry.offset + drawData->TotalVtxCount * format.vertexStride()) / sizeof(ImDrawIdx));
 
     ImVec2 clipOff = drawData->DisplayPos;
     ImVec2 clipScale = drawData->FramebufferScale;
+    float fbWidth = drawData->DisplaySize.x * clipScale.x;
+    float fbHeight = drawData->DisplaySize.y * clipScale.y;
+
+    DrawBatcher batcher(cmd, *pipelineLayout_,
+                        bindless_ ? static_cast<int32_t>(sizeof(PushConstantBlock)) : -1,
+                        sdfFonts_ ? kSdfFlagOffset : -1, &sdfTextures_);
 
     for (int n = 0; n < drawData->CmdListsCount; n++) {
         const ImDrawList* cmdList = drawData->CmdLists[n];
@@ -416,10 +1150,15 @@ void ImGuiBackend::render(finevk::CommandBuffer& cmd, uint32_t frameIndex) {
             const ImDrawCmd* pcmd = &cmdList->CmdBuffer[cmdIdx];
 
             if (pcmd->UserCallback != nullptr) {
-                // User callback (not commonly used, but supported)
+                // User callback (not commonly used, but supported). Anything
+                // batched so far must be recorded first, and the callback may
+                // change bound state behind our back.
+                batcher.flush();
                 if (pcmd->UserCallback != ImDrawCallback_ResetRenderState) {
                     pcmd->UserCallback(cmdList, pcmd);
                 }
+                batcher.invalidate();
+                bindBindlessSet(cmd, frameIndex);
             } else {
                 // Calculate scissor rect
                 ImVec2 clipMin((pcmd->ClipRect.x - clipOff.x) * clipScale.x,
@@ -430,9 +1169,6 @@ void ImGuiBackend::render(finevk::CommandBuffer& cmd, uint32_t frameIndex) {
                 // Clamp to viewport
                 if (clipMin.x < 0.0f) clipMin.x = 0.0f;
                 if (clipMin.y < 0.0f) clipMin.y = 0.0f;
-
-                float fbWidth = drawData->DisplaySize.x * clipScale.x;
-                float fbHeight = drawData->DisplaySize.y * clipScale.y;
                 if (clipMax.x > fbWidth) clipMax.x = fbWidth;
                 if (clipMax.y > fbHeight) clipMax.y = fbHeight;
 
@@ -440,55 +1176,212 @@ void ImGuiBackend::render(finevk::CommandBuffer& cmd, uint32_t frameIndex) {
                     continue;
                 }
 
-                // Set scissor
-                cmd.setScissor(
-                    static_cast<int32_t>(clipMin.x),
-                    static_cast<int32_t>(clipMin.y),
-                    static_cast<uint32_t>(clipMax.x - clipMin.x),
-                    static_cast<uint32_t>(clipMax.y - clipMin.y));
-
-                // Get texture descriptor - in 1.92+, GetTexID() returns the descriptor set directly
-                VkDescriptorSet texDescriptor = reinterpret_cast<VkDescriptorSet>(pcmd->GetTexID());
-
-                // Bind descriptor set
-                cmd.bindDescriptorSet(*pipelineLayout_, texDescriptor, 0);
-
-                // Draw
-                cmd.drawIndexed(pcmd->ElemCount,
-                                1,
-                                pcmd->IdxOffset + globalIdxOffset,
-                                pcmd->VtxOffset + globalVtxOffset,
-                                0);
+                VkRect2D scissor;
+                scissor.offset.x = static_cast<int32_t>(clipMin.x);
+                scissor.offset.y = static_cast<int32_t>(clipMin.y);
+                scissor.extent.width = static_cast<uint32_t>(clipMax.x - clipMin.x);
+                scissor.extent.height = static_cast<uint32_t>(clipMax.y - clipMin.y);
+
+                // In 1.92+, GetTexID() returns the descriptor set (or bindless slot) directly
+                uint64_t textureId = resolveTexture(static_cast<uint64_t>(pcmd->GetTexID()));
+                if (hidden(textureId)) {
+                    continue;
+                }
+                batcher.draw(scissor, textureId,
+                             pcmd->IdxOffset + globalIdxOffset,
+                             pcmd->ElemCount,
+                             format.rebase ? baseVertex
+                                    : static_cast<int32_t>(pcmd->VtxOffset) + globalVtxOffset);
             }
         }
 
         globalVtxOffset += cmdList->VtxBuffer.Size;
         globalIdxOffset += cmdList->IdxBuffer.Size;
     }
+
+    batcher.flush();
+    lastBatchStats_ = batcher.stats();
+    if (bindless_) {
+        lastBatchStats_.descriptorBinds++;
+    }
+
+    if (timed) {
+        gpuTimer_->end(cmd.handle(), frameIndex);
+    }
 }
 
 void ImGuiBackend::renderDrawData(finevk::CommandBuffer& cmd, uint32_t frameIndex,
                                    const GuiDrawData& data)
 {
+    submitUploads();
+
     if (data.empty()) {
         return;
     }
 
-    // Ensure buffers are large enough
-    ensureBufferCapacity(frameIndex, data.vertices.size(), data.indices.size());
+    // A worker may still be recording against the shared geometry ring
+    waitForRecording();
 
-    auto& frame = frameData_[frameIndex];
+    GeometryFormat format;
+    bool descriptorsChanged = false;
+    StreamAllocation geometry = prepareDrawData(frameIndex, data, format, descriptorsChanged);
 
-    // Upload captured vertex/index data
-    std::memcpy(frame.vertexBuffer->mappedPtr(),
-                data.vertices.data(),
-                data.vertices.size() * sizeof(ImDrawVert));
-    std::memcpy(frame.indexBuffer->mappedPtr(),
-                data.indices.data(),
-                data.indices.size() * sizeof(ImDrawIdx));
+    bool timed = gpuTimer_ && gpuTimer_->begin(cmd.handle(), frameIndex);
+    recordDrawData(cmd, frameIndex, data, geometry, format);
+    if (timed) {
+        gpuTimer_->end(cmd.handle(), frameIndex);
+    }
+}
+
+// ============================================================================
+// Cached layer
+// ============================================================================
+
+void ImGuiBackend::initializeLayer(finevk::RenderPass* layerPass) {
+    if (!initialized_) {
+        throw std::runtime_error("ImGuiBackend::initializeLayer: backend not initialized");
+    }
+
+    layerPipelines_ = createPipelineSet(layerPass, 0, VK_SAMPLE_COUNT_1_BIT,
+                                        BlendMode::IntoLayer, VK_NULL_HANDLE);
+    compositePipelines_ = createPipelineSet(renderPass_, subpass_, msaaSamples_,
+                                            BlendMode::PremultipliedIn, VK_NULL_HANDLE);
+
+    // One quad: two triangles over the whole display, untinted
+    layerQuad_.vertices.resize(4);
+    layerQuad_.indices = {0, 1, 2, 0, 2, 3};
+    layerQuad_.commands.resize(1);
+    for (ImDrawVert& v : layerQuad_.vertices) {
+        v.col = IM_COL32_WHITE;
+    }
+}
+
+void ImGuiBackend::renderToLayer(finevk::CommandBuffer& cmd, uint32_t frameIndex) {
+    activePipelines_ = &layerPipelines_;
+    try {
+        render(cmd, frameIndex);
+    } catch (...) {
+        activePipelines_ = &pipelines_;
+        throw;
+    }
+    activePipelines_ = &pipelines_;
+}
+
+void ImGuiBackend::compositeLayer(finevk::CommandBuffer& cmd, uint32_t frameIndex,
+                                  uint64_t textureId, ImVec2 displaySize,
+                                  ImVec2 framebufferScale)
+{
+    submitUploads();
+
+    const float w = displaySize.x;
+    const float h = displaySize.y;
+    ImDrawVert* v = layerQuad_.vertices.data();
+    v[0].pos = ImVec2(0.0f, 0.0f); v[0].uv = ImVec2(0.0f, 0.0f);
+    v[1].pos = ImVec2(w, 0.0f);    v[1].uv = ImVec2(1.0f, 0.0f);
+    v[2].pos = ImVec2(w, h);       v[2].uv = ImVec2(1.0f, 1.0f);
+    v[3].pos = ImVec2(0.0f, h);    v[3].uv = ImVec2(0.0f, 1.0f);
+
+    DrawCommand& quad = layerQuad_.commands[0];
+    quad.indexOffset = 0;
+    quad.indexCount = 6;
+    quad.vertexOffset = 0;
+    quad.texture.id = textureId;
+    quad.scissorRect = glm::ivec4(0, 0, static_cast<int>(w), static_cast<int>(h));
+
+    layerQuad_.displaySize = glm::vec2(w, h);
+    layerQuad_.framebufferScale = glm::vec2(framebufferScale.x, framebufferScale.y);
+
+    activePipelines_ = &compositePipelines_;
+    try {
+        renderDrawData(cmd, frameIndex, layerQuad_);
+    } catch (...) {
+        activePipelines_ = &pipelines_;
+        throw;
+    }
+    activePipelines_ = &pipelines_;
+}
+
+uint64_t ImGuiBackend::layerHash(const ImDrawData* drawData) const {
+    if (drawData->Textures != nullptr) {
+        for (const ImTextureData* tex : *drawData->Textures) {
+            if (tex->Status != ImTextureStatus_OK) {
+                return 0;
+            }
+        }
+    }
+
+    float view[6] = {drawData->DisplayPos.x, drawData->DisplayPos.y,
+                     drawData->DisplaySize.x, drawData->DisplaySize.y,
+                     drawData->FramebufferScale.x, drawData->FramebufferScale.y};
+    uint64_t hash = hashBytes(view, sizeof(view), kHashSeed);
+    hash = hashBytes(&textureEpoch_, sizeof(textureEpoch_), hash);
+
+    for (int n = 0; n < drawData->CmdListsCount; n++) {
+        const ImDrawList* cmdList = drawData->CmdLists[n];
+        hash = hashBytes(cmdList->VtxBuffer.Data, cmdList->VtxBuffer.Size * sizeof(ImDrawVert), hash);
+        hash = hashBytes(cmdList->IdxBuffer.Data, cmdList->IdxBuffer.Size * sizeof(ImDrawIdx), hash);
+        for (const ImDrawCmd& drawCmd : cmdList->CmdBuffer) {
+            uint64_t fields[4] = {static_cast<uint64_t>(drawCmd.GetTexID()),
+                                  drawCmd.VtxOffset,
+                                  (static_cast<uint64_t>(drawCmd.IdxOffset) << 32) | drawCmd.ElemCount,
+                                  reinterpret_cast<uint64_t>(drawCmd.UserCallback)};
+            hash = hashBytes(fields, sizeof(fields), hash);
+            hash = hashBytes(&drawCmd.ClipRect, sizeof(drawCmd.ClipRect), hash);
+        }
+    }
+    return hash != 0 ? hash : 1;
+}
+
+void ImGuiBackend::resetGpuTimer(finevk::CommandBuffer& cmd, uint32_t frameIndex) {
+    if (!gpuTimer_) {
+        return;
+    }
+
+    float micros = 0.0f;
+    if (gpuTimer_->reset(cmd.handle(), frameIndex, micros)) {
+        gpuMicros_ = smoothGpuTime(gpuMicros_, micros, gpuSamples_ == 0);
+        gpuSamples_++;
+    }
+}
+
+StreamAllocation ImGuiBackend::prepareDrawData(uint32_t frameIndex, const GuiDrawData& data,
+                                               GeometryFormat& format, bool& descriptorsChanged)
+{
+    descriptorsChanged = bindless_ ? bindless_->update(frameIndex) : false;
+
+    format.rebase = indicesFitFrame(data.vertices.size());
+    format.compact = compactVertices_ &&
+                     fitsCompactVertices(data.vertices.data(), data.vertices.size(), ImVec2(0.0f, 0.0f));
+
+    // Sub-allocate this frame's vertices followed by its indices, unless the
+    // most recent upload already holds exactly this geometry
+    auto hashStart = std::chrono::steady_clock::now();
+    uint64_t contentHash = fingerprint(data, format);
+    recordHashCost(hashStart, data.vertices.size(), data.indices.size());
+
+    bool reused = false;
+    StreamAllocation geometry = allocateGeometry(frameIndex,
+                                                 data.vertices.size(),
+                                                 data.indices.size(),
+                                                 format,
+                                                 contentHash,
+                                                 reused);
+    if (!reused) {
+        uploadDrawData(data, geometry, format);
+    }
+    return geometry;
+}
+
+void ImGuiBackend::recordDrawData(finevk::CommandBuffer& cmd, uint32_t frameIndex,
+                                  const GuiDrawData& data, const StreamAllocation& geometry,
+                                  const GeometryFormat& format)
+{
+    uint32_t baseVertex = static_cast<uint32_t>(geometry.offset / format.vertexStride());
+    uint32_t baseIndex = static_cast<uint32_t>(
+        (geometry.offset + data.vertices.size() * format.vertexStride()) / sizeof(ImDrawIdx));
 
     // Bind pipeline
-    cmd.bindPipeline(pipeline_.get());
+    cmd.bindPipeline(activePipelines_->get(format));
 
     // Set viewport
     cmd.setViewport(0, 0,
@@ -506,16 +1399,28 @@ void ImGuiBackend::renderDrawData(finevk::CommandBuffer& cmd, uint32_t frameInde
                       VK_SHADER_STAGE_VERTEX_BIT,
                       0, sizeof(PushConstantBlock), &pushConstants);
 
-    // Bind vertex/index buffers
-    cmd.bindVertexBuffer(*frame.vertexBuffer);
-    cmd.bindIndexBuffer(*frame.indexBuffer,
+    // Bind vertex/index buffers (both regions live in the geometry ring)
+    cmd.bindVertexBuffer(*geometryStream_->buffer());
+    cmd.bindIndexBuffer(*geometryStream_->buffer(),
                         sizeof(ImDrawIdx) == 2 ? VK_INDEX_TYPE_UINT16 : VK_INDEX_TYPE_UINT32);
 
+    // Bindless mode binds every texture at once; draws only push an index
+    bindBindlessSet(cmd, frameIndex);
+
     // Render captured commands
     float fbWidth = data.displaySize.x * data.framebufferScale.x;
     float fbHeight = data.displaySize.y * data.framebufferScale.y;
 
+    DrawBatcher batcher(cmd, *pipelineLayout_,
+                        bindless_ ? static_cast<int32_t>(sizeof(PushConstantBlock)) : -1,
+                        sdfFonts_ ? kSdfFlagOffset : -1, &sdfTextures_);
+
     for (const auto& drawCmd : data.commands) {
+        uint64_t textureId = resolveTexture(drawCmd.texture.id);
+        if (hidden(textureId)) {
+            continue;
+        }
+
         // Calculate scissor from clip rect
         float clipMinX = static_cast<float>(drawCmd.scissorRect.x) * data.framebufferScale.x;
         float clipMinY = static_cast<float>(drawCmd.scissorRect.y) * data.framebufferScale.y;
@@ -532,25 +1437,122 @@ void ImGuiBackend::renderDrawData(finevk::CommandBuffer& cmd, uint32_t frameInde
             continue;
         }
 
-        // Set scissor
-        cmd.setScissor(
-            static_cast<int32_t>(clipMinX),
-            static_cast<int32_t>(clipMinY),
-            static_cast<uint32_t>(clipMaxX - clipMinX),
-            static_cast<uint32_t>(clipMaxY - clipMinY));
-
-        // Get texture descriptor
-        VkDescriptorSet texDescriptor = reinterpret_cast<VkDescriptorSet>(drawCmd.texture.id);
-
-        // Bind descriptor set
-        cmd.bindDescriptorSet(*pipelineLayout_, texDescriptor, 0);
-
-        // Draw
-        cmd.drawIndexed(drawCmd.indexCount,
-                        1,
-                        drawCmd.indexOffset,
-                        drawCmd.vertexOffset,
-                        0);
+        VkRect2D scissor;
+        scissor.offset.x = static_cast<int32_t>(clipMinX);
+        scissor.offset.y = static_cast<int32_t>(clipMinY);
+        scissor.extent.width = static_cast<uint32_t>(clipMaxX - clipMinX);
+        scissor.extent.height = static_cast<uint32_t>(clipMaxY - clipMinY);
+
+        batcher.draw(scissor, textureId,
+                     baseIndex + drawCmd.indexOffset,
+                     drawCmd.indexCount,
+                     static_cast<int32_t>(format.rebase ? baseVertex : baseVertex + drawCmd.vertexOffset));
+    }
+
+    batcher.flush();
+    lastBatchStats_ = batcher.stats();
+    if (bindless_) {
+        lastBatchStats_.descriptorBinds++;
+    }
+}
+
+// ============================================================================
+// Secondary command buffers
+// ============================================================================
+
+void ImGuiBackend::recordSecondary(uint32_t frameIndex, const GuiDrawData& data,
+                                   VkFramebuffer framebuffer, bool async)
+{
+    // Only one recording may touch the ring and descriptor state at a time
+    waitForRecording();
+    submitUploads();
+
+    if (secondaries_.empty()) {
+        secondaryPool_ = finevk::CommandPool::create(device_, device_->graphicsQueue(),
+                                                     finevk::CommandPoolFlags::Resettable);
+        secondaries_.resize(framesInFlight_);
+    }
+
+    SecondarySlot& slot = secondaries_[frameIndex];
+    if (data.empty()) {
+        slot.valid = false;
+        return;
+    }
+
+    // Uploads and descriptor writes stay on this thread; only command
+    // recording is handed to the worker
+    GeometryFormat format;
+    bool descriptorsChanged = false;
+    StreamAllocation geometry = prepareDrawData(frameIndex, data, format, descriptorsChanged);
+    uint64_t key = recordingKey(data, geometry, format, framebuffer);
+
+    // This slot's fence has been waited on, so its previous submission is
+    // complete and the buffer can be executed again as recorded
+    if (slot.valid && !descriptorsChanged &&
+        slot.drawHash == key && slot.textureEpoch == textureEpoch_) {
+        secondaryReuses_++;
+        return;
+    }
+
+    if (!slot.buffer) {
+        slot.buffer = secondaryPool_->allocate(VK_COMMAND_BUFFER_LEVEL_SECONDARY);
+    }
+    slot.valid = false;
+    slot.drawHash = key;
+    slot.textureEpoch = textureEpoch_;
+    secondaryRecords_++;
+
+    auto record = [this, &slot, &data, geometry, format, framebuffer, frameIndex]() {
+        beginSecondary(slot, framebuffer);
+        recordDrawData(*slot.buffer, frameIndex, data, geometry, format);
+        if (vkEndCommandBuffer(slot.buffer->handle()) != VK_SUCCESS) {
+            throw std::runtime_error("ImGuiBackend::recordSecondary: failed to end command buffer");
+        }
+        slot.valid = true;
+    };
+
+    if (async) {
+        if (!recordWorker_) {
+            recordWorker_ = std::make_unique<RecordWorker>();
+        }
+        recordWorker_->submit(std::move(record));
+    } else {
+        record();
+    }
+}
+
+void ImGuiBackend::beginSecondary(SecondarySlot& slot, VkFramebuffer framebuffer) {
+    VkCommandBufferInheritanceInfo inheritance{};
+    inheritance.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_INHERITANCE_INFO;
+    inheritance.renderPass = renderPass_->handle();
+    inheritance.subpass = subpass_;
+    inheritance.framebuffer = framebuffer;
+
+    // Beginning implicitly resets the buffer (the pool is resettable)
+    VkCommandBufferBeginInfo beginInfo{};
+    beginInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
+    beginInfo.flags = VK_COMMAND_BUFFER_USAGE_RENDER_PASS_CONTINUE_BIT;
+    beginInfo.pInheritanceInfo = &inheritance;
+    if (vkBeginCommandBuffer(slot.buffer->handle(), &beginInfo) != VK_SUCCESS) {
+        throw std::runtime_error("ImGuiBackend::recordSecondary: failed to begin command buffer");
+    }
+}
+
+void ImGuiBackend::executeSecondary(finevk::CommandBuffer& primary, uint32_t frameIndex) {
+    waitForRecording();
+
+    if (frameIndex >= secondaries_.size() || !secondaries_[frameIndex].valid) {
+        return;
+    }
+
+    VkCommandBuffer secondary = secondaries_[frameIndex].buffer->handle();
+    vkCmdExecuteCommands(primary.handle(), 1, &secondary);
+    secondaryExecutes_++;
+}
+
+void ImGuiBackend::waitForRecording() {
+    if (recordWorker_) {
+        recordWorker_->wait();
     }
 }
 
@@ -8,16 +8,33 @@
  * Supports ImGui 1.92+ with ImGuiBackendFlags_RendererHasTextures.
  */
 
+#include "bindless_table.hpp"
+#include "descriptor_allocator.hpp"
+#include "draw_batcher.hpp"
+#include "gpu_timer.hpp"
+#include "record_worker.hpp"
+#include "stream_buffer.hpp"
+#include "texture_uploader.hpp"
+
+#include <finegui/compact_vertex.hpp>
+#include <finegui/gui_config.hpp>
 #include <finegui/gui_draw_data.hpp>
+#include <finegui/gui_stats.hpp>
 
 #include <finevk/finevk.hpp>
 
 #include <imgui.h>
 
+#include <chrono>
+#include <cstddef>
+#include <map>
 #include <memory>
+#include <mutex>
 #include <vector>
 #include <string>
 #include <unordered_map>
+#include <unordered_set>
+#include <utility>
 
 namespace finegui {
 namespace backend {
@@ -31,15 +48,55 @@ struct PushConstantBlock {
 };
 
 /**
- * @brief Per-frame rendering data
- *
- * Maintains vertex/index buffers per frame-in-flight to avoid GPU/CPU sync.
+ * @brief Fragment push constant for bindless mode (follows PushConstantBlock)
+ */
+struct BindlessPushConstantBlock {
+    uint32_t textureIndex;  // Slot in the bindless texture array
+};
+
+/**
+ * @brief Fragment push constants with SDF fonts (follows PushConstantBlock)
+ */
+struct SdfPushConstantBlock {
+    uint32_t textureIndex;  // Slot in the bindless texture array (bindless mode only)
+    uint32_t sdf;           // Non-zero when the bound texture is a distance-field font atlas
+};
+
+/// Push constant offset of SdfPushConstantBlock::sdf
+constexpr int32_t kSdfFlagOffset =
+    static_cast<int32_t>(sizeof(PushConstantBlock) + offsetof(SdfPushConstantBlock, sdf));
+
+/**
+ * @brief How one render call's geometry is laid out in the ring
+ */
+struct GeometryFormat {
+    bool rebase = false;   // Indices rebased onto one frame-wide vertex offset
+    bool compact = false;  // Vertices stored as CompactDrawVert
+
+    VkDeviceSize vertexStride() const {
+        return compact ? sizeof(CompactDrawVert) : sizeof(ImDrawVert);
+    }
+};
+
+/**
+ * @brief How a pipeline blends into its target
+ */
+enum class BlendMode {
+    Straight,        ///< ImGui's usual blend, into the application's pass
+    IntoLayer,       ///< Same color blend, alpha accumulated for premultiplied output
+    PremultipliedIn  ///< Compositing premultiplied content (the cached layer)
+};
+
+/**
+ * @brief Pipelines for one target: standard and (optionally) compact vertices
  */
-struct FrameRenderData {
-    finevk::BufferPtr vertexBuffer;
-    finevk::BufferPtr indexBuffer;
-    size_t vertexCapacity = 0;
-    size_t indexCapacity = 0;
+struct PipelineSet {
+    finevk::GraphicsPipelinePtr standard;
+    finevk::GraphicsPipelinePtr compact;  // Only with GuiConfig::compactVertices
+
+    finevk::GraphicsPipeline* get(const GeometryFormat& format) const {
+        return format.compact ? compact.get() : standard.get();
+    }
 };
 
 /**
@@ -48,6 +105,7 @@ struct FrameRenderData {
 struct BackendTextureData {
     finevk::TextureRef texture;
     finevk::DescriptorSetPtr descriptorSet;
+    uint32_t bindlessSlot = 0;  // Used instead of descriptorSet in bindless mode
 };
 
 /**
@@ -57,6 +115,23 @@ struct TextureEntry {
     finevk::Texture* texture = nullptr;
     finevk::Sampler* sampler = nullptr;
     finevk::DescriptorSetPtr descriptorSet;
+    uint32_t bindlessSlot = 0;  // Used instead of descriptorSet in bindless mode
+    VkImageView view = VK_NULL_HANDLE;
+    uint32_t refCount = 1;      // Registrations sharing this entry
+    uint32_t upload = 0;        // Async upload owning the image (0 = caller-owned)
+};
+
+/// Registered textures are shared per (image view, sampler) pair
+using TextureKey = std::pair<VkImageView, VkSampler>;
+
+/**
+ * @brief Cached secondary command buffer for one frame in flight
+ */
+struct SecondarySlot {
+    finevk::CommandBufferPtr buffer;
+    uint64_t drawHash = 0;      // Commands, layout and geometry placement recorded
+    uint64_t textureEpoch = 0;  // Descriptor lifetime epoch at record time
+    bool valid = false;         // Holds a complete recording for the current data
 };
 
 /**
@@ -76,16 +151,20 @@ public:
      * @param renderPass The render pass to render into
      * @param commandPool Command pool for resource creation
      * @param subpass Subpass index
-     * @param msaaSamples MSAA sample count
+     * @param config GUI configuration (MSAA samples, texture binding mode)
      */
     void initialize(finevk::RenderPass* renderPass,
                     finevk::CommandPool* commandPool,
                     uint32_t subpass,
-                    VkSampleCountFlagBits msaaSamples);
+                    const GuiConfig& config);
 
     /**
      * @brief Register a texture for use in GUI
-     * @return Unique texture ID
+     *
+     * Registering the same view/sampler pair again returns the same ID and
+     * bumps a reference count; each registration needs one unregisterTexture().
+     *
+     * @return Texture ID
      */
     uint64_t registerTexture(finevk::Texture* texture, finevk::Sampler* sampler);
 
@@ -93,15 +172,53 @@ public:
      * @brief Register an image view for use in GUI (e.g. offscreen render result)
      * @param imageView The image view to sample from
      * @param sampler The sampler to use (uses default if null)
-     * @return Unique texture ID
+     * @return Texture ID (shared with earlier registrations of the same pair)
      */
     uint64_t registerTexture(finevk::ImageView* imageView, finevk::Sampler* sampler);
 
     /**
-     * @brief Unregister a texture
+     * @brief Register RGBA8 pixels whose upload happens in the background
+     *
+     * Returns at once; draws using the ID are skipped until updateUploads()
+     * sees the upload complete. The entry is never shared.
+     * @param sampler The sampler to use (uses default if null)
+     * @return Texture ID
+     */
+    uint64_t registerTextureAsync(const void* pixels, uint32_t width, uint32_t height,
+                                  finevk::Sampler* sampler);
+
+    /**
+     * @brief Release one registration; the descriptor is freed with the last
      */
     void unregisterTexture(uint64_t textureId);
 
+    /**
+     * @brief Make finished async uploads visible and open the next frame's
+     *        upload budget
+     *
+     * Call once per frame, after the previous frame has been submitted.
+     * The copies themselves are submitted by the next render call, on the
+     * thread that submits frames.
+     */
+    void updateUploads();
+
+    /**
+     * @brief Check whether a texture can be drawn (false while its async
+     *        upload is pending)
+     */
+    bool textureReady(uint64_t textureId) const { return pendingTextures_.count(textureId) == 0; }
+
+    /**
+     * @brief Start a frame: free the geometry the slot's previous frame used
+     *
+     * Call exactly once per frame, after the slot's fence has been waited
+     * on and before the frame's first render call (render(),
+     * renderDrawData(), renderToLayer(), compositeLayer() or
+     * recordSecondary()). Every draw of the frame keeps its geometry until
+     * the slot's next beginFrame().
+     */
+    void beginFrame(uint32_t frameIndex);
+
     /**
      * @brief Render ImGui draw data
      * @param cmd Command buffer to record into
@@ -118,6 +235,99 @@ public:
     void renderDrawData(finevk::CommandBuffer& cmd, uint32_t frameIndex,
                         const GuiDrawData& data);
 
+    /**
+     * @brief Create the pipelines for the cached GUI layer
+     * @param layerPass Render pass of the offscreen layer surfaces
+     */
+    void initializeLayer(finevk::RenderPass* layerPass);
+
+    /**
+     * @brief Render ImGui draw data into a layer surface (premultiplied alpha)
+     *
+     * Same as render(), with the layer pipelines. Never GPU-timed.
+     */
+    void renderToLayer(finevk::CommandBuffer& cmd, uint32_t frameIndex);
+
+    /**
+     * @brief Draw a layer as one textured quad covering the display
+     * @param textureId Registered texture of the layer image
+     */
+    void compositeLayer(finevk::CommandBuffer& cmd, uint32_t frameIndex, uint64_t textureId,
+                        ImVec2 displaySize, ImVec2 framebufferScale);
+
+    /**
+     * @brief Hash of everything a layer rendered from this draw data shows
+     *
+     * Covers geometry, draw commands (textures, clip rects), the display
+     * transform and texture descriptor lifetimes.
+     * @return 0 while ImGui has texture requests pending, which must be
+     *         serviced by rendering
+     */
+    uint64_t layerHash(const ImDrawData* drawData) const;
+
+    /**
+     * @brief Record captured draw data into this frame's secondary command buffer
+     *
+     * The buffer is reused untouched when the draws, geometry placement and
+     * texture descriptors match its last recording. With @p async the
+     * recording itself runs on a worker thread; @p data must stay alive and
+     * unmodified until executeSecondary() or waitForRecording().
+     *
+     * @param frameIndex Current frame-in-flight index
+     * @param data Captured draw data
+     * @param framebuffer Framebuffer for the inheritance info (may be null)
+     * @param async Record on the worker thread
+     */
+    void recordSecondary(uint32_t frameIndex, const GuiDrawData& data,
+                         VkFramebuffer framebuffer, bool async);
+
+    /**
+     * @brief Execute this frame's secondary command buffer from a primary
+     *
+     * Waits for a pending asynchronous recording. Does nothing if the last
+     * recordSecondary() for this frame had nothing to draw.
+     */
+    void executeSecondary(finevk::CommandBuffer& primary, uint32_t frameIndex);
+
+    /**
+     * @brief Block until any asynchronous recording has finished
+     */
+    void waitForRecording();
+
+    /**
+     * @brief Apply captured font atlas changes not applied yet
+     *
+     * Call before drawing the frame the requests came with; requests seen
+     * before (by sequence) are skipped.
+     */
+    void applyTextureRequests(const std::vector<TextureRequest>& requests);
+
+    /// Sequence of the last texture request applied (0 = none)
+    [[nodiscard]] uint64_t appliedTextureRequest() const { return appliedTextureRequest_; }
+
+    /**
+     * @brief Collect the frame's previous GPU time and re-arm its timestamps
+     *
+     * Record outside a render pass, before render()/renderDrawData() for
+     * the same frame. Without this call those are simply not timed.
+     */
+    void resetGpuTimer(finevk::CommandBuffer& cmd, uint32_t frameIndex);
+
+    /**
+     * @brief Check if GPU timestamps are being recorded
+     */
+    bool hasGpuTimer() const { return gpuTimer_ != nullptr; }
+
+    /**
+     * @brief Smoothed GPU time of render()/renderDrawData() per frame
+     */
+    float gpuMicros() const { return gpuMicros_; }
+
+    /**
+     * @brief Number of frames whose GPU time was collected
+     */
+    uint64_t gpuSamples() const { return gpuSamples_; }
+
     /**
      * @brief Get the pipeline layout
      */
@@ -128,42 +338,170 @@ public:
      */
     bool isInitialized() const { return initialized_; }
 
+    /**
+     * @brief Check if textures are addressed through the bindless table
+     */
+    bool isBindless() const { return bindless_ != nullptr; }
+
+    /**
+     * @brief Get rendering statistics
+     */
+    GuiRenderStats stats() const;
+
 private:
-    void createPipeline(finevk::RenderPass* renderPass, uint32_t subpass,
-                        VkSampleCountFlagBits msaaSamples);
+    void createPipelines(finevk::RenderPass* renderPass, uint32_t subpass,
+                         VkSampleCountFlagBits msaaSamples, VkPipelineCache cache);
+    PipelineSet createPipelineSet(finevk::RenderPass* renderPass, uint32_t subpass,
+                                  VkSampleCountFlagBits msaaSamples, BlendMode blend,
+                                  VkPipelineCache cache);
+    finevk::GraphicsPipelinePtr createPipeline(finevk::RenderPass* renderPass, uint32_t subpass,
+                                               VkSampleCountFlagBits msaaSamples, bool compact,
+                                               BlendMode blend, VkPipelineCache cache);
     void createDescriptorResources();
-    void ensureBufferCapacity(uint32_t frameIndex, size_t vertexCount, size_t indexCount);
+    void createBindlessResources();
+    uint64_t acquireTexture(VkImageView view, finevk::Sampler* sampler, finevk::Texture* texture);
+    void bindBindlessSet(finevk::CommandBuffer& cmd, uint32_t frameIndex);
+    void submitUploads();  // Once per frame, from whichever render call comes first
+    bool hidden(uint64_t textureId) const {
+        return !pendingTextures_.empty() && pendingTextures_.count(textureId) != 0;
+    }
+    StreamAllocation allocateGeometry(uint32_t frameIndex, size_t vertexCount, size_t indexCount,
+                                      const GeometryFormat& format, uint64_t contentHash,
+                                      bool& reused);
+    void uploadDrawLists(const ImDrawData* drawData, const StreamAllocation& geometry,
+                         const GeometryFormat& format);
+    void uploadDrawData(const GuiDrawData& data, const StreamAllocation& geometry,
+                        const GeometryFormat& format);
+    StreamAllocation prepareDrawData(uint32_t frameIndex, const GuiDrawData& data,
+                                     GeometryFormat& format, bool& descriptorsChanged);
+    void recordDrawData(finevk::CommandBuffer& cmd, uint32_t frameIndex, const GuiDrawData& data,
+                        const StreamAllocation& geometry, const GeometryFormat& format);
+    void beginSecondary(SecondarySlot& slot, VkFramebuffer framebuffer);
+    static uint64_t fingerprint(const ImDrawData* drawData, const GeometryFormat& format);
+    static uint64_t fingerprint(const GuiDrawData& data, const GeometryFormat& format);
+    void recordHashCost(std::chrono::steady_clock::time_point start, size_t vertexCount,
+                        size_t indexCount);
+    static uint64_t recordingKey(const GuiDrawData& data, const StreamAllocation& geometry,
+                                 const GeometryFormat& format, VkFramebuffer framebuffer);
     finevk::DescriptorSetPtr allocateTextureDescriptor(finevk::Texture* texture, finevk::Sampler* sampler);
     finevk::DescriptorSetPtr allocateTextureDescriptor(VkImageView view, VkSampler sampler);
 
     // ImGui 1.92+ texture lifecycle
     void updateTexture(ImTextureData* tex);
     void destroyTexture(ImTextureData* tex);
+    void uploadTextureRegions(ImTextureData* tex, BackendTextureData* backendTex);
+    uint64_t createManagedTexture(const void* pixels, int width, int height);
+    void destroyManagedTexture(uint64_t id);
+    uint8_t* reserveStaging(VkDeviceSize bytes);
+    void copyStagedRegions(BackendTextureData* backendTex, const ImTextureRect* rects,
+                           int rectCount, VkDeviceSize bytesPerPixel);
+    uint64_t resolveTexture(uint64_t id) const {
+        if (provisionalTextures_.empty()) {
+            return id;
+        }
+        auto it = provisionalTextures_.find(id);
+        return it != provisionalTextures_.end() ? it->second : id;
+    }
 
     finevk::RenderSurface* surface_ = nullptr;
     finevk::LogicalDevice* device_ = nullptr;
     finevk::CommandPool* commandPool_ = nullptr;
+    finevk::RenderPass* renderPass_ = nullptr;
+    uint32_t subpass_ = 0;
+    VkSampleCountFlagBits msaaSamples_ = VK_SAMPLE_COUNT_1_BIT;
     uint32_t framesInFlight_ = 2;
+    bool compactVertices_ = false;  // GuiConfig::compactVertices
+    bool sdfFonts_ = false;         // GuiConfig::sdfFonts
+
+    // ImGui-managed textures (font atlases), which hold distance fields
+    // with SDF fonts. Usually one; two while the atlas is being replaced.
+    std::vector<uint64_t> sdfTextures_;
     bool initialized_ = false;
 
+    // The same textures by ID; owns their BackendTextureData
+    std::unordered_map<uint64_t, BackendTextureData*> managedTextures_;
+
+    // Textures created from captured requests: provisional ID -> real ID
+    std::unordered_map<uint64_t, uint64_t> provisionalTextures_;
+    uint64_t appliedTextureRequest_ = 0;
+
     // Pipeline resources
     finevk::DescriptorSetLayoutPtr descriptorSetLayout_;
     finevk::PipelineLayoutPtr pipelineLayout_;
-    finevk::GraphicsPipelinePtr pipeline_;
+    PipelineSet pipelines_;           // Application render pass
+    PipelineSet layerPipelines_;      // Into the cached layer (GuiConfig::cachedLayer)
+    PipelineSet compositePipelines_;  // Layer quad into the application render pass
+    const PipelineSet* activePipelines_ = &pipelines_;
 
-    // Descriptor resources
-    finevk::DescriptorPoolPtr descriptorPool_;
+    // Composite quad, rebuilt in place each frame
+    GuiDrawData layerQuad_;
+    uint64_t pipelineCreateMicros_ = 0;
+    uint64_t pipelineCacheLoadedBytes_ = 0;
+
+    // Descriptor resources (per-texture sets; unused in bindless mode)
+    std::unique_ptr<DescriptorAllocator> descriptorAllocator_;
 
     // Default sampler for textures
     finevk::SamplerPtr defaultSampler_;
 
-    // Per-frame data
-    std::vector<FrameRenderData> frameData_;
+    // Bindless mode: one texture array per frame in flight (null otherwise)
+    std::unique_ptr<BindlessTextureTable> bindless_;
+    finevk::TextureRef placeholderTexture_;
+
+    // Vertex/index ring shared by all frames in flight
+    std::unique_ptr<StreamBuffer> geometryStream_;
+
+    // Most recent geometry upload, reused when the next frame is identical
+    StreamAllocation lastUpload_;
+    uint64_t lastUploadHash_ = 0;
+    uint64_t uploadsSkipped_ = 0;
+    uint64_t uploadBytesSkipped_ = 0;
+    uint64_t geometryBytesHashed_ = 0;
+    uint64_t geometryHashNanos_ = 0;
+    uint64_t compactUploads_ = 0;
 
-    // User-registered textures, keyed by VkDescriptorSet handle
+    // Reusable staging buffer for partial texture updates
+    finevk::BufferPtr stagingBuffer_;
+    VkDeviceSize stagingCapacity_ = 0;
+    uint64_t textureUploadBytes_ = 0;
+    uint64_t textureRegionUpdates_ = 0;
+
+    // Batching counters from the most recent render call
+    DrawBatchStats lastBatchStats_;
+
+    // Secondary command buffers, one per frame in flight. They come from a
+    // pool of their own so the worker never touches the caller's pool.
+    finevk::CommandPoolPtr secondaryPool_;
+    std::vector<SecondarySlot> secondaries_;
+    std::unique_ptr<RecordWorker> recordWorker_;
+    uint64_t secondaryRecords_ = 0;
+    uint64_t secondaryReuses_ = 0;
+    uint64_t secondaryExecutes_ = 0;
+
+    // Bumped whenever a texture descriptor is released, which invalidates
+    // any recorded command buffer that still binds it
+    uint64_t textureEpoch_ = 0;
+
+    // User-registered textures, keyed by VkDescriptorSet handle (or bindless slot)
     std::unordered_map<uint64_t, TextureEntry> textures_;
+    std::map<TextureKey, uint64_t> textureCache_;
+    uint64_t textureCacheHits_ = 0;
+
+    // Async uploads (created on first use). Draws of pending textures are
+    // skipped; their descriptor is only written once the image is ready.
+    std::unique_ptr<TextureUploader> uploader_;
+    uint64_t uploadBytesPerFrame_ = 0;
+    std::mutex* queueMutex_ = nullptr;  // GuiConfig::queueMutex
+    std::unordered_set<uint64_t> pendingTextures_;
+    std::unordered_map<uint32_t, uint64_t> uploadTextures_;  // Upload ID -> texture ID
+    std::vector<uint32_t> completedUploads_;
+
+    // GPU timestamps around render()/renderDrawData() (GuiConfig::gpuTiming)
+    std::unique_ptr<GpuTimer> gpuTimer_;
+    float gpuMicros_ = 0.0f;
+    uint64_t gpuSamples_ = 0;
 
-    // Shader paths
+    // Shader paths (unused when the SPIR-V is embedded)
     std::string shaderDir_;
 };
 
@@ -0,0 +1,105 @@
+/**
+ * @file null_backend.cpp
+ * @brief Renderer backend that draws nothing (headless mode)
+ */
+
+#include "null_backend.hpp"
+
+namespace finegui {
+namespace backend {
+
+NullBackend::NullBackend() {
+    ImGuiIO& io = ImGui::GetIO();
+    io.BackendFlags |= ImGuiBackendFlags_RendererHasVtxOffset;
+    io.BackendFlags |= ImGuiBackendFlags_RendererHasTextures;
+}
+
+NullBackend::~NullBackend() {
+    if (ImGui::GetCurrentContext() == nullptr) {
+        return;
+    }
+
+    for (ImTextureData* tex : ImGui::GetPlatformIO().Textures) {
+        if (tex->TexID != ImTextureID_Invalid) {
+            tex->SetTexID(ImTextureID_Invalid);
+            tex->SetStatus(ImTextureStatus_Destroyed);
+        }
+    }
+
+    ImGuiIO& io = ImGui::GetIO();
+    io.BackendFlags &= ~(ImGuiBackendFlags_RendererHasVtxOffset | ImGuiBackendFlags_RendererHasTextures);
+}
+
+void NullBackend::render(ImDrawData* drawData) {
+    if (!drawData) {
+        return;
+    }
+
+    if (drawData->Textures != nullptr) {
+        for (ImTextureData* tex : *drawData->Textures) {
+            if (tex->Status != ImTextureStatus_OK) {
+                updateTexture(tex);
+            }
+        }
+    }
+
+    // Count what the Vulkan backend would submit before batching
+    uint32_t drawCalls = 0;
+    for (int n = 0; n < drawData->CmdListsCount; n++) {
+        for (const ImDrawCmd& cmd : drawData->CmdLists[n]->CmdBuffer) {
+            if (cmd.UserCallback == nullptr && cmd.ElemCount > 0) {
+                drawCalls++;
+            }
+        }
+    }
+
+    stats_.frames++;
+    stats_.drawLists = static_cast<uint32_t>(drawData->CmdListsCount);
+    stats_.vertices = static_cast<uint32_t>(drawData->TotalVtxCount);
+    stats_.indices = static_cast<uint32_t>(drawData->TotalIdxCount);
+    stats_.drawCalls = drawCalls;
+    stats_.totalVertices += stats_.vertices;
+    stats_.totalIndices += stats_.indices;
+    stats_.totalDrawCalls += drawCalls;
+    stats_.vertexBytes += static_cast<uint64_t>(stats_.vertices) * sizeof(ImDrawVert);
+    stats_.indexBytes += static_cast<uint64_t>(stats_.indices) * sizeof(ImDrawIdx);
+}
+
+void NullBackend::updateTexture(ImTextureData* tex) {
+    if (tex->Status == ImTextureStatus_WantDestroy) {
+        tex->SetTexID(ImTextureID_Invalid);
+        tex->SetStatus(ImTextureStatus_Destroyed);
+        stats_.texturesLive--;
+        stats_.textureDestroys++;
+        return;
+    }
+
+    if (tex->Status == ImTextureStatus_WantCreate) {
+        IM_ASSERT(tex->TexID == ImTextureID_Invalid && tex->BackendUserData == nullptr);
+
+        // Any non-zero ID works; nothing ever dereferences it
+        tex->SetTexID(static_cast<ImTextureID>(nextTextureId_++));
+        stats_.texturesLive++;
+        stats_.textureCreates++;
+        stats_.textureUploadBytes +=
+            static_cast<uint64_t>(tex->Width) * tex->Height * tex->BytesPerPixel;
+    }
+    else if (tex->Status == ImTextureStatus_WantUpdates) {
+        // Same accounting as the Vulkan backend: individual rects, else their bounds
+        if (tex->Updates.Size > 0) {
+            for (const ImTextureRect& r : tex->Updates) {
+                stats_.textureUploadBytes += static_cast<uint64_t>(r.w) * r.h * tex->BytesPerPixel;
+            }
+            stats_.textureUpdates += static_cast<uint64_t>(tex->Updates.Size);
+        } else if (tex->UpdateRect.w > 0 && tex->UpdateRect.h > 0) {
+            const ImTextureRect& r = tex->UpdateRect;
+            stats_.textureUploadBytes += static_cast<uint64_t>(r.w) * r.h * tex->BytesPerPixel;
+            stats_.textureUpdates++;
+        }
+    }
+
+    tex->SetStatus(ImTextureStatus_OK);
+}
+
+} // namespace backend
+} // namespace finegui
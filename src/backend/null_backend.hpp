@@ -0,0 +1,52 @@
+#pragma once
+
+/**
+ * @file null_backend.hpp
+ * @brief Renderer backend that draws nothing (headless mode)
+ *
+ * Internal. Services ImGui's texture lifecycle without a GPU and counts what
+ * a real backend would have uploaded and drawn.
+ */
+
+#include <finegui/gui_stats.hpp>
+
+#include <imgui.h>
+
+#include <cstdint>
+
+namespace finegui {
+namespace backend {
+
+/**
+ * @brief Null ImGui renderer backend for headless GuiSystem
+ */
+class NullBackend {
+public:
+    /// Advertises texture and vertex-offset support on the current context
+    NullBackend();
+
+    /// Releases texture IDs; the owning context must be current
+    ~NullBackend();
+
+    NullBackend(const NullBackend&) = delete;
+    NullBackend& operator=(const NullBackend&) = delete;
+
+    /**
+     * @brief Consume one frame of draw data
+     *
+     * Handles pending texture requests first, so draw commands reference
+     * valid texture IDs afterwards (as they would after a real render()).
+     */
+    void render(ImDrawData* drawData);
+
+    [[nodiscard]] const HeadlessStats& stats() const { return stats_; }
+
+private:
+    void updateTexture(ImTextureData* tex);
+
+    uint64_t nextTextureId_ = 1;
+    HeadlessStats stats_;
+};
+
+} // namespace backend
+} // namespace finegui
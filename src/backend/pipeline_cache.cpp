@@ -0,0 +1,119 @@
+/**
+ * @file pipeline_cache.cpp
+ * @brief VkPipelineCache persisted to a file between runs
+ */
+
+#include "pipeline_cache.hpp"
+
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <stdexcept>
+
+namespace finegui {
+namespace backend {
+
+namespace {
+
+std::vector<char> readFile(const std::string& path) {
+    std::ifstream file(path, std::ios::binary);
+    if (!file) {
+        return {};
+    }
+    return std::vector<char>(std::istreambuf_iterator<char>(file),
+                             std::istreambuf_iterator<char>());
+}
+
+} // namespace
+
+PipelineCache::PipelineCache(finevk::LogicalDevice* device, std::string path)
+    : device_(device->handle())
+    , physical_(device->physicalDevice()->handle())
+    , path_(std::move(path))
+{
+    std::vector<char> data = readFile(path_);
+    if (compatible(data)) {
+        loaded_ = std::move(data);
+    }
+
+    VkPipelineCacheCreateInfo info{};
+    info.sType = VK_STRUCTURE_TYPE_PIPELINE_CACHE_CREATE_INFO;
+    info.initialDataSize = loaded_.size();
+    info.pInitialData = loaded_.empty() ? nullptr : loaded_.data();
+
+    if (vkCreatePipelineCache(device_, &info, nullptr, &cache_) != VK_SUCCESS) {
+        // Some drivers reject data that passed the header check; start cold
+        loaded_.clear();
+        info.initialDataSize = 0;
+        info.pInitialData = nullptr;
+        if (vkCreatePipelineCache(device_, &info, nullptr, &cache_) != VK_SUCCESS) {
+            throw std::runtime_error("PipelineCache: failed to create pipeline cache");
+        }
+    }
+    loadedBytes_ = loaded_.size();
+}
+
+PipelineCache::~PipelineCache() {
+    vkDestroyPipelineCache(device_, cache_, nullptr);
+}
+
+bool PipelineCache::compatible(const std::vector<char>& data) const {
+    // Drivers are supposed to ignore foreign data, but not all do; only pass
+    // on a cache written by this exact device and driver
+    VkPipelineCacheHeaderVersionOne header{};
+    if (data.size() < sizeof(header)) {
+        return false;
+    }
+    std::memcpy(&header, data.data(), sizeof(header));
+
+    VkPhysicalDeviceProperties props{};
+    vkGetPhysicalDeviceProperties(physical_, &props);
+
+    return header.headerSize >= sizeof(header) &&
+           header.headerVersion == VK_PIPELINE_CACHE_HEADER_VERSION_ONE &&
+           header.vendorID == props.vendorID &&
+           header.deviceID == props.deviceID &&
+           std::memcmp(header.pipelineCacheUUID, props.pipelineCacheUUID, VK_UUID_SIZE) == 0;
+}
+
+bool PipelineCache::save() {
+    size_t size = 0;
+    if (vkGetPipelineCacheData(device_, cache_, &size, nullptr) != VK_SUCCESS || size == 0) {
+        return false;
+    }
+    std::vector<char> data(size);
+    if (vkGetPipelineCacheData(device_, cache_, &size, data.data()) != VK_SUCCESS) {
+        return false;
+    }
+    data.resize(size);
+
+    // Every pipeline came from the file: nothing new to write
+    if (data == loaded_) {
+        return true;
+    }
+
+    std::string tempPath = path_ + ".tmp";
+    {
+        std::ofstream file(tempPath, std::ios::binary | std::ios::trunc);
+        if (!file.write(data.data(), static_cast<std::streamsize>(data.size()))) {
+            std::remove(tempPath.c_str());
+            return false;
+        }
+    }
+
+    if (std::rename(tempPath.c_str(), path_.c_str()) != 0) {
+        // rename() does not replace an existing file on every platform
+        std::remove(path_.c_str());
+        if (std::rename(tempPath.c_str(), path_.c_str()) != 0) {
+            std::remove(tempPath.c_str());
+            return false;
+        }
+    }
+
+    loaded_ = std::move(data);
+    return true;
+}
+
+} // namespace backend
+} // namespace finegui
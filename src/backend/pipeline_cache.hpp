@@ -0,0 +1,62 @@
+#pragma once
+
+/**
+ * @file pipeline_cache.hpp
+ * @brief VkPipelineCache persisted to a file between runs
+ *
+ * Internal to the finevk backend. A missing, unreadable or foreign cache
+ * file (different driver or GPU) just means a cold start, and a failed save
+ * is never fatal, since the cache is only an optimization.
+ */
+
+#include <finevk/finevk.hpp>
+
+#include <string>
+#include <vector>
+
+namespace finegui {
+namespace backend {
+
+/**
+ * @brief File-backed pipeline cache
+ */
+class PipelineCache {
+public:
+    /**
+     * @brief Create the cache, seeded from @p path if it holds compatible data
+     * @param device Logical device
+     * @param path Cache file (need not exist)
+     */
+    PipelineCache(finevk::LogicalDevice* device, std::string path);
+    ~PipelineCache();
+
+    PipelineCache(const PipelineCache&) = delete;
+    PipelineCache& operator=(const PipelineCache&) = delete;
+
+    /**
+     * @brief Write the cache back to its file if its contents changed
+     *
+     * Writes to a temporary file first and renames it over the old one, so
+     * an interrupted save never leaves a truncated cache behind.
+     * @return false if the file could not be written
+     */
+    bool save();
+
+    [[nodiscard]] VkPipelineCache handle() const { return cache_; }
+
+    /// Bytes of initial data accepted from the file (0 = cold start)
+    [[nodiscard]] size_t loadedBytes() const { return loadedBytes_; }
+
+private:
+    bool compatible(const std::vector<char>& data) const;
+
+    VkDevice device_ = VK_NULL_HANDLE;
+    VkPhysicalDevice physical_ = VK_NULL_HANDLE;
+    VkPipelineCache cache_ = VK_NULL_HANDLE;
+    std::string path_;
+    std::vector<char> loaded_;  // Contents of the file as last read or written
+    size_t loadedBytes_ = 0;
+};
+
+} // namespace backend
+} // namespace finegui
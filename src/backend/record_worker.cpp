@@ -0,0 +1,70 @@
+/**
+ * @file record_worker.cpp
+ * @brief Single background thread for command buffer recording
+ */
+
+#include "record_worker.hpp"
+
+namespace finegui {
+namespace backend {
+
+RecordWorker::RecordWorker()
+    : thread_(&RecordWorker::run, this)
+{
+}
+
+RecordWorker::~RecordWorker() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stop_ = true;
+    }
+    cv_.notify_all();
+    thread_.join();
+}
+
+void RecordWorker::submit(std::function<void()> job) {
+    wait();
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        job_ = std::move(job);
+        busy_ = true;
+    }
+    cv_.notify_all();
+}
+
+void RecordWorker::wait() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    cv_.wait(lock, [this] { return !busy_; });
+    if (error_) {
+        std::exception_ptr error = error_;
+        error_ = nullptr;
+        std::rethrow_exception(error);
+    }
+}
+
+void RecordWorker::run() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    for (;;) {
+        cv_.wait(lock, [this] { return busy_ || stop_; });
+        if (!busy_) {
+            return;  // stop requested with nothing pending
+        }
+
+        std::function<void()> job = std::move(job_);
+        lock.unlock();
+        std::exception_ptr error;
+        try {
+            job();
+        } catch (...) {
+            error = std::current_exception();
+        }
+        lock.lock();
+
+        error_ = error;
+        busy_ = false;
+        cv_.notify_all();
+    }
+}
+
+} // namespace backend
+} // namespace finegui
@@ -0,0 +1,57 @@
+#pragma once
+
+/**
+ * @file record_worker.hpp
+ * @brief Single background thread for command buffer recording
+ *
+ * Internal to the finevk backend. Runs at most one job at a time so GUI
+ * recording can overlap the caller's own recording on the main thread.
+ */
+
+#include <condition_variable>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+
+namespace finegui {
+namespace backend {
+
+/**
+ * @brief Persistent worker thread with a single job slot
+ */
+class RecordWorker {
+public:
+    RecordWorker();
+    ~RecordWorker();
+
+    RecordWorker(const RecordWorker&) = delete;
+    RecordWorker& operator=(const RecordWorker&) = delete;
+
+    /**
+     * @brief Run a job on the worker thread
+     *
+     * Waits for the previous job first. An exception thrown by the job is
+     * rethrown from the next wait().
+     */
+    void submit(std::function<void()> job);
+
+    /**
+     * @brief Block until the current job (if any) has finished
+     */
+    void wait();
+
+private:
+    void run();
+
+    std::mutex mutex_;
+    std::condition_variable cv_;
+    std::function<void()> job_;
+    bool busy_ = false;
+    bool stop_ = false;
+    std::exception_ptr error_;
+    std::thread thread_;
+};
+
+} // namespace backend
+} // namespace finegui
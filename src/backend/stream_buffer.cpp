@@ -0,0 +1,211 @@
+/**
+ * @file stream_buffer.cpp
+ * @brief Persistently mapped ring buffer for per-frame geometry streaming
+ */
+
+#include "stream_buffer.hpp"
+
+#include <algorithm>
+#include <stdexcept>
+
+namespace finegui {
+namespace backend {
+
+namespace {
+
+// Per-frame decay of the high-water mark (~halves every 140 frames)
+constexpr double kHighWaterDecay = 0.995;
+
+// Trim when the ring is this many times larger than the high-water mark
+constexpr double kTrimRatio = 4.0;
+
+VkDeviceSize alignUp(VkDeviceSize value, VkDeviceSize alignment) {
+    return (value + alignment - 1) / alignment * alignment;
+}
+
+VkDeviceSize roundUpPow2(VkDeviceSize value) {
+    VkDeviceSize result = 1;
+    while (result < value) {
+        result <<= 1;
+    }
+    return result;
+}
+
+} // namespace
+
+StreamBuffer::StreamBuffer(finevk::LogicalDevice* device,
+                           VkBufferUsageFlags usage,
+                           VkDeviceSize alignment,
+                           uint32_t framesInFlight,
+                           VkDeviceSize minCapacity)
+    : device_(device)
+    , usage_(usage)
+    , alignment_(alignment > 0 ? alignment : 1)
+    , framesInFlight_(framesInFlight > 0 ? framesInFlight : 1)
+    , minCapacity_(alignUp(minCapacity, alignment_))
+{
+    if (!device_) {
+        throw std::runtime_error("StreamBuffer: device cannot be null");
+    }
+    if (framesInFlight_ > 64) {
+        throw std::runtime_error("StreamBuffer: at most 64 frames in flight supported");
+    }
+
+    replaceBuffer(minCapacity_);
+}
+
+void StreamBuffer::beginFrame(uint32_t frameIndex) {
+    retire(frameIndex);
+    releaseRetiredBuffers(frameIndex);
+
+    // Trim toward the decaying high-water mark
+    highWater_ *= kHighWaterDecay;
+    if (capacity_ > minCapacity_ &&
+        static_cast<double>(capacity_) > highWater_ * kTrimRatio) {
+        VkDeviceSize target = std::max(
+            minCapacity_,
+            alignUp(roundUpPow2(static_cast<VkDeviceSize>(highWater_ * 2.0)), alignment_));
+        if (target < capacity_) {
+            replaceBuffer(target);
+        }
+    }
+}
+
+bool StreamBuffer::renewLast(uint32_t frameIndex, const StreamAllocation& alloc) {
+    if (!alloc.valid() || alloc.generation != reallocations_ || spans_.empty() ||
+        spans_.back().begin != alloc.offset ||
+        spans_.back().end != alloc.offset + alloc.size) {
+        return false;
+    }
+
+    spans_.back().frameIndex = frameIndex;
+    return true;
+}
+
+void StreamBuffer::retire(uint32_t frameIndex) {
+    // Retire this slot's previous allocations. Frames complete in submission
+    // order, so anything allocated before the slot's last span is done too.
+    auto last = std::find_if(spans_.rbegin(), spans_.rend(),
+        [frameIndex](const Span& s) { return s.frameIndex == frameIndex; });
+    if (last != spans_.rend()) {
+        auto end = last.base();
+        for (auto it = spans_.begin(); it != end; ++it) {
+            used_ -= it->end - it->begin;
+        }
+        spans_.erase(spans_.begin(), end);
+    }
+
+    if (spans_.empty()) {
+        head_ = 0;
+        tail_ = 0;
+    } else {
+        tail_ = spans_.front().begin;
+    }
+}
+
+void StreamBuffer::releaseRetiredBuffers(uint32_t frameIndex) {
+    // Release replaced buffers once no in-flight frame can read them
+    uint64_t bit = uint64_t{1} << frameIndex;
+    for (auto& r : retired_) {
+        r.pendingSlots &= ~bit;
+    }
+    retired_.erase(std::remove_if(retired_.begin(), retired_.end(),
+                       [](const RetiredBuffer& r) { return r.pendingSlots == 0; }),
+                   retired_.end());
+}
+
+StreamAllocation StreamBuffer::allocate(uint32_t frameIndex, VkDeviceSize size) {
+    StreamAllocation alloc;
+    if (size == 0) {
+        return alloc;
+    }
+
+    VkDeviceSize offset = 0;
+    if (!tryAllocate(size, offset)) {
+        // Grow geometrically; leave room for every frame in flight at this size
+        VkDeviceSize newCapacity = std::max(capacity_ * 2, minCapacity_);
+        while (newCapacity < size * framesInFlight_) {
+            newCapacity *= 2;
+        }
+        replaceBuffer(alignUp(newCapacity, alignment_));
+
+        if (!tryAllocate(size, offset)) {
+            throw std::runtime_error("StreamBuffer::allocate: allocation failed after growth");
+        }
+    }
+
+    spans_.push_back(Span{frameIndex, offset, offset + size});
+    used_ += size;
+    highWater_ = std::max(highWater_, static_cast<double>(used_));
+
+    alloc.data = static_cast<uint8_t*>(buffer_->mappedPtr()) + offset;
+    alloc.offset = offset;
+    alloc.size = size;
+    alloc.generation = reallocations_;
+    return alloc;
+}
+
+bool StreamBuffer::tryAllocate(VkDeviceSize size, VkDeviceSize& offset) {
+    if (spans_.empty()) {
+        head_ = 0;
+        tail_ = 0;
+    }
+
+    VkDeviceSize start = alignUp(head_, alignment_);
+
+    if (spans_.empty() || head_ >= tail_) {
+        // Free space is [head, capacity) followed by [0, tail)
+        if (start + size <= capacity_) {
+            offset = start;
+            head_ = start + size;
+            return true;
+        }
+        if (!spans_.empty() && size < tail_) {
+            offset = 0;
+            head_ = size;
+            return true;
+        }
+        return false;
+    }
+
+    // Wrapped: free space is [head, tail)
+    if (start + size < tail_) {
+        offset = start;
+        head_ = start + size;
+        return true;
+    }
+    return false;
+}
+
+void StreamBuffer::replaceBuffer(VkDeviceSize newCapacity) {
+    if (buffer_) {
+        uint64_t pending = liveSlotMask();
+        if (pending != 0) {
+            retired_.push_back(RetiredBuffer{std::move(buffer_), pending});
+        }
+        reallocations_++;
+    }
+
+    buffer_ = finevk::Buffer::create(device_)
+        .size(newCapacity)
+        .usage(usage_)
+        .memoryUsage(finevk::MemoryUsage::CpuToGpu)
+        .build();
+
+    capacity_ = newCapacity;
+    head_ = 0;
+    tail_ = 0;
+    used_ = 0;
+    spans_.clear();
+}
+
+uint64_t StreamBuffer::liveSlotMask() const {
+    uint64_t mask = 0;
+    for (const auto& s : spans_) {
+        mask |= uint64_t{1} << s.frameIndex;
+    }
+    return mask;
+}
+
+} // namespace backend
+} // namespace finegui
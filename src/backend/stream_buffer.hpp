@@ -0,0 +1,158 @@
+#pragma once
+
+/**
+ * @file stream_buffer.hpp
+ * @brief Persistently mapped ring buffer for per-frame geometry streaming
+ *
+ * Internal to the finevk backend. One buffer is shared by all frames in
+ * flight; each render call sub-allocates a contiguous region for its
+ * vertices and indices. A region is retired when its frame slot comes
+ * around again (the caller has waited on that slot's fence by then).
+ *
+ * Usage is per frame, not per render call: beginFrame() exactly once when
+ * a frame slot is reused, then any number of allocate() / renewLast()
+ * calls for that slot until the next frame begins. A frame that draws
+ * several times (a layer pass plus its composite, a secondary plus a
+ * primary draw, ...) keeps every region it allocated until the slot's
+ * next beginFrame().
+ */
+
+#include <finevk/finevk.hpp>
+
+#include <cstdint>
+#include <deque>
+#include <vector>
+
+namespace finegui {
+namespace backend {
+
+/**
+ * @brief A region sub-allocated from a StreamBuffer
+ */
+struct StreamAllocation {
+    void* data = nullptr;       ///< Mapped CPU pointer to the start of the region
+    VkDeviceSize offset = 0;    ///< Byte offset of the region within the buffer
+    VkDeviceSize size = 0;      ///< Size of the region in bytes
+    uint64_t generation = 0;    ///< Buffer the region lives in (see StreamBuffer::reallocations())
+
+    [[nodiscard]] bool valid() const { return data != nullptr; }
+};
+
+/**
+ * @brief Ring allocator over one persistently mapped buffer
+ *
+ * Grows geometrically when a request does not fit, and trims back toward a
+ * decaying high-water mark once the ring has been oversized for a while.
+ * Replaced buffers are kept alive until every frame slot that still
+ * referenced them has been retired.
+ */
+class StreamBuffer {
+public:
+    /**
+     * @param device Logical device to allocate from
+     * @param usage Buffer usage flags (e.g. VERTEX | INDEX)
+     * @param alignment Every allocation offset is a multiple of this (need not be a power of two)
+     * @param framesInFlight Number of frame slots sharing the ring
+     * @param minCapacity Initial capacity, and the floor when trimming
+     */
+    StreamBuffer(finevk::LogicalDevice* device,
+                 VkBufferUsageFlags usage,
+                 VkDeviceSize alignment,
+                 uint32_t framesInFlight,
+                 VkDeviceSize minCapacity);
+
+    StreamBuffer(const StreamBuffer&) = delete;
+    StreamBuffer& operator=(const StreamBuffer&) = delete;
+
+    /**
+     * @brief Start a frame: retire everything its slot allocated last time
+     *
+     * Call exactly once per frame, after waiting on the slot's fence and
+     * before the frame's first allocate() or renewLast(); never between
+     * two draws of the same frame, whose earlier regions and buffer the
+     * command buffer still references. Also decays the high-water mark and
+     * trims the ring if it has been far larger than needed.
+     */
+    void beginFrame(uint32_t frameIndex);
+
+    /**
+     * @brief Sub-allocate a region for the current frame of a slot
+     *
+     * May be called any number of times per frame. Grows the ring if
+     * needed; a grown ring starts empty, so the returned region always
+     * lives in the current buffer() (the old one is kept until every slot
+     * that used it has begun a new frame).
+     */
+    StreamAllocation allocate(uint32_t frameIndex, VkDeviceSize size);
+
+    /**
+     * @brief Hand the most recent allocation over to a frame slot
+     *
+     * Alternative to allocate() when the current frame would upload exactly
+     * what the most recent allocation already holds. That region is then
+     * owned by @p frameIndex (the newest frame, so retirement order is
+     * preserved). Retires nothing; call after the frame's beginFrame().
+     *
+     * @param frameIndex Slot of the frame being recorded
+     * @param alloc The allocation to keep; must be the most recent one
+     * @return false, with no effect, if @p alloc is no longer the most
+     *         recent live allocation in the current buffer
+     */
+    bool renewLast(uint32_t frameIndex, const StreamAllocation& alloc);
+
+    /// Buffer backing the most recent allocation
+    [[nodiscard]] finevk::Buffer* buffer() const { return buffer_.get(); }
+
+    /// Current ring size in bytes
+    [[nodiscard]] VkDeviceSize capacity() const { return capacity_; }
+
+    /// Bytes held by allocations that have not been retired yet
+    [[nodiscard]] VkDeviceSize used() const { return used_; }
+
+    /// Decaying high-water mark of used() in bytes
+    [[nodiscard]] VkDeviceSize highWaterMark() const {
+        return static_cast<VkDeviceSize>(highWater_);
+    }
+
+    /// Number of times the ring was grown or trimmed
+    [[nodiscard]] uint64_t reallocations() const { return reallocations_; }
+
+private:
+    struct Span {
+        uint32_t frameIndex;
+        VkDeviceSize begin;
+        VkDeviceSize end;
+    };
+
+    struct RetiredBuffer {
+        finevk::BufferPtr buffer;
+        uint64_t pendingSlots;  // bit per frame slot that may still read it
+    };
+
+    void retire(uint32_t frameIndex);
+    void releaseRetiredBuffers(uint32_t frameIndex);
+    bool tryAllocate(VkDeviceSize size, VkDeviceSize& offset);
+    void replaceBuffer(VkDeviceSize newCapacity);
+    uint64_t liveSlotMask() const;
+
+    finevk::LogicalDevice* device_ = nullptr;
+    VkBufferUsageFlags usage_ = 0;
+    VkDeviceSize alignment_ = 1;
+    uint32_t framesInFlight_ = 2;
+    VkDeviceSize minCapacity_ = 0;
+
+    finevk::BufferPtr buffer_;
+    VkDeviceSize capacity_ = 0;
+    VkDeviceSize head_ = 0;
+    VkDeviceSize tail_ = 0;
+    VkDeviceSize used_ = 0;
+    std::deque<Span> spans_;  // in allocation order
+
+    double highWater_ = 0.0;
+    uint64_t reallocations_ = 0;
+
+    std::vector<RetiredBuffer> retired_;
+};
+
+} // namespace backend
+} // namespace finegui
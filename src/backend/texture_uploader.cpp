@@ -0,0 +1,480 @@
+/**
+ * @file texture_uploader.cpp
+ * @brief Background texture uploads throttled by a per-frame byte budget
+ */
+
+#include "texture_uploader.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstring>
+#include <stdexcept>
+
+namespace finegui {
+namespace backend {
+
+namespace {
+
+// Size of the device memory blocks images are bound into (larger images
+// get a block of their own)
+constexpr VkDeviceSize kImageBlockSize = 16 * 1024 * 1024;
+
+// Smallest staging buffer created, so small batches share one
+constexpr VkDeviceSize kMinStagingSize = 256 * 1024;
+
+// Finished batches' resources kept for reuse
+constexpr size_t kMaxSpares = 4;
+
+VkDeviceSize alignUp(VkDeviceSize value, VkDeviceSize alignment) {
+    return (value + alignment - 1) / alignment * alignment;
+}
+
+} // namespace
+
+TextureUploader::TextureUploader(finevk::LogicalDevice* device, uint64_t bytesPerFrame,
+                                 std::mutex* queueMutex)
+    : owner_(device)
+    , device_(device->handle())
+    , physical_(device->physicalDevice()->handle())
+    , queue_(device->graphicsQueue()->handle())
+    , queueMutex_(queueMutex)
+    , bytesPerFrame_(bytesPerFrame)
+{
+    pool_ = finevk::CommandPool::create(device, device->graphicsQueue(),
+                                        finevk::CommandPoolFlags::Resettable);
+}
+
+TextureUploader::~TextureUploader() {
+    for (Batch& batch : inFlight_) {
+        vkWaitForFences(device_, 1, &batch.fence, VK_TRUE, UINT64_MAX);
+        vkDestroyFence(device_, batch.fence, nullptr);
+    }
+    inFlight_.clear();
+    spareCommands_.clear();
+
+    // The owner has waited for the device, so retired images are idle too
+    for (auto& [id, upload] : uploads_) {
+        destroyImage(upload);
+    }
+    for (auto& block : blocks_) {
+        vkFreeMemory(device_, block->memory, nullptr);
+    }
+}
+
+uint32_t TextureUploader::enqueue(const void* pixels, uint32_t width, uint32_t height) {
+    if (!pixels || width == 0 || height == 0) {
+        throw std::runtime_error("TextureUploader::enqueue: pixels and a non-empty size required");
+    }
+
+    Upload upload;
+    upload.width = width;
+    upload.height = height;
+
+    VkImageCreateInfo imageInfo{};
+    imageInfo.sType = VK_STRUCTURE_TYPE_IMAGE_CREATE_INFO;
+    imageInfo.imageType = VK_IMAGE_TYPE_2D;
+    imageInfo.format = VK_FORMAT_R8G8B8A8_UNORM;
+    imageInfo.extent = {width, height, 1};
+    imageInfo.mipLevels = 1;
+    imageInfo.arrayLayers = 1;
+    imageInfo.samples = VK_SAMPLE_COUNT_1_BIT;
+    imageInfo.tiling = VK_IMAGE_TILING_OPTIMAL;
+    imageInfo.usage = VK_IMAGE_USAGE_TRANSFER_DST_BIT | VK_IMAGE_USAGE_SAMPLED_BIT;
+    imageInfo.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
+    imageInfo.initialLayout = VK_IMAGE_LAYOUT_UNDEFINED;
+    if (vkCreateImage(device_, &imageInfo, nullptr, &upload.image) != VK_SUCCESS) {
+        throw std::runtime_error("TextureUploader::enqueue: failed to create image");
+    }
+
+    try {
+        bindMemory(upload);
+    } catch (...) {
+        vkDestroyImage(device_, upload.image, nullptr);
+        throw;
+    }
+
+    VkImageViewCreateInfo viewInfo{};
+    viewInfo.sType = VK_STRUCTURE_TYPE_IMAGE_VIEW_CREATE_INFO;
+    viewInfo.image = upload.image;
+    viewInfo.viewType = VK_IMAGE_VIEW_TYPE_2D;
+    viewInfo.format = imageInfo.format;
+    viewInfo.subresourceRange.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+    viewInfo.subresourceRange.levelCount = 1;
+    viewInfo.subresourceRange.layerCount = 1;
+    if (vkCreateImageView(device_, &viewInfo, nullptr, &upload.view) != VK_SUCCESS) {
+        destroyImage(upload);
+        throw std::runtime_error("TextureUploader::enqueue: failed to create image view");
+    }
+
+    // The caller's pixels may be gone by the time the copy is submitted
+    const auto* bytes = static_cast<const uint8_t*>(pixels);
+    upload.pixels.assign(bytes, bytes + static_cast<size_t>(width) * height * 4);
+
+    uint32_t id = nextId_++;
+    uploads_.emplace(id, std::move(upload));
+    queued_.push_back(id);
+    pending_++;
+    return id;
+}
+
+VkImageView TextureUploader::view(uint32_t id) const {
+    auto it = uploads_.find(id);
+    return it != uploads_.end() ? it->second.view : VK_NULL_HANDLE;
+}
+
+void TextureUploader::collect(std::vector<uint32_t>& completed) {
+    // Batches finish in submission order, but a fence is cheap to query
+    for (size_t i = 0; i < inFlight_.size();) {
+        if (vkGetFenceStatus(device_, inFlight_[i].fence) == VK_SUCCESS) {
+            finish(inFlight_[i], completed);
+            inFlight_.erase(inFlight_.begin() + static_cast<std::ptrdiff_t>(i));
+        } else {
+            i++;
+        }
+    }
+    submittedThisFrame_ = false;
+}
+
+void TextureUploader::release(uint32_t id) {
+    auto it = uploads_.find(id);
+    if (it == uploads_.end()) {
+        return;
+    }
+
+    Upload& upload = it->second;
+    switch (upload.state) {
+    case State::Queued:
+        // Never submitted: nothing on the GPU refers to it
+        for (auto q = queued_.begin(); q != queued_.end(); ++q) {
+            if (*q == id) {
+                queued_.erase(q);
+                break;
+            }
+        }
+        destroyImage(upload);
+        uploads_.erase(it);
+        pending_--;
+        break;
+    case State::InFlight:
+        upload.released = true;
+        break;
+    case State::Ready:
+        retiring_.push_back(id);
+        break;
+    }
+}
+
+void TextureUploader::submit() {
+    if (submittedThisFrame_) {
+        return;
+    }
+    submittedThisFrame_ = true;
+
+    Batch batch;
+    batch.retired = std::move(retireNext_);
+    retireNext_ = std::move(retiring_);
+    retiring_.clear();
+
+    VkDeviceSize totalBytes = 0;
+    while (!queued_.empty()) {
+        const Upload& upload = uploads_.at(queued_.front());
+        VkDeviceSize bytes = upload.pixels.size();
+        if (!batch.uploads.empty() && totalBytes + bytes > bytesPerFrame_) {
+            break;
+        }
+        batch.uploads.push_back(queued_.front());
+        queued_.pop_front();
+        totalBytes += bytes;
+    }
+
+    if (batch.uploads.empty() && batch.retired.empty()) {
+        return;
+    }
+
+    VkFenceCreateInfo fenceInfo{};
+    fenceInfo.sType = VK_STRUCTURE_TYPE_FENCE_CREATE_INFO;
+    if (vkCreateFence(device_, &fenceInfo, nullptr, &batch.fence) != VK_SUCCESS) {
+        throw std::runtime_error("TextureUploader::submit: failed to create fence");
+    }
+
+    VkSubmitInfo submitInfo{};
+    submitInfo.sType = VK_STRUCTURE_TYPE_SUBMIT_INFO;
+    VkCommandBuffer cmd = VK_NULL_HANDLE;
+
+    if (!batch.uploads.empty()) {
+        batch.staging = acquireStaging(totalBytes);
+        auto* mapped = static_cast<uint8_t*>(batch.staging.buffer->mappedPtr());
+
+        if (!spareCommands_.empty()) {
+            batch.cmd = std::move(spareCommands_.back());
+            spareCommands_.pop_back();
+            vkResetCommandBuffer(batch.cmd->handle(), 0);
+        } else {
+            batch.cmd = pool_->allocate(VK_COMMAND_BUFFER_LEVEL_PRIMARY);
+        }
+        cmd = batch.cmd->handle();
+
+        VkCommandBufferBeginInfo beginInfo{};
+        beginInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
+        beginInfo.flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT;
+        if (vkBeginCommandBuffer(cmd, &beginInfo) != VK_SUCCESS) {
+            recycle(batch);
+            throw std::runtime_error("TextureUploader::submit: failed to begin command buffer");
+        }
+
+        VkImageMemoryBarrier barrier{};
+        barrier.sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
+        barrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+        barrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+        barrier.subresourceRange.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+        barrier.subresourceRange.levelCount = 1;
+        barrier.subresourceRange.layerCount = 1;
+
+        VkDeviceSize offset = 0;
+        for (uint32_t id : batch.uploads) {
+            Upload& upload = uploads_.at(id);
+            std::memcpy(mapped + offset, upload.pixels.data(), upload.pixels.size());
+
+            barrier.image = upload.image;
+            barrier.oldLayout = VK_IMAGE_LAYOUT_UNDEFINED;
+            barrier.newLayout = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL;
+            barrier.srcAccessMask = 0;
+            barrier.dstAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+            vkCmdPipelineBarrier(cmd,
+                                 VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT,
+                                 VK_PIPELINE_STAGE_TRANSFER_BIT,
+                                 0, 0, nullptr, 0, nullptr, 1, &barrier);
+
+            VkBufferImageCopy region{};
+            region.bufferOffset = offset;
+            region.imageSubresource.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+            region.imageSubresource.layerCount = 1;
+            region.imageExtent = {upload.width, upload.height, 1};
+            vkCmdCopyBufferToImage(cmd, batch.staging.buffer->handle(), upload.image,
+                                   VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, 1, &region);
+
+            barrier.oldLayout = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL;
+            barrier.newLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
+            barrier.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+            barrier.dstAccessMask = VK_ACCESS_SHADER_READ_BIT;
+            vkCmdPipelineBarrier(cmd,
+                                 VK_PIPELINE_STAGE_TRANSFER_BIT,
+                                 VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT,
+                                 0, 0, nullptr, 0, nullptr, 1, &barrier);
+
+            offset += upload.pixels.size();
+            upload.pixels.clear();
+            upload.pixels.shrink_to_fit();
+            upload.state = State::InFlight;
+        }
+
+        if (vkEndCommandBuffer(cmd) != VK_SUCCESS) {
+            recycle(batch);
+            throw std::runtime_error("TextureUploader::submit: failed to end command buffer");
+        }
+
+        submitInfo.commandBufferCount = 1;
+        submitInfo.pCommandBuffers = &cmd;
+        submittedBytes_ += totalBytes;
+    }
+
+    // A batch without copies still signals once earlier frames are done
+    VkResult result;
+    if (queueMutex_) {
+        std::lock_guard<std::mutex> lock(*queueMutex_);
+        result = vkQueueSubmit(queue_, 1, &submitInfo, batch.fence);
+    } else {
+        result = vkQueueSubmit(queue_, 1, &submitInfo, batch.fence);
+    }
+    if (result != VK_SUCCESS) {
+        recycle(batch);
+        throw std::runtime_error("TextureUploader::submit: failed to submit uploads");
+    }
+    inFlight_.push_back(std::move(batch));
+}
+
+void TextureUploader::finish(Batch& batch, std::vector<uint32_t>& completed) {
+    for (uint32_t id : batch.uploads) {
+        auto it = uploads_.find(id);
+        pending_--;
+        completedUploads_++;
+        if (it->second.released) {
+            destroyImage(it->second);
+            uploads_.erase(it);
+        } else {
+            it->second.state = State::Ready;
+            completed.push_back(id);
+        }
+    }
+
+    for (uint32_t id : batch.retired) {
+        auto it = uploads_.find(id);
+        destroyImage(it->second);
+        uploads_.erase(it);
+    }
+
+    recycle(batch);
+}
+
+void TextureUploader::recycle(Batch& batch) {
+    vkDestroyFence(device_, batch.fence, nullptr);
+    if (batch.staging.buffer && spareStaging_.size() < kMaxSpares) {
+        spareStaging_.push_back(std::move(batch.staging));
+    }
+    if (batch.cmd && spareCommands_.size() < kMaxSpares) {
+        spareCommands_.push_back(std::move(batch.cmd));
+    }
+    batch = Batch{};
+}
+
+void TextureUploader::destroyImage(Upload& upload) {
+    vkDestroyImageView(device_, upload.view, nullptr);
+    vkDestroyImage(device_, upload.image, nullptr);
+    freeMemory(upload);
+    upload.view = VK_NULL_HANDLE;
+    upload.image = VK_NULL_HANDLE;
+}
+
+void TextureUploader::bindMemory(Upload& upload) {
+    VkMemoryRequirements requirements;
+    vkGetImageMemoryRequirements(device_, upload.image, &requirements);
+    uint32_t memoryType = findMemoryType(requirements.memoryTypeBits,
+                                         VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT);
+
+    // First fit in an existing block of the right type. Every block only
+    // holds optimal-tiling images, so bufferImageGranularity never applies.
+    MemoryBlock* block = nullptr;
+    VkDeviceSize offset = 0;
+    for (auto& candidate : blocks_) {
+        if (candidate->memoryType != memoryType) {
+            continue;
+        }
+        for (size_t i = 0; i < candidate->free.size(); i++) {
+            Range& range = candidate->free[i];
+            VkDeviceSize start = alignUp(range.offset, requirements.alignment);
+            if (start + requirements.size > range.offset + range.size) {
+                continue;
+            }
+
+            // Split the free range around the allocation
+            Range before{range.offset, start - range.offset};
+            Range after{start + requirements.size,
+                        range.offset + range.size - (start + requirements.size)};
+            candidate->free.erase(candidate->free.begin() + static_cast<std::ptrdiff_t>(i));
+            if (after.size > 0) {
+                candidate->free.insert(candidate->free.begin() + static_cast<std::ptrdiff_t>(i), after);
+            }
+            if (before.size > 0) {
+                candidate->free.insert(candidate->free.begin() + static_cast<std::ptrdiff_t>(i), before);
+            }
+            block = candidate.get();
+            offset = start;
+            break;
+        }
+        if (block) {
+            break;
+        }
+    }
+
+    if (!block) {
+        auto fresh = std::make_unique<MemoryBlock>();
+        fresh->size = std::max(kImageBlockSize, requirements.size);
+        fresh->memoryType = memoryType;
+
+        VkMemoryAllocateInfo info{};
+        info.sType = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO;
+        info.allocationSize = fresh->size;
+        info.memoryTypeIndex = memoryType;
+        if (vkAllocateMemory(device_, &info, nullptr, &fresh->memory) != VK_SUCCESS) {
+            throw std::runtime_error("TextureUploader: failed to allocate memory");
+        }
+        if (fresh->size > requirements.size) {
+            fresh->free.push_back(Range{requirements.size, fresh->size - requirements.size});
+        }
+        block = fresh.get();
+        offset = 0;
+        blocks_.push_back(std::move(fresh));
+    }
+
+    vkBindImageMemory(device_, upload.image, block->memory, offset);
+    upload.block = block;
+    upload.range = Range{offset, requirements.size};
+    block->images++;
+}
+
+void TextureUploader::freeMemory(Upload& upload) {
+    MemoryBlock* block = upload.block;
+    if (!block) {
+        return;
+    }
+    upload.block = nullptr;
+
+    if (--block->images == 0) {
+        // Keep one empty block around for the next icons
+        size_t emptyBlocks = 0;
+        for (const auto& b : blocks_) {
+            emptyBlocks += b->images == 0 ? 1 : 0;
+        }
+        if (emptyBlocks > 1) {
+            vkFreeMemory(device_, block->memory, nullptr);
+            blocks_.erase(std::find_if(blocks_.begin(), blocks_.end(),
+                [block](const std::unique_ptr<MemoryBlock>& b) { return b.get() == block; }));
+            return;
+        }
+        block->free.assign(1, Range{0, block->size});
+        return;
+    }
+
+    // Insert the range back in offset order, merging with its neighbours
+    auto& free = block->free;
+    auto next = std::lower_bound(free.begin(), free.end(), upload.range.offset,
+        [](const Range& r, VkDeviceSize offset) { return r.offset < offset; });
+    auto it = free.insert(next, upload.range);
+    if (it + 1 != free.end() && it->offset + it->size == (it + 1)->offset) {
+        it->size += (it + 1)->size;
+        free.erase(it + 1);
+    }
+    if (it != free.begin() && (it - 1)->offset + (it - 1)->size == it->offset) {
+        (it - 1)->size += it->size;
+        free.erase(it);
+    }
+}
+
+TextureUploader::Staging TextureUploader::acquireStaging(VkDeviceSize bytes) {
+    // Smallest spare buffer that fits
+    auto best = spareStaging_.end();
+    for (auto it = spareStaging_.begin(); it != spareStaging_.end(); ++it) {
+        if (it->size >= bytes && (best == spareStaging_.end() || it->size < best->size)) {
+            best = it;
+        }
+    }
+    if (best != spareStaging_.end()) {
+        Staging staging = std::move(*best);
+        spareStaging_.erase(best);
+        return staging;
+    }
+
+    Staging staging;
+    staging.size = std::max(bytes, kMinStagingSize);
+    staging.buffer = finevk::Buffer::create(owner_)
+        .size(staging.size)
+        .usage(VK_BUFFER_USAGE_TRANSFER_SRC_BIT)
+        .memoryUsage(finevk::MemoryUsage::CpuToGpu)
+        .build();
+    return staging;
+}
+
+uint32_t TextureUploader::findMemoryType(uint32_t typeBits, VkMemoryPropertyFlags flags) const {
+    VkPhysicalDeviceMemoryProperties props;
+    vkGetPhysicalDeviceMemoryProperties(physical_, &props);
+
+    for (uint32_t i = 0; i < props.memoryTypeCount; i++) {
+        if ((typeBits & (1u << i)) && (props.memoryTypes[i].propertyFlags & flags) == flags) {
+            return i;
+        }
+    }
+    throw std::runtime_error("TextureUploader: no suitable memory type");
+}
+
+} // namespace backend
+} // namespace finegui
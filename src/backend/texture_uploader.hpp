@@ -0,0 +1,186 @@
+#pragma once
+
+/**
+ * @file texture_uploader.hpp
+ * @brief Background texture uploads throttled by a per-frame byte budget
+ *
+ * Internal to the finevk backend. enqueue() only copies the pixels and
+ * creates the image, so registering many textures never waits on the GPU.
+ * Images are bound to ranges of a few large device memory blocks rather
+ * than one allocation each, so hundreds of icons stay far below the
+ * device's maxMemoryAllocationCount.
+ *
+ * collect() (once per frame) reports the uploads whose fence has signaled.
+ * submit() sends queued copies up to the byte budget from a finevk command
+ * pool of its own, each batch with a fence; the backend calls it from its
+ * render entry points, i.e. on the thread that submits frames, holding
+ * GuiConfig::queueMutex when one is set.
+ *
+ * Copies go to the graphics queue, which is the only queue the device is
+ * guaranteed to have created; the barrier after each copy makes the image
+ * visible to fragment shaders of later submissions on that queue.
+ */
+
+#include <finevk/finevk.hpp>
+
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+namespace finegui {
+namespace backend {
+
+/**
+ * @brief Owner of asynchronously uploaded RGBA8 images
+ *
+ * Upload IDs are never 0. Images live until release(); one that the GPU
+ * may still sample is destroyed once a fence submitted after the next
+ * frame has signaled, which assumes each frame is submitted before the
+ * following submit().
+ */
+class TextureUploader {
+public:
+    /**
+     * @brief Create the command pool
+     * @param device Logical device
+     * @param bytesPerFrame Pixel bytes submitted per submit() (at least one
+     *        upload is always submitted, however large)
+     * @param queueMutex Held around vkQueueSubmit (may be null)
+     */
+    TextureUploader(finevk::LogicalDevice* device, uint64_t bytesPerFrame,
+                    std::mutex* queueMutex);
+    ~TextureUploader();
+
+    TextureUploader(const TextureUploader&) = delete;
+    TextureUploader& operator=(const TextureUploader&) = delete;
+
+    /**
+     * @brief Copy RGBA8 pixels and create their (still empty) image
+     * @return Upload ID
+     */
+    uint32_t enqueue(const void* pixels, uint32_t width, uint32_t height);
+
+    /// Image view of an upload (only sampled once it has completed)
+    [[nodiscard]] VkImageView view(uint32_t id) const;
+
+    /**
+     * @brief Collect finished batches and start a new frame's budget
+     * @param completed Receives uploads that finished since the last call
+     */
+    void collect(std::vector<uint32_t>& completed);
+
+    /**
+     * @brief Submit queued copies, once per collect()
+     *
+     * Call on the thread that submits frames to the graphics queue.
+     */
+    void submit();
+
+    /// Destroy an upload's image once nothing can use it any more
+    void release(uint32_t id);
+
+    /// Uploads queued or in flight
+    [[nodiscard]] uint32_t pending() const { return pending_; }
+
+    /// Pixel bytes submitted so far
+    [[nodiscard]] uint64_t submittedBytes() const { return submittedBytes_; }
+
+    /// Uploads completed so far
+    [[nodiscard]] uint64_t completedUploads() const { return completedUploads_; }
+
+    /// Device memory allocations held for images
+    [[nodiscard]] uint32_t memoryBlocks() const { return static_cast<uint32_t>(blocks_.size()); }
+
+private:
+    enum class State : uint8_t {
+        Queued,    // Pixels held on the CPU
+        InFlight,  // Copy submitted
+        Ready      // Copy finished
+    };
+
+    // A range of a memory block
+    struct Range {
+        VkDeviceSize offset = 0;
+        VkDeviceSize size = 0;
+    };
+
+    // One device-local allocation that images are bound into
+    struct MemoryBlock {
+        VkDeviceMemory memory = VK_NULL_HANDLE;
+        VkDeviceSize size = 0;
+        uint32_t memoryType = 0;
+        std::vector<Range> free;  // Sorted by offset, never adjacent
+        uint32_t images = 0;
+    };
+
+    struct Upload {
+        VkImage image = VK_NULL_HANDLE;
+        VkImageView view = VK_NULL_HANDLE;
+        MemoryBlock* block = nullptr;
+        Range range;
+        uint32_t width = 0;
+        uint32_t height = 0;
+        std::vector<uint8_t> pixels;
+        State state = State::Queued;
+        bool released = false;  // Released while in flight
+    };
+
+    // Host-visible staging, reused by later batches once its fence signals
+    struct Staging {
+        finevk::BufferPtr buffer;
+        VkDeviceSize size = 0;
+    };
+
+    // One submission: copies (and/or retired images waiting for it)
+    struct Batch {
+        VkFence fence = VK_NULL_HANDLE;
+        finevk::CommandBufferPtr cmd;
+        Staging staging;
+        std::vector<uint32_t> uploads;
+        std::vector<uint32_t> retired;
+    };
+
+    void finish(Batch& batch, std::vector<uint32_t>& completed);
+    void recycle(Batch& batch);
+    void destroyImage(Upload& upload);
+    void bindMemory(Upload& upload);
+    void freeMemory(Upload& upload);
+    Staging acquireStaging(VkDeviceSize bytes);
+    uint32_t findMemoryType(uint32_t typeBits, VkMemoryPropertyFlags flags) const;
+
+    finevk::LogicalDevice* owner_ = nullptr;
+    VkDevice device_ = VK_NULL_HANDLE;
+    VkPhysicalDevice physical_ = VK_NULL_HANDLE;
+    VkQueue queue_ = VK_NULL_HANDLE;
+    std::mutex* queueMutex_ = nullptr;
+    finevk::CommandPoolPtr pool_;
+    uint64_t bytesPerFrame_ = 0;
+    bool submittedThisFrame_ = false;
+
+    std::unordered_map<uint32_t, Upload> uploads_;
+    std::deque<uint32_t> queued_;
+    std::vector<Batch> inFlight_;
+    uint32_t nextId_ = 1;
+    uint32_t pending_ = 0;
+
+    // Image memory (Upload::block points at these)
+    std::vector<std::unique_ptr<MemoryBlock>> blocks_;
+
+    // Finished batches' staging buffers and command buffers
+    std::vector<Staging> spareStaging_;
+    std::vector<finevk::CommandBufferPtr> spareCommands_;
+
+    // Released images that frames may still sample: those released before
+    // the last submit() wait for the next submission's fence
+    std::vector<uint32_t> retiring_;
+    std::vector<uint32_t> retireNext_;
+
+    uint64_t submittedBytes_ = 0;
+    uint64_t completedUploads_ = 0;
+};
+
+} // namespace backend
+} // namespace finegui
@@ -0,0 +1,77 @@
+/**
+ * @file compact_vertex.cpp
+ * @brief Quantized 12-byte GUI vertex format
+ */
+
+#include <finegui/compact_vertex.hpp>
+
+#include <cmath>
+
+namespace finegui {
+
+namespace {
+
+constexpr float kPosMin = -32768.0f;
+constexpr float kPosMax = 32767.0f;
+constexpr float kUvMax = 65535.0f;
+
+float quantizePosition(float value, float origin) {
+    return std::floor((value - origin) * kCompactPositionScale + 0.5f);
+}
+
+int16_t encodePosition(float value, float origin) {
+    float q = quantizePosition(value, origin);
+    if (!(q >= kPosMin)) q = kPosMin;  // Also catches NaN
+    if (q > kPosMax) q = kPosMax;
+    return static_cast<int16_t>(q);
+}
+
+uint16_t encodeUv(float value) {
+    float q = std::floor(value * kUvMax + 0.5f);
+    if (!(q >= 0.0f)) q = 0.0f;
+    if (q > kUvMax) q = kUvMax;
+    return static_cast<uint16_t>(q);
+}
+
+} // namespace
+
+bool fitsCompactVertices(const ImDrawVert* src, size_t count, ImVec2 origin) {
+    for (size_t i = 0; i < count; i++) {
+        const ImDrawVert& v = src[i];
+        float x = quantizePosition(v.pos.x, origin.x);
+        float y = quantizePosition(v.pos.y, origin.y);
+        // Written so NaN fails every test
+        if (!(x >= kPosMin && x <= kPosMax && y >= kPosMin && y <= kPosMax)) {
+            return false;
+        }
+        if (!(v.uv.x >= 0.0f && v.uv.x <= 1.0f && v.uv.y >= 0.0f && v.uv.y <= 1.0f)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+void packCompactVertices(const ImDrawVert* src, size_t count, ImVec2 origin, CompactDrawVert* dst) {
+    for (size_t i = 0; i < count; i++) {
+        const ImDrawVert& v = src[i];
+        CompactDrawVert out;
+        out.pos[0] = encodePosition(v.pos.x, origin.x);
+        out.pos[1] = encodePosition(v.pos.y, origin.y);
+        out.uv[0] = encodeUv(v.uv.x);
+        out.uv[1] = encodeUv(v.uv.y);
+        out.col = v.col;
+        dst[i] = out;  // One store per vertex into (possibly mapped) memory
+    }
+}
+
+ImDrawVert unpackCompactVertex(const CompactDrawVert& vertex, ImVec2 origin) {
+    ImDrawVert v;
+    v.pos.x = origin.x + static_cast<float>(vertex.pos[0]) / kCompactPositionScale;
+    v.pos.y = origin.y + static_cast<float>(vertex.pos[1]) / kCompactPositionScale;
+    v.uv.x = static_cast<float>(vertex.uv[0]) / kUvMax;
+    v.uv.y = static_cast<float>(vertex.uv[1]) / kUvMax;
+    v.col = vertex.col;
+    return v;
+}
+
+} // namespace finegui
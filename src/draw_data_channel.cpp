@@ -0,0 +1,35 @@
+/**
+ * @file draw_data_channel.cpp
+ * @brief Lock-free triple-buffered handoff of GuiDrawData between threads
+ */
+
+#include <finegui/draw_data_channel.hpp>
+
+namespace finegui {
+
+void DrawDataChannel::publish() {
+    // Release makes the buffer's contents visible to the reader that swaps
+    // it out; acquire covers the reader's last use of the buffer handed back
+    uint32_t previous = middle_.exchange(writeIndex_ | kFresh, std::memory_order_acq_rel);
+    writeIndex_ = previous & kIndexMask;
+
+    published_.fetch_add(1, std::memory_order_relaxed);
+    if (previous & kFresh) {
+        overwritten_.fetch_add(1, std::memory_order_relaxed);
+    }
+}
+
+const GuiDrawData& DrawDataChannel::acquire(bool* isNew) {
+    bool fresh = (middle_.load(std::memory_order_relaxed) & kFresh) != 0;
+    if (fresh) {
+        uint32_t previous = middle_.exchange(readIndex_, std::memory_order_acq_rel);
+        readIndex_ = previous & kIndexMask;
+    }
+
+    if (isNew) {
+        *isNew = fresh;
+    }
+    return buffers_[readIndex_];
+}
+
+} // namespace finegui
@@ -0,0 +1,66 @@
+/**
+ * @file gui_draw_data.cpp
+ * @brief Capture of ImGui draw data for threaded rendering mode
+ */
+
+#include <finegui/gui_draw_data.hpp>
+
+#include <cstring>
+
+namespace finegui {
+
+void captureDrawData(const ImDrawData* drawData, GuiDrawData& out) {
+    if (!drawData || drawData->TotalVtxCount <= 0) {
+        out.clear();
+        return;
+    }
+
+    size_t commandCount = 0;
+    for (int n = 0; n < drawData->CmdListsCount; n++) {
+        commandCount += static_cast<size_t>(drawData->CmdLists[n]->CmdBuffer.Size);
+    }
+
+    // resize() rather than clear() + append: elements within the previous
+    // size are overwritten as they are, with no zero-fill or regrowth
+    out.vertices.resize(static_cast<size_t>(drawData->TotalVtxCount));
+    out.indices.resize(static_cast<size_t>(drawData->TotalIdxCount));
+    out.commands.resize(commandCount);
+    out.textureRequests.clear();
+
+    out.displaySize = glm::vec2(drawData->DisplaySize.x, drawData->DisplaySize.y);
+    out.framebufferScale = glm::vec2(drawData->FramebufferScale.x, drawData->FramebufferScale.y);
+
+    ImDrawVert* vertices = out.vertices.data();
+    ImDrawIdx* indices = out.indices.data();
+    DrawCommand* command = out.commands.data();
+    size_t vtxOffset = 0;
+    size_t idxOffset = 0;
+
+    for (int n = 0; n < drawData->CmdListsCount; n++) {
+        const ImDrawList* cmdList = drawData->CmdLists[n];
+
+        std::memcpy(vertices + vtxOffset, cmdList->VtxBuffer.Data,
+                    static_cast<size_t>(cmdList->VtxBuffer.Size) * sizeof(ImDrawVert));
+        std::memcpy(indices + idxOffset, cmdList->IdxBuffer.Data,
+                    static_cast<size_t>(cmdList->IdxBuffer.Size) * sizeof(ImDrawIdx));
+
+        for (const ImDrawCmd& pcmd : cmdList->CmdBuffer) {
+            command->indexOffset = static_cast<uint32_t>(idxOffset + pcmd.IdxOffset);
+            command->indexCount = pcmd.ElemCount;
+            command->vertexOffset = static_cast<uint32_t>(vtxOffset + pcmd.VtxOffset);
+            command->texture = TextureHandle{};
+            command->texture.id = static_cast<uint64_t>(pcmd.GetTexID());
+            command->scissorRect = glm::ivec4(
+                static_cast<int>(pcmd.ClipRect.x),
+                static_cast<int>(pcmd.ClipRect.y),
+                static_cast<int>(pcmd.ClipRect.z - pcmd.ClipRect.x),
+                static_cast<int>(pcmd.ClipRect.w - pcmd.ClipRect.y));
+            command++;
+        }
+
+        vtxOffset += static_cast<size_t>(cmdList->VtxBuffer.Size);
+        idxOffset += static_cast<size_t>(cmdList->IdxBuffer.Size);
+    }
+}
+
+} // namespace finegui
@@ -5,13 +5,40 @@
 
 #include <finegui/gui_system.hpp>
 
+#include <finegui/draw_data_channel.hpp>
+#include <finegui/sdf_font.hpp>
+#include <finegui/session_recorder.hpp>
+
 #include "backend/imgui_impl_finevk.hpp"
+#include "backend/null_backend.hpp"
+
+#include <imgui_internal.h>
 
+#include <algorithm>
+#include <atomic>
 #include <stdexcept>
 #include <chrono>
+#include <cstdint>
+#include <cmath>
+#include <cstring>
+#include <vector>
 
 namespace finegui {
 
+namespace {
+
+// Provisional IDs of textures created from captured requests (see
+// TextureRequest); far above any descriptor handle or bindless slot
+constexpr uint64_t kProvisionalTextureBase = 0xFFF0000000000000ull;
+
+// Consecutive changed frames after which the cached layer is bypassed
+constexpr uint32_t kLayerChangeLimit = 4;
+
+// While bypassed, frames between checks for the GUI having settled
+constexpr uint32_t kLayerProbeInterval = 30;
+
+} // namespace
+
 // ============================================================================
 // Implementation structure
 // ============================================================================
@@ -25,6 +52,7 @@ struct GuiSystem::Impl {
 
     // Backend
     std::unique_ptr<backend::ImGuiBackend> backend;
+    std::unique_ptr<backend::NullBackend> nullBackend;  // Headless mode only
 
     // Rendering state
     finevk::RenderSurface* surface = nullptr;
@@ -32,8 +60,69 @@ struct GuiSystem::Impl {
     uint32_t currentFrameIndex = 0;  // For manual mode tracking
     bool initialized = false;
 
-    // Draw data capture (for threaded mode)
-    GuiDrawData capturedDrawData;
+    // The backend's geometry ring retires a slot once per frame, at the
+    // frame's first draw. beginFrame() marks a new frame, or getDrawData()
+    // with capture (beginFrame() then runs on the GUI thread, mid-frame
+    // for the render thread). A draw for a slot other than the current
+    // frame's also starts one, for callers that do neither.
+    std::atomic<bool> backendFramePending{false};
+    uint32_t backendFrameIndex = UINT32_MAX;
+
+    // Draw data capture (for threaded mode): endFrame() publishes,
+    // getDrawData() acquires
+    DrawDataChannel drawChannel;
+
+    // Font atlas changes not yet applied by the render thread. endFrame()
+    // adds to the list and copies it into every captured frame; the render
+    // thread reports the last sequence it applied, and endFrame() drops
+    // what it has seen.
+    std::vector<TextureRequest> textureRequests;
+    uint64_t textureSequence = 0;
+    std::atomic<uint64_t> texturesApplied{0};
+
+    // Cached GUI layer (GuiConfig::cachedLayer), one per frame in flight so
+    // a layer is never re-rendered while an earlier frame still samples it.
+    // endFrame() decides whether the layer needs rendering; recordLayer()
+    // records that into the frame's own command buffer.
+    struct CachedLayer {
+        std::unique_ptr<finevk::OffscreenSurface> surface;
+        VkFramebuffer framebuffer = VK_NULL_HANDLE;  // Ours, over the surface's color view
+        uint64_t textureId = 0;
+        uint64_t hash = 0;          // layerHash() of the draw data it holds
+        uint64_t pendingHash = 0;   // layerHash() of the frame waiting in recordLayer()
+        bool stale = true;          // Re-render on the next frame
+        bool pending = false;       // This frame needs recordLayer() before compositing
+        bool hasContent = false;
+    };
+    std::vector<CachedLayer> layers;
+    VkExtent2D layerExtent{};
+    uint64_t layerRenders = 0;
+    uint64_t layerReuses = 0;
+    uint64_t layerBypasses = 0;
+
+    // A GUI that changes every frame is drawn directly instead (bypass),
+    // with an occasional hash to notice when it has settled again
+    uint64_t lastFrameHash = 0;
+    uint32_t changedStreak = 0;
+    bool layerInvalidated = false;  // invalidateLayer() since the last endFrame()
+    bool layerBypass = false;
+    uint32_t bypassFrames = 0;
+    uint64_t probeHash = 0;
+    bool probeInvalidated = false;
+
+    // SceneTexture GPU times reported since the last endFrame()
+    float scenePendingMicros = 0.0f;
+    bool scenePending = false;
+    float sceneMicros = 0.0f;
+    uint64_t sceneSamples = 0;
+
+    // Glyph prewarming: queued codepoints, and the default font bake that
+    // frames are checked against for lazily rasterized (missed) glyphs
+    std::vector<ImWchar> prewarmQueue;
+    size_t prewarmHead = 0;
+    GlyphPrewarmStats prewarmStats;
+    ImFontBaked* frameBaked = nullptr;
+    int frameGlyphCount = 0;
 
     // Display state
     float displayWidth = 800.0f;
@@ -47,6 +136,16 @@ struct GuiSystem::Impl {
     Clock::time_point lastFrameTime = Clock::now();
     bool firstFrame = true;
 
+    // Input: modifier bits last sent to ImGui (-1 = unknown), and the
+    // MouseMove/MouseScroll run processInputBatch() is coalescing
+    int sentModifiers = -1;
+    InputEvent pendingInput{};
+    bool hasPendingInput = false;
+    InputStats batchStats;
+    InputStats inputStats;
+
+    SessionRecorder* recorder = nullptr;
+
     // InputManager integration
     GuiMode guiMode = GuiMode::Auto;
     finevk::InputManager* connectedInput = nullptr;
@@ -60,48 +159,47 @@ struct GuiSystem::Impl {
             listenerId = -1;
         }
 
+        destroyLayerFramebuffers();
+
         // Destroy backend first while ImGui context is still valid
         // This allows proper cleanup of GPU resources for ImGui textures
         backend.reset();
 
+        if (nullBackend) {
+            ImGui::SetCurrentContext(context);
+            nullBackend.reset();
+        }
+
         if (context) {
             ImGui::DestroyContext(context);
         }
     }
-};
-
-// ============================================================================
-// Constructor/Destructor
-// ============================================================================
-
-GuiSystem::GuiSystem(finevk::LogicalDevice* device, const GuiConfig& config)
-    : impl_(std::make_unique<Impl>())
-{
-    if (!device) {
-        throw std::runtime_error("GuiSystem: device cannot be null");
-    }
-
-    impl_->device = device;
-    impl_->config = config;
-
-    // Determine frames in flight
-    impl_->framesInFlight = config.framesInFlight > 0
-        ? config.framesInFlight
-        : device->framesInFlight();
 
-    if (impl_->framesInFlight == 0) {
-        impl_->framesInFlight = 2;  // Safe default
-    }
+    void createContext();
+    uint32_t emitInput(const InputEvent& event);
+    void queueGlyphs(const char* text, const char* textEnd);
+    void queueGlyphRange(uint32_t first, uint32_t last);
+    uint32_t prewarmGlyphs(uint32_t maxGlyphs);
+    void createLayers();
+    void registerLayers();
+    void createLayerFramebuffers();
+    void destroyLayerFramebuffers();
+    void updateLayer();
+    void captureTextureRequests(ImDrawData* drawData);
+    void applyTextureRequests(const std::vector<TextureRequest>& requests);
+    void beginBackendFrame(uint32_t frameIndex);
+};
 
+void GuiSystem::Impl::createContext() {
     // Set up DPI scaling
     // dpiScale of 0 means use 1.0 (auto-detect requires window access in initialize())
-    impl_->dpiScale = config.dpiScale > 0.0f ? config.dpiScale : 1.0f;
-    impl_->framebufferScaleX = impl_->dpiScale;
-    impl_->framebufferScaleY = impl_->dpiScale;
+    dpiScale = config.dpiScale > 0.0f ? config.dpiScale : 1.0f;
+    framebufferScaleX = dpiScale;
+    framebufferScaleY = dpiScale;
 
     // Create ImGui context
-    impl_->context = ImGui::CreateContext();
-    ImGui::SetCurrentContext(impl_->context);
+    context = ImGui::CreateContext();
+    ImGui::SetCurrentContext(context);
 
     // Configure ImGui
     ImGuiIO& io = ImGui::GetIO();
@@ -112,22 +210,33 @@ GuiSystem::GuiSystem(finevk::LogicalDevice* device, const GuiConfig& config)
     }
 
     // Set display size (will be updated per-frame)
-    io.DisplaySize = ImVec2(impl_->displayWidth, impl_->displayHeight);
-    io.DisplayFramebufferScale = ImVec2(impl_->framebufferScaleX, impl_->framebufferScaleY);
+    io.DisplaySize = ImVec2(displayWidth, displayHeight);
+    io.DisplayFramebufferScale = ImVec2(framebufferScaleX, framebufferScaleY);
+
+    // SDF glyphs are converted as they are rasterized, so the loader has to
+    // be in place before any font is added. Baked anti-aliased lines are
+    // coverage, not distance, and would be sharpened by the SDF shader.
+    if (config.sdfFonts) {
+        io.Fonts->SetFontLoader(sdfFontLoader());
+        io.Fonts->Flags |= ImFontAtlasFlags_NoBakedLines;
+    }
 
     // Configure font
     // RasterizerDensity handles high-DPI: rasterizes at dpiScale resolution
     // but displays at the logical font size. No manual size scaling needed.
+    // (SDF fonts are baked at an absolute pixel size instead.)
     float logicalFontSize = config.fontSize * config.fontScale;
+    float density = config.sdfFonts ? 1.0f : dpiScale;
+    ImFont* font = nullptr;
     if (!config.fontPath.empty()) {
         ImFontConfig fontConfig;
-        fontConfig.RasterizerDensity = impl_->dpiScale;
-        io.Fonts->AddFontFromFileTTF(config.fontPath.c_str(), logicalFontSize, &fontConfig);
+        fontConfig.RasterizerDensity = density;
+        font = io.Fonts->AddFontFromFileTTF(config.fontPath.c_str(), logicalFontSize, &fontConfig);
     } else if (config.fontData && config.fontDataSize > 0) {
         ImFontConfig fontConfig;
         fontConfig.FontDataOwnedByAtlas = false;  // We manage the data
-        fontConfig.RasterizerDensity = impl_->dpiScale;
-        io.Fonts->AddFontFromMemoryTTF(
+        fontConfig.RasterizerDensity = density;
+        font = io.Fonts->AddFontFromMemoryTTF(
             const_cast<void*>(config.fontData),
             static_cast<int>(config.fontDataSize),
             logicalFontSize,
@@ -135,13 +244,322 @@ GuiSystem::GuiSystem(finevk::LogicalDevice* device, const GuiConfig& config)
     } else {
         ImFontConfig fontConfig;
         fontConfig.SizePixels = logicalFontSize;
-        fontConfig.RasterizerDensity = impl_->dpiScale;
-        io.Fonts->AddFontDefaultVector(&fontConfig);
+        fontConfig.RasterizerDensity = density;
+        font = io.Fonts->AddFontDefaultVector(&fontConfig);
+    }
+
+    // Bake the one size, then lock it: every other size scales this bake
+    // instead of rasterizing a new one
+    if (config.sdfFonts && font) {
+        font->GetFontBaked(config.sdfBakeSize, 1.0f);
+        font->Flags |= ImFontFlags_LockBakedSizes;
+    }
+
+    queueGlyphs(config.prewarmText.data(), config.prewarmText.data() + config.prewarmText.size());
+    for (const auto& range : config.prewarmRanges) {
+        queueGlyphRange(range.first, range.second);
+    }
+}
+
+void GuiSystem::Impl::queueGlyphs(const char* text, const char* textEnd) {
+    while (text < textEnd) {
+        unsigned int c = 0;
+        text += ImTextCharFromUtf8(&c, text, textEnd);
+        if (c > 0 && c <= IM_UNICODE_CODEPOINT_MAX) {
+            prewarmQueue.push_back(static_cast<ImWchar>(c));
+        }
+    }
+}
+
+void GuiSystem::Impl::queueGlyphRange(uint32_t first, uint32_t last) {
+    last = std::min<uint32_t>(last, IM_UNICODE_CODEPOINT_MAX);
+    for (uint32_t c = std::max<uint32_t>(first, 1); c <= last; c++) {
+        prewarmQueue.push_back(static_cast<ImWchar>(c));
+    }
+}
+
+uint32_t GuiSystem::Impl::prewarmGlyphs(uint32_t maxGlyphs) {
+    ImGui::SetCurrentContext(context);
+    ImGuiIO& io = ImGui::GetIO();
+    ImFont* font = io.FontDefault ? io.FontDefault : io.Fonts->Fonts[0];
+    ImFontBaked* baked = font->GetFontBaked(font->LegacySize);
+
+    // Loading a glyph rasterizes it into the atlas and queues the dirty
+    // rect, which the next render() uploads with the rest
+    uint32_t loaded = 0;
+    while (prewarmHead < prewarmQueue.size() && loaded < maxGlyphs) {
+        ImWchar c = prewarmQueue[prewarmHead++];
+        if (baked->IsGlyphLoaded(c)) {
+            continue;
+        }
+        if (!font->IsGlyphInFont(c)) {
+            prewarmStats.unavailable++;
+            continue;
+        }
+        baked->FindGlyph(c);
+        loaded++;
+    }
+
+    if (prewarmHead == prewarmQueue.size()) {
+        prewarmQueue.clear();
+        prewarmHead = 0;
+    }
+    prewarmStats.prewarmed += loaded;
+    return loaded;
+}
+
+void GuiSystem::Impl::createLayers() {
+    layerExtent = surface->extent();
+    layers.resize(framesInFlight);
+    for (CachedLayer& layer : layers) {
+        // Same color format as SceneTexture, so blending happens in linear
+        // space as it does when drawing straight into an sRGB swapchain
+        layer.surface = finevk::OffscreenSurface::create(device)
+            .extent(layerExtent.width, layerExtent.height)
+            .colorFormat(VK_FORMAT_R8G8B8A8_SRGB)
+            .build();
+    }
+    registerLayers();
+    createLayerFramebuffers();
+    backend->initializeLayer(layers[0].surface->renderTarget()->renderPass());
+}
+
+void GuiSystem::Impl::registerLayers() {
+    for (CachedLayer& layer : layers) {
+        layer.textureId = backend->registerTexture(layer.surface->colorImageView(),
+                                                   layer.surface->colorSampler());
+        layer.stale = true;
+        layer.hasContent = false;
+    }
+}
+
+void GuiSystem::Impl::createLayerFramebuffers() {
+    // recordLayer() begins the layer pass on the application's command
+    // buffer, so it needs a framebuffer of its own over the layer image
+    for (CachedLayer& layer : layers) {
+        VkImageView view = layer.surface->colorImageView();
+
+        VkFramebufferCreateInfo info{};
+        info.sType = VK_STRUCTURE_TYPE_FRAMEBUFFER_CREATE_INFO;
+        info.renderPass = layer.surface->renderTarget()->renderPass()->handle();
+        info.attachmentCount = 1;
+        info.pAttachments = &view;
+        info.width = layerExtent.width;
+        info.height = layerExtent.height;
+        info.layers = 1;
+        if (vkCreateFramebuffer(device->handle(), &info, nullptr, &layer.framebuffer) != VK_SUCCESS) {
+            throw std::runtime_error("GuiSystem: failed to create layer framebuffer");
+        }
+    }
+}
+
+void GuiSystem::Impl::destroyLayerFramebuffers() {
+    if (layers.empty()) {
+        return;
+    }
+    device->waitIdle();
+    for (CachedLayer& layer : layers) {
+        if (layer.framebuffer != VK_NULL_HANDLE) {
+            vkDestroyFramebuffer(device->handle(), layer.framebuffer, nullptr);
+            layer.framebuffer = VK_NULL_HANDLE;
+        }
+    }
+}
+
+void GuiSystem::Impl::updateLayer() {
+    CachedLayer& layer = layers[currentFrameIndex];
+    layer.pending = false;
+
+    VkExtent2D extent = surface->extent();
+    if (extent.width == 0 || extent.height == 0) {
+        return;  // Minimized
+    }
+    if (extent.width != layerExtent.width || extent.height != layerExtent.height) {
+        // Earlier frames may still be compositing the old images
+        destroyLayerFramebuffers();
+        for (CachedLayer& l : layers) {
+            backend->unregisterTexture(l.textureId);
+            l.surface->resize(extent.width, extent.height);
+        }
+        layerExtent = extent;
+        registerLayers();
+        createLayerFramebuffers();
     }
 
+    bool invalidated = layerInvalidated;
+    layerInvalidated = false;
+
+    if (layerBypass) {
+        // Drawn directly. Hash only every kLayerProbeInterval frames, and
+        // resume caching once two probes in a row saw the same GUI.
+        probeInvalidated = probeInvalidated || invalidated;
+        if (++bypassFrames < kLayerProbeInterval) {
+            layerBypasses++;
+            return;
+        }
+        bypassFrames = 0;
+        uint64_t hash = backend->layerHash(ImGui::GetDrawData());
+        bool settled = hash != 0 && hash == probeHash && !probeInvalidated;
+        probeHash = hash;
+        probeInvalidated = false;
+        if (!settled) {
+            layerBypasses++;
+            return;
+        }
+        layerBypass = false;
+        changedStreak = 0;
+        lastFrameHash = hash;
+    }
+
+    uint64_t hash = backend->layerHash(ImGui::GetDrawData());
+
+    // Every layer render costs an extra pass over the GUI, so a GUI that
+    // keeps changing is cheaper to draw directly
+    if (hash != lastFrameHash || invalidated) {
+        changedStreak++;
+    } else {
+        changedStreak = 0;
+    }
+    lastFrameHash = hash;
+    if (changedStreak >= kLayerChangeLimit) {
+        layerBypass = true;
+        bypassFrames = 0;
+        probeHash = hash;
+        probeInvalidated = false;
+        layerBypasses++;
+        return;
+    }
+
+    if (!layer.stale && hash != 0 && hash == layer.hash) {
+        layerReuses++;
+        return;
+    }
+
+    layer.pending = true;
+    layer.pendingHash = hash;
+}
+
+void GuiSystem::Impl::captureTextureRequests(ImDrawData* drawData) {
+    // Drop requests the render thread has applied
+    uint64_t applied = texturesApplied.load(std::memory_order_acquire);
+    auto seen = std::find_if(textureRequests.begin(), textureRequests.end(),
+        [applied](const TextureRequest& request) { return request.sequence > applied; });
+    textureRequests.erase(textureRequests.begin(), seen);
+
+    if (!drawData || !drawData->Textures) {
+        return;
+    }
+
+    for (ImTextureData* tex : *drawData->Textures) {
+        if (tex->Status == ImTextureStatus_OK || tex->Status == ImTextureStatus_Destroyed) {
+            continue;
+        }
+        IM_ASSERT(tex->Format == ImTextureFormat_RGBA32);
+
+        TextureRequest request;
+        request.status = tex->Status;
+        if (tex->Status == ImTextureStatus_WantCreate) {
+            request.width = tex->Width;
+            request.height = tex->Height;
+            const auto* pixels = static_cast<const uint8_t*>(tex->GetPixels());
+            request.pixels.assign(pixels, pixels + tex->GetSizeInBytes());
+        } else if (tex->Status == ImTextureStatus_WantUpdates) {
+            request.textureId = static_cast<uint64_t>(tex->GetTexID());
+            if (tex->Updates.Size > 0) {
+                request.rects.assign(tex->Updates.begin(), tex->Updates.end());
+            } else if (tex->UpdateRect.w > 0 && tex->UpdateRect.h > 0) {
+                request.rects.push_back(tex->UpdateRect);
+            }
+
+            // Rows packed in rect order, as the backend copies them
+            size_t bytes = 0;
+            for (const ImTextureRect& r : request.rects) {
+                bytes += static_cast<size_t>(r.w) * r.h * tex->BytesPerPixel;
+            }
+            request.pixels.resize(bytes);
+            uint8_t* out = request.pixels.data();
+            for (const ImTextureRect& r : request.rects) {
+                const size_t rowBytes = static_cast<size_t>(r.w) * tex->BytesPerPixel;
+                for (int y = 0; y < r.h; y++) {
+                    std::memcpy(out, tex->GetPixelsAt(r.x, r.y + y), rowBytes);
+                    out += rowBytes;
+                }
+            }
+        } else {
+            // WantDestroy: never created (or already gone) needs no request
+            request.textureId = static_cast<uint64_t>(tex->GetTexID());
+            tex->SetTexID(ImTextureID_Invalid);
+            tex->BackendUserData = nullptr;  // Freed by the backend
+            tex->SetStatus(ImTextureStatus_Destroyed);
+            if (request.textureId == 0) {
+                continue;
+            }
+        }
+
+        request.sequence = ++textureSequence;
+        if (request.status == ImTextureStatus_WantCreate) {
+            request.textureId = kProvisionalTextureBase + request.sequence;
+            tex->SetTexID(static_cast<ImTextureID>(request.textureId));
+        }
+        if (request.status != ImTextureStatus_WantDestroy) {
+            tex->SetStatus(ImTextureStatus_OK);
+        }
+        textureRequests.push_back(std::move(request));
+    }
+}
+
+void GuiSystem::Impl::applyTextureRequests(const std::vector<TextureRequest>& requests) {
+    backend->applyTextureRequests(requests);
+    texturesApplied.store(backend->appliedTextureRequest(), std::memory_order_release);
+}
+
+void GuiSystem::Impl::beginBackendFrame(uint32_t frameIndex) {
+    // Never again within a frame: its earlier draws still reference their
+    // geometry from the unsubmitted command buffer
+    if (backendFramePending.exchange(false) || frameIndex != backendFrameIndex) {
+        backend->beginFrame(frameIndex);
+        backendFrameIndex = frameIndex;
+    }
+}
+
+// ============================================================================
+// Constructor/Destructor
+// ============================================================================
+
+GuiSystem::GuiSystem(finevk::LogicalDevice* device, const GuiConfig& config)
+    : impl_(std::make_unique<Impl>())
+{
+    if (!device) {
+        throw std::runtime_error("GuiSystem: device cannot be null");
+    }
+
+    impl_->device = device;
+    impl_->config = config;
+
+    // Determine frames in flight
+    impl_->framesInFlight = config.framesInFlight > 0
+        ? config.framesInFlight
+        : device->framesInFlight();
+
+    if (impl_->framesInFlight == 0) {
+        impl_->framesInFlight = 2;  // Safe default
+    }
+
+    impl_->createContext();
+
     // Backend is created in initialize() when we have a RenderSurface
 }
 
+GuiSystem::GuiSystem(const GuiConfig& config)
+    : impl_(std::make_unique<Impl>())
+{
+    impl_->config = config;
+    impl_->framesInFlight = config.framesInFlight > 0 ? config.framesInFlight : 2;
+    impl_->createContext();
+
+    // Null backend is created in initializeHeadless()
+}
+
 GuiSystem::~GuiSystem() = default;
 
 GuiSystem::GuiSystem(GuiSystem&&) noexcept = default;
@@ -164,7 +582,7 @@ void GuiSystem::initialize(finevk::RenderPass* renderPass,
 
     ImGui::SetCurrentContext(impl_->context);
 
-    impl_->backend->initialize(renderPass, commandPool, subpass, impl_->config.msaaSamples);
+    impl_->backend->initialize(renderPass, commandPool, subpass, impl_->config);
     impl_->initialized = true;
 }
 
@@ -186,6 +604,25 @@ void GuiSystem::initialize(finevk::RenderSurface* surface, uint32_t subpass) {
     impl_->displayHeight = static_cast<float>(extent.height) / impl_->dpiScale;
 
     initialize(surface->renderPass(), surface->commandPool(), subpass);
+
+    if (impl_->config.cachedLayer) {
+        impl_->createLayers();
+    }
+}
+
+void GuiSystem::initializeHeadless(uint32_t width, uint32_t height) {
+    if (impl_->device) {
+        throw std::runtime_error("GuiSystem::initializeHeadless: constructed with a device");
+    }
+    if (impl_->nullBackend) {
+        throw std::runtime_error("GuiSystem::initializeHeadless: already initialized");
+    }
+
+    impl_->displayWidth = static_cast<float>(width) / impl_->dpiScale;
+    impl_->displayHeight = static_cast<float>(height) / impl_->dpiScale;
+
+    ImGui::SetCurrentContext(impl_->context);
+    impl_->nullBackend = std::make_unique<backend::NullBackend>();
 }
 
 TextureHandle GuiSystem::registerTexture(finevk::Texture* texture, finevk::Sampler* sampler) {
@@ -216,6 +653,24 @@ TextureHandle GuiSystem::registerTexture(finevk::ImageView* imageView,
     return handle;
 }
 
+TextureHandle GuiSystem::registerTextureAsync(const void* pixels, uint32_t width, uint32_t height,
+                                              finevk::Sampler* sampler) {
+    if (!impl_->initialized) {
+        throw std::runtime_error("GuiSystem::registerTextureAsync: must call initialize() first");
+    }
+
+    TextureHandle handle;
+    handle.id = impl_->backend->registerTextureAsync(pixels, width, height, sampler);
+    handle.width = width;
+    handle.height = height;
+
+    return handle;
+}
+
+bool GuiSystem::textureReady(TextureHandle handle) const {
+    return !impl_->backend || impl_->backend->textureReady(handle.id);
+}
+
 void GuiSystem::unregisterTexture(TextureHandle handle) {
     if (handle.valid() && impl_->backend) {
         impl_->backend->unregisterTexture(handle.id);
@@ -226,52 +681,166 @@ void GuiSystem::unregisterTexture(TextureHandle handle) {
 // Input processing
 // ============================================================================
 
-void GuiSystem::processInput(const InputEvent& event) {
-    ImGui::SetCurrentContext(impl_->context);
-    ImGuiIO& io = ImGui::GetIO();
+namespace {
 
-    // Update modifiers
-    io.AddKeyEvent(ImGuiMod_Ctrl, event.ctrl);
-    io.AddKeyEvent(ImGuiMod_Shift, event.shift);
-    io.AddKeyEvent(ImGuiMod_Alt, event.alt);
-    io.AddKeyEvent(ImGuiMod_Super, event.super);
+int modifierBits(const InputEvent& event) {
+    return (event.ctrl ? 1 : 0) | (event.shift ? 2 : 0) | (event.alt ? 4 : 0) | (event.super ? 8 : 0);
+}
+
+bool isCoalescable(InputEventType type) {
+    return type == InputEventType::MouseMove || type == InputEventType::MouseScroll;
+}
+
+} // namespace
+
+uint32_t GuiSystem::Impl::emitInput(const InputEvent& event) {
+    if (recorder) {
+        recorder->recordInput(event);
+    }
+
+    ImGui::SetCurrentContext(context);
+    ImGuiIO& io = ImGui::GetIO();
+    uint32_t emitted = 0;
+
+    // Every event carries the modifiers; only changes are sent, since ImGui
+    // searches its whole input queue to filter repeats of an unchanged key
+    int modifiers = modifierBits(event);
+    if (modifiers != sentModifiers) {
+        static constexpr ImGuiKey kModifierKeys[] = {
+            ImGuiMod_Ctrl, ImGuiMod_Shift, ImGuiMod_Alt, ImGuiMod_Super
+        };
+        int changed = sentModifiers < 0 ? 0xF : (modifiers ^ sentModifiers);
+        for (int bit = 0; bit < 4; bit++) {
+            if (changed & (1 << bit)) {
+                io.AddKeyEvent(kModifierKeys[bit], (modifiers & (1 << bit)) != 0);
+                emitted++;
+            }
+        }
+        sentModifiers = modifiers;
+    }
 
     switch (event.type) {
         case InputEventType::MouseMove:
             io.AddMousePosEvent(event.mouseX, event.mouseY);
+            emitted++;
             break;
 
         case InputEventType::MouseButton:
             io.AddMouseButtonEvent(event.button, event.pressed);
+            emitted++;
             break;
 
         case InputEventType::MouseScroll:
             io.AddMouseWheelEvent(event.scrollX, event.scrollY);
+            emitted++;
             break;
 
         case InputEventType::Key:
             if (event.keyCode != ImGuiKey_None) {
                 io.AddKeyEvent(static_cast<ImGuiKey>(event.keyCode), event.keyPressed);
+                emitted++;
             }
             break;
 
         case InputEventType::Char:
             if (event.character > 0 && event.character < 0x10000) {
                 io.AddInputCharacter(event.character);
+                emitted++;
             }
             break;
 
         case InputEventType::Focus:
             io.AddFocusEvent(event.focused);
+            emitted++;
+            // ImGui releases all keys on focus loss: resend modifiers after
+            if (!event.focused) {
+                sentModifiers = -1;
+            }
             break;
 
         case InputEventType::WindowResize:
             // Convert to logical size for high-DPI
-            impl_->displayWidth = static_cast<float>(event.windowWidth) / impl_->dpiScale;
-            impl_->displayHeight = static_cast<float>(event.windowHeight) / impl_->dpiScale;
-            io.DisplaySize = ImVec2(impl_->displayWidth, impl_->displayHeight);
+            displayWidth = static_cast<float>(event.windowWidth) / dpiScale;
+            displayHeight = static_cast<float>(event.windowHeight) / dpiScale;
+            io.DisplaySize = ImVec2(displayWidth, displayHeight);
             break;
     }
+
+    return emitted;
+}
+
+void GuiSystem::processInput(const InputEvent& event) {
+    impl_->inputStats.ingested++;
+    impl_->inputStats.emitted += impl_->emitInput(event);
+}
+
+void GuiSystem::batchInput(const InputEvent& event) {
+    Impl& impl = *impl_;
+    impl.batchStats.ingested++;
+
+    if (impl.hasPendingInput) {
+        InputEvent& pending = impl.pendingInput;
+        if (event.type == pending.type && modifierBits(event) == modifierBits(pending)) {
+            // The merged event takes the newest event's fields (and time)
+            float scrollX = pending.scrollX + event.scrollX;
+            float scrollY = pending.scrollY + event.scrollY;
+            pending = event;
+            if (event.type == InputEventType::MouseScroll) {
+                pending.scrollX = scrollX;
+                pending.scrollY = scrollY;
+            }
+            impl.batchStats.coalesced++;
+            return;
+        }
+
+        // Anything else ends the run, and goes to ImGui after it
+        impl.batchStats.emitted += impl.emitInput(pending);
+        impl.hasPendingInput = false;
+    }
+
+    if (isCoalescable(event.type)) {
+        impl.pendingInput = event;
+        impl.hasPendingInput = true;
+    } else {
+        impl.batchStats.emitted += impl.emitInput(event);
+    }
+}
+
+InputStats GuiSystem::finishInputBatch() {
+    Impl& impl = *impl_;
+    if (impl.hasPendingInput) {
+        impl.batchStats.emitted += impl.emitInput(impl.pendingInput);
+        impl.hasPendingInput = false;
+    }
+
+    InputStats batch = impl.batchStats;
+    impl.batchStats = InputStats{};
+    impl.inputStats.ingested += batch.ingested;
+    impl.inputStats.emitted += batch.emitted;
+    impl.inputStats.coalesced += batch.coalesced;
+    return batch;
+}
+
+InputStats GuiSystem::inputStats() const {
+    return impl_->inputStats;
+}
+
+// ============================================================================
+// Session recording
+// ============================================================================
+
+void GuiSystem::setSessionRecorder(SessionRecorder* recorder) {
+    impl_->recorder = recorder;
+}
+
+SessionRecorder* GuiSystem::sessionRecorder() const {
+    return impl_->recorder;
+}
+
+void GuiSystem::recordState(const GuiStateUpdate& update) {
+    if (impl_->recorder) {
+        impl_->recorder->recordState(update);
+    }
 }
 
 // ============================================================================
@@ -382,6 +951,9 @@ void GuiSystem::beginFrame(float deltaTime) {
 
 void GuiSystem::beginFrame(uint32_t frameIndex, float deltaTime) {
     impl_->currentFrameIndex = frameIndex % impl_->framesInFlight;
+    if (!impl_->config.enableDrawDataCapture) {
+        impl_->backendFramePending = true;
+    }
 
     ImGui::SetCurrentContext(impl_->context);
     ImGuiIO& io = ImGui::GetIO();
@@ -398,59 +970,79 @@ void GuiSystem::beginFrame(uint32_t frameIndex, float deltaTime) {
     io.DisplayFramebufferScale = ImVec2(impl_->framebufferScaleX, impl_->framebufferScaleY);
     io.DeltaTime = deltaTime > 0.0f ? deltaTime : (1.0f / 60.0f);
 
+    if (impl_->recorder) {
+        impl_->recorder->recordFrameBegin(
+            io.DeltaTime,
+            static_cast<int>(std::lround(impl_->displayWidth * impl_->dpiScale)),
+            static_cast<int>(std::lround(impl_->displayHeight * impl_->dpiScale)));
+    }
+
     ImGui::NewFrame();
+
+    impl_->frameBaked = ImGui::GetFontBaked();
+    impl_->frameGlyphCount = impl_->frameBaked->Glyphs.Size;
 }
 
 void GuiSystem::endFrame() {
     ImGui::SetCurrentContext(impl_->context);
     ImGui::Render();
 
-    // Capture draw data if enabled
+    if (impl_->recorder) {
+        impl_->recorder->recordFrameEnd();
+    }
+
+    // Glyphs the frame had to rasterize on first use
+    if (impl_->frameBaked) {
+        int added = impl_->frameBaked->Glyphs.Size - impl_->frameGlyphCount;
+        impl_->prewarmStats.missed += static_cast<uint64_t>(std::max(added, 0));
+        impl_->frameBaked = nullptr;
+    }
+
+    // Before the draw data is consumed, so this frame's render() uploads them
+    if (impl_->config.prewarmGlyphsPerFrame > 0) {
+        impl_->prewarmGlyphs(impl_->config.prewarmGlyphsPerFrame);
+    }
+
+    if (impl_->scenePending) {
+        impl_->sceneMicros = backend::smoothGpuTime(
+            impl_->sceneMicros, impl_->scenePendingMicros, impl_->sceneSamples == 0);
+        impl_->sceneSamples++;
+        impl_->scenePendingMicros = 0.0f;
+        impl_->scenePending = false;
+    }
+
+    // Headless: stands in for render(), which is what services texture requests
+    if (impl_->nullBackend) {
+        impl_->nullBackend->render(ImGui::GetDrawData());
+    }
+
+    // The previous frame has been submitted, so released images can retire.
+    // With capture the render thread owns the backend: getDrawData() does it.
+    if (impl_->backend && impl_->initialized && !impl_->config.enableDrawDataCapture) {
+        impl_->backend->updateUploads();
+    }
+
+    if (!impl_->layers.empty()) {
+        impl_->updateLayer();
+    }
+
+    // Capture draw data if enabled. The write buffer is never one the
+    // render thread holds, and keeps its capacity from earlier frames.
     if (impl_->config.enableDrawDataCapture) {
-        impl_->capturedDrawData.clear();
+        // The render thread applies atlas changes from the frame it draws;
+        // this first gives created textures the IDs the commands capture.
+        // Headless mode has already serviced them above.
+        bool requests = impl_->backend && impl_->initialized;
+        if (requests) {
+            impl_->captureTextureRequests(ImGui::GetDrawData());
+        }
 
-        ImDrawData* drawData = ImGui::GetDrawData();
-        if (drawData && drawData->TotalVtxCount > 0) {
-            impl_->capturedDrawData.displaySize = glm::vec2(
-                drawData->DisplaySize.x, drawData->DisplaySize.y);
-            impl_->capturedDrawData.framebufferScale = glm::vec2(
-                drawData->FramebufferScale.x, drawData->FramebufferScale.y);
-
-            // Copy vertex/index data
-            for (int n = 0; n < drawData->CmdListsCount; n++) {
-                const ImDrawList* cmdList = drawData->CmdLists[n];
-
-                size_t vtxOffset = impl_->capturedDrawData.vertices.size();
-                size_t idxOffset = impl_->capturedDrawData.indices.size();
-
-                impl_->capturedDrawData.vertices.insert(
-                    impl_->capturedDrawData.vertices.end(),
-                    cmdList->VtxBuffer.Data,
-                    cmdList->VtxBuffer.Data + cmdList->VtxBuffer.Size);
-
-                impl_->capturedDrawData.indices.insert(
-                    impl_->capturedDrawData.indices.end(),
-                    cmdList->IdxBuffer.Data,
-                    cmdList->IdxBuffer.Data + cmdList->IdxBuffer.Size);
-
-                for (int cmdIdx = 0; cmdIdx < cmdList->CmdBuffer.Size; cmdIdx++) {
-                    const ImDrawCmd* pcmd = &cmdList->CmdBuffer[cmdIdx];
-
-                    DrawCommand cmd;
-                    cmd.indexOffset = static_cast<uint32_t>(idxOffset + pcmd->IdxOffset);
-                    cmd.indexCount = pcmd->ElemCount;
-                    cmd.vertexOffset = static_cast<uint32_t>(vtxOffset + pcmd->VtxOffset);
-                    cmd.texture.id = reinterpret_cast<uint64_t>(pcmd->GetTexID());
-                    cmd.scissorRect = glm::ivec4(
-                        static_cast<int>(pcmd->ClipRect.x),
-                        static_cast<int>(pcmd->ClipRect.y),
-                        static_cast<int>(pcmd->ClipRect.z - pcmd->ClipRect.x),
-                        static_cast<int>(pcmd->ClipRect.w - pcmd->ClipRect.y));
-
-                    impl_->capturedDrawData.commands.push_back(cmd);
-                }
-            }
+        GuiDrawData& frame = impl_->drawChannel.writeBuffer();
+        captureDrawData(ImGui::GetDrawData(), frame);
+        if (requests) {
+            frame.textureRequests = impl_->textureRequests;
         }
+        impl_->drawChannel.publish();
     }
 }
 
@@ -465,14 +1057,100 @@ void GuiSystem::render(finevk::CommandBuffer& cmd, uint32_t frameIndex) {
     }
 
     ImGui::SetCurrentContext(impl_->context);
-    impl_->backend->render(cmd, frameIndex % impl_->framesInFlight);
+    frameIndex %= impl_->framesInFlight;
+    impl_->beginBackendFrame(frameIndex);
+
+    // With capture, endFrame() turned atlas changes into requests
+    if (impl_->config.enableDrawDataCapture) {
+        impl_->applyTextureRequests(impl_->textureRequests);
+    }
+
+    // recordLayer() brought the layer up to date; draw it as one quad.
+    // Without that, or while the layer is bypassed, draw the GUI directly.
+    if (!impl_->layers.empty() && !impl_->layerBypass) {
+        const Impl::CachedLayer& layer = impl_->layers[frameIndex];
+        ImDrawData* drawData = ImGui::GetDrawData();
+        if (layer.hasContent && !layer.pending) {
+            if (drawData && drawData->TotalVtxCount > 0) {
+                impl_->backend->compositeLayer(cmd, frameIndex, layer.textureId,
+                                               drawData->DisplaySize, drawData->FramebufferScale);
+            }
+            return;
+        }
+    }
+
+    impl_->backend->render(cmd, frameIndex);
+}
+
+void GuiSystem::recordLayer(finevk::CommandBuffer& cmd) {
+    // Use frame index from beginFrame (automatic or stored from renderer)
+    recordLayer(cmd, impl_->currentFrameIndex);
+}
+
+void GuiSystem::recordLayer(finevk::CommandBuffer& cmd, uint32_t frameIndex) {
+    if (!impl_->initialized) {
+        throw std::runtime_error("GuiSystem::recordLayer: must call initialize() first");
+    }
+    if (impl_->layers.empty()) {
+        return;
+    }
+
+    frameIndex %= impl_->framesInFlight;
+    Impl::CachedLayer& layer = impl_->layers[frameIndex];
+    if (!layer.pending) {
+        return;
+    }
+
+    ImGui::SetCurrentContext(impl_->context);
+    impl_->beginBackendFrame(frameIndex);
+    if (impl_->config.enableDrawDataCapture) {
+        impl_->applyTextureRequests(impl_->textureRequests);
+    }
+
+    // The renderer's beginFrame() waited for this slot, so no frame still
+    // samples this layer
+    VkClearValue clear{};
+    VkRenderPassBeginInfo passInfo{};
+    passInfo.sType = VK_STRUCTURE_TYPE_RENDER_PASS_BEGIN_INFO;
+    passInfo.renderPass = layer.surface->renderTarget()->renderPass()->handle();
+    passInfo.framebuffer = layer.framebuffer;
+    passInfo.renderArea.extent = impl_->layerExtent;
+    passInfo.clearValueCount = 1;
+    passInfo.pClearValues = &clear;
+    vkCmdBeginRenderPass(cmd.handle(), &passInfo, VK_SUBPASS_CONTENTS_INLINE);
+    impl_->backend->renderToLayer(cmd, frameIndex);
+    vkCmdEndRenderPass(cmd.handle());
+
+    // render() samples the layer in the pass that follows
+    VkMemoryBarrier barrier{};
+    barrier.sType = VK_STRUCTURE_TYPE_MEMORY_BARRIER;
+    barrier.srcAccessMask = VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT;
+    barrier.dstAccessMask = VK_ACCESS_SHADER_READ_BIT;
+    vkCmdPipelineBarrier(cmd.handle(), VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT,
+                         VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT, 0,
+                         1, &barrier, 0, nullptr, 0, nullptr);
+
+    layer.hash = layer.pendingHash;
+    layer.stale = false;
+    layer.pending = false;
+    layer.hasContent = true;
+    impl_->layerRenders++;
 }
 
 const GuiDrawData& GuiSystem::getDrawData() const {
     if (!impl_->config.enableDrawDataCapture) {
         throw std::runtime_error("GuiSystem::getDrawData: enableDrawDataCapture not set in config");
     }
-    return impl_->capturedDrawData;
+    // A recording from the previous call may still be reading the frame
+    // that acquire() hands back to the writer
+    if (impl_->backend) {
+        impl_->backend->waitForRecording();
+        if (impl_->initialized) {
+            impl_->backend->updateUploads();
+        }
+    }
+    impl_->backendFramePending = true;
+    return impl_->drawChannel.acquire();
 }
 
 void GuiSystem::renderDrawData(finevk::CommandBuffer& cmd, const GuiDrawData& data) {
@@ -485,7 +1163,112 @@ void GuiSystem::renderDrawData(finevk::CommandBuffer& cmd, uint32_t frameIndex,
         throw std::runtime_error("GuiSystem::renderDrawData: must call initialize() first");
     }
 
-    impl_->backend->renderDrawData(cmd, frameIndex % impl_->framesInFlight, data);
+    frameIndex %= impl_->framesInFlight;
+    impl_->beginBackendFrame(frameIndex);
+    impl_->applyTextureRequests(data.textureRequests);
+    impl_->backend->renderDrawData(cmd, frameIndex, data);
+}
+
+void GuiSystem::recordSecondary(const GuiDrawData& data, VkFramebuffer framebuffer) {
+    // Use frame index from beginFrame
+    recordSecondary(impl_->currentFrameIndex, data, framebuffer);
+}
+
+void GuiSystem::recordSecondary(uint32_t frameIndex, const GuiDrawData& data,
+                                VkFramebuffer framebuffer) {
+    if (!impl_->initialized) {
+        throw std::runtime_error("GuiSystem::recordSecondary: must call initialize() first");
+    }
+
+    frameIndex %= impl_->framesInFlight;
+    impl_->beginBackendFrame(frameIndex);
+    impl_->applyTextureRequests(data.textureRequests);
+    impl_->backend->recordSecondary(frameIndex, data, framebuffer, false);
+}
+
+void GuiSystem::recordSecondaryAsync(const GuiDrawData& data, VkFramebuffer framebuffer) {
+    // Use frame index from beginFrame
+    recordSecondaryAsync(impl_->currentFrameIndex, data, framebuffer);
+}
+
+void GuiSystem::recordSecondaryAsync(uint32_t frameIndex, const GuiDrawData& data,
+                                     VkFramebuffer framebuffer) {
+    if (!impl_->initialized) {
+        throw std::runtime_error("GuiSystem::recordSecondaryAsync: must call initialize() first");
+    }
+
+    frameIndex %= impl_->framesInFlight;
+    impl_->beginBackendFrame(frameIndex);
+    impl_->applyTextureRequests(data.textureRequests);
+    impl_->backend->recordSecondary(frameIndex, data, framebuffer, true);
+}
+
+void GuiSystem::executeSecondary(finevk::CommandBuffer& primary) {
+    // Use frame index from beginFrame
+    executeSecondary(primary, impl_->currentFrameIndex);
+}
+
+void GuiSystem::executeSecondary(finevk::CommandBuffer& primary, uint32_t frameIndex) {
+    if (!impl_->initialized) {
+        throw std::runtime_error("GuiSystem::executeSecondary: must call initialize() first");
+    }
+
+    impl_->backend->executeSecondary(primary, frameIndex % impl_->framesInFlight);
+}
+
+void GuiSystem::resetGpuTimers(finevk::CommandBuffer& cmd) {
+    // Use frame index from beginFrame
+    resetGpuTimers(cmd, impl_->currentFrameIndex);
+}
+
+void GuiSystem::resetGpuTimers(finevk::CommandBuffer& cmd, uint32_t frameIndex) {
+    if (!impl_->initialized) {
+        throw std::runtime_error("GuiSystem::resetGpuTimers: must call initialize() first");
+    }
+
+    impl_->backend->resetGpuTimer(cmd, frameIndex % impl_->framesInFlight);
+}
+
+GpuTimings GuiSystem::gpuTimings() const {
+    GpuTimings result;
+    if (impl_->backend && impl_->backend->hasGpuTimer()) {
+        result.supported = true;
+        result.guiMicros = impl_->backend->gpuMicros();
+        result.guiSamples = impl_->backend->gpuSamples();
+        result.sceneMicros = impl_->sceneMicros;
+        result.sceneSamples = impl_->sceneSamples;
+    }
+    return result;
+}
+
+void GuiSystem::invalidateLayer() {
+    for (auto& layer : impl_->layers) {
+        layer.stale = true;
+    }
+    impl_->layerInvalidated = !impl_->layers.empty();
+}
+
+void GuiSystem::queueGlyphs(const std::string& utf8Text) {
+    impl_->queueGlyphs(utf8Text.data(), utf8Text.data() + utf8Text.size());
+}
+
+void GuiSystem::queueGlyphRange(uint32_t first, uint32_t last) {
+    impl_->queueGlyphRange(first, last);
+}
+
+uint32_t GuiSystem::prewarmGlyphs(uint32_t maxGlyphs) {
+    return impl_->prewarmGlyphs(maxGlyphs);
+}
+
+GlyphPrewarmStats GuiSystem::glyphPrewarmStats() const {
+    GlyphPrewarmStats stats = impl_->prewarmStats;
+    stats.pending = impl_->prewarmQueue.size() - impl_->prewarmHead;
+    return stats;
+}
+
+void GuiSystem::addSceneGpuTime(float micros) {
+    impl_->scenePendingMicros += micros;
+    impl_->scenePending = true;
 }
 
 // ============================================================================
@@ -507,7 +1290,7 @@ ImGuiContext* GuiSystem::imguiContext() {
 }
 
 void GuiSystem::rebuildFontAtlas() {
-    if (!impl_->initialized) {
+    if (!impl_->initialized && !impl_->nullBackend) {
         throw std::runtime_error("GuiSystem::rebuildFontAtlas: must call initialize() first");
     }
 
@@ -519,6 +1302,26 @@ void GuiSystem::rebuildFontAtlas() {
     // compatibility but is effectively a no-op.
 }
 
+GuiRenderStats GuiSystem::renderStats() const {
+    if (!impl_->backend) {
+        return {};
+    }
+    // Batching counters are written by an asynchronous recording
+    impl_->backend->waitForRecording();
+    GuiRenderStats stats = impl_->backend->stats();
+    stats.layerRenders = impl_->layerRenders;
+    stats.layerReuses = impl_->layerReuses;
+    stats.layerBypasses = impl_->layerBypasses;
+    return stats;
+}
+
+HeadlessStats GuiSystem::headlessStats() const {
+    if (!impl_->nullBackend) {
+        return {};
+    }
+    return impl_->nullBackend->stats();
+}
+
 finevk::LogicalDevice* GuiSystem::device() const {
     return impl_->device;
 }
@@ -527,4 +1330,12 @@ bool GuiSystem::isInitialized() const {
     return impl_->initialized;
 }
 
+bool GuiSystem::isHeadless() const {
+    return impl_->nullBackend != nullptr;
+}
+
+const GuiConfig& GuiSystem::config() const {
+    return impl_->config;
+}
+
 } // namespace finegui
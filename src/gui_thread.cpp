@@ -0,0 +1,153 @@
+/**
+ * @file gui_thread.cpp
+ * @brief Runs a GuiSystem's frames on a dedicated thread
+ */
+
+#include <finegui/gui_thread.hpp>
+#include <finegui/gui_system.hpp>
+
+#include <chrono>
+#include <stdexcept>
+
+namespace finegui {
+
+namespace {
+
+// Weight of a new sample in the smoothed frame time
+constexpr float kFrameTimeSmoothing = 0.1f;
+
+} // namespace
+
+GuiThread::GuiThread(GuiSystem& gui, GuiThreadConfig config)
+    : gui_(gui)
+    , config_(config)
+    , input_(config.inputQueueCapacity)
+{
+    inputBatch_.reserve(input_.capacity());
+}
+
+GuiThread::~GuiThread() {
+    try {
+        stop();
+    } catch (...) {
+    }
+}
+
+void GuiThread::addFrameCallback(FrameCallback callback) {
+    if (thread_.joinable()) {
+        throw std::runtime_error("GuiThread::addFrameCallback: cannot add callbacks while running");
+    }
+    callbacks_.push_back(std::move(callback));
+}
+
+void GuiThread::start() {
+    if (thread_.joinable()) {
+        throw std::runtime_error("GuiThread::start: already running");
+    }
+    if (!gui_.config().enableDrawDataCapture) {
+        throw std::runtime_error("GuiThread::start: GuiConfig::enableDrawDataCapture required");
+    }
+    if (gui_.config().cachedLayer) {
+        throw std::runtime_error("GuiThread::start: GuiConfig::cachedLayer not supported");
+    }
+
+    stopRequested_ = false;
+    error_ = nullptr;
+    running_.store(true, std::memory_order_release);
+    thread_ = std::thread(&GuiThread::run, this);
+}
+
+void GuiThread::stop() {
+    if (!thread_.joinable()) {
+        return;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(stopMutex_);
+        stopRequested_ = true;
+    }
+    stopCv_.notify_all();
+    thread_.join();
+    running_.store(false, std::memory_order_release);
+
+    if (error_) {
+        std::exception_ptr error = error_;
+        error_ = nullptr;
+        std::rethrow_exception(error);
+    }
+}
+
+void GuiThread::run() {
+    using Clock = std::chrono::steady_clock;
+
+    const auto interval = config_.targetFrameRate > 0.0f
+        ? std::chrono::duration_cast<Clock::duration>(
+              std::chrono::duration<double>(1.0 / config_.targetFrameRate))
+        : Clock::duration::zero();
+
+    auto lastFrame = Clock::now();
+    auto nextFrame = lastFrame;
+    bool first = true;
+    bool inFrame = false;
+
+    try {
+        for (;;) {
+            auto frameStart = Clock::now();
+            float deltaTime = first ? 0.0f
+                : std::chrono::duration<float>(frameStart - lastFrame).count();
+            lastFrame = frameStart;
+            first = false;
+
+            // At most one queue's worth, so steady posting cannot stall the frame
+            InputEvent event;
+            inputBatch_.clear();
+            while (inputBatch_.size() < inputBatch_.capacity() && input_.pop(event)) {
+                inputBatch_.push_back(event);
+            }
+            InputStats input = gui_.processInputBatch(inputBatch_);
+            inputsProcessed_.fetch_add(input.ingested, std::memory_order_relaxed);
+
+            // beginFrame() substitutes 1/60 s for the first frame's 0
+            gui_.beginFrame(0, deltaTime);
+            inFrame = true;
+            for (FrameCallback& callback : callbacks_) {
+                callback(deltaTime);
+            }
+            inFrame = false;
+            gui_.endFrame();
+
+            float micros = std::chrono::duration<float, std::micro>(Clock::now() - frameStart).count();
+            float smoothed = frameMicros_.load(std::memory_order_relaxed);
+            frameMicros_.store(frames_.load(std::memory_order_relaxed) == 0
+                                   ? micros
+                                   : smoothed + (micros - smoothed) * kFrameTimeSmoothing,
+                               std::memory_order_relaxed);
+            frames_.fetch_add(1, std::memory_order_relaxed);
+
+            // Sleep until the next frame is due; a late frame starts the
+            // schedule over rather than running several frames back to back
+            nextFrame += interval;
+            if (nextFrame < Clock::now()) {
+                nextFrame = Clock::now();
+            }
+            std::unique_lock<std::mutex> lock(stopMutex_);
+            if (stopCv_.wait_until(lock, nextFrame, [this] { return stopRequested_; })) {
+                break;
+            }
+        }
+    } catch (...) {
+        error_ = std::current_exception();
+
+        // Close the frame so the context can be used again after stop()
+        if (inFrame) {
+            try {
+                gui_.endFrame();
+            } catch (...) {
+            }
+        }
+    }
+
+    running_.store(false, std::memory_order_release);
+}
+
+} // namespace finegui
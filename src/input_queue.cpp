@@ -0,0 +1,68 @@
+/**
+ * @file input_queue.cpp
+ * @brief Lock-free multi-producer, single-consumer queue of InputEvents
+ */
+
+#include <finegui/input_queue.hpp>
+
+namespace finegui {
+
+InputQueue::InputQueue(size_t capacity) {
+    size_t size = 2;
+    while (size < capacity) {
+        size *= 2;
+    }
+    mask_ = size - 1;
+
+    // Cell i is free for the producer that claims position i
+    cells_ = std::make_unique<Cell[]>(size);
+    for (size_t i = 0; i < size; i++) {
+        cells_[i].sequence.store(i, std::memory_order_relaxed);
+    }
+}
+
+InputQueue::~InputQueue() = default;
+
+bool InputQueue::push(const InputEvent& event) {
+    size_t pos = enqueuePos_.load(std::memory_order_relaxed);
+    Cell* cell;
+    for (;;) {
+        cell = &cells_[pos & mask_];
+        size_t sequence = cell->sequence.load(std::memory_order_acquire);
+        auto diff = static_cast<intptr_t>(sequence) - static_cast<intptr_t>(pos);
+        if (diff == 0) {
+            // Free for this position: claim it (on failure pos is reloaded)
+            if (enqueuePos_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                break;
+            }
+        } else if (diff < 0) {
+            // Still holds the event from one lap ago: full
+            dropped_.fetch_add(1, std::memory_order_relaxed);
+            return false;
+        } else {
+            // Another producer claimed it first
+            pos = enqueuePos_.load(std::memory_order_relaxed);
+        }
+    }
+
+    cell->event = event;
+    cell->sequence.store(pos + 1, std::memory_order_release);
+    return true;
+}
+
+bool InputQueue::pop(InputEvent& event) {
+    Cell* cell = &cells_[dequeuePos_ & mask_];
+    size_t sequence = cell->sequence.load(std::memory_order_acquire);
+    if (sequence != dequeuePos_ + 1) {
+        return false;  // Empty, or the claiming producer is still writing
+    }
+
+    event = cell->event;
+
+    // Free the cell for the producer one lap ahead
+    cell->sequence.store(dequeuePos_ + mask_ + 1, std::memory_order_release);
+    dequeuePos_++;
+    return true;
+}
+
+} // namespace finegui
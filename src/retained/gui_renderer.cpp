@@ -21,42 +21,96 @@ static int inputTextCallback(ImGuiInputTextCallbackData* data) {
         data->Buf = userData->str->data();
     } else if (data->EventFlag == ImGuiInputTextFlags_CallbackHistory) {
         auto* node = userData->node;
-        if (node && node->onHistory) {
+        if (node && node->callbacks().onHistory) {
             // Encode direction in intValue: -1 = up, +1 = down
             int savedInt = node->intValue;
             node->intValue = (data->EventKey == ImGuiKey_UpArrow) ? -1 : 1;
-            node->onHistory(*node);
+            node->callbacks().onHistory(*node);
             // After callback, stringValue may have been updated
             data->DeleteChars(0, data->BufTextLen);
-            data->InsertChars(0, node->stringValue.c_str());
-            *userData->str = node->stringValue;
+            data->InsertChars(0, node->props().stringValue.c_str());
+            *userData->str = node->props().stringValue;
             node->intValue = savedInt;
         }
     }
     return 0;
 }
 
+// -- List clipping ------------------------------------------------------------
+
+// Below this many rows, submitting them all costs less than clipping
+static constexpr size_t kClipMinRows = 32;
+
+// Single-line widgets that can make up a clipped Child's rows
+static bool isChildRowType(WidgetNode::Type type) {
+    switch (type) {
+        case WidgetNode::Type::Text:
+        case WidgetNode::Type::TextColored:
+        case WidgetNode::Type::TextDisabled:
+        case WidgetNode::Type::BulletText:
+        case WidgetNode::Type::Selectable:
+        case WidgetNode::Type::Button:
+        case WidgetNode::Type::SmallButton:
+        case WidgetNode::Type::Checkbox:
+        case WidgetNode::Type::RadioButton:
+        case WidgetNode::Type::Slider:
+        case WidgetNode::Type::SliderInt:
+        case WidgetNode::Type::DragFloat:
+        case WidgetNode::Type::DragInt:
+        case WidgetNode::Type::InputText:
+        case WidgetNode::Type::InputInt:
+        case WidgetNode::Type::InputFloat:
+        case WidgetNode::Type::InputTextWithHint:
+        case WidgetNode::Type::Combo:
+        case WidgetNode::Type::ProgressBar:
+            return true;
+        default:
+            return false;
+    }
+}
+
+// Whether a table row's cells are all single-line widgets
+static bool isSingleLineTableRow(const WidgetNode& row) {
+    for (const auto& cell : row.children) {
+        if (cell.type != WidgetNode::Type::TableColumn && !isChildRowType(cell.type)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+// Whether node has enough children, all visible and of rowType, for
+// ImGuiListClipper to lay them out from the first row's height. Mixed
+// children (SameLine, style pushes, item tooltips, ...) and table rows
+// holding wrapped text or nested containers are never clipped.
+static bool hasUniformRows(const WidgetNode& node, WidgetNode::Type rowType) {
+    if (node.children.size() < kClipMinRows) return false;
+    for (const auto& child : node.children) {
+        if (child.type != rowType || !child.visible) return false;
+        if (rowType == WidgetNode::Type::TableRow && !isSingleLineTableRow(child)) return false;
+    }
+    return true;
+}
+
 // -- GuiRenderer --------------------------------------------------------------
 
 GuiRenderer::GuiRenderer(GuiSystem& gui)
-    : gui_(gui) {
-    (void)gui_;  // Reserved for future use (e.g., querying display size)
-}
+    : gui_(gui) {}
 
 int GuiRenderer::show(WidgetNode tree, bool immediate) {
     int id = nextId_++;
     int warmup = 0;
     if (!immediate && tree.type == WidgetNode::Type::Window &&
-        !(tree.windowSizeW > 0.0f && tree.windowSizeH > 0.0f)) {
+        !(tree.props().windowSizeW > 0.0f && tree.props().windowSizeH > 0.0f)) {
         warmup = 1;
     }
-    trees_.emplace(id, Entry{std::move(tree), warmup});
+    trees_.emplace(id, Entry{nullptr, nullptr, std::move(tree), warmup});
     return id;
 }
 
 int GuiRenderer::stage(WidgetNode tree) {
     int id = nextId_++;
-    trees_.emplace(id, Entry{std::move(tree), -1});
+    trees_.emplace(id, Entry{nullptr, nullptr, std::move(tree), -1});
     return id;
 }
 
@@ -65,7 +119,7 @@ void GuiRenderer::goLive(int guiId) {
     if (it == trees_.end() || it->second.warmupFrames != -1) return;
     auto& entry = it->second;
     if (entry.tree.type == WidgetNode::Type::Window &&
-        !(entry.tree.windowSizeW > 0.0f && entry.tree.windowSizeH > 0.0f)) {
+        !(entry.tree.props().windowSizeW > 0.0f && entry.tree.props().windowSizeH > 0.0f)) {
         entry.warmupFrames = 1;
     } else {
         entry.warmupFrames = 0;
@@ -88,12 +142,66 @@ void GuiRenderer::update(int guiId, WidgetNode tree) {
         // Recalculate warmup for the new tree
         int warmup = 0;
         if (tree.type == WidgetNode::Type::Window &&
-            !(tree.windowSizeW > 0.0f && tree.windowSizeH > 0.0f)) {
+            !(tree.props().windowSizeW > 0.0f && tree.props().windowSizeH > 0.0f)) {
             warmup = 1;
         }
         it->second.tree = std::move(tree);
         it->second.warmupFrames = warmup;
+
+        // The old tree is gone; take its arena back in one shot. Nodes
+        // moved out of it still use its storage: leave the arena to them
+        // (it frees itself after the last) and build in a fresh one.
+        if (it->second.arena) {
+            if (it->second.arena->liveBlocks() == 0) {
+                it->second.arena->reset();
+            } else {
+                it->second.arena = std::make_unique<WidgetArena>();
+            }
+        }
+    }
+}
+
+size_t GuiRenderer::reconcile(int guiId, WidgetNode tree) {
+    auto it = trees_.find(guiId);
+    if (it == trees_.end()) return 0;
+
+    Entry& entry = it->second;
+    bool sameRoot = entry.tree.type == tree.type;
+    size_t touched = entry.tree.reconcile(std::move(tree));
+
+    // Only a replaced root needs a new warmup; staged trees stay staged
+    if (!sameRoot && entry.warmupFrames != -1) {
+        entry.warmupFrames = (entry.tree.type == WidgetNode::Type::Window &&
+                              !(entry.tree.props().windowSizeW > 0.0f &&
+                                entry.tree.props().windowSizeH > 0.0f)) ? 1 : 0;
+    }
+    return touched;
+}
+
+int GuiRenderer::showInArena(const TreeBuilder& build, bool immediate) {
+    auto arena = std::make_unique<WidgetArena>();
+    int id = show(buildInArena(*arena, build), immediate);
+    trees_[id].arena = std::move(arena);
+    return id;
+}
+
+void GuiRenderer::updateInArena(int guiId, const TreeBuilder& build) {
+    auto it = trees_.find(guiId);
+    if (it == trees_.end()) return;
+
+    Entry& entry = it->second;
+    if (!entry.spareArena) {
+        entry.spareArena = std::make_unique<WidgetArena>();
     }
+    update(guiId, buildInArena(*entry.spareArena, build));
+
+    // update() reset the old tree's arena; the next build goes there
+    std::swap(entry.arena, entry.spareArena);
+}
+
+WidgetNode GuiRenderer::buildInArena(WidgetArena& arena, const TreeBuilder& build) {
+    WidgetArena::Scope scope(arena);
+    return build();
 }
 
 void GuiRenderer::hide(int guiId) {
@@ -139,16 +247,26 @@ void GuiRenderer::renderAll() {
         if (entry.warmupFrames == -1) continue;  // staged — skip
         if (entry.warmupFrames > 0) {
             // Render invisibly so ImGui computes layout
-            float savedAlpha = entry.tree.alpha;
-            entry.tree.alpha = 0.0f;
+            float savedAlpha = entry.tree.props().alpha;
+            entry.tree.propsMut().alpha = 0.0f;
             renderNode(entry.tree);
-            entry.tree.alpha = savedAlpha;
+            entry.tree.propsMut().alpha = savedAlpha;
             entry.warmupFrames--;
         } else {
             renderNode(entry.tree);
         }
     }
     lastFocusedId_ = currentFocusedId_;
+
+    // Every virtual row built this frame should have been destroyed by now.
+    // Rows kept anyway hold on to the old arena, which frees itself after
+    // the last of them.
+    if (rowArena_->liveBlocks() == 0) {
+        rowArena_->reset();
+    } else {
+        escapedRowFrames_++;
+        rowArena_ = std::make_unique<WidgetArena>();
+    }
 }
 
 // -- Dispatch -----------------------------------------------------------------
@@ -260,6 +378,9 @@ void GuiRenderer::renderNode(WidgetNode& node) {
         // Style & Theming
         case WidgetNode::Type::PushTheme:        renderPushTheme(node); break;
         case WidgetNode::Type::PopTheme:         renderPopTheme(node); break;
+        // Virtual lists
+        case WidgetNode::Type::VirtualList:      renderVirtualList(node); break;
+        case WidgetNode::Type::VirtualTable:     renderVirtualTable(node); break;
         default:
             ImGui::TextColored({1, 0, 0, 1}, "[TODO: %s]", widgetTypeName(node.type));
             break;
@@ -274,11 +395,11 @@ void GuiRenderer::renderNode(WidgetNode& node) {
     if (!node.id.empty()) {
         if (ImGui::IsItemFocused()) {
             currentFocusedId_ = node.id;
-            if (node.id != lastFocusedId_ && node.onFocus) {
-                node.onFocus(node);
+            if (node.id != lastFocusedId_ && node.callbacks().onFocus) {
+                node.callbacks().onFocus(node);
             }
-        } else if (node.id == lastFocusedId_ && node.onBlur) {
-            node.onBlur(node);
+        } else if (node.id == lastFocusedId_ && node.callbacks().onBlur) {
+            node.callbacks().onBlur(node);
         }
     }
 
@@ -298,30 +419,62 @@ void GuiRenderer::renderNode(WidgetNode& node) {
     }
 }
 
+void GuiRenderer::renderChildRows(WidgetNode& node, bool clip) {
+    if (!clip) {
+        for (auto& child : node.children) {
+            renderNode(child);
+        }
+        return;
+    }
+
+    ImGuiListClipper clipper;
+    clipper.Begin(static_cast<int>(node.children.size()));
+
+    // A row holding a pending setFocus() target must be submitted to take it
+    if (!pendingFocusId_.empty()) {
+        for (size_t i = 0; i < node.children.size(); i++) {
+            if (findByIdRecursive(node.children[i], pendingFocusId_)) {
+                clipper.IncludeItemByIndex(static_cast<int>(i));
+                break;
+            }
+        }
+    }
+
+    while (clipper.Step()) {
+        // A callback may have shrunk the list mid-frame
+        int end = std::min(clipper.DisplayEnd, static_cast<int>(node.children.size()));
+        for (int i = clipper.DisplayStart; i < end; i++) {
+            renderNode(node.children[static_cast<size_t>(i)]);
+        }
+    }
+}
+
 // -- Per-widget render methods ------------------------------------------------
 
 void GuiRenderer::renderWindow(WidgetNode& node) {
+    const WidgetNode::Props& props = node.props();
+
     // Animation: explicit window position (with optional pivot for centering)
-    if (node.windowPosX != FLT_MAX && node.windowPosY != FLT_MAX) {
-        ImGui::SetNextWindowPos(ImVec2(node.windowPosX, node.windowPosY),
+    if (props.windowPosX != FLT_MAX && props.windowPosY != FLT_MAX) {
+        ImGui::SetNextWindowPos(ImVec2(props.windowPosX, props.windowPosY),
                                 ImGuiCond_Always,
-                                ImVec2(node.windowPivotX, node.windowPivotY));
+                                ImVec2(props.windowPivotX, props.windowPivotY));
     }
 
     // Programmatic window size
-    if (node.windowSizeW > 0.0f || node.windowSizeH > 0.0f) {
-        ImGui::SetNextWindowSize(ImVec2(node.windowSizeW, node.windowSizeH), ImGuiCond_FirstUseEver);
+    if (props.windowSizeW > 0.0f || props.windowSizeH > 0.0f) {
+        ImGui::SetNextWindowSize(ImVec2(props.windowSizeW, props.windowSizeH), ImGuiCond_FirstUseEver);
     }
 
     // Animation: window alpha
-    bool pushedAlpha = node.alpha < 1.0f;
+    bool pushedAlpha = props.alpha < 1.0f;
     if (pushedAlpha) {
-        ImGui::PushStyleVar(ImGuiStyleVar_Alpha, node.alpha);
+        ImGui::PushStyleVar(ImGuiStyleVar_Alpha, props.alpha);
     }
 
     bool open = true;
     bool windowOpen = ImGui::Begin(node.label.c_str(), &open,
-                     static_cast<ImGuiWindowFlags>(node.windowFlags));
+                     static_cast<ImGuiWindowFlags>(props.windowFlags));
 
     // Capture draw list and window geometry for vertex post-processing
     ImDrawList* drawList = ImGui::GetWindowDrawList();
@@ -341,12 +494,12 @@ void GuiRenderer::renderWindow(WidgetNode& node) {
     }
 
     // Post-process vertices for zoom/flip transforms
-    bool needsTransform = node.scaleX != 1.0f || node.scaleY != 1.0f || node.rotationY != 0.0f;
+    bool needsTransform = props.scaleX != 1.0f || props.scaleY != 1.0f || props.rotationY != 0.0f;
     if (needsTransform && drawList->VtxBuffer.Size > vtxStart) {
         float cx = windowPos.x + windowSize.x * 0.5f;
         float cy = windowPos.y + windowSize.y * 0.5f;
-        float cosR = std::cos(node.rotationY);
-        float sinR = std::sin(node.rotationY);
+        float cosR = std::cos(props.rotationY);
+        float sinR = std::sin(props.rotationY);
         constexpr float perspD = 800.0f; // perspective focal length in pixels
 
         for (int i = vtxStart; i < drawList->VtxBuffer.Size; i++) {
@@ -355,11 +508,11 @@ void GuiRenderer::renderWindow(WidgetNode& node) {
             float dy = v.pos.y - cy;
 
             // Apply scale
-            dx *= node.scaleX;
-            dy *= node.scaleY;
+            dx *= props.scaleX;
+            dy *= props.scaleY;
 
             // Apply Y-axis rotation with perspective
-            if (node.rotationY != 0.0f) {
+            if (props.rotationY != 0.0f) {
                 float xRot = dx * cosR;
                 float z = dx * sinR;
                 float pScale = perspD / (perspD + z);
@@ -381,7 +534,7 @@ void GuiRenderer::renderWindow(WidgetNode& node) {
 
     if (!open) {
         node.visible = false;
-        if (node.onClose) node.onClose(node);
+        if (node.callbacks().onClose) node.callbacks().onClose(node);
     }
 }
 
@@ -396,98 +549,102 @@ void GuiRenderer::renderButton(WidgetNode& node) {
     } else {
         clicked = ImGui::Button(node.label.c_str());
     }
-    if (clicked && node.onClick) {
-        node.onClick(node);
+    if (clicked && node.callbacks().onClick) {
+        node.callbacks().onClick(node);
     }
 }
 
 void GuiRenderer::renderCheckbox(WidgetNode& node) {
     if (ImGui::Checkbox(node.label.c_str(), &node.boolValue)) {
-        if (node.onChange) node.onChange(node);
+        if (node.callbacks().onChange) node.callbacks().onChange(node);
     }
 }
 
 void GuiRenderer::renderSlider(WidgetNode& node) {
-    const char* fmt = node.formatString.empty() ? nullptr : node.formatString.c_str();
+    const WidgetNode::Props& props = node.props();
+    const char* fmt = props.formatString.empty() ? nullptr : props.formatString.c_str();
     if (ImGui::SliderFloat(node.label.c_str(), &node.floatValue,
-                           node.minFloat, node.maxFloat, fmt)) {
-        if (node.onChange) node.onChange(node);
+                           props.minFloat, props.maxFloat, fmt)) {
+        if (node.callbacks().onChange) node.callbacks().onChange(node);
     }
 }
 
 void GuiRenderer::renderSliderInt(WidgetNode& node) {
-    const char* fmt = node.formatString.empty() ? nullptr : node.formatString.c_str();
+    const WidgetNode::Props& props = node.props();
+    const char* fmt = props.formatString.empty() ? nullptr : props.formatString.c_str();
     if (ImGui::SliderInt(node.label.c_str(), &node.intValue,
-                         node.minInt, node.maxInt, fmt)) {
-        if (node.onChange) node.onChange(node);
+                         props.minInt, props.maxInt, fmt)) {
+        if (node.callbacks().onChange) node.callbacks().onChange(node);
     }
 }
 
 void GuiRenderer::renderInputText(WidgetNode& node) {
+    std::string& value = node.propsMut().stringValue;
+
     // Ensure buffer has enough capacity for editing
-    if (node.stringValue.capacity() < 256) {
-        node.stringValue.reserve(256);
+    if (value.capacity() < 256) {
+        value.reserve(256);
     }
     // Resize to capacity so ImGui can write into the full buffer
-    size_t cap = node.stringValue.capacity();
-    node.stringValue.resize(cap);
+    size_t cap = value.capacity();
+    value.resize(cap);
 
-    InputTextCallbackData cbData{&node.stringValue, &node};
+    InputTextCallbackData cbData{&value, &node};
 
     ImGuiInputTextFlags flags = ImGuiInputTextFlags_CallbackResize;
-    if (node.onSubmit) {
+    if (node.callbacks().onSubmit) {
         flags |= ImGuiInputTextFlags_EnterReturnsTrue;
     }
-    if (node.onHistory) {
+    if (node.callbacks().onHistory) {
         flags |= ImGuiInputTextFlags_CallbackHistory;
     }
 
     bool enterPressed = ImGui::InputText(
         node.label.c_str(),
-        node.stringValue.data(),
-        node.stringValue.size() + 1,  // +1 for null terminator
+        value.data(),
+        value.size() + 1,  // +1 for null terminator
         flags,
         inputTextCallback,
         &cbData
     );
 
     // Trim to actual string length (ImGui writes null-terminated)
-    node.stringValue.resize(std::strlen(node.stringValue.c_str()));
+    value.resize(std::strlen(value.c_str()));
 
     if (ImGui::IsItemDeactivatedAfterEdit()) {
-        if (node.onChange) node.onChange(node);
+        if (node.callbacks().onChange) node.callbacks().onChange(node);
     }
 
-    if (enterPressed && node.onSubmit) {
-        node.onSubmit(node);
+    if (enterPressed && node.callbacks().onSubmit) {
+        node.callbacks().onSubmit(node);
     }
 }
 
 void GuiRenderer::renderInputInt(WidgetNode& node) {
     if (ImGui::InputInt(node.label.c_str(), &node.intValue)) {
-        if (node.onChange) node.onChange(node);
+        if (node.callbacks().onChange) node.callbacks().onChange(node);
     }
 }
 
 void GuiRenderer::renderInputFloat(WidgetNode& node) {
     if (ImGui::InputFloat(node.label.c_str(), &node.floatValue)) {
-        if (node.onChange) node.onChange(node);
+        if (node.callbacks().onChange) node.callbacks().onChange(node);
     }
 }
 
 void GuiRenderer::renderCombo(WidgetNode& node) {
     // Get preview text
     const char* preview = (node.selectedIndex >= 0 &&
-                           node.selectedIndex < static_cast<int>(node.items.size()))
-                          ? node.items[static_cast<size_t>(node.selectedIndex)].c_str()
+                           node.selectedIndex < static_cast<int>(node.props().items.size()))
+                          ? node.props().items[static_cast<size_t>(node.selectedIndex)].c_str()
                           : "";
 
     if (ImGui::BeginCombo(node.label.c_str(), preview)) {
-        for (int i = 0; i < static_cast<int>(node.items.size()); i++) {
+        for (int i = 0; i < static_cast<int>(node.props().items.size()); i++) {
             bool isSelected = (i == node.selectedIndex);
-            if (ImGui::Selectable(node.items[static_cast<size_t>(i)].c_str(), isSelected)) {
+            if (ImGui::Selectable(node.props().items[static_cast<size_t>(i)].c_str(), isSelected)) {
                 node.selectedIndex = i;
-                if (node.onChange) node.onChange(node);
+                if (node.callbacks().onChange) node.callbacks().onChange(node);
             }
             if (isSelected) {
                 ImGui::SetItemDefaultFocus();
@@ -508,7 +665,7 @@ void GuiRenderer::renderGroup(WidgetNode& node) {
 }
 
 void GuiRenderer::renderColumns(WidgetNode& node) {
-    if (node.columnCount <= 1) {
+    if (node.props().columnCount <= 1) {
         // Just render children sequentially
         for (auto& child : node.children) {
             renderNode(child);
@@ -516,7 +673,7 @@ void GuiRenderer::renderColumns(WidgetNode& node) {
         return;
     }
 
-    ImGui::Columns(node.columnCount, nullptr, false);
+    ImGui::Columns(node.props().columnCount, nullptr, false);
     for (size_t i = 0; i < node.children.size(); i++) {
         renderNode(node.children[i]);
         if (i + 1 < node.children.size()) {
@@ -527,11 +684,12 @@ void GuiRenderer::renderColumns(WidgetNode& node) {
 }
 
 void GuiRenderer::renderImage(WidgetNode& node) {
-    if (node.texture.valid()) {
-        ImGui::Image(static_cast<ImTextureID>(node.texture),
-                     {node.imageWidth, node.imageHeight});
-        if (node.onClick && ImGui::IsItemClicked()) {
-            node.onClick(node);
+    const WidgetNode::Props& props = node.props();
+    if (props.texture.valid()) {
+        ImGui::Image(static_cast<ImTextureID>(props.texture),
+                     {props.imageWidth, props.imageHeight});
+        if (node.callbacks().onClick && ImGui::IsItemClicked()) {
+            node.callbacks().onClick(node);
         }
     }
 }
@@ -539,8 +697,8 @@ void GuiRenderer::renderImage(WidgetNode& node) {
 // -- Phase 3: Layout & Display ------------------------------------------------
 
 void GuiRenderer::renderSameLine(WidgetNode& node) {
-    if (node.offsetX > 0) {
-        ImGui::SameLine(node.offsetX);
+    if (node.props().offsetX > 0) {
+        ImGui::SameLine(node.props().offsetX);
     } else {
         ImGui::SameLine();
     }
@@ -551,7 +709,8 @@ void GuiRenderer::renderSpacing(WidgetNode& /*node*/) {
 }
 
 void GuiRenderer::renderTextColored(WidgetNode& node) {
-    ImGui::TextColored({node.colorR, node.colorG, node.colorB, node.colorA},
+    const WidgetNode::Props& props = node.props();
+    ImGui::TextColored({props.colorR, props.colorG, props.colorB, props.colorA},
                        "%s", node.textContent.c_str());
 }
 
@@ -564,9 +723,10 @@ void GuiRenderer::renderTextDisabled(WidgetNode& node) {
 }
 
 void GuiRenderer::renderProgressBar(WidgetNode& node) {
+    const WidgetNode::Props& props = node.props();
     float w = (node.width > 0) ? node.width : -FLT_MIN;
     float h = node.height;
-    const char* overlay = node.overlayText.empty() ? nullptr : node.overlayText.c_str();
+    const char* overlay = props.overlayText.empty() ? nullptr : props.overlayText.c_str();
     ImGui::ProgressBar(node.floatValue, {w, h}, overlay);
 }
 
@@ -609,8 +769,8 @@ void GuiRenderer::renderTreeNode(WidgetNode& node) {
 
     bool open = ImGui::TreeNodeEx(node.label.c_str(), flags);
 
-    if (ImGui::IsItemClicked() && node.onClick) {
-        node.onClick(node);
+    if (ImGui::IsItemClicked() && node.callbacks().onClick) {
+        node.callbacks().onClick(node);
     }
 
     if (open && !node.leaf) {
@@ -628,9 +788,9 @@ void GuiRenderer::renderChild(WidgetNode& node) {
     if (node.border) childFlags |= ImGuiChildFlags_Borders;
 
     if (ImGui::BeginChild(id, {node.width, node.height}, childFlags)) {
-        for (auto& child : node.children) {
-            renderNode(child);
-        }
+        bool clip = !node.children.empty() && isChildRowType(node.children.front().type) &&
+                    hasUniformRows(node, node.children.front().type);
+        renderChildRows(node, clip);
         if (node.autoScroll && ImGui::GetScrollY() >= ImGui::GetScrollMaxY()) {
             ImGui::SetScrollHereY(1.0f);
         }
@@ -657,31 +817,31 @@ void GuiRenderer::renderMenu(WidgetNode& node) {
 }
 
 void GuiRenderer::renderMenuItem(WidgetNode& node) {
-    const char* shortcut = node.shortcutText.empty() ? nullptr : node.shortcutText.c_str();
+    const WidgetNode::Props& props = node.props();
+    const char* shortcut = props.shortcutText.empty() ? nullptr : props.shortcutText.c_str();
 
     if (ImGui::MenuItem(node.label.c_str(), shortcut, node.checked)) {
-        if (node.onClick) node.onClick(node);
+        if (node.callbacks().onClick) node.callbacks().onClick(node);
     }
 }
 
 // -- Phase 5: Tables ----------------------------------------------------------
 
 void GuiRenderer::renderTable(WidgetNode& node) {
+    const WidgetNode::Props& props = node.props();
     const char* id = node.id.empty() ? "##table" : node.id.c_str();
-    int numCols = node.columnCount > 0 ? node.columnCount : 1;
+    int numCols = props.columnCount > 0 ? props.columnCount : 1;
 
-    if (ImGui::BeginTable(id, numCols, static_cast<ImGuiTableFlags>(node.tableFlags))) {
+    if (ImGui::BeginTable(id, numCols, static_cast<ImGuiTableFlags>(props.tableFlags))) {
         // Setup column headers if provided (stored in items)
-        if (!node.items.empty()) {
-            for (const auto& header : node.items) {
+        if (!props.items.empty()) {
+            for (const auto& header : props.items) {
                 ImGui::TableSetupColumn(header.c_str());
             }
             ImGui::TableHeadersRow();
         }
 
-        for (auto& child : node.children) {
-            renderNode(child);
-        }
+        renderChildRows(node, hasUniformRows(node, WidgetNode::Type::TableRow));
         ImGui::EndTable();
     }
 }
@@ -704,36 +864,42 @@ void GuiRenderer::renderTableColumn(WidgetNode& /*node*/) {
 // -- Phase 6: Advanced Input --------------------------------------------------
 
 void GuiRenderer::renderColorEdit(WidgetNode& node) {
-    float col[4] = {node.colorR, node.colorG, node.colorB, node.colorA};
+    const WidgetNode::Props& props = node.props();
+    float col[4] = {props.colorR, props.colorG, props.colorB, props.colorA};
     if (ImGui::ColorEdit4(node.label.c_str(), col)) {
-        node.colorR = col[0]; node.colorG = col[1];
-        node.colorB = col[2]; node.colorA = col[3];
-        if (node.onChange) node.onChange(node);
+        WidgetNode::Props& out = node.propsMut();
+        out.colorR = col[0]; out.colorG = col[1];
+        out.colorB = col[2]; out.colorA = col[3];
+        if (node.callbacks().onChange) node.callbacks().onChange(node);
     }
 }
 
 void GuiRenderer::renderColorPicker(WidgetNode& node) {
-    float col[4] = {node.colorR, node.colorG, node.colorB, node.colorA};
+    const WidgetNode::Props& props = node.props();
+    float col[4] = {props.colorR, props.colorG, props.colorB, props.colorA};
     if (ImGui::ColorPicker4(node.label.c_str(), col)) {
-        node.colorR = col[0]; node.colorG = col[1];
-        node.colorB = col[2]; node.colorA = col[3];
-        if (node.onChange) node.onChange(node);
+        WidgetNode::Props& out = node.propsMut();
+        out.colorR = col[0]; out.colorG = col[1];
+        out.colorB = col[2]; out.colorA = col[3];
+        if (node.callbacks().onChange) node.callbacks().onChange(node);
     }
 }
 
 void GuiRenderer::renderDragFloat(WidgetNode& node) {
-    const char* fmt = node.formatString.empty() ? nullptr : node.formatString.c_str();
+    const WidgetNode::Props& props = node.props();
+    const char* fmt = props.formatString.empty() ? nullptr : props.formatString.c_str();
     if (ImGui::DragFloat(node.label.c_str(), &node.floatValue,
-                         node.dragSpeed, node.minFloat, node.maxFloat, fmt)) {
-        if (node.onChange) node.onChange(node);
+                         props.dragSpeed, props.minFloat, props.maxFloat, fmt)) {
+        if (node.callbacks().onChange) node.callbacks().onChange(node);
     }
 }
 
 void GuiRenderer::renderDragInt(WidgetNode& node) {
-    const char* fmt = node.formatString.empty() ? nullptr : node.formatString.c_str();
+    const WidgetNode::Props& props = node.props();
+    const char* fmt = props.formatString.empty() ? nullptr : props.formatString.c_str();
     if (ImGui::DragInt(node.label.c_str(), &node.intValue,
-                       node.dragSpeed, node.minInt, node.maxInt, fmt)) {
-        if (node.onChange) node.onChange(node);
+                       props.dragSpeed, props.minInt, props.maxInt, fmt)) {
+        if (node.callbacks().onChange) node.callbacks().onChange(node);
     }
 }
 
@@ -741,7 +907,7 @@ void GuiRenderer::renderDragInt(WidgetNode& node) {
 
 void GuiRenderer::renderListBox(WidgetNode& node) {
     // Calculate size based on heightInItems (-1 = auto)
-    int heightItems = node.heightInItems;
+    int heightItems = node.props().heightInItems;
     float heightPx = 0.0f;
     if (heightItems > 0) {
         heightPx = ImGui::GetTextLineHeightWithSpacing() * heightItems
@@ -749,14 +915,25 @@ void GuiRenderer::renderListBox(WidgetNode& node) {
     }
 
     if (ImGui::BeginListBox(node.label.c_str(), {0.0f, heightPx})) {
-        for (int i = 0; i < static_cast<int>(node.items.size()); i++) {
-            bool isSelected = (i == node.selectedIndex);
-            if (ImGui::Selectable(node.items[static_cast<size_t>(i)].c_str(), isSelected)) {
-                node.selectedIndex = i;
-                if (node.onChange) node.onChange(node);
-            }
-            if (isSelected) {
-                ImGui::SetItemDefaultFocus();
+        // Items are uniform, so only the ones in view are submitted
+        int count = static_cast<int>(node.props().items.size());
+        ImGuiListClipper clipper;
+        clipper.Begin(count);
+        if (ImGui::IsWindowAppearing() && node.selectedIndex >= 0 && node.selectedIndex < count) {
+            clipper.IncludeItemByIndex(node.selectedIndex);  // for SetItemDefaultFocus()
+        }
+        while (clipper.Step()) {
+            for (int i = clipper.DisplayStart; i < clipper.DisplayEnd; i++) {
+                // onChange may replace the items
+                if (i >= static_cast<int>(node.props().items.size())) break;
+                bool isSelected = (i == node.selectedIndex);
+                if (ImGui::Selectable(node.props().items[static_cast<size_t>(i)].c_str(), isSelected)) {
+                    node.selectedIndex = i;
+                    if (node.callbacks().onChange) node.callbacks().onChange(node);
+                }
+                if (isSelected) {
+                    ImGui::SetItemDefaultFocus();
+                }
             }
         }
         ImGui::EndListBox();
@@ -804,13 +981,14 @@ void GuiRenderer::renderModal(WidgetNode& node) {
     }
 
     if (!open) {
-        if (node.onClose) node.onClose(node);
+        if (node.callbacks().onClose) node.callbacks().onClose(node);
     }
 }
 
 // -- Phase 8: Custom ----------------------------------------------------------
 
 void GuiRenderer::renderCanvas(WidgetNode& node) {
+    const WidgetNode::Props& props = node.props();
     const char* id = node.id.empty() ? "##canvas" : node.id.c_str();
     float w = node.width > 0 ? node.width : 200.0f;
     float h = node.height > 0 ? node.height : 200.0f;
@@ -825,10 +1003,10 @@ void GuiRenderer::renderCanvas(WidgetNode& node) {
     bool isHovered = ImGui::IsItemHovered();
 
     // Draw background if color is not the default white
-    if (node.colorR < 1.0f || node.colorG < 1.0f || node.colorB < 1.0f || node.colorA < 1.0f) {
+    if (props.colorR < 1.0f || props.colorG < 1.0f || props.colorB < 1.0f || props.colorA < 1.0f) {
         ImDrawList* drawList = ImGui::GetWindowDrawList();
         ImU32 bgCol = ImGui::ColorConvertFloat4ToU32(
-            {node.colorR, node.colorG, node.colorB, node.colorA});
+            {props.colorR, props.colorG, props.colorB, props.colorA});
         drawList->AddRectFilled(canvasPos,
             {canvasPos.x + canvasSize.x, canvasPos.y + canvasSize.y}, bgCol);
     }
@@ -842,20 +1020,20 @@ void GuiRenderer::renderCanvas(WidgetNode& node) {
     }
 
     // Draw texture if set (e.g. from SceneTexture offscreen render)
-    if (node.texture.valid()) {
+    if (props.texture.valid()) {
         ImDrawList* drawList = ImGui::GetWindowDrawList();
-        drawList->AddImage(static_cast<ImTextureID>(node.texture),
+        drawList->AddImage(static_cast<ImTextureID>(props.texture),
                            canvasPos,
                            {canvasPos.x + canvasSize.x, canvasPos.y + canvasSize.y});
     }
 
     // Custom draw callback
-    if (node.onDraw) {
-        node.onDraw(node);
+    if (node.callbacks().onDraw) {
+        node.callbacks().onDraw(node);
     }
 
-    if (isClicked && node.onClick) {
-        node.onClick(node);
+    if (isClicked && node.callbacks().onClick) {
+        node.callbacks().onClick(node);
     }
 
     (void)isHovered; // available for future tooltip support
@@ -887,40 +1065,42 @@ void GuiRenderer::renderTooltip(WidgetNode& node) {
 void GuiRenderer::renderRadioButton(WidgetNode& node) {
     // intValue = currently active value in the group
     // minInt = this radio button's value
-    if (ImGui::RadioButton(node.label.c_str(), &node.intValue, node.minInt)) {
-        if (node.onChange) node.onChange(node);
+    if (ImGui::RadioButton(node.label.c_str(), &node.intValue, node.props().minInt)) {
+        if (node.callbacks().onChange) node.callbacks().onChange(node);
     }
 }
 
 void GuiRenderer::renderSelectable(WidgetNode& node) {
     if (ImGui::Selectable(node.label.c_str(), &node.boolValue)) {
-        if (node.onClick) node.onClick(node);
+        if (node.callbacks().onClick) node.callbacks().onClick(node);
     }
 }
 
 void GuiRenderer::renderInputTextMultiline(WidgetNode& node) {
-    if (node.stringValue.capacity() < 1024) {
-        node.stringValue.reserve(1024);
+    std::string& value = node.propsMut().stringValue;
+
+    if (value.capacity() < 1024) {
+        value.reserve(1024);
     }
-    size_t cap = node.stringValue.capacity();
-    node.stringValue.resize(cap);
+    size_t cap = value.capacity();
+    value.resize(cap);
 
-    InputTextCallbackData cbData{&node.stringValue, nullptr};
+    InputTextCallbackData cbData{&value, nullptr};
 
     ImGui::InputTextMultiline(
         node.label.c_str(),
-        node.stringValue.data(),
-        node.stringValue.size() + 1,
+        value.data(),
+        value.size() + 1,
         {node.width, node.height},
         ImGuiInputTextFlags_CallbackResize,
         inputTextCallback,
         &cbData
     );
 
-    node.stringValue.resize(std::strlen(node.stringValue.c_str()));
+    value.resize(std::strlen(value.c_str()));
 
     if (ImGui::IsItemDeactivatedAfterEdit()) {
-        if (node.onChange) node.onChange(node);
+        if (node.callbacks().onChange) node.callbacks().onChange(node);
     }
 }
 
@@ -963,8 +1143,9 @@ static bool isStyleVarVec2(int idx) {
 }
 
 void GuiRenderer::renderPushStyleColor(WidgetNode& node) {
+    const WidgetNode::Props& props = node.props();
     ImGui::PushStyleColor(node.intValue,
-        ImVec4(node.colorR, node.colorG, node.colorB, node.colorA));
+        ImVec4(props.colorR, props.colorG, props.colorB, props.colorA));
 }
 
 void GuiRenderer::renderPopStyleColor(WidgetNode& node) {
@@ -996,73 +1177,79 @@ void GuiRenderer::renderNewLine(WidgetNode& /*node*/) {
 // -- Phase 12: Advanced Input (continued) -------------------------------------
 
 void GuiRenderer::renderDragFloat3(WidgetNode& node) {
-    float v[3] = {node.floatX, node.floatY, node.floatZ};
-    const char* fmt = node.formatString.empty() ? nullptr : node.formatString.c_str();
-    if (ImGui::DragFloat3(node.label.c_str(), v, node.dragSpeed,
-                          node.minFloat, node.maxFloat, fmt)) {
-        node.floatX = v[0];
-        node.floatY = v[1];
-        node.floatZ = v[2];
-        if (node.onChange) node.onChange(node);
+    const WidgetNode::Props& props = node.props();
+    float v[3] = {props.floatX, props.floatY, props.floatZ};
+    const char* fmt = props.formatString.empty() ? nullptr : props.formatString.c_str();
+    if (ImGui::DragFloat3(node.label.c_str(), v, props.dragSpeed,
+                          props.minFloat, props.maxFloat, fmt)) {
+        WidgetNode::Props& out = node.propsMut();
+        out.floatX = v[0];
+        out.floatY = v[1];
+        out.floatZ = v[2];
+        if (node.callbacks().onChange) node.callbacks().onChange(node);
     }
 }
 
 void GuiRenderer::renderInputTextWithHint(WidgetNode& node) {
-    if (node.stringValue.capacity() < 256) {
-        node.stringValue.reserve(256);
+    std::string& value = node.propsMut().stringValue;
+
+    if (value.capacity() < 256) {
+        value.reserve(256);
     }
-    size_t cap = node.stringValue.capacity();
-    node.stringValue.resize(cap);
+    size_t cap = value.capacity();
+    value.resize(cap);
 
-    InputTextCallbackData cbData{&node.stringValue, &node};
+    InputTextCallbackData cbData{&value, &node};
 
     ImGuiInputTextFlags flags = ImGuiInputTextFlags_CallbackResize;
-    if (node.onSubmit) {
+    if (node.callbacks().onSubmit) {
         flags |= ImGuiInputTextFlags_EnterReturnsTrue;
     }
-    if (node.onHistory) {
+    if (node.callbacks().onHistory) {
         flags |= ImGuiInputTextFlags_CallbackHistory;
     }
 
     bool enterPressed = ImGui::InputTextWithHint(
         node.label.c_str(),
-        node.hintText.c_str(),
-        node.stringValue.data(),
-        node.stringValue.size() + 1,
+        node.props().hintText.c_str(),
+        value.data(),
+        value.size() + 1,
         flags,
         inputTextCallback,
         &cbData
     );
 
-    node.stringValue.resize(std::strlen(node.stringValue.c_str()));
+    value.resize(std::strlen(value.c_str()));
 
     if (ImGui::IsItemDeactivatedAfterEdit()) {
-        if (node.onChange) node.onChange(node);
+        if (node.callbacks().onChange) node.callbacks().onChange(node);
     }
 
-    if (enterPressed && node.onSubmit) {
-        node.onSubmit(node);
+    if (enterPressed && node.callbacks().onSubmit) {
+        node.callbacks().onSubmit(node);
     }
 }
 
 void GuiRenderer::renderSliderAngle(WidgetNode& node) {
-    const char* fmt = node.formatString.empty() ? nullptr : node.formatString.c_str();
+    const WidgetNode::Props& props = node.props();
+    const char* fmt = props.formatString.empty() ? nullptr : props.formatString.c_str();
     if (ImGui::SliderAngle(node.label.c_str(), &node.floatValue,
-                           node.minFloat, node.maxFloat, fmt)) {
-        if (node.onChange) node.onChange(node);
+                           props.minFloat, props.maxFloat, fmt)) {
+        if (node.callbacks().onChange) node.callbacks().onChange(node);
     }
 }
 
 void GuiRenderer::renderSmallButton(WidgetNode& node) {
     if (ImGui::SmallButton(node.label.c_str())) {
-        if (node.onClick) node.onClick(node);
+        if (node.callbacks().onClick) node.callbacks().onClick(node);
     }
 }
 
 void GuiRenderer::renderColorButton(WidgetNode& node) {
-    ImVec4 col{node.colorR, node.colorG, node.colorB, node.colorA};
+    const WidgetNode::Props& props = node.props();
+    ImVec4 col{props.colorR, props.colorG, props.colorB, props.colorA};
     if (ImGui::ColorButton(node.label.c_str(), col)) {
-        if (node.onClick) node.onClick(node);
+        if (node.callbacks().onClick) node.callbacks().onClick(node);
     }
 }
 
@@ -1109,34 +1296,37 @@ void GuiRenderer::renderItemTooltip(WidgetNode& node) {
 }
 
 void GuiRenderer::renderImageButton(WidgetNode& node) {
-    if (!node.texture.valid()) return;
+    const WidgetNode::Props& props = node.props();
+    if (!props.texture.valid()) return;
 
     const char* strId = node.id.empty() ? "##imgbtn" : node.id.c_str();
-    if (ImGui::ImageButton(strId, static_cast<ImTextureID>(node.texture),
-                           {node.imageWidth, node.imageHeight})) {
-        if (node.onClick) node.onClick(node);
+    if (ImGui::ImageButton(strId, static_cast<ImTextureID>(props.texture),
+                           {props.imageWidth, props.imageHeight})) {
+        if (node.callbacks().onClick) node.callbacks().onClick(node);
     }
 }
 
 // -- Phase 15: Display (plots) ------------------------------------------------
 
 void GuiRenderer::renderPlotLines(WidgetNode& node) {
-    const char* overlay = node.overlayText.empty() ? nullptr : node.overlayText.c_str();
+    const WidgetNode::Props& props = node.props();
+    const char* overlay = props.overlayText.empty() ? nullptr : props.overlayText.c_str();
     ImGui::PlotLines(node.label.c_str(),
-                     node.plotValues.data(),
-                     static_cast<int>(node.plotValues.size()),
+                     props.plotValues.data(),
+                     static_cast<int>(props.plotValues.size()),
                      0, overlay,
-                     node.minFloat, node.maxFloat,
+                     props.minFloat, props.maxFloat,
                      {node.width, node.height});
 }
 
 void GuiRenderer::renderPlotHistogram(WidgetNode& node) {
-    const char* overlay = node.overlayText.empty() ? nullptr : node.overlayText.c_str();
+    const WidgetNode::Props& props = node.props();
+    const char* overlay = props.overlayText.empty() ? nullptr : props.overlayText.c_str();
     ImGui::PlotHistogram(node.label.c_str(),
-                         node.plotValues.data(),
-                         static_cast<int>(node.plotValues.size()),
+                         props.plotValues.data(),
+                         static_cast<int>(props.plotValues.size()),
                          0, overlay,
-                         node.minFloat, node.maxFloat,
+                         props.minFloat, props.maxFloat,
                          {node.width, node.height});
 }
 
@@ -1209,15 +1399,138 @@ void GuiRenderer::renderPopTheme(WidgetNode& node) {
     }
 }
 
+// -- Virtual lists ------------------------------------------------------------
+
+void GuiRenderer::renderVirtualList(WidgetNode& node) {
+    const char* id = node.id.empty() ? "##virtual_list" : node.id.c_str();
+
+    ImGuiChildFlags childFlags = ImGuiChildFlags_None;
+    if (node.border) childFlags |= ImGuiChildFlags_Borders;
+
+    if (ImGui::BeginChild(id, {node.width, node.height}, childFlags)) {
+        renderVirtualRows(node);
+    }
+    ImGui::EndChild();
+}
+
+void GuiRenderer::renderVirtualTable(WidgetNode& node) {
+    const WidgetNode::Props& props = node.props();
+    const char* id = node.id.empty() ? "##virtual_table" : node.id.c_str();
+    int numCols = props.columnCount > 0 ? props.columnCount : 1;
+
+    // The table scrolls itself so the clipper only sees its own rows
+    ImGuiTableFlags flags = static_cast<ImGuiTableFlags>(props.tableFlags) | ImGuiTableFlags_ScrollY;
+    if (node.callbacks().onSort) flags |= ImGuiTableFlags_Sortable;
+
+    if (!ImGui::BeginTable(id, numCols, flags, {node.width, node.height})) return;
+
+    if (!props.items.empty()) {
+        ImGui::TableSetupScrollFreeze(0, 1);
+        for (size_t i = 0; i < props.items.size(); i++) {
+            ImGuiTableColumnFlags colFlags = ImGuiTableColumnFlags_None;
+            if (static_cast<int>(i) == props.sortColumn) {
+                colFlags |= ImGuiTableColumnFlags_DefaultSort;
+                colFlags |= props.sortAscending ? ImGuiTableColumnFlags_PreferSortAscending
+                                                : ImGuiTableColumnFlags_PreferSortDescending;
+            }
+            ImGui::TableSetupColumn(props.items[i].c_str(), colFlags);
+        }
+        ImGui::TableHeadersRow();
+    }
+
+    // Sorting is by column index only; the data source reorders its rows
+    ImGuiTableSortSpecs* specs = ImGui::TableGetSortSpecs();
+    if (specs && specs->SpecsDirty) {
+        WidgetNode::Props& sortProps = node.propsMut();
+        if (specs->SpecsCount > 0) {
+            sortProps.sortColumn = specs->Specs[0].ColumnIndex;
+            sortProps.sortAscending = specs->Specs[0].SortDirection != ImGuiSortDirection_Descending;
+        } else {
+            sortProps.sortColumn = -1;
+            sortProps.sortAscending = true;
+        }
+        specs->SpecsDirty = false;
+        if (node.callbacks().onSort) node.callbacks().onSort(node);
+    }
+
+    renderVirtualRows(node);
+    ImGui::EndTable();
+}
+
+void GuiRenderer::renderVirtualRows(WidgetNode& node) {
+    if (!node.callbacks().rowProvider) return;
+
+    // Row heights are measured from the first row, so per-frame cost
+    // depends on the rows in view, not on rowCount
+    ImGuiListClipper clipper;
+    clipper.Begin(std::max(node.props().rowCount, 0));
+    while (clipper.Step()) {
+        for (int row = clipper.DisplayStart; row < clipper.DisplayEnd; row++) {
+            // A callback may have shrunk the data source mid-frame
+            if (row >= node.props().rowCount) break;
+            renderVirtualRow(node, row);
+        }
+    }
+}
+
+void GuiRenderer::renderVirtualRow(WidgetNode& node, int row) {
+    const bool inTable = node.type == WidgetNode::Type::VirtualTable;
+    float rowHeight = node.props().rowHeight;
+    WidgetNode rowNode = buildVirtualRow(node, row);
+
+    ImGui::PushID(row);
+    if (inTable) {
+        ImGui::TableNextRow(ImGuiTableRowFlags_None, rowHeight);
+        ImGui::TableNextColumn();
+    }
+    ImVec2 rowPos = ImGui::GetCursorScreenPos();
+
+    // Selection highlight behind the row's own widgets
+    if (node.props().rowSelection) {
+        ImGuiSelectableFlags selFlags = ImGuiSelectableFlags_AllowOverlap;
+        if (inTable) selFlags |= ImGuiSelectableFlags_SpanAllColumns;
+        if (ImGui::Selectable("##row", row == node.selectedIndex, selFlags, {0.0f, rowHeight})) {
+            node.selectedIndex = row;
+            if (node.callbacks().onChange) node.callbacks().onChange(node);
+        }
+        ImGui::SetCursorScreenPos(rowPos);
+    }
+
+    if (inTable && rowNode.type == WidgetNode::Type::TableRow) {
+        // Each child of a tableRow fills the next cell
+        for (size_t i = 0; i < rowNode.children.size(); i++) {
+            if (i > 0) ImGui::TableNextColumn();
+            renderNode(rowNode.children[i]);
+        }
+    } else {
+        renderNode(rowNode);
+    }
+
+    // Pad short list rows so every row keeps the same height
+    if (!inTable && rowHeight > 0.0f) {
+        float used = ImGui::GetCursorScreenPos().y - rowPos.y - ImGui::GetStyle().ItemSpacing.y;
+        if (used < rowHeight) ImGui::Dummy({0.0f, rowHeight - used});
+    }
+    ImGui::PopID();
+}
+
+WidgetNode GuiRenderer::buildVirtualRow(const WidgetNode& node, int row) {
+    WidgetArena::Scope scope(*rowArena_);
+    return node.callbacks().rowProvider(row);
+}
+
 // -- Drag and Drop ------------------------------------------------------------
 
 void GuiRenderer::handleDragDrop(WidgetNode& node) {
-    bool isDragSource = !node.dragType.empty();
-    bool isDropTarget = !node.dropAcceptType.empty();
+    bool isDragSource = !node.props().dragType.empty();
+    bool isDropTarget = !node.props().dropAcceptType.empty();
     if (!isDragSource && !isDropTarget) return;
 
-    bool allowTraditional = (node.dragMode == 0 || node.dragMode == 1);
-    bool allowClickPickup = (node.dragMode == 0 || node.dragMode == 2);
+    // Already allocated, since a drag or drop type is set
+    WidgetNode::Props& props = node.propsMut();
+
+    bool allowTraditional = (props.dragMode == 0 || props.dragMode == 1);
+    bool allowClickPickup = (props.dragMode == 0 || props.dragMode == 2);
 
     // === DRAG SOURCE ===
     if (isDragSource) {
@@ -1225,19 +1538,19 @@ void GuiRenderer::handleDragDrop(WidgetNode& node) {
         if (allowTraditional) {
             ImGuiDragDropFlags srcFlags = ImGuiDragDropFlags_SourceAllowNullID;
             if (ImGui::BeginDragDropSource(srcFlags)) {
-                ImGui::SetDragDropPayload(node.dragType.c_str(),
-                    node.dragData.data(), node.dragData.size());
+                ImGui::SetDragDropPayload(props.dragType.c_str(),
+                    props.dragData.data(), props.dragData.size());
 
                 // Preview: show image if Image widget, else show label/text
-                if (node.type == WidgetNode::Type::Image && node.texture.valid()) {
-                    ImGui::Image(static_cast<ImTextureID>(node.texture),
-                                 {node.imageWidth, node.imageHeight});
+                if (node.type == WidgetNode::Type::Image && props.texture.valid()) {
+                    ImGui::Image(static_cast<ImTextureID>(props.texture),
+                                 {props.imageWidth, props.imageHeight});
                 } else if (!node.label.empty()) {
                     ImGui::TextUnformatted(node.label.c_str());
                 } else if (!node.textContent.empty()) {
                     ImGui::TextUnformatted(node.textContent.c_str());
                 } else {
-                    ImGui::TextUnformatted(node.dragData.c_str());
+                    ImGui::TextUnformatted(props.dragData.c_str());
                 }
 
                 ImGui::EndDragDropSource();
@@ -1250,19 +1563,19 @@ void GuiRenderer::handleDragDrop(WidgetNode& node) {
                 // Only pick up if not in a traditional ImGui drag
                 if (!ImGui::GetDragDropPayload()) {
                     DragDropManager::CursorItem item;
-                    item.type = node.dragType;
-                    item.data = node.dragData;
-                    if (node.type == WidgetNode::Type::Image && node.texture.valid()) {
-                        item.textureId = static_cast<ImTextureID>(node.texture);
-                        item.iconWidth = node.imageWidth;
-                        item.iconHeight = node.imageHeight;
+                    item.type = props.dragType;
+                    item.data = props.dragData;
+                    if (node.type == WidgetNode::Type::Image && props.texture.valid()) {
+                        item.textureId = static_cast<ImTextureID>(props.texture);
+                        item.iconWidth = props.imageWidth;
+                        item.iconHeight = props.imageHeight;
                     } else {
                         item.fallbackText = !node.label.empty() ? node.label :
                                             !node.textContent.empty() ? node.textContent :
-                                            node.dragData;
+                                            props.dragData;
                     }
                     dndManager_->pickUp(item);
-                    if (node.onDragBegin) node.onDragBegin(node);
+                    if (node.callbacks().onDragBegin) node.callbacks().onDragBegin(node);
                 }
             }
         }
@@ -1274,19 +1587,19 @@ void GuiRenderer::handleDragDrop(WidgetNode& node) {
         if (allowTraditional) {
             if (ImGui::BeginDragDropTarget()) {
                 const ImGuiPayload* payload =
-                    ImGui::AcceptDragDropPayload(node.dropAcceptType.c_str());
+                    ImGui::AcceptDragDropPayload(props.dropAcceptType.c_str());
                 if (payload) {
-                    node.dragData = std::string(
+                    props.dragData = std::string(
                         static_cast<const char*>(payload->Data),
                         static_cast<size_t>(payload->DataSize));
-                    if (node.onDrop) node.onDrop(node);
+                    if (node.callbacks().onDrop) node.callbacks().onDrop(node);
                 }
                 ImGui::EndDragDropTarget();
             }
         }
 
         // Click-to-pick-up
-        if (dndManager_ && dndManager_->isHolding(node.dropAcceptType)) {
+        if (dndManager_ && dndManager_->isHolding(props.dropAcceptType)) {
             if (ImGui::IsItemHovered()) {
                 // Visual highlight: yellow border
                 ImVec2 rMin = ImGui::GetItemRectMin();
@@ -1299,8 +1612,8 @@ void GuiRenderer::handleDragDrop(WidgetNode& node) {
                 // Click to deliver
                 if (ImGui::IsItemClicked(ImGuiMouseButton_Left)) {
                     auto delivered = dndManager_->dropItem();
-                    node.dragData = std::move(delivered.data);
-                    if (node.onDrop) node.onDrop(node);
+                    props.dragData = std::move(delivered.data);
+                    if (node.callbacks().onDrop) node.callbacks().onDrop(node);
                 }
             }
         }
@@ -1336,7 +1649,7 @@ void GuiRenderer::collectState(WidgetNode& node, WidgetStateMap& out) {
             case WidgetNode::Type::InputText:
             case WidgetNode::Type::InputTextMultiline:
             case WidgetNode::Type::InputTextWithHint:
-                out[node.id] = node.stringValue;
+                out[node.id] = node.props().stringValue;
                 break;
 
             case WidgetNode::Type::Combo:
@@ -1347,12 +1660,13 @@ void GuiRenderer::collectState(WidgetNode& node, WidgetStateMap& out) {
             case WidgetNode::Type::ColorEdit:
             case WidgetNode::Type::ColorPicker:
                 out[node.id] = std::vector<float>{
-                    node.colorR, node.colorG, node.colorB, node.colorA};
+                    node.props().colorR, node.props().colorG,
+                    node.props().colorB, node.props().colorA};
                 break;
 
             case WidgetNode::Type::DragFloat3:
                 out[node.id] = std::vector<float>{
-                    node.floatX, node.floatY, node.floatZ};
+                    node.props().floatX, node.props().floatY, node.props().floatZ};
                 break;
 
             default:
@@ -1399,7 +1713,7 @@ void GuiRenderer::applyState(WidgetNode& node, const WidgetStateMap& state) {
                 case WidgetNode::Type::InputTextMultiline:
                 case WidgetNode::Type::InputTextWithHint:
                     if (auto* s = std::get_if<std::string>(&val))
-                        node.stringValue = *s;
+                        node.propsMut().stringValue = *s;
                     break;
 
                 case WidgetNode::Type::Combo:
@@ -1412,8 +1726,9 @@ void GuiRenderer::applyState(WidgetNode& node, const WidgetStateMap& state) {
                 case WidgetNode::Type::ColorPicker:
                     if (auto* v = std::get_if<std::vector<float>>(&val)) {
                         if (v->size() >= 4) {
-                            node.colorR = (*v)[0]; node.colorG = (*v)[1];
-                            node.colorB = (*v)[2]; node.colorA = (*v)[3];
+                            WidgetNode::Props& props = node.propsMut();
+                            props.colorR = (*v)[0]; props.colorG = (*v)[1];
+                            props.colorB = (*v)[2]; props.colorA = (*v)[3];
                         }
                     }
                     break;
@@ -1421,9 +1736,10 @@ void GuiRenderer::applyState(WidgetNode& node, const WidgetStateMap& state) {
                 case WidgetNode::Type::DragFloat3:
                     if (auto* v = std::get_if<std::vector<float>>(&val)) {
                         if (v->size() >= 3) {
-                            node.floatX = (*v)[0];
-                            node.floatY = (*v)[1];
-                            node.floatZ = (*v)[2];
+                            WidgetNode::Props& props = node.propsMut();
+                            props.floatX = (*v)[0];
+                            props.floatY = (*v)[1];
+                            props.floatZ = (*v)[2];
                         }
                     }
                     break;
@@ -1,5 +1,6 @@
 #include <finegui/tween_manager.hpp>
 #include <finegui/gui_renderer.hpp>
+#include <finegui/gui_system.hpp>
 #include <cmath>
 #include <algorithm>
 
@@ -25,40 +26,40 @@ WidgetNode* TweenManager::resolve(int guiId, const std::vector<int>& childPath)
 
 float TweenManager::readProperty(const WidgetNode& node, TweenProperty prop) {
     switch (prop) {
-        case TweenProperty::Alpha:      return node.alpha;
-        case TweenProperty::PosX:       return node.windowPosX;
-        case TweenProperty::PosY:       return node.windowPosY;
+        case TweenProperty::Alpha:      return node.props().alpha;
+        case TweenProperty::PosX:       return node.props().windowPosX;
+        case TweenProperty::PosY:       return node.props().windowPosY;
         case TweenProperty::FloatValue: return node.floatValue;
         case TweenProperty::IntValue:   return static_cast<float>(node.intValue);
-        case TweenProperty::ColorR:     return node.colorR;
-        case TweenProperty::ColorG:     return node.colorG;
-        case TweenProperty::ColorB:     return node.colorB;
-        case TweenProperty::ColorA:     return node.colorA;
+        case TweenProperty::ColorR:     return node.props().colorR;
+        case TweenProperty::ColorG:     return node.props().colorG;
+        case TweenProperty::ColorB:     return node.props().colorB;
+        case TweenProperty::ColorA:     return node.props().colorA;
         case TweenProperty::Width:      return node.width;
         case TweenProperty::Height:     return node.height;
-        case TweenProperty::ScaleX:     return node.scaleX;
-        case TweenProperty::ScaleY:     return node.scaleY;
-        case TweenProperty::RotationY:  return node.rotationY;
+        case TweenProperty::ScaleX:     return node.props().scaleX;
+        case TweenProperty::ScaleY:     return node.props().scaleY;
+        case TweenProperty::RotationY:  return node.props().rotationY;
     }
     return 0.0f;
 }
 
 void TweenManager::writeProperty(WidgetNode& node, TweenProperty prop, float value) {
     switch (prop) {
-        case TweenProperty::Alpha:      node.alpha = value; break;
-        case TweenProperty::PosX:       node.windowPosX = value; break;
-        case TweenProperty::PosY:       node.windowPosY = value; break;
+        case TweenProperty::Alpha:      node.propsMut().alpha = value; break;
+        case TweenProperty::PosX:       node.propsMut().windowPosX = value; break;
+        case TweenProperty::PosY:       node.propsMut().windowPosY = value; break;
         case TweenProperty::FloatValue: node.floatValue = value; break;
         case TweenProperty::IntValue:   node.intValue = static_cast<int>(value); break;
-        case TweenProperty::ColorR:     node.colorR = value; break;
-        case TweenProperty::ColorG:     node.colorG = value; break;
-        case TweenProperty::ColorB:     node.colorB = value; break;
-        case TweenProperty::ColorA:     node.colorA = value; break;
+        case TweenProperty::ColorR:     node.propsMut().colorR = value; break;
+        case TweenProperty::ColorG:     node.propsMut().colorG = value; break;
+        case TweenProperty::ColorB:     node.propsMut().colorB = value; break;
+        case TweenProperty::ColorA:     node.propsMut().colorA = value; break;
         case TweenProperty::Width:      node.width = value; break;
         case TweenProperty::Height:     node.height = value; break;
-        case TweenProperty::ScaleX:     node.scaleX = value; break;
-        case TweenProperty::ScaleY:     node.scaleY = value; break;
-        case TweenProperty::RotationY:  node.rotationY = value; break;
+        case TweenProperty::ScaleX:     node.propsMut().scaleX = value; break;
+        case TweenProperty::ScaleY:     node.propsMut().scaleY = value; break;
+        case TweenProperty::RotationY:  node.propsMut().rotationY = value; break;
     }
 }
 
@@ -148,11 +149,12 @@ void TweenManager::update(float dt) {
             it = shakes_.erase(it);
             continue;
         }
+        WidgetNode::Props& props = node->propsMut();
 
         if (!sk.started) {
             // Capture base position
-            sk.basePosX = (node->windowPosX != FLT_MAX) ? node->windowPosX : 0.0f;
-            sk.basePosY = (node->windowPosY != FLT_MAX) ? node->windowPosY : 0.0f;
+            sk.basePosX = (props.windowPosX != FLT_MAX) ? props.windowPosX : 0.0f;
+            sk.basePosY = (props.windowPosY != FLT_MAX) ? props.windowPosY : 0.0f;
             sk.started = true;
         }
 
@@ -161,8 +163,8 @@ void TweenManager::update(float dt) {
 
         if (t >= 1.0f) {
             // Restore base position
-            node->windowPosX = sk.basePosX;
-            node->windowPosY = sk.basePosY;
+            props.windowPosX = sk.basePosX;
+            props.windowPosY = sk.basePosY;
             if (sk.onComplete) {
                 completedCallbacks.push_back(
                     [cb = sk.onComplete, id = sk.id]() { cb(id); });
@@ -173,12 +175,17 @@ void TweenManager::update(float dt) {
             float decay = std::exp(-3.0f * t);
             float offset = sk.amplitude * decay *
                            std::sin(2.0f * static_cast<float>(M_PI) * sk.frequency * sk.elapsed);
-            node->windowPosX = sk.basePosX + offset;
-            node->windowPosY = sk.basePosY + offset * 0.7f; // slightly different Y for natural feel
+            props.windowPosX = sk.basePosX + offset;
+            props.windowPosY = sk.basePosY + offset * 0.7f; // slightly different Y for natural feel
             ++it;
         }
     }
 
+    // Keep a cached GUI layer re-rendering while anything animates
+    if (!tweens_.empty() || !shakes_.empty()) {
+        renderer_.guiSystem().invalidateLayer();
+    }
+
     // Fire callbacks after mutation is done (safe to start new tweens in callbacks)
     for (auto& cb : completedCallbacks) {
         cb();
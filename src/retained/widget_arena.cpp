@@ -0,0 +1,136 @@
+#include <finegui/widget_arena.hpp>
+
+#include <algorithm>
+#include <stdexcept>
+#include <string>
+
+namespace finegui {
+
+namespace detail {
+
+// Held apart from the WidgetArena so blocks that outlive it keep their
+// memory: once orphaned, the last block freed deletes it
+struct ArenaState {
+    struct Chunk {
+        std::unique_ptr<unsigned char[]> data;
+        size_t size;
+    };
+
+    std::vector<Chunk> chunks;
+    size_t liveBlocks = 0;
+    bool orphaned = false;  // the arena is gone
+};
+
+} // namespace detail
+
+namespace {
+
+thread_local WidgetArena* tCurrentArena = nullptr;
+
+// Precedes every node storage block; nullptr = heap
+struct alignas(WidgetArena::kAlignment) BlockHeader {
+    detail::ArenaState* state;
+};
+
+constexpr size_t alignUp(size_t size) {
+    return (size + WidgetArena::kAlignment - 1) & ~(WidgetArena::kAlignment - 1);
+}
+
+} // namespace
+
+// ============================================================================
+// WidgetArena
+// ============================================================================
+
+WidgetArena::WidgetArena(size_t chunkSize)
+    : chunkSize_(std::max(alignUp(chunkSize), kAlignment))
+    , state_(new detail::ArenaState) {}
+
+WidgetArena::~WidgetArena() {
+    if (state_->liveBlocks == 0) {
+        delete state_;
+    } else {
+        state_->orphaned = true;
+    }
+}
+
+void* WidgetArena::allocate(size_t size) {
+    size = alignUp(std::max<size_t>(size, 1));
+
+    // Move on to the next chunk with room; later chunks are empty after reset()
+    auto& chunks = state_->chunks;
+    while (chunkIndex_ < chunks.size() &&
+           chunks[chunkIndex_].size - chunkOffset_ < size) {
+        chunkIndex_++;
+        chunkOffset_ = 0;
+    }
+
+    if (chunkIndex_ == chunks.size()) {
+        size_t chunkSize = std::max(chunkSize_, size);
+        chunks.push_back({std::unique_ptr<unsigned char[]>(new unsigned char[chunkSize]), chunkSize});
+        bytesReserved_ += chunkSize;
+        chunkOffset_ = 0;
+    }
+
+    void* ptr = chunks[chunkIndex_].data.get() + chunkOffset_;
+    chunkOffset_ += size;
+    bytesUsed_ += size;
+    return ptr;
+}
+
+void WidgetArena::reset() {
+    if (state_->liveBlocks != 0) {
+        throw std::runtime_error("WidgetArena::reset: " + std::to_string(state_->liveBlocks) +
+                                 " node blocks still in use");
+    }
+    chunkIndex_ = 0;
+    chunkOffset_ = 0;
+    bytesUsed_ = 0;
+}
+
+size_t WidgetArena::liveBlocks() const {
+    return state_->liveBlocks;
+}
+
+WidgetArena::Scope::Scope(WidgetArena& arena) : previous_(tCurrentArena) {
+    tCurrentArena = &arena;
+}
+
+WidgetArena::Scope::~Scope() {
+    tCurrentArena = previous_;
+}
+
+WidgetArena* WidgetArena::current() {
+    return tCurrentArena;
+}
+
+// ============================================================================
+// Node storage
+// ============================================================================
+
+namespace detail {
+
+void* allocateNodeStorage(size_t size) {
+    WidgetArena* arena = tCurrentArena;
+    void* mem = arena ? arena->allocate(sizeof(BlockHeader) + size)
+                      : ::operator new(sizeof(BlockHeader) + size);
+    auto* header = new (mem) BlockHeader{arena ? arena->state_ : nullptr};
+    if (arena) arena->state_->liveBlocks++;
+    return header + 1;
+}
+
+void freeNodeStorage(void* ptr) noexcept {
+    if (!ptr) return;
+    auto* header = static_cast<BlockHeader*>(ptr) - 1;
+    if (ArenaState* state = header->state) {
+        if (--state->liveBlocks == 0 && state->orphaned) {
+            delete state;
+        }
+    } else {
+        ::operator delete(header);
+    }
+}
+
+} // namespace detail
+
+} // namespace finegui
@@ -1,25 +1,31 @@
 #include <finegui/widget_node.hpp>
 
+#include <unordered_map>
+
 namespace finegui {
 
-WidgetNode WidgetNode::window(std::string title, std::vector<WidgetNode> children, int flags) {
+// Builders only write props() / callbacks() for values that are actually
+// given, so nodes that need neither never allocate side storage.
+
+WidgetNode WidgetNode::window(std::string title, WidgetList children, int flags) {
     WidgetNode n;
     n.type = Type::Window;
     n.label = std::move(title);
     n.children = std::move(children);
-    n.windowFlags = flags;
+    if (flags) n.propsMut().windowFlags = flags;
     return n;
 }
 
 WidgetNode WidgetNode::window(std::string title, float width, float height,
-                              std::vector<WidgetNode> children, int flags) {
+                              WidgetList children, int flags) {
     WidgetNode n;
     n.type = Type::Window;
     n.label = std::move(title);
-    n.windowSizeW = width;
-    n.windowSizeH = height;
+    Props& p = n.propsMut();
+    p.windowSizeW = width;
+    p.windowSizeH = height;
     n.children = std::move(children);
-    n.windowFlags = flags;
+    p.windowFlags = flags;
     return n;
 }
 
@@ -34,7 +40,7 @@ WidgetNode WidgetNode::button(std::string label, WidgetCallback onClick) {
     WidgetNode n;
     n.type = Type::Button;
     n.label = std::move(label);
-    n.onClick = std::move(onClick);
+    if (onClick) n.callbacksMut().onClick = std::move(onClick);
     return n;
 }
 
@@ -43,7 +49,7 @@ WidgetNode WidgetNode::checkbox(std::string label, bool value, WidgetCallback on
     n.type = Type::Checkbox;
     n.label = std::move(label);
     n.boolValue = value;
-    n.onChange = std::move(onChange);
+    if (onChange) n.callbacksMut().onChange = std::move(onChange);
     return n;
 }
 
@@ -53,9 +59,10 @@ WidgetNode WidgetNode::slider(std::string label, float value, float min, float m
     n.type = Type::Slider;
     n.label = std::move(label);
     n.floatValue = value;
-    n.minFloat = min;
-    n.maxFloat = max;
-    n.onChange = std::move(onChange);
+    Props& p = n.propsMut();
+    p.minFloat = min;
+    p.maxFloat = max;
+    if (onChange) n.callbacksMut().onChange = std::move(onChange);
     return n;
 }
 
@@ -65,9 +72,10 @@ WidgetNode WidgetNode::sliderInt(std::string label, int value, int min, int max,
     n.type = Type::SliderInt;
     n.label = std::move(label);
     n.intValue = value;
-    n.minInt = min;
-    n.maxInt = max;
-    n.onChange = std::move(onChange);
+    Props& p = n.propsMut();
+    p.minInt = min;
+    p.maxInt = max;
+    if (onChange) n.callbacksMut().onChange = std::move(onChange);
     return n;
 }
 
@@ -76,9 +84,9 @@ WidgetNode WidgetNode::inputText(std::string label, std::string value,
     WidgetNode n;
     n.type = Type::InputText;
     n.label = std::move(label);
-    n.stringValue = std::move(value);
-    n.onChange = std::move(onChange);
-    n.onSubmit = std::move(onSubmit);
+    n.propsMut().stringValue = std::move(value);
+    if (onChange) n.callbacksMut().onChange = std::move(onChange);
+    if (onSubmit) n.callbacksMut().onSubmit = std::move(onSubmit);
     return n;
 }
 
@@ -87,7 +95,7 @@ WidgetNode WidgetNode::inputInt(std::string label, int value, WidgetCallback onC
     n.type = Type::InputInt;
     n.label = std::move(label);
     n.intValue = value;
-    n.onChange = std::move(onChange);
+    if (onChange) n.callbacksMut().onChange = std::move(onChange);
     return n;
 }
 
@@ -96,7 +104,7 @@ WidgetNode WidgetNode::inputFloat(std::string label, float value, WidgetCallback
     n.type = Type::InputFloat;
     n.label = std::move(label);
     n.floatValue = value;
-    n.onChange = std::move(onChange);
+    if (onChange) n.callbacksMut().onChange = std::move(onChange);
     return n;
 }
 
@@ -105,9 +113,9 @@ WidgetNode WidgetNode::combo(std::string label, std::vector<std::string> items,
     WidgetNode n;
     n.type = Type::Combo;
     n.label = std::move(label);
-    n.items = std::move(items);
+    n.propsMut().items = std::move(items);
     n.selectedIndex = selected;
-    n.onChange = std::move(onChange);
+    if (onChange) n.callbacksMut().onChange = std::move(onChange);
     return n;
 }
 
@@ -117,17 +125,17 @@ WidgetNode WidgetNode::separator() {
     return n;
 }
 
-WidgetNode WidgetNode::group(std::vector<WidgetNode> children) {
+WidgetNode WidgetNode::group(WidgetList children) {
     WidgetNode n;
     n.type = Type::Group;
     n.children = std::move(children);
     return n;
 }
 
-WidgetNode WidgetNode::columns(int count, std::vector<WidgetNode> children) {
+WidgetNode WidgetNode::columns(int count, WidgetList children) {
     WidgetNode n;
     n.type = Type::Columns;
-    n.columnCount = count;
+    n.propsMut().columnCount = count;
     n.children = std::move(children);
     return n;
 }
@@ -135,9 +143,10 @@ WidgetNode WidgetNode::columns(int count, std::vector<WidgetNode> children) {
 WidgetNode WidgetNode::image(TextureHandle texture, float width, float height) {
     WidgetNode n;
     n.type = Type::Image;
-    n.texture = texture;
-    n.imageWidth = width;
-    n.imageHeight = height;
+    Props& p = n.propsMut();
+    p.texture = texture;
+    p.imageWidth = width;
+    p.imageHeight = height;
     return n;
 }
 
@@ -146,7 +155,7 @@ WidgetNode WidgetNode::image(TextureHandle texture, float width, float height) {
 WidgetNode WidgetNode::sameLine(float offset) {
     WidgetNode n;
     n.type = Type::SameLine;
-    n.offsetX = offset;
+    if (offset != 0.0f) n.propsMut().offsetX = offset;
     return n;
 }
 
@@ -160,10 +169,11 @@ WidgetNode WidgetNode::textColored(float r, float g, float b, float a, std::stri
     WidgetNode n;
     n.type = Type::TextColored;
     n.textContent = std::move(content);
-    n.colorR = r;
-    n.colorG = g;
-    n.colorB = b;
-    n.colorA = a;
+    Props& p = n.propsMut();
+    p.colorR = r;
+    p.colorG = g;
+    p.colorB = b;
+    p.colorA = a;
     return n;
 }
 
@@ -188,11 +198,11 @@ WidgetNode WidgetNode::progressBar(float fraction, float width, float height,
     n.floatValue = fraction;
     n.width = width;
     n.height = height;
-    n.overlayText = std::move(overlay);
+    if (!overlay.empty()) n.propsMut().overlayText = std::move(overlay);
     return n;
 }
 
-WidgetNode WidgetNode::collapsingHeader(std::string label, std::vector<WidgetNode> children,
+WidgetNode WidgetNode::collapsingHeader(std::string label, WidgetList children,
                                          bool defaultOpen) {
     WidgetNode n;
     n.type = Type::CollapsingHeader;
@@ -204,7 +214,7 @@ WidgetNode WidgetNode::collapsingHeader(std::string label, std::vector<WidgetNod
 
 // Phase 4 builders
 
-WidgetNode WidgetNode::tabBar(std::string id, std::vector<WidgetNode> children) {
+WidgetNode WidgetNode::tabBar(std::string id, WidgetList children) {
     WidgetNode n;
     n.type = Type::TabBar;
     n.id = std::move(id);
@@ -212,7 +222,7 @@ WidgetNode WidgetNode::tabBar(std::string id, std::vector<WidgetNode> children)
     return n;
 }
 
-WidgetNode WidgetNode::tabItem(std::string label, std::vector<WidgetNode> children) {
+WidgetNode WidgetNode::tabItem(std::string label, WidgetList children) {
     WidgetNode n;
     n.type = Type::TabItem;
     n.label = std::move(label);
@@ -220,7 +230,7 @@ WidgetNode WidgetNode::tabItem(std::string label, std::vector<WidgetNode> childr
     return n;
 }
 
-WidgetNode WidgetNode::treeNode(std::string label, std::vector<WidgetNode> children,
+WidgetNode WidgetNode::treeNode(std::string label, WidgetList children,
                                  bool defaultOpen, bool isLeaf) {
     WidgetNode n;
     n.type = Type::TreeNode;
@@ -233,7 +243,7 @@ WidgetNode WidgetNode::treeNode(std::string label, std::vector<WidgetNode> child
 
 WidgetNode WidgetNode::child(std::string id, float width, float height,
                               bool border, bool autoScroll,
-                              std::vector<WidgetNode> children) {
+                              WidgetList children) {
     WidgetNode n;
     n.type = Type::Child;
     n.id = std::move(id);
@@ -245,14 +255,14 @@ WidgetNode WidgetNode::child(std::string id, float width, float height,
     return n;
 }
 
-WidgetNode WidgetNode::menuBar(std::vector<WidgetNode> children) {
+WidgetNode WidgetNode::menuBar(WidgetList children) {
     WidgetNode n;
     n.type = Type::MenuBar;
     n.children = std::move(children);
     return n;
 }
 
-WidgetNode WidgetNode::menu(std::string label, std::vector<WidgetNode> children) {
+WidgetNode WidgetNode::menu(std::string label, WidgetList children) {
     WidgetNode n;
     n.type = Type::Menu;
     n.label = std::move(label);
@@ -265,8 +275,8 @@ WidgetNode WidgetNode::menuItem(std::string label, WidgetCallback onClick,
     WidgetNode n;
     n.type = Type::MenuItem;
     n.label = std::move(label);
-    n.onClick = std::move(onClick);
-    n.shortcutText = std::move(shortcut);
+    if (onClick) n.callbacksMut().onClick = std::move(onClick);
+    if (!shortcut.empty()) n.propsMut().shortcutText = std::move(shortcut);
     n.checked = checked;
     return n;
 }
@@ -278,8 +288,9 @@ WidgetNode WidgetNode::colorEdit(std::string label, float r, float g, float b, f
     WidgetNode n;
     n.type = Type::ColorEdit;
     n.label = std::move(label);
-    n.colorR = r; n.colorG = g; n.colorB = b; n.colorA = a;
-    n.onChange = std::move(onChange);
+    Props& p = n.propsMut();
+    p.colorR = r; p.colorG = g; p.colorB = b; p.colorA = a;
+    if (onChange) n.callbacksMut().onChange = std::move(onChange);
     return n;
 }
 
@@ -288,8 +299,9 @@ WidgetNode WidgetNode::colorPicker(std::string label, float r, float g, float b,
     WidgetNode n;
     n.type = Type::ColorPicker;
     n.label = std::move(label);
-    n.colorR = r; n.colorG = g; n.colorB = b; n.colorA = a;
-    n.onChange = std::move(onChange);
+    Props& p = n.propsMut();
+    p.colorR = r; p.colorG = g; p.colorB = b; p.colorA = a;
+    if (onChange) n.callbacksMut().onChange = std::move(onChange);
     return n;
 }
 
@@ -299,10 +311,11 @@ WidgetNode WidgetNode::dragFloat(std::string label, float value, float speed,
     n.type = Type::DragFloat;
     n.label = std::move(label);
     n.floatValue = value;
-    n.dragSpeed = speed;
-    n.minFloat = min;
-    n.maxFloat = max;
-    n.onChange = std::move(onChange);
+    Props& p = n.propsMut();
+    p.dragSpeed = speed;
+    p.minFloat = min;
+    p.maxFloat = max;
+    if (onChange) n.callbacksMut().onChange = std::move(onChange);
     return n;
 }
 
@@ -312,10 +325,11 @@ WidgetNode WidgetNode::dragInt(std::string label, int value, float speed,
     n.type = Type::DragInt;
     n.label = std::move(label);
     n.intValue = value;
-    n.dragSpeed = speed;
-    n.minInt = min;
-    n.maxInt = max;
-    n.onChange = std::move(onChange);
+    Props& p = n.propsMut();
+    p.dragSpeed = speed;
+    p.minInt = min;
+    p.maxInt = max;
+    if (onChange) n.callbacksMut().onChange = std::move(onChange);
     return n;
 }
 
@@ -327,14 +341,15 @@ WidgetNode WidgetNode::listBox(std::string label, std::vector<std::string> items
     WidgetNode n;
     n.type = Type::ListBox;
     n.label = std::move(label);
-    n.items = std::move(items);
+    Props& p = n.propsMut();
+    p.items = std::move(items);
     n.selectedIndex = selected;
-    n.heightInItems = heightInItems;
-    n.onChange = std::move(onChange);
+    p.heightInItems = heightInItems;
+    if (onChange) n.callbacksMut().onChange = std::move(onChange);
     return n;
 }
 
-WidgetNode WidgetNode::popup(std::string id, std::vector<WidgetNode> children) {
+WidgetNode WidgetNode::popup(std::string id, WidgetList children) {
     WidgetNode n;
     n.type = Type::Popup;
     n.id = std::move(id);
@@ -342,13 +357,13 @@ WidgetNode WidgetNode::popup(std::string id, std::vector<WidgetNode> children) {
     return n;
 }
 
-WidgetNode WidgetNode::modal(std::string title, std::vector<WidgetNode> children,
+WidgetNode WidgetNode::modal(std::string title, WidgetList children,
                               WidgetCallback onClose) {
     WidgetNode n;
     n.type = Type::Modal;
     n.label = std::move(title);
     n.children = std::move(children);
-    n.onClose = std::move(onClose);
+    if (onClose) n.callbacksMut().onClose = std::move(onClose);
     return n;
 }
 
@@ -361,8 +376,8 @@ WidgetNode WidgetNode::canvas(std::string id, float width, float height,
     n.id = std::move(id);
     n.width = width;
     n.height = height;
-    n.onDraw = std::move(onDraw);
-    n.onClick = std::move(onClick);
+    if (onDraw) n.callbacksMut().onDraw = std::move(onDraw);
+    if (onClick) n.callbacksMut().onClick = std::move(onClick);
     return n;
 }
 
@@ -373,8 +388,8 @@ WidgetNode WidgetNode::canvas(std::string id, float width, float height,
     n.id = std::move(id);
     n.width = width;
     n.height = height;
-    n.texture = texture;
-    n.onClick = std::move(onClick);
+    n.propsMut().texture = texture;
+    if (onClick) n.callbacksMut().onClick = std::move(onClick);
     return n;
 }
 
@@ -385,7 +400,7 @@ WidgetNode WidgetNode::tooltip(std::string text) {
     return n;
 }
 
-WidgetNode WidgetNode::tooltip(std::vector<WidgetNode> children) {
+WidgetNode WidgetNode::tooltip(WidgetList children) {
     WidgetNode n;
     n.type = Type::Tooltip;
     n.children = std::move(children);
@@ -396,19 +411,20 @@ WidgetNode WidgetNode::tooltip(std::vector<WidgetNode> children) {
 
 WidgetNode WidgetNode::table(std::string id, int numColumns,
                               std::vector<std::string> headers,
-                              std::vector<WidgetNode> children,
+                              WidgetList children,
                               int flags) {
     WidgetNode n;
     n.type = Type::Table;
     n.id = std::move(id);
-    n.columnCount = numColumns;
-    n.items = std::move(headers);  // items stores header labels for Table
+    Props& p = n.propsMut();
+    p.columnCount = numColumns;
+    p.items = std::move(headers);  // items stores header labels for Table
     n.children = std::move(children);
-    n.tableFlags = flags;
+    p.tableFlags = flags;
     return n;
 }
 
-WidgetNode WidgetNode::tableRow(std::vector<WidgetNode> children) {
+WidgetNode WidgetNode::tableRow(WidgetList children) {
     WidgetNode n;
     n.type = Type::TableRow;
     n.children = std::move(children);
@@ -429,8 +445,8 @@ WidgetNode WidgetNode::radioButton(std::string label, int activeValue, int myVal
     n.type = Type::RadioButton;
     n.label = std::move(label);
     n.intValue = activeValue;
-    n.minInt = myValue;  // minInt stores this radio button's value
-    n.onChange = std::move(onChange);
+    n.propsMut().minInt = myValue;  // minInt stores this radio button's value
+    if (onChange) n.callbacksMut().onChange = std::move(onChange);
     return n;
 }
 
@@ -439,7 +455,7 @@ WidgetNode WidgetNode::selectable(std::string label, bool selected, WidgetCallba
     n.type = Type::Selectable;
     n.label = std::move(label);
     n.boolValue = selected;
-    n.onClick = std::move(onClick);
+    if (onClick) n.callbacksMut().onClick = std::move(onClick);
     return n;
 }
 
@@ -449,10 +465,10 @@ WidgetNode WidgetNode::inputTextMultiline(std::string label, std::string value,
     WidgetNode n;
     n.type = Type::InputTextMultiline;
     n.label = std::move(label);
-    n.stringValue = std::move(value);
+    n.propsMut().stringValue = std::move(value);
     n.width = width;
     n.height = height;
-    n.onChange = std::move(onChange);
+    if (onChange) n.callbacksMut().onChange = std::move(onChange);
     return n;
 }
 
@@ -490,7 +506,8 @@ WidgetNode WidgetNode::pushStyleColor(int colIdx, float r, float g, float b, flo
     WidgetNode n;
     n.type = Type::PushStyleColor;
     n.intValue = colIdx;
-    n.colorR = r; n.colorG = g; n.colorB = b; n.colorA = a;
+    Props& p = n.propsMut();
+    p.colorR = r; p.colorG = g; p.colorB = b; p.colorA = a;
     return n;
 }
 
@@ -547,13 +564,14 @@ WidgetNode WidgetNode::dragFloat3(std::string label, float x, float y, float z,
     WidgetNode n;
     n.type = Type::DragFloat3;
     n.label = std::move(label);
-    n.floatX = x;
-    n.floatY = y;
-    n.floatZ = z;
-    n.dragSpeed = speed;
-    n.minFloat = min;
-    n.maxFloat = max;
-    n.onChange = std::move(onChange);
+    Props& p = n.propsMut();
+    p.floatX = x;
+    p.floatY = y;
+    p.floatZ = z;
+    p.dragSpeed = speed;
+    p.minFloat = min;
+    p.maxFloat = max;
+    if (onChange) n.callbacksMut().onChange = std::move(onChange);
     return n;
 }
 
@@ -563,10 +581,11 @@ WidgetNode WidgetNode::inputTextWithHint(std::string label, std::string hint,
     WidgetNode n;
     n.type = Type::InputTextWithHint;
     n.label = std::move(label);
-    n.hintText = std::move(hint);
-    n.stringValue = std::move(value);
-    n.onChange = std::move(onChange);
-    n.onSubmit = std::move(onSubmit);
+    Props& p = n.propsMut();
+    p.hintText = std::move(hint);
+    p.stringValue = std::move(value);
+    if (onChange) n.callbacksMut().onChange = std::move(onChange);
+    if (onSubmit) n.callbacksMut().onSubmit = std::move(onSubmit);
     return n;
 }
 
@@ -577,9 +596,10 @@ WidgetNode WidgetNode::sliderAngle(std::string label, float valueRadians,
     n.type = Type::SliderAngle;
     n.label = std::move(label);
     n.floatValue = valueRadians;
-    n.minFloat = minDegrees;
-    n.maxFloat = maxDegrees;
-    n.onChange = std::move(onChange);
+    Props& p = n.propsMut();
+    p.minFloat = minDegrees;
+    p.maxFloat = maxDegrees;
+    if (onChange) n.callbacksMut().onChange = std::move(onChange);
     return n;
 }
 
@@ -587,7 +607,7 @@ WidgetNode WidgetNode::smallButton(std::string label, WidgetCallback onClick) {
     WidgetNode n;
     n.type = Type::SmallButton;
     n.label = std::move(label);
-    n.onClick = std::move(onClick);
+    if (onClick) n.callbacksMut().onClick = std::move(onClick);
     return n;
 }
 
@@ -596,21 +616,22 @@ WidgetNode WidgetNode::colorButton(std::string label, float r, float g, float b,
     WidgetNode n;
     n.type = Type::ColorButton;
     n.label = std::move(label);
-    n.colorR = r; n.colorG = g; n.colorB = b; n.colorA = a;
-    n.onClick = std::move(onClick);
+    Props& p = n.propsMut();
+    p.colorR = r; p.colorG = g; p.colorB = b; p.colorA = a;
+    if (onClick) n.callbacksMut().onClick = std::move(onClick);
     return n;
 }
 
 // Phase 13 builders
 
-WidgetNode WidgetNode::contextMenu(std::vector<WidgetNode> children) {
+WidgetNode WidgetNode::contextMenu(WidgetList children) {
     WidgetNode n;
     n.type = Type::ContextMenu;
     n.children = std::move(children);
     return n;
 }
 
-WidgetNode WidgetNode::mainMenuBar(std::vector<WidgetNode> children) {
+WidgetNode WidgetNode::mainMenuBar(WidgetList children) {
     WidgetNode n;
     n.type = Type::MainMenuBar;
     n.children = std::move(children);
@@ -626,7 +647,7 @@ WidgetNode WidgetNode::itemTooltip(std::string text) {
     return n;
 }
 
-WidgetNode WidgetNode::itemTooltip(std::vector<WidgetNode> children) {
+WidgetNode WidgetNode::itemTooltip(WidgetList children) {
     WidgetNode n;
     n.type = Type::ItemTooltip;
     n.children = std::move(children);
@@ -639,10 +660,11 @@ WidgetNode WidgetNode::imageButton(std::string id, TextureHandle texture,
     WidgetNode n;
     n.type = Type::ImageButton;
     n.id = std::move(id);
-    n.texture = texture;
-    n.imageWidth = width;
-    n.imageHeight = height;
-    n.onClick = std::move(onClick);
+    Props& p = n.propsMut();
+    p.texture = texture;
+    p.imageWidth = width;
+    p.imageHeight = height;
+    if (onClick) n.callbacksMut().onClick = std::move(onClick);
     return n;
 }
 
@@ -662,6 +684,44 @@ WidgetNode WidgetNode::popTheme(std::string name) {
     return n;
 }
 
+// Virtual (data-source-backed) lists
+
+WidgetNode WidgetNode::virtualList(std::string id, int rowCount, RowProvider rowProvider,
+                                    float height, WidgetCallback onSelect) {
+    WidgetNode n;
+    n.type = Type::VirtualList;
+    n.id = std::move(id);
+    n.height = height;
+    Props& p = n.propsMut();
+    p.rowCount = rowCount;
+    p.rowSelection = static_cast<bool>(onSelect);
+    Callbacks& cb = n.callbacksMut();
+    cb.rowProvider = std::move(rowProvider);
+    if (onSelect) cb.onChange = std::move(onSelect);
+    return n;
+}
+
+WidgetNode WidgetNode::virtualTable(std::string id, int numColumns,
+                                     std::vector<std::string> headers,
+                                     int rowCount, RowProvider rowProvider,
+                                     int flags, WidgetCallback onSelect,
+                                     WidgetCallback onSort) {
+    WidgetNode n;
+    n.type = Type::VirtualTable;
+    n.id = std::move(id);
+    Props& p = n.propsMut();
+    p.columnCount = numColumns;
+    p.items = std::move(headers);  // items stores header labels, as for Table
+    p.tableFlags = flags;
+    p.rowCount = rowCount;
+    p.rowSelection = static_cast<bool>(onSelect);
+    Callbacks& cb = n.callbacksMut();
+    cb.rowProvider = std::move(rowProvider);
+    if (onSelect) cb.onChange = std::move(onSelect);
+    if (onSort) cb.onSort = std::move(onSort);
+    return n;
+}
+
 // Phase 15 builders
 
 WidgetNode WidgetNode::plotLines(std::string label, std::vector<float> values,
@@ -671,10 +731,11 @@ WidgetNode WidgetNode::plotLines(std::string label, std::vector<float> values,
     WidgetNode n;
     n.type = Type::PlotLines;
     n.label = std::move(label);
-    n.plotValues = std::move(values);
-    n.overlayText = std::move(overlay);
-    n.minFloat = scaleMin;
-    n.maxFloat = scaleMax;
+    Props& p = n.propsMut();
+    p.plotValues = std::move(values);
+    p.overlayText = std::move(overlay);
+    p.minFloat = scaleMin;
+    p.maxFloat = scaleMax;
     n.width = width;
     n.height = height;
     return n;
@@ -687,15 +748,157 @@ WidgetNode WidgetNode::plotHistogram(std::string label, std::vector<float> value
     WidgetNode n;
     n.type = Type::PlotHistogram;
     n.label = std::move(label);
-    n.plotValues = std::move(values);
-    n.overlayText = std::move(overlay);
-    n.minFloat = scaleMin;
-    n.maxFloat = scaleMax;
+    Props& p = n.propsMut();
+    p.plotValues = std::move(values);
+    p.overlayText = std::move(overlay);
+    p.minFloat = scaleMin;
+    p.maxFloat = scaleMax;
     n.width = width;
     n.height = height;
     return n;
 }
 
+// Reconciliation
+
+bool WidgetNode::Props::operator==(const Props& o) const {
+    return stringValue == o.stringValue &&
+           minFloat == o.minFloat && maxFloat == o.maxFloat &&
+           minInt == o.minInt && maxInt == o.maxInt &&
+           columnCount == o.columnCount && items == o.items &&
+           texture == o.texture &&
+           imageWidth == o.imageWidth && imageHeight == o.imageHeight &&
+           colorR == o.colorR && colorG == o.colorG &&
+           colorB == o.colorB && colorA == o.colorA &&
+           overlayText == o.overlayText && offsetX == o.offsetX &&
+           alpha == o.alpha && windowPosX == o.windowPosX && windowPosY == o.windowPosY &&
+           scaleX == o.scaleX && scaleY == o.scaleY && rotationY == o.rotationY &&
+           shortcutText == o.shortcutText && tableFlags == o.tableFlags &&
+           windowFlags == o.windowFlags &&
+           windowSizeW == o.windowSizeW && windowSizeH == o.windowSizeH &&
+           windowPivotX == o.windowPivotX && windowPivotY == o.windowPivotY &&
+           dragSpeed == o.dragSpeed && formatString == o.formatString &&
+           floatX == o.floatX && floatY == o.floatY && floatZ == o.floatZ &&
+           hintText == o.hintText && plotValues == o.plotValues &&
+           heightInItems == o.heightInItems &&
+           dragType == o.dragType && dragData == o.dragData &&
+           dropAcceptType == o.dropAcceptType && dragMode == o.dragMode &&
+           rowCount == o.rowCount && rowHeight == o.rowHeight &&
+           rowSelection == o.rowSelection &&
+           sortColumn == o.sortColumn && sortAscending == o.sortAscending;
+}
+
+// Copy next's own fields (not its children) where they differ.
+// Returns whether anything other than the callbacks changed.
+bool WidgetNode::patchFields(WidgetNode& next) {
+    bool changed = false;
+    auto patch = [&changed](auto& field, auto& value) {
+        if (field != value) {
+            field = std::move(value);
+            changed = true;
+        }
+    };
+
+    patch(visible, next.visible);
+    patch(enabled, next.enabled);
+    patch(boolValue, next.boolValue);
+    patch(defaultOpen, next.defaultOpen);
+    patch(border, next.border);
+    patch(autoScroll, next.autoScroll);
+    patch(leaf, next.leaf);
+    patch(checked, next.checked);
+    patch(focusable, next.focusable);
+    patch(autoFocus, next.autoFocus);
+    patch(floatValue, next.floatValue);
+    patch(intValue, next.intValue);
+    patch(selectedIndex, next.selectedIndex);
+    patch(width, next.width);
+    patch(height, next.height);
+    patch(label, next.label);
+    patch(textContent, next.textContent);
+    patch(id, next.id);
+
+    if (props() != next.props()) {
+        props_ = std::move(next.props_);
+        changed = true;
+    }
+    callbacks_ = std::move(next.callbacks_);
+    return changed;
+}
+
+size_t WidgetNode::reconcile(WidgetNode&& next) {
+    if (this == &next) return 0;
+
+    // A different widget shares nothing worth keeping
+    if (type != next.type) {
+        size_t touched = subtreeSize() + next.subtreeSize();
+        *this = std::move(next);
+        return touched;
+    }
+
+    size_t touched = patchFields(next) ? 1 : 0;
+
+    // Same shape (the usual case for a periodic refresh): patch in place
+    bool sameShape = children.size() == next.children.size();
+    for (size_t i = 0; sameShape && i < children.size(); i++) {
+        sameShape = children[i].type == next.children[i].type &&
+                    children[i].id == next.children[i].id;
+    }
+    if (sameShape) {
+        for (size_t i = 0; i < children.size(); i++) {
+            touched += children[i].reconcile(std::move(next.children[i]));
+        }
+        return touched;
+    }
+
+    // Children were added, removed or reordered: match them up again
+    WidgetList old = std::move(children);
+    std::unordered_map<std::string, size_t> keyed;
+    std::vector<size_t> unkeyed;
+    for (size_t i = 0; i < old.size(); i++) {
+        if (old[i].id.empty()) {
+            unkeyed.push_back(i);
+        } else {
+            keyed.emplace(old[i].id, i);  // first one wins on duplicates
+        }
+    }
+
+    constexpr size_t kNoMatch = static_cast<size_t>(-1);
+    std::vector<bool> used(old.size(), false);
+    size_t nextUnkeyed = 0;
+    children.clear();
+    children.reserve(next.children.size());
+    for (auto& child : next.children) {
+        size_t match = kNoMatch;
+        if (!child.id.empty()) {
+            auto it = keyed.find(child.id);
+            if (it != keyed.end() && !used[it->second]) match = it->second;
+        } else if (nextUnkeyed < unkeyed.size()) {
+            match = unkeyed[nextUnkeyed++];
+        }
+
+        if (match != kNoMatch && old[match].type == child.type) {
+            used[match] = true;
+            children.push_back(std::move(old[match]));
+            touched += children.back().reconcile(std::move(child));
+        } else {
+            touched += child.subtreeSize();
+            children.push_back(std::move(child));
+        }
+    }
+    for (size_t i = 0; i < old.size(); i++) {
+        if (!used[i]) touched += old[i].subtreeSize();
+    }
+    return touched;
+}
+
+size_t WidgetNode::subtreeSize() const {
+    size_t count = 1;
+    for (const auto& child : children) {
+        count += child.subtreeSize();
+    }
+    return count;
+}
+
 const char* widgetTypeName(WidgetNode::Type type) {
     switch (type) {
         case WidgetNode::Type::Window:            return "Window";
@@ -763,6 +966,8 @@ const char* widgetTypeName(WidgetNode::Type type) {
         case WidgetNode::Type::PlotHistogram:    return "PlotHistogram";
         case WidgetNode::Type::PushTheme:        return "PushTheme";
         case WidgetNode::Type::PopTheme:         return "PopTheme";
+        case WidgetNode::Type::VirtualList:      return "VirtualList";
+        case WidgetNode::Type::VirtualTable:     return "VirtualTable";
         default:                                  return "Unknown";
     }
 }
@@ -6,6 +6,8 @@
 #include <finegui/scene_texture.hpp>
 #include <finegui/gui_system.hpp>
 
+#include "backend/gpu_timer.hpp"
+
 #include <stdexcept>
 
 namespace finegui {
@@ -26,6 +28,11 @@ SceneTexture::SceneTexture(GuiSystem& gui, uint32_t width, uint32_t height, bool
     }
 
     offscreen_ = builder.build();
+
+    // The offscreen frame is waited on in endScene(), so one slot suffices
+    if (gui_->gpuTimings().supported) {
+        gpuTimer_ = std::make_unique<backend::GpuTimer>(gui_->device(), 1);
+    }
 }
 
 SceneTexture::~SceneTexture() {
@@ -39,6 +46,9 @@ SceneTexture::SceneTexture(SceneTexture&& other) noexcept
     , width_(other.width_)
     , height_(other.height_)
     , rendering_(other.rendering_)
+    , gpuTimer_(std::move(other.gpuTimer_))
+    , gpuMicros_(other.gpuMicros_)
+    , gpuSamples_(other.gpuSamples_)
 {
     other.gui_ = nullptr;
     other.handle_ = {};
@@ -54,6 +64,9 @@ SceneTexture& SceneTexture::operator=(SceneTexture&& other) noexcept {
         width_ = other.width_;
         height_ = other.height_;
         rendering_ = other.rendering_;
+        gpuTimer_ = std::move(other.gpuTimer_);
+        gpuMicros_ = other.gpuMicros_;
+        gpuSamples_ = other.gpuSamples_;
         other.gui_ = nullptr;
         other.handle_ = {};
         other.rendering_ = false;
@@ -66,6 +79,15 @@ void SceneTexture::beginScene(float r, float g, float b, float a) {
         throw std::runtime_error("SceneTexture::beginScene: already rendering");
     }
     offscreen_->beginFrame();
+
+    // Queries can only be reset outside the render pass
+    if (gpuTimer_) {
+        VkCommandBuffer cmd = offscreen_->currentCommandBuffer()->handle();
+        float unused = 0.0f;
+        gpuTimer_->reset(cmd, 0, unused);  // Already read in endScene()
+        gpuTimer_->begin(cmd, 0);
+    }
+
     offscreen_->beginRenderPass({r, g, b, a});
     rendering_ = true;
 }
@@ -90,15 +112,33 @@ void SceneTexture::endScene() {
         throw std::runtime_error("SceneTexture::endScene: must call beginScene() first");
     }
     offscreen_->endRenderPass();
+    if (gpuTimer_) {
+        gpuTimer_->end(offscreen_->currentCommandBuffer()->handle(), 0);
+    }
     offscreen_->endFrame();
     rendering_ = false;
 
+    // endFrame() waited for the submission, so the result is normally ready
+    float micros = 0.0f;
+    if (gpuTimer_ && gpuTimer_->read(0, micros)) {
+        gpuMicros_ = backend::smoothGpuTime(gpuMicros_, micros, gpuSamples_ == 0);
+        gpuSamples_++;
+        if (gui_) {
+            gui_->addSceneGpuTime(micros);
+        }
+    }
+
     // Register texture on first call (or after resize).
     // The OffscreenSurface is single-buffered, so the colorImageView is stable
     // across frames and doesn't need re-registration each frame.
     if (!handle_.valid()) {
         registerTexture();
     }
+
+    // New scene contents behind the same texture ID
+    if (gui_) {
+        gui_->invalidateLayer();
+    }
 }
 
 void SceneTexture::resize(uint32_t width, uint32_t height) {
@@ -2,6 +2,7 @@
 #include <finescript/map_data.h>
 #include <finescript/interner.h>
 #include <imgui.h>
+#include <algorithm>
 #include <cstring>
 #include <cfloat>
 #include <cmath>
@@ -43,6 +44,9 @@ static int inputTextCallback(ImGuiInputTextCallbackData* data) {
     return 0;
 }
 
+// Shorter row lists are cheaper to submit whole than to clip
+static constexpr size_t kClipMinRows = 32;
+
 // -- MapRenderer --------------------------------------------------------------
 
 MapRenderer::MapRenderer(finescript::ScriptEngine& engine)
@@ -163,6 +167,7 @@ finescript::Value MapRenderer::findById(uint32_t symbolId) {
 
 void MapRenderer::renderAll() {
     currentFocusedId_.clear();
+    frame_++;
     for (auto& [id, entry] : trees_) {
         if (entry.warmupFrames == -1) continue;  // staged — skip
         if (entry.rootMap.isMap()) {
@@ -179,6 +184,15 @@ void MapRenderer::renderAll() {
         }
     }
     lastFocusedId_ = currentFocusedId_;
+
+    // Forget lists that weren't drawn (their arrays may be gone)
+    for (auto it = uniformRows_.begin(); it != uniformRows_.end();) {
+        if (it->second.frame != frame_) {
+            it = uniformRows_.erase(it);
+        } else {
+            ++it;
+        }
+    }
 }
 
 // -- Helpers ------------------------------------------------------------------
@@ -332,6 +346,9 @@ void MapRenderer::renderNode(MapData& m, ExecutionContext& ctx) {
         // Style & Theming
         else if (sym == syms_.sym_push_theme)        renderPushTheme(m);
         else if (sym == syms_.sym_pop_theme)         renderPopTheme(m);
+        // Virtual lists
+        else if (sym == syms_.sym_virtual_list)      renderVirtualList(m, ctx);
+        else if (sym == syms_.sym_virtual_table)     renderVirtualTable(m, ctx);
         else {
             ImGui::TextColored({1, 0, 0, 1}, "[Unknown widget type]");
         }
@@ -366,6 +383,110 @@ void MapRenderer::renderNode(MapData& m, ExecutionContext& ctx) {
     if (wasDisabled) ImGui::EndDisabled();
 }
 
+// -- List clipping ------------------------------------------------------------
+
+bool MapRenderer::isChildRowType(uint32_t sym) const {
+    // Single-line widgets that can make up a clipped child's rows
+    return sym == syms_.sym_text || sym == syms_.sym_text_colored ||
+           sym == syms_.sym_text_disabled || sym == syms_.sym_bullet_text ||
+           sym == syms_.sym_selectable || sym == syms_.sym_button ||
+           sym == syms_.sym_small_button || sym == syms_.sym_checkbox ||
+           sym == syms_.sym_radio_button || sym == syms_.sym_slider ||
+           sym == syms_.sym_slider_int || sym == syms_.sym_drag_float ||
+           sym == syms_.sym_drag_int || sym == syms_.sym_input_text ||
+           sym == syms_.sym_input_int || sym == syms_.sym_input_float ||
+           sym == syms_.sym_input_with_hint || sym == syms_.sym_combo ||
+           sym == syms_.sym_progress_bar;
+}
+
+bool MapRenderer::isUniformRow(Value& row, uint32_t rowType) {
+    // A visible map of rowType; table rows also need single-line cells
+    if (!row.isMap()) return false;
+    auto& rm = row.asMap();
+    auto typeVal = rm.get(syms_.type);
+    if (!typeVal.isSymbol() || typeVal.asSymbol() != rowType) return false;
+    if (!getBoolField(rm, syms_.visible, true)) return false;
+    if (rowType != syms_.sym_table_row) return true;
+
+    auto cellsVal = rm.get(syms_.children);
+    if (!cellsVal.isArray()) return true;
+    for (const auto& cell : cellsVal.asArray()) {
+        if (!cell.isMap()) return false;
+        auto cellType = cell.asMap().get(syms_.type);
+        if (!cellType.isSymbol()) return false;
+        if (cellType.asSymbol() != syms_.sym_table_next_column &&
+            !isChildRowType(cellType.asSymbol())) {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool MapRenderer::hasUniformRows(Value& childrenVal, uint32_t rowType) {
+    // Every entry must qualify, or ImGuiListClipper's one-height-fits-all
+    // layout would be wrong
+    if (!childrenVal.isArray() || childrenVal.asArray().size() < kClipMinRows) return false;
+    auto& rows = childrenVal.asArrayMut();
+    const void* firstRow = rows[0].isMap() ? &rows[0].asMap() : nullptr;
+
+    auto& cached = uniformRows_[&rows];
+    if (cached.frame == 0 || cached.size != rows.size() || cached.firstRow != firstRow) {
+        cached.uniform = std::all_of(rows.begin(), rows.end(),
+            [&](Value& row) { return isUniformRow(row, rowType); });
+        cached.size = rows.size();
+        cached.firstRow = firstRow;
+    }
+    cached.frame = frame_;
+    return cached.uniform;
+}
+
+void MapRenderer::renderChildRows(Value& childrenVal, uint32_t rowType, ExecutionContext& ctx) {
+    if (!childrenVal.isArray()) return;
+
+    if (rowType == 0 || !hasUniformRows(childrenVal, rowType)) {
+        // Drawing every row anyway: recheck them, so a list whose rows
+        // were fixed in place is clipped again from the next frame
+        bool uniform = rowType != 0;
+        for (auto& child : childrenVal.asArrayMut()) {
+            if (uniform && !isUniformRow(child, rowType)) uniform = false;
+            if (child.isMap()) {
+                renderNode(child.asMap(), ctx);
+            }
+        }
+        auto it = uniformRows_.find(&childrenVal.asArrayMut());
+        if (it != uniformRows_.end()) it->second.uniform = uniform;
+        return;
+    }
+
+    auto& rows = childrenVal.asArrayMut();
+    ImGuiListClipper clipper;
+    clipper.Begin(static_cast<int>(rows.size()));
+
+    // The row holding a pending set_focus target has to be submitted
+    if (!pendingFocusId_.empty()) {
+        for (size_t i = 0; i < rows.size(); i++) {
+            if (!findByIdRecursive(rows[i], 0, pendingFocusId_).isNil()) {
+                clipper.IncludeItemByIndex(static_cast<int>(i));
+                break;
+            }
+        }
+    }
+
+    // Rows edited in place only show up here; the next frame rechecks them all
+    bool stillUniform = true;
+    while (clipper.Step()) {
+        int end = std::min(clipper.DisplayEnd, static_cast<int>(rows.size()));
+        for (int i = clipper.DisplayStart; i < end; i++) {
+            auto& row = rows[static_cast<size_t>(i)];
+            if (!isUniformRow(row, rowType)) stillUniform = false;
+            if (row.isMap()) {
+                renderNode(row.asMap(), ctx);
+            }
+        }
+    }
+    if (!stillUniform) uniformRows_.erase(&rows);
+}
+
 // -- Per-widget render methods ------------------------------------------------
 
 void MapRenderer::renderWindow(MapData& m, ExecutionContext& ctx) {
@@ -897,13 +1018,15 @@ void MapRenderer::renderChild(MapData& m, ExecutionContext& ctx) {
 
     if (ImGui::BeginChild(id.c_str(), {w, h}, childFlags)) {
         auto childrenVal = m.get(syms_.children);
-        if (childrenVal.isArray()) {
-            for (auto& child : childrenVal.asArrayMut()) {
-                if (child.isMap()) {
-                    renderNode(child.asMap(), ctx);
-                }
+        uint32_t rowType = 0;
+        if (childrenVal.isArray() && childrenVal.asArray().size() > 0 &&
+            childrenVal.asArray()[0].isMap()) {
+            auto firstType = childrenVal.asArrayMut()[0].asMap().get(syms_.type);
+            if (firstType.isSymbol() && isChildRowType(firstType.asSymbol())) {
+                rowType = firstType.asSymbol();
             }
         }
+        renderChildRows(childrenVal, rowType, ctx);
         if (autoScroll && ImGui::GetScrollY() >= ImGui::GetScrollMaxY()) {
             ImGui::SetScrollHereY(1.0f);
         }
@@ -1008,13 +1131,7 @@ void MapRenderer::renderTable(MapData& m, ExecutionContext& ctx) {
         }
 
         auto childrenVal = m.get(syms_.children);
-        if (childrenVal.isArray()) {
-            for (auto& child : childrenVal.asArrayMut()) {
-                if (child.isMap()) {
-                    renderNode(child.asMap(), ctx);
-                }
-            }
-        }
+        renderChildRows(childrenVal, syms_.sym_table_row, ctx);
         ImGui::EndTable();
     }
 }
@@ -1144,8 +1261,8 @@ void MapRenderer::renderListBox(MapData& m, ExecutionContext& ctx) {
     }
 
     if (ImGui::BeginListBox(label.c_str(), {0.0f, heightPx})) {
-        for (int i = 0; i < static_cast<int>(items.size()); i++) {
-            if (!items[static_cast<size_t>(i)].isString()) continue;
+        auto renderItem = [&](int i) {
+            if (!items[static_cast<size_t>(i)].isString()) return;
             bool isSelected = (i == selected);
             if (ImGui::Selectable(items[static_cast<size_t>(i)].asString().c_str(), isSelected)) {
                 selected = i;
@@ -1155,6 +1272,28 @@ void MapRenderer::renderListBox(MapData& m, ExecutionContext& ctx) {
             if (isSelected) {
                 ImGui::SetItemDefaultFocus();
             }
+        };
+
+        // Non-string entries are skipped, which would throw off the
+        // clipper's row positions, so only all-string lists are clipped
+        int count = static_cast<int>(items.size());
+        bool clip = std::all_of(items.begin(), items.end(),
+                                [](const Value& item) { return item.isString(); });
+        if (clip) {
+            ImGuiListClipper clipper;
+            clipper.Begin(count);
+            if (ImGui::IsWindowAppearing() && selected >= 0 && selected < count) {
+                clipper.IncludeItemByIndex(selected);  // for SetItemDefaultFocus()
+            }
+            while (clipper.Step()) {
+                for (int i = clipper.DisplayStart; i < clipper.DisplayEnd; i++) {
+                    renderItem(i);
+                }
+            }
+        } else {
+            for (int i = 0; i < count; i++) {
+                renderItem(i);
+            }
         }
         ImGui::EndListBox();
     }
@@ -1906,6 +2045,144 @@ int MapRenderer::parseWindowFlags(MapData& m) {
     return result;
 }
 
+// -- Virtual lists ------------------------------------------------------------
+
+void MapRenderer::renderVirtualList(MapData& m, ExecutionContext& ctx) {
+    auto id = getStringField(m, syms_.id, "##virtual_list");
+    float w = static_cast<float>(getNumericField(m, syms_.width, 0.0));
+    float h = static_cast<float>(getNumericField(m, syms_.height, 0.0));
+
+    ImGuiChildFlags childFlags = ImGuiChildFlags_None;
+    if (getBoolField(m, syms_.border, false)) childFlags |= ImGuiChildFlags_Borders;
+
+    if (ImGui::BeginChild(id.c_str(), {w, h}, childFlags)) {
+        renderVirtualRows(m, false, ctx);
+    }
+    ImGui::EndChild();
+}
+
+void MapRenderer::renderVirtualTable(MapData& m, ExecutionContext& ctx) {
+    auto id = getStringField(m, syms_.id, "##virtual_table");
+    int numCols = static_cast<int>(getNumericField(m, syms_.num_columns, 1));
+    if (numCols < 1) numCols = 1;
+    float w = static_cast<float>(getNumericField(m, syms_.width, 0.0));
+    float h = static_cast<float>(getNumericField(m, syms_.height, 0.0));
+    int sortColumn = static_cast<int>(getNumericField(m, syms_.sort_column, -1));
+    bool sortAscending = getBoolField(m, syms_.sort_ascending, true);
+
+    // The table scrolls itself so the clipper only sees its own rows
+    int flags = parseTableFlags(m) | ImGuiTableFlags_ScrollY;
+    if (m.get(syms_.on_sort).isCallable()) flags |= ImGuiTableFlags_Sortable;
+
+    if (!ImGui::BeginTable(id.c_str(), numCols, static_cast<ImGuiTableFlags>(flags), {w, h})) return;
+
+    auto headersVal = m.get(syms_.headers);
+    if (headersVal.isArray()) {
+        ImGui::TableSetupScrollFreeze(0, 1);
+        const auto& headers = headersVal.asArray();
+        for (size_t i = 0; i < headers.size(); i++) {
+            ImGuiTableColumnFlags colFlags = ImGuiTableColumnFlags_None;
+            if (static_cast<int>(i) == sortColumn) {
+                colFlags |= ImGuiTableColumnFlags_DefaultSort;
+                colFlags |= sortAscending ? ImGuiTableColumnFlags_PreferSortAscending
+                                          : ImGuiTableColumnFlags_PreferSortDescending;
+            }
+            ImGui::TableSetupColumn(headers[i].isString() ? headers[i].asString().c_str() : "",
+                                    colFlags);
+        }
+        ImGui::TableHeadersRow();
+    }
+
+    // Sorting is by column index only; the script reorders its data
+    ImGuiTableSortSpecs* specs = ImGui::TableGetSortSpecs();
+    if (specs && specs->SpecsDirty) {
+        if (specs->SpecsCount > 0) {
+            sortColumn = specs->Specs[0].ColumnIndex;
+            sortAscending = specs->Specs[0].SortDirection != ImGuiSortDirection_Descending;
+        } else {
+            sortColumn = -1;
+            sortAscending = true;
+        }
+        specs->SpecsDirty = false;
+        m.set(syms_.sort_column, Value::integer(sortColumn));
+        m.set(syms_.sort_ascending, Value::boolean(sortAscending));
+        invokeCallback(m, syms_.on_sort, ctx,
+                       {Value::integer(sortColumn), Value::boolean(sortAscending)});
+    }
+
+    renderVirtualRows(m, true, ctx);
+    ImGui::EndTable();
+}
+
+void MapRenderer::renderVirtualRows(MapData& m, bool inTable, ExecutionContext& ctx) {
+    auto rowFn = m.get(syms_.row_fn);
+    if (!rowFn.isCallable()) return;
+
+    int rowCount = std::max(static_cast<int>(getNumericField(m, syms_.row_count, 0)), 0);
+    float rowHeight = static_cast<float>(getNumericField(m, syms_.row_height, 0.0));
+    bool selectable = m.get(syms_.on_change).isCallable();
+
+    // Only the rows in view are requested from row_fn, and nothing is kept
+    // between frames, so per-frame cost does not depend on row_count
+    ImGuiListClipper clipper;
+    clipper.Begin(rowCount);
+    while (clipper.Step()) {
+        for (int row = clipper.DisplayStart; row < clipper.DisplayEnd; row++) {
+            // A callback may have shrunk the data source mid-frame
+            if (row >= static_cast<int>(getNumericField(m, syms_.row_count, 0))) break;
+
+            Value rowVal = engine_.callFunction(rowFn, {Value::integer(row)}, ctx);
+
+            ImGui::PushID(row);
+            if (inTable) {
+                ImGui::TableNextRow(ImGuiTableRowFlags_None, rowHeight);
+                ImGui::TableNextColumn();
+            }
+            ImVec2 rowPos = ImGui::GetCursorScreenPos();
+
+            // Selection highlight behind the row's own widgets
+            if (selectable) {
+                int selected = static_cast<int>(getNumericField(m, syms_.selected, -1));
+                ImGuiSelectableFlags selFlags = ImGuiSelectableFlags_AllowOverlap;
+                if (inTable) selFlags |= ImGuiSelectableFlags_SpanAllColumns;
+                if (ImGui::Selectable("##row", row == selected, selFlags, {0.0f, rowHeight})) {
+                    m.set(syms_.selected, Value::integer(row));
+                    invokeCallback(m, syms_.on_change, ctx, {Value::integer(row)});
+                }
+                ImGui::SetCursorScreenPos(rowPos);
+            }
+
+            if (rowVal.isMap()) {
+                auto& rm = rowVal.asMap();
+                auto typeVal = rm.get(syms_.type);
+                auto cellsVal = rm.get(syms_.children);
+                if (inTable && typeVal.isSymbol() && typeVal.asSymbol() == syms_.sym_table_row &&
+                    cellsVal.isArray()) {
+                    // Each child of a table_row fills the next cell
+                    bool first = true;
+                    for (auto& cell : cellsVal.asArrayMut()) {
+                        if (!cell.isMap()) continue;
+                        if (!first) ImGui::TableNextColumn();
+                        renderNode(cell.asMap(), ctx);
+                        first = false;
+                    }
+                } else {
+                    renderNode(rm, ctx);
+                }
+            } else if (rowVal.isString()) {
+                ImGui::TextUnformatted(rowVal.asString().c_str());
+            }
+
+            // Pad short list rows so every row keeps the same height
+            if (!inTable && rowHeight > 0.0f) {
+                float used = ImGui::GetCursorScreenPos().y - rowPos.y - ImGui::GetStyle().ItemSpacing.y;
+                if (used < rowHeight) ImGui::Dummy({0.0f, rowHeight - used});
+            }
+            ImGui::PopID();
+        }
+    }
+}
+
 // -- Drag and Drop ------------------------------------------------------------
 
 void MapRenderer::handleDragDrop(MapData& m, ExecutionContext& ctx) {
@@ -1403,6 +1403,49 @@ void registerGuiBindings(ScriptEngine& engine) {
             return makeWidget(engine, "table_next_column");
         }));
 
+    // =========================================================================
+    // Virtual lists
+    // =========================================================================
+
+    // ui.virtual_list "id" row_count row_fn
+    uiMap.set(engine.intern("virtual_list"), makeFn(
+        [&engine](ExecutionContext&, const std::vector<Value>& args) -> Value {
+            auto w = makeWidget(engine, "virtual_list");
+            auto& m = w.asMap();
+            if (args.size() > 0 && args[0].isString()) {
+                m.set(engine.intern("id"), args[0]);
+            }
+            if (args.size() > 1 && args[1].isNumeric()) {
+                m.set(engine.intern("row_count"), args[1]);
+            }
+            if (args.size() > 2 && args[2].isCallable()) {
+                m.set(engine.intern("row_fn"), args[2]);
+            }
+            mergeOptions(args, w, engine);
+            return w;
+        }));
+
+    // ui.virtual_table "id" num_cols row_count row_fn
+    uiMap.set(engine.intern("virtual_table"), makeFn(
+        [&engine](ExecutionContext&, const std::vector<Value>& args) -> Value {
+            auto w = makeWidget(engine, "virtual_table");
+            auto& m = w.asMap();
+            if (args.size() > 0 && args[0].isString()) {
+                m.set(engine.intern("id"), args[0]);
+            }
+            if (args.size() > 1 && args[1].isNumeric()) {
+                m.set(engine.intern("num_columns"), args[1]);
+            }
+            if (args.size() > 2 && args[2].isNumeric()) {
+                m.set(engine.intern("row_count"), args[2]);
+            }
+            if (args.size() > 3 && args[3].isCallable()) {
+                m.set(engine.intern("row_fn"), args[3]);
+            }
+            mergeOptions(args, w, engine);
+            return w;
+        }));
+
     // =========================================================================
     // Action functions (require ScriptGui context via ctx.userData())
     // =========================================================================
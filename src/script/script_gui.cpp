@@ -1,6 +1,7 @@
 #include <finegui/script_gui.hpp>
 #include <finegui/map_renderer.hpp>
 #include <finegui/hotkey_manager.hpp>
+#include <finegui/script_session.hpp>
 #include <finescript/map_data.h>
 #include <mutex>
 #include <unordered_map>
@@ -29,6 +30,7 @@ struct ScriptGui::Impl {
     std::vector<PendingMessage> pendingMessages;
 
     HotkeyManager* hotkeyManager = nullptr;
+    SessionRecorder* recorder = nullptr;
 
     Impl(finescript::ScriptEngine& e, MapRenderer& r)
         : engine(e), renderer(r) {
@@ -102,6 +104,12 @@ bool ScriptGui::run(const finescript::CompiledScript& script,
 // -- Message delivery ---------------------------------------------------------
 
 bool ScriptGui::deliverMessage(uint32_t messageType, finescript::Value data) {
+    if (impl_->recorder) {
+        impl_->recorder->recordMessage(impl_->guiId, [&](SessionWriter& out) {
+            writeScriptMessage(out, impl_->engine, messageType, data);
+        });
+    }
+
     auto it = impl_->messageHandlers.find(messageType);
     if (it == impl_->messageHandlers.end()) {
         return false;
@@ -133,6 +141,10 @@ void ScriptGui::processPendingMessages() {
     }
 }
 
+void ScriptGui::setSessionRecorder(SessionRecorder* recorder) {
+    impl_->recorder = recorder;
+}
+
 // -- Lifecycle ----------------------------------------------------------------
 
 void ScriptGui::close() {
@@ -1,5 +1,6 @@
 #include <finegui/script_gui_manager.hpp>
 #include <finegui/map_renderer.hpp>
+#include <finegui/script_session.hpp>
 #include <algorithm>
 
 namespace finegui {
@@ -33,12 +34,24 @@ int ScriptGuiManager::loadUIFromValue(finescript::Value widgetTree, bool immedia
 
 bool ScriptGuiManager::deliverMessage(int guiId, uint32_t messageType,
                                        finescript::Value data) {
+    if (recorder_) {
+        recorder_->recordMessage(guiId, [&](SessionWriter& out) {
+            writeScriptMessage(out, engine_, messageType, data);
+        });
+    }
+
     auto* gui = findByGuiId(guiId);
     if (!gui) return false;
     return gui->deliverMessage(messageType, std::move(data));
 }
 
 void ScriptGuiManager::broadcastMessage(uint32_t messageType, finescript::Value data) {
+    if (recorder_) {
+        recorder_->recordMessage(kSessionBroadcast, [&](SessionWriter& out) {
+            writeScriptMessage(out, engine_, messageType, data);
+        });
+    }
+
     for (auto& gui : guis_) {
         if (gui->isActive()) {
             gui->deliverMessage(messageType, data);
@@ -70,6 +83,10 @@ void ScriptGuiManager::processPendingMessages() {
     }
 }
 
+void ScriptGuiManager::setSessionRecorder(SessionRecorder* recorder) {
+    recorder_ = recorder;
+}
+
 void ScriptGuiManager::close(int guiId) {
     auto* gui = findByGuiId(guiId);
     if (gui) {
@@ -0,0 +1,145 @@
+#include <finegui/script_session.hpp>
+#include <finegui/script_gui.hpp>
+#include <finegui/script_gui_manager.hpp>
+#include <finegui/session_replayer.hpp>
+#include <finescript/map_data.h>
+#include <algorithm>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace finegui {
+
+using finescript::Value;
+
+namespace {
+
+// Value tags in the session encoding
+enum class ValueTag : uint8_t {
+    Nil = 0,
+    False = 1,
+    True = 2,
+    Int = 3,
+    Float = 4,
+    String = 5,
+    Symbol = 6,
+    Array = 7,
+    Map = 8
+};
+
+// Guards readScriptValue() against runaway nesting in a corrupt log
+constexpr int kMaxDepth = 64;
+
+Value readValue(SessionReader& in, finescript::ScriptEngine& engine, int depth) {
+    if (depth > kMaxDepth) {
+        throw std::runtime_error("readScriptValue: values nested too deeply");
+    }
+
+    switch (static_cast<ValueTag>(in.u8())) {
+        case ValueTag::Nil:    return Value::nil();
+        case ValueTag::False:  return Value::boolean(false);
+        case ValueTag::True:   return Value::boolean(true);
+        case ValueTag::Int:    return Value::integer(in.svarint());
+        case ValueTag::Float:  return Value::number(in.f64());
+        case ValueTag::String: return Value::string(in.string());
+        case ValueTag::Symbol: return Value::symbol(engine.intern(in.string()));
+        case ValueTag::Array: {
+            auto count = static_cast<size_t>(in.varint());
+            auto result = Value::array({});
+            auto& items = result.asArrayMut();
+            items.reserve(std::min(count, in.remaining()));
+            for (size_t i = 0; i < count; i++) {
+                items.push_back(readValue(in, engine, depth + 1));
+            }
+            return result;
+        }
+        case ValueTag::Map: {
+            auto count = static_cast<size_t>(in.varint());
+            auto result = Value::map();
+            for (size_t i = 0; i < count; i++) {
+                uint32_t key = engine.intern(in.string());
+                result.asMap().set(key, readValue(in, engine, depth + 1));
+            }
+            return result;
+        }
+    }
+    throw std::runtime_error("readScriptValue: unknown value tag");
+}
+
+} // namespace
+
+void writeScriptValue(SessionWriter& out, finescript::ScriptEngine& engine,
+                      const Value& value) {
+    if (value.isBool()) {
+        out.u8(static_cast<uint8_t>(value.asBool() ? ValueTag::True : ValueTag::False));
+    } else if (value.isInt()) {
+        out.u8(static_cast<uint8_t>(ValueTag::Int));
+        out.svarint(value.asInt());
+    } else if (value.isFloat()) {
+        out.u8(static_cast<uint8_t>(ValueTag::Float));
+        out.f64(value.asFloat());
+    } else if (value.isString()) {
+        out.u8(static_cast<uint8_t>(ValueTag::String));
+        out.string(value.asString());
+    } else if (value.isSymbol()) {
+        out.u8(static_cast<uint8_t>(ValueTag::Symbol));
+        out.string(engine.lookupSymbol(value.asSymbol()));
+    } else if (value.isArray()) {
+        const auto& items = value.asArray();
+        out.u8(static_cast<uint8_t>(ValueTag::Array));
+        out.varint(items.size());
+        for (const auto& item : items) {
+            writeScriptValue(out, engine, item);
+        }
+    } else if (value.isMap()) {
+        const auto& map = value.asMap();
+        auto keys = map.keys();
+        out.u8(static_cast<uint8_t>(ValueTag::Map));
+        out.varint(keys.size());
+        for (uint32_t key : keys) {
+            out.string(engine.lookupSymbol(key));
+            writeScriptValue(out, engine, map.get(key));
+        }
+    } else {
+        out.u8(static_cast<uint8_t>(ValueTag::Nil));
+    }
+}
+
+Value readScriptValue(SessionReader& in, finescript::ScriptEngine& engine) {
+    return readValue(in, engine, 0);
+}
+
+void writeScriptMessage(SessionWriter& out, finescript::ScriptEngine& engine,
+                        uint32_t messageType, const Value& data) {
+    out.string(engine.lookupSymbol(messageType));
+    writeScriptValue(out, engine, data);
+}
+
+std::pair<uint32_t, Value> readScriptMessage(SessionReader& in,
+                                             finescript::ScriptEngine& engine) {
+    uint32_t messageType = engine.intern(in.string());
+    Value data = readScriptValue(in, engine);
+    return {messageType, std::move(data)};
+}
+
+void replayScriptMessages(SessionReplayer& replayer, finescript::ScriptEngine& engine,
+                          ScriptGuiManager& manager) {
+    replayer.setMessageHandler([&engine, &manager](int target, SessionReader& payload) {
+        auto [messageType, data] = readScriptMessage(payload, engine);
+        if (target == kSessionBroadcast) {
+            manager.broadcastMessage(messageType, std::move(data));
+        } else {
+            manager.deliverMessage(target, messageType, std::move(data));
+        }
+    });
+}
+
+void replayScriptMessages(SessionReplayer& replayer, finescript::ScriptEngine& engine,
+                          ScriptGui& gui) {
+    replayer.setMessageHandler([&engine, &gui](int, SessionReader& payload) {
+        auto [messageType, data] = readScriptMessage(payload, engine);
+        gui.deliverMessage(messageType, std::move(data));
+    });
+}
+
+} // namespace finegui
@@ -187,6 +187,18 @@ void ConverterSymbols::intern(finescript::ScriptEngine& engine) {
     sym_push_theme = engine.intern("push_theme");
     sym_pop_theme  = engine.intern("pop_theme");
 
+    // Type name symbols - Virtual lists
+    sym_virtual_list  = engine.intern("virtual_list");
+    sym_virtual_table = engine.intern("virtual_table");
+
+    // Virtual list field keys
+    row_count      = engine.intern("row_count");
+    row_fn         = engine.intern("row_fn");
+    row_height     = engine.intern("row_height");
+    sort_column    = engine.intern("sort_column");
+    sort_ascending = engine.intern("sort_ascending");
+    on_sort        = engine.intern("on_sort");
+
     // Phase 12 field keys
     hint = engine.intern("hint");
 
@@ -270,6 +282,9 @@ static WidgetNode::Type symbolToType(uint32_t sym, const ConverterSymbols& s) {
     // Style & Theming
     if (sym == s.sym_push_theme)     return WidgetNode::Type::PushTheme;
     if (sym == s.sym_pop_theme)      return WidgetNode::Type::PopTheme;
+    // Virtual lists
+    if (sym == s.sym_virtual_list)   return WidgetNode::Type::VirtualList;
+    if (sym == s.sym_virtual_table)  return WidgetNode::Type::VirtualTable;
     return WidgetNode::Type::Text; // fallback
 }
 
@@ -326,20 +341,22 @@ WidgetNode convertToWidget(const finescript::Value& map,
         } else if (valVal.isFloat() || valVal.isNumeric()) {
             node.floatValue = static_cast<float>(valVal.asNumber());
         } else if (valVal.isString()) {
-            node.stringValue = std::string(valVal.asString());
+            node.propsMut().stringValue = std::string(valVal.asString());
         }
     }
 
     // Min / max
     auto minVal = m.get(syms.min);
     if (minVal.isNumeric()) {
-        node.minFloat = static_cast<float>(minVal.asNumber());
-        node.minInt = static_cast<int>(minVal.asNumber());
+        WidgetNode::Props& props = node.propsMut();
+        props.minFloat = static_cast<float>(minVal.asNumber());
+        props.minInt = static_cast<int>(minVal.asNumber());
     }
     auto maxVal = m.get(syms.max);
     if (maxVal.isNumeric()) {
-        node.maxFloat = static_cast<float>(maxVal.asNumber());
-        node.maxInt = static_cast<int>(maxVal.asNumber());
+        WidgetNode::Props& props = node.propsMut();
+        props.maxFloat = static_cast<float>(maxVal.asNumber());
+        props.maxInt = static_cast<int>(maxVal.asNumber());
     }
 
     // Selected index (for combo)
@@ -361,7 +378,7 @@ WidgetNode convertToWidget(const finescript::Value& map,
     // Column count
     auto countVal = m.get(syms.count);
     if (countVal.isInt()) {
-        node.columnCount = static_cast<int>(countVal.asInt());
+        node.propsMut().columnCount = static_cast<int>(countVal.asInt());
     }
 
     // Visible / enabled
@@ -378,12 +395,13 @@ WidgetNode convertToWidget(const finescript::Value& map,
     auto itemsVal = m.get(syms.items);
     if (itemsVal.isArray()) {
         const auto& arr = itemsVal.asArray();
-        node.items.reserve(arr.size());
+        auto& items = node.propsMut().items;
+        items.reserve(arr.size());
         for (const auto& item : arr) {
             if (item.isString()) {
-                node.items.push_back(std::string(item.asString()));
+                items.push_back(std::string(item.asString()));
             } else {
-                node.items.push_back(item.toString(&engine.interner()));
+                items.push_back(item.toString(&engine.interner()));
             }
         }
     }
@@ -391,14 +409,14 @@ WidgetNode convertToWidget(const finescript::Value& map,
     // Callbacks — wrap script closures as C++ WidgetCallback
     auto onClickVal = m.get(syms.on_click);
     if (onClickVal.isCallable()) {
-        node.onClick = [&engine, &ctx, closure = onClickVal](WidgetNode&) {
+        node.callbacksMut().onClick = [&engine, &ctx, closure = onClickVal](WidgetNode&) {
             engine.callFunction(closure, {}, ctx);
         };
     }
 
     auto onChangeVal = m.get(syms.on_change);
     if (onChangeVal.isCallable()) {
-        node.onChange = [&engine, &ctx, closure = onChangeVal](WidgetNode& w) {
+        node.callbacksMut().onChange = [&engine, &ctx, closure = onChangeVal](WidgetNode& w) {
             auto scriptVal = widgetValueToScriptValue(w);
             engine.callFunction(closure, {scriptVal}, ctx);
         };
@@ -406,7 +424,7 @@ WidgetNode convertToWidget(const finescript::Value& map,
 
     auto onSubmitVal = m.get(syms.on_submit);
     if (onSubmitVal.isCallable()) {
-        node.onSubmit = [&engine, &ctx, closure = onSubmitVal](WidgetNode& w) {
+        node.callbacksMut().onSubmit = [&engine, &ctx, closure = onSubmitVal](WidgetNode& w) {
             auto scriptVal = widgetValueToScriptValue(w);
             engine.callFunction(closure, {scriptVal}, ctx);
         };
@@ -414,7 +432,7 @@ WidgetNode convertToWidget(const finescript::Value& map,
 
     auto onCloseVal = m.get(syms.on_close);
     if (onCloseVal.isCallable()) {
-        node.onClose = [&engine, &ctx, closure = onCloseVal](WidgetNode&) {
+        node.callbacksMut().onClose = [&engine, &ctx, closure = onCloseVal](WidgetNode&) {
             engine.callFunction(closure, {}, ctx);
         };
     }
@@ -422,29 +440,29 @@ WidgetNode convertToWidget(const finescript::Value& map,
     // DnD fields
     auto dragTypeVal = m.get(syms.drag_type);
     if (dragTypeVal.isString()) {
-        node.dragType = std::string(dragTypeVal.asString());
+        node.propsMut().dragType = std::string(dragTypeVal.asString());
     }
     auto dragDataVal = m.get(syms.drag_data);
     if (dragDataVal.isString()) {
-        node.dragData = std::string(dragDataVal.asString());
+        node.propsMut().dragData = std::string(dragDataVal.asString());
     }
     auto dropAcceptVal = m.get(syms.drop_accept);
     if (dropAcceptVal.isString()) {
-        node.dropAcceptType = std::string(dropAcceptVal.asString());
+        node.propsMut().dropAcceptType = std::string(dropAcceptVal.asString());
     }
     auto dragModeVal = m.get(syms.drag_mode);
     if (dragModeVal.isInt()) {
-        node.dragMode = static_cast<int>(dragModeVal.asInt());
+        node.propsMut().dragMode = static_cast<int>(dragModeVal.asInt());
     }
     auto onDropVal = m.get(syms.on_drop);
     if (onDropVal.isCallable()) {
-        node.onDrop = [&engine, &ctx, closure = onDropVal](WidgetNode& w) {
-            engine.callFunction(closure, {finescript::Value::string(w.dragData)}, ctx);
+        node.callbacksMut().onDrop = [&engine, &ctx, closure = onDropVal](WidgetNode& w) {
+            engine.callFunction(closure, {finescript::Value::string(w.props().dragData)}, ctx);
         };
     }
     auto onDragVal = m.get(syms.on_drag);
     if (onDragVal.isCallable()) {
-        node.onDragBegin = [&engine, &ctx, closure = onDragVal](WidgetNode&) {
+        node.callbacksMut().onDragBegin = [&engine, &ctx, closure = onDragVal](WidgetNode&) {
             engine.callFunction(closure, {}, ctx);
         };
     }
@@ -460,13 +478,13 @@ WidgetNode convertToWidget(const finescript::Value& map,
     }
     auto onFocusVal = m.get(syms.on_focus);
     if (onFocusVal.isCallable()) {
-        node.onFocus = [&engine, &ctx, closure = onFocusVal](WidgetNode&) {
+        node.callbacksMut().onFocus = [&engine, &ctx, closure = onFocusVal](WidgetNode&) {
             engine.callFunction(closure, {}, ctx);
         };
     }
     auto onBlurVal = m.get(syms.on_blur);
     if (onBlurVal.isCallable()) {
-        node.onBlur = [&engine, &ctx, closure = onBlurVal](WidgetNode&) {
+        node.callbacksMut().onBlur = [&engine, &ctx, closure = onBlurVal](WidgetNode&) {
             engine.callFunction(closure, {}, ctx);
         };
     }
@@ -474,32 +492,85 @@ WidgetNode convertToWidget(const finescript::Value& map,
     // Window pivot (for centering positioned windows)
     auto pivotXVal = m.get(syms.window_pivot_x);
     if (pivotXVal.isNumeric()) {
-        node.windowPivotX = static_cast<float>(pivotXVal.asNumber());
+        node.propsMut().windowPivotX = static_cast<float>(pivotXVal.asNumber());
     }
     auto pivotYVal = m.get(syms.window_pivot_y);
     if (pivotYVal.isNumeric()) {
-        node.windowPivotY = static_cast<float>(pivotYVal.asNumber());
+        node.propsMut().windowPivotY = static_cast<float>(pivotYVal.asNumber());
     }
 
     // Format string (for sliders, drags)
     auto formatVal = m.get(syms.format);
     if (formatVal.isString()) {
-        node.formatString = std::string(formatVal.asString());
+        node.propsMut().formatString = std::string(formatVal.asString());
     }
 
     // History callback (for InputText)
     auto onHistoryVal = m.get(syms.on_history);
     if (onHistoryVal.isCallable()) {
-        node.onHistory = [&engine, &ctx, closure = onHistoryVal](WidgetNode& w) {
+        node.callbacksMut().onHistory = [&engine, &ctx, closure = onHistoryVal](WidgetNode& w) {
             // w.intValue carries direction: -1 = up, +1 = down
             auto result = engine.callFunction(
                 closure, {finescript::Value::integer(w.intValue)}, ctx);
             if (result.isString()) {
-                w.stringValue = std::string(result.asString());
+                w.propsMut().stringValue = std::string(result.asString());
             }
         };
     }
 
+    // Virtual list / table: the row closure is called per visible row
+    if (node.type == WidgetNode::Type::VirtualList ||
+        node.type == WidgetNode::Type::VirtualTable) {
+        WidgetNode::Props& props = node.propsMut();
+        auto rowCountVal = m.get(syms.row_count);
+        if (rowCountVal.isInt()) {
+            props.rowCount = static_cast<int>(rowCountVal.asInt());
+        }
+        auto rowHeightVal = m.get(syms.row_height);
+        if (rowHeightVal.isNumeric()) {
+            props.rowHeight = static_cast<float>(rowHeightVal.asNumber());
+        }
+        auto numColsVal = m.get(syms.num_columns);
+        if (numColsVal.isInt()) {
+            props.columnCount = static_cast<int>(numColsVal.asInt());
+        }
+        auto headersVal = m.get(syms.headers);
+        if (headersVal.isArray()) {
+            for (const auto& h : headersVal.asArray()) {
+                props.items.push_back(h.isString() ? std::string(h.asString()) : std::string());
+            }
+        }
+        auto sortColVal = m.get(syms.sort_column);
+        if (sortColVal.isInt()) {
+            props.sortColumn = static_cast<int>(sortColVal.asInt());
+        }
+        auto sortAscVal = m.get(syms.sort_ascending);
+        if (sortAscVal.isBool()) {
+            props.sortAscending = sortAscVal.asBool();
+        }
+        // As in the script renderer, an on_change handler makes rows selectable
+        props.rowSelection = onChangeVal.isCallable();
+
+        auto rowFnVal = m.get(syms.row_fn);
+        if (rowFnVal.isCallable()) {
+            node.callbacksMut().rowProvider = [&engine, &ctx, syms, closure = rowFnVal](int row) {
+                auto result = engine.callFunction(closure, {finescript::Value::integer(row)}, ctx);
+                if (result.isMap()) {
+                    return convertToWidget(result, engine, ctx, syms);
+                }
+                return WidgetNode::text(result.isString() ? std::string(result.asString())
+                                                          : result.toString(&engine.interner()));
+            };
+        }
+        auto onSortVal = m.get(syms.on_sort);
+        if (onSortVal.isCallable()) {
+            node.callbacksMut().onSort = [&engine, &ctx, closure = onSortVal](WidgetNode& w) {
+                engine.callFunction(closure, {finescript::Value::integer(w.props().sortColumn),
+                                              finescript::Value::boolean(w.props().sortAscending)}, ctx);
+            };
+        }
+    }
+
     // Children (recurse)
     auto childrenVal = m.get(syms.children);
     if (childrenVal.isArray()) {
@@ -532,15 +603,17 @@ finescript::Value widgetValueToScriptValue(const WidgetNode& widget) {
             return finescript::Value::integer(widget.intValue);
         case WidgetNode::Type::InputText:
         case WidgetNode::Type::InputTextWithHint:
-            return finescript::Value::string(widget.stringValue);
+            return finescript::Value::string(widget.props().stringValue);
         case WidgetNode::Type::DragFloat3:
             return finescript::Value::array({
-                finescript::Value::number(widget.floatX),
-                finescript::Value::number(widget.floatY),
-                finescript::Value::number(widget.floatZ)
+                finescript::Value::number(widget.props().floatX),
+                finescript::Value::number(widget.props().floatY),
+                finescript::Value::number(widget.props().floatZ)
             });
         case WidgetNode::Type::Combo:
         case WidgetNode::Type::ListBox:
+        case WidgetNode::Type::VirtualList:
+        case WidgetNode::Type::VirtualTable:
             return finescript::Value::integer(widget.selectedIndex);
         default:
             return finescript::Value::nil();
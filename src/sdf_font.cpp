@@ -0,0 +1,158 @@
+/**
+ * @file sdf_font.cpp
+ * @brief Signed-distance-field glyphs for scale-independent text
+ */
+
+#include <finegui/sdf_font.hpp>
+
+#include <imgui.h>
+#include <imgui_internal.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <vector>
+
+namespace finegui {
+
+void coverageToDistanceField(uint8_t* pixels, int width, int height,
+                             int pitch, int stride, int spread)
+{
+    if (width <= 0 || height <= 0 || spread <= 0) {
+        return;
+    }
+
+    std::vector<uint8_t> coverage(static_cast<size_t>(width) * height);
+    for (int y = 0; y < height; y++) {
+        for (int x = 0; x < width; x++) {
+            coverage[y * width + x] = pixels[y * pitch + x * stride];
+        }
+    }
+    auto inside = [&](int x, int y) { return coverage[y * width + x] >= 128; };
+
+    // Brute-force search within the spread: glyphs are small and only
+    // converted once, when they are first rasterized
+    const int radius = spread + 1;
+    for (int y = 0; y < height; y++) {
+        for (int x = 0; x < width; x++) {
+            uint8_t c = coverage[y * width + x];
+            float distance;
+            if (c > 0 && c < 255) {
+                // Antialiased edge pixel: coverage locates the edge within it
+                distance = c / 255.0f - 0.5f;
+            } else {
+                bool in = inside(x, y);
+                int best = radius * radius * 2;
+                for (int dy = -radius; dy <= radius; dy++) {
+                    int sy = y + dy;
+                    if (sy < 0 || sy >= height) continue;
+                    for (int dx = -radius; dx <= radius; dx++) {
+                        int sx = x + dx;
+                        if (sx < 0 || sx >= width || inside(sx, sy) == in) continue;
+                        best = std::min(best, dx * dx + dy * dy);
+                    }
+                }
+                // Distance to the opposite pixel's center, less half a pixel
+                // to land on the edge between them
+                float edge = std::sqrt(static_cast<float>(best)) - 0.5f;
+                distance = in ? edge : -edge;
+            }
+
+            float value = 0.5f + distance / (2.0f * static_cast<float>(spread));
+            value = std::clamp(value, 0.0f, 1.0f);
+            pixels[y * pitch + x * stride] = static_cast<uint8_t>(value * 255.0f + 0.5f);
+        }
+    }
+}
+
+namespace {
+
+// Re-pack a glyph's pixels into a rect with @p pad blank pixels on every
+// side, and grow its quad to match. Returns the glyph's rect (the original
+// one if the atlas has no room).
+ImTextureRect* padGlyphRect(ImFontAtlas* atlas, ImFontGlyph* glyph, int pad) {
+    ImTextureRect* old = ImFontAtlasPackGetRect(atlas, glyph->PackId);
+    const int w = old->w;
+    const int h = old->h;
+
+    // Adding a rect may grow the atlas, which moves the old rect's pixels
+    ImFontAtlasRectId padded = ImFontAtlasPackAddRect(atlas, w + 2 * pad, h + 2 * pad);
+    if (padded == ImFontAtlasRectId_Invalid) {
+        return ImFontAtlasPackGetRect(atlas, glyph->PackId);
+    }
+    old = ImFontAtlasPackGetRect(atlas, glyph->PackId);
+    ImTextureRect* rect = ImFontAtlasPackGetRect(atlas, padded);
+
+    // Blank padding (transparent white, as ImGui clears RGBA atlases), then
+    // the glyph's rows in the middle
+    ImTextureData* tex = atlas->TexData;
+    const int bpp = tex->BytesPerPixel;
+    for (int y = 0; y < rect->h; y++) {
+        auto* row = static_cast<uint8_t*>(tex->GetPixelsAt(rect->x, rect->y + y));
+        if (tex->Format == ImTextureFormat_RGBA32) {
+            for (int x = 0; x < rect->w; x++) {
+                row[x * 4 + 0] = row[x * 4 + 1] = row[x * 4 + 2] = 255;
+                row[x * 4 + 3] = 0;
+            }
+        } else {
+            std::memset(row, 0, static_cast<size_t>(rect->w) * bpp);
+        }
+    }
+    for (int y = 0; y < h; y++) {
+        std::memcpy(tex->GetPixelsAt(rect->x + pad, rect->y + pad + y),
+                    tex->GetPixelsAt(old->x, old->y + y),
+                    static_cast<size_t>(w) * bpp);
+    }
+
+    // The quad spans the rect in glyph units; extend it by the padding
+    const float padX = pad * (glyph->X1 - glyph->X0) / static_cast<float>(w);
+    const float padY = pad * (glyph->Y1 - glyph->Y0) / static_cast<float>(h);
+    glyph->X0 -= padX;
+    glyph->X1 += padX;
+    glyph->Y0 -= padY;
+    glyph->Y1 += padY;
+
+    ImFontAtlasPackDiscardRect(atlas, glyph->PackId);
+    glyph->PackId = padded;
+    return rect;
+}
+
+bool loadSdfGlyph(ImFontAtlas* atlas, ImFontConfig* src, ImFontBaked* baked,
+                  void* loaderData, ImWchar codepoint, ImFontGlyph* outGlyph,
+                  float* outAdvanceX)
+{
+    const ImFontLoader* base = ImFontAtlasGetFontLoaderForStbTruetype();
+    if (!base->FontBakedLoadGlyph(atlas, src, baked, loaderData, codepoint, outGlyph, outAdvanceX)) {
+        return false;
+    }
+
+    // Advance-only queries and blank glyphs have no pixels
+    if (outGlyph == nullptr || !outGlyph->Visible || outGlyph->PackId < 0) {
+        return true;
+    }
+
+    // The base loader packed the glyph's rect tight around its coverage,
+    // but the field has to extend kSdfSpread pixels beyond it; move the
+    // glyph into a padded rect before converting it
+    ImTextureRect* rect = padGlyphRect(atlas, outGlyph, kSdfSpread);
+    ImTextureData* tex = atlas->TexData;
+    int alphaOffset = tex->Format == ImTextureFormat_RGBA32 ? 3 : 0;
+    auto* pixels = static_cast<uint8_t*>(tex->GetPixelsAt(rect->x, rect->y)) + alphaOffset;
+    coverageToDistanceField(pixels, rect->w, rect->h, tex->GetPitch(), tex->BytesPerPixel);
+    ImFontAtlasTextureBlockQueueUpload(atlas, tex, rect->x, rect->y, rect->w, rect->h);
+    return true;
+}
+
+} // namespace
+
+const ImFontLoader* sdfFontLoader() {
+    static const ImFontLoader loader = [] {
+        ImFontLoader l = *ImFontAtlasGetFontLoaderForStbTruetype();
+        l.Name = "stb_truetype (SDF)";
+        l.FontBakedLoadGlyph = loadSdfGlyph;
+        return l;
+    }();
+    return &loader;
+}
+
+} // namespace finegui
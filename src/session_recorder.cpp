@@ -0,0 +1,258 @@
+/**
+ * @file session_recorder.cpp
+ * @brief Compact binary log of everything that drives a GUI session
+ */
+
+#include <finegui/session_recorder.hpp>
+
+#include <cstring>
+#include <fstream>
+#include <ostream>
+#include <stdexcept>
+
+namespace finegui {
+
+// ============================================================================
+// SessionWriter / SessionReader
+// ============================================================================
+
+void SessionWriter::varint(uint64_t value) {
+    while (value >= 0x80) {
+        out_.push_back(static_cast<uint8_t>(value | 0x80));
+        value >>= 7;
+    }
+    out_.push_back(static_cast<uint8_t>(value));
+}
+
+void SessionWriter::svarint(int64_t value) {
+    varint((static_cast<uint64_t>(value) << 1) ^ static_cast<uint64_t>(value >> 63));
+}
+
+void SessionWriter::f32(float value) {
+    uint32_t bits;
+    std::memcpy(&bits, &value, sizeof(bits));
+    for (int i = 0; i < 4; i++) {
+        out_.push_back(static_cast<uint8_t>(bits >> (i * 8)));
+    }
+}
+
+void SessionWriter::f64(double value) {
+    uint64_t bits;
+    std::memcpy(&bits, &value, sizeof(bits));
+    for (int i = 0; i < 8; i++) {
+        out_.push_back(static_cast<uint8_t>(bits >> (i * 8)));
+    }
+}
+
+void SessionWriter::bytes(const void* data, size_t size) {
+    const auto* begin = static_cast<const uint8_t*>(data);
+    out_.insert(out_.end(), begin, begin + size);
+}
+
+void SessionWriter::string(std::string_view value) {
+    varint(value.size());
+    bytes(value.data(), value.size());
+}
+
+const uint8_t* SessionReader::bytes(size_t size) {
+    if (size > remaining()) {
+        throw std::runtime_error("SessionReader::bytes: record runs past the end of the log");
+    }
+    const uint8_t* data = data_ + pos_;
+    pos_ += size;
+    return data;
+}
+
+uint8_t SessionReader::u8() {
+    return *bytes(1);
+}
+
+uint64_t SessionReader::varint() {
+    uint64_t value = 0;
+    for (int shift = 0; shift < 64; shift += 7) {
+        uint8_t byte = u8();
+        value |= static_cast<uint64_t>(byte & 0x7F) << shift;
+        if (!(byte & 0x80)) {
+            return value;
+        }
+    }
+    throw std::runtime_error("SessionReader::varint: malformed varint");
+}
+
+int64_t SessionReader::svarint() {
+    uint64_t value = varint();
+    return static_cast<int64_t>(value >> 1) ^ -static_cast<int64_t>(value & 1);
+}
+
+float SessionReader::f32() {
+    const uint8_t* data = bytes(4);
+    uint32_t bits = 0;
+    for (int i = 0; i < 4; i++) {
+        bits |= static_cast<uint32_t>(data[i]) << (i * 8);
+    }
+    float value;
+    std::memcpy(&value, &bits, sizeof(value));
+    return value;
+}
+
+double SessionReader::f64() {
+    const uint8_t* data = bytes(8);
+    uint64_t bits = 0;
+    for (int i = 0; i < 8; i++) {
+        bits |= static_cast<uint64_t>(data[i]) << (i * 8);
+    }
+    double value;
+    std::memcpy(&value, &bits, sizeof(value));
+    return value;
+}
+
+std::string SessionReader::string() {
+    size_t size = static_cast<size_t>(varint());
+    const uint8_t* data = bytes(size);
+    return std::string(reinterpret_cast<const char*>(data), size);
+}
+
+// ============================================================================
+// SessionRecorder
+// ============================================================================
+
+SessionRecorder::SessionRecorder(std::ostream& out)
+    : out_(&out)
+{
+    writeHeader();
+}
+
+SessionRecorder::SessionRecorder(const std::string& path)
+    : file_(std::make_unique<std::ofstream>(path, std::ios::binary | std::ios::trunc))
+{
+    if (!*file_) {
+        throw std::runtime_error("SessionRecorder: cannot create " + path);
+    }
+    out_ = file_.get();
+    writeHeader();
+}
+
+SessionRecorder::~SessionRecorder() {
+    flush();
+}
+
+void SessionRecorder::writeHeader() {
+    buffer_.insert(buffer_.end(), kSessionMagic, kSessionMagic + sizeof(kSessionMagic));
+    buffer_.push_back(kSessionVersion);
+    flush();
+}
+
+void SessionRecorder::recordFrameBegin(float deltaTime, int displayWidth, int displayHeight) {
+    SessionWriter out(buffer_);
+    out.u8(static_cast<uint8_t>(SessionRecordType::FrameBegin));
+    out.f32(deltaTime);
+
+    // The display size only goes into the log when it changes
+    bool resized = displayWidth != displayWidth_ || displayHeight != displayHeight_;
+    out.u8(resized ? detail::kSessionFrameDisplaySize : 0);
+    if (resized) {
+        out.varint(static_cast<uint64_t>(displayWidth));
+        out.varint(static_cast<uint64_t>(displayHeight));
+        displayWidth_ = displayWidth;
+        displayHeight_ = displayHeight;
+    }
+}
+
+void SessionRecorder::recordFrameEnd() {
+    buffer_.push_back(static_cast<uint8_t>(SessionRecordType::FrameEnd));
+    frames_++;
+    flush();
+}
+
+void SessionRecorder::recordInput(const InputEvent& event) {
+    SessionWriter out(buffer_);
+    out.u8(static_cast<uint8_t>(SessionRecordType::Input));
+    out.u8(static_cast<uint8_t>(event.type));
+
+    bool flag = false;
+    switch (event.type) {
+        case InputEventType::MouseButton: flag = event.pressed; break;
+        case InputEventType::Key:         flag = event.keyPressed; break;
+        case InputEventType::Focus:       flag = event.focused; break;
+        default: break;
+    }
+    uint8_t bits = static_cast<uint8_t>((event.ctrl ? 1 : 0) | (event.shift ? 2 : 0) |
+                                        (event.alt ? 4 : 0) | (event.super ? 8 : 0));
+    if (event.time != 0.0) bits |= detail::kSessionInputHasTime;
+    if (flag) bits |= detail::kSessionInputFlag;
+    out.u8(bits);
+
+    switch (event.type) {
+        case InputEventType::MouseMove:
+            out.f32(event.mouseX);
+            out.f32(event.mouseY);
+            break;
+        case InputEventType::MouseButton:
+            out.varint(static_cast<uint64_t>(event.button));
+            break;
+        case InputEventType::MouseScroll:
+            out.f32(event.scrollX);
+            out.f32(event.scrollY);
+            break;
+        case InputEventType::Key:
+            out.svarint(event.keyCode);
+            break;
+        case InputEventType::Char:
+            out.varint(event.character);
+            break;
+        case InputEventType::Focus:
+            break;
+        case InputEventType::WindowResize:
+            out.svarint(event.windowWidth);
+            out.svarint(event.windowHeight);
+            break;
+    }
+
+    if (bits & detail::kSessionInputHasTime) {
+        out.f64(event.time);
+    }
+}
+
+void SessionRecorder::recordState(const GuiStateUpdate& update) {
+    auto it = stateTypes_.find(update.typeId());
+    if (it == stateTypes_.end()) {
+        unrecordedStates_++;
+        return;
+    }
+
+    SessionWriter out(buffer_);
+    out.u8(static_cast<uint8_t>(SessionRecordType::State));
+    out.varint(it->second.tag);
+    writePayload([&](SessionWriter& payload) { it->second.encode(update, payload); });
+}
+
+void SessionRecorder::recordMessage(int target, const std::function<void(SessionWriter&)>& writePayload) {
+    SessionWriter out(buffer_);
+    out.u8(static_cast<uint8_t>(SessionRecordType::Message));
+    out.svarint(target);
+    this->writePayload(writePayload);
+}
+
+void SessionRecorder::writePayload(const std::function<void(SessionWriter&)>& write) {
+    // Encoded aside first: the length prefix comes before the payload
+    payload_.clear();
+    SessionWriter payload(payload_);
+    write(payload);
+
+    SessionWriter out(buffer_);
+    out.varint(payload_.size());
+    out.bytes(payload_.data(), payload_.size());
+}
+
+void SessionRecorder::flush() {
+    if (buffer_.empty() || !out_) {
+        return;
+    }
+    out_->write(reinterpret_cast<const char*>(buffer_.data()),
+                static_cast<std::streamsize>(buffer_.size()));
+    out_->flush();
+    bytesWritten_ += buffer_.size();
+    buffer_.clear();
+}
+
+} // namespace finegui
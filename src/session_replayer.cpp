@@ -0,0 +1,202 @@
+/**
+ * @file session_replayer.cpp
+ * @brief Plays a session log back into a GuiSystem
+ */
+
+#include <finegui/session_replayer.hpp>
+
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <stdexcept>
+
+namespace finegui {
+
+namespace {
+
+constexpr size_t kHeaderSize = sizeof(kSessionMagic) + 1;
+
+} // namespace
+
+SessionReplayer::SessionReplayer(std::istream& in) {
+    load(in);
+}
+
+SessionReplayer::SessionReplayer(const std::string& path) {
+    std::ifstream file(path, std::ios::binary);
+    if (!file) {
+        throw std::runtime_error("SessionReplayer: cannot open " + path);
+    }
+    load(file);
+}
+
+void SessionReplayer::load(std::istream& in) {
+    data_.assign(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+
+    if (data_.size() < kHeaderSize ||
+        std::memcmp(data_.data(), kSessionMagic, sizeof(kSessionMagic)) != 0) {
+        throw std::runtime_error("SessionReplayer: not a session log");
+    }
+    if (data_[sizeof(kSessionMagic)] != kSessionVersion) {
+        throw std::runtime_error("SessionReplayer: unsupported session log version " +
+                                 std::to_string(data_[sizeof(kSessionMagic)]));
+    }
+
+    start_ = kHeaderSize;
+    pos_ = start_;
+}
+
+void SessionReplayer::rewind() {
+    pos_ = start_;
+    frames_ = 0;
+}
+
+SessionRecordType SessionReplayer::dispatch(GuiSystem& gui, SessionReader& in, float& deltaTime) {
+    auto type = static_cast<SessionRecordType>(in.u8());
+
+    switch (type) {
+        case SessionRecordType::FrameBegin: {
+            deltaTime = in.f32();
+            uint8_t flags = in.u8();
+            if (flags & detail::kSessionFrameDisplaySize) {
+                InputEvent resize{};
+                resize.type = InputEventType::WindowResize;
+                resize.windowWidth = static_cast<int>(in.varint());
+                resize.windowHeight = static_cast<int>(in.varint());
+                gui.processInput(resize);
+            }
+            break;
+        }
+
+        case SessionRecordType::FrameEnd:
+            break;
+
+        case SessionRecordType::Input: {
+            InputEvent event{};
+            event.type = static_cast<InputEventType>(in.u8());
+            uint8_t bits = in.u8();
+            event.ctrl = (bits & 1) != 0;
+            event.shift = (bits & 2) != 0;
+            event.alt = (bits & 4) != 0;
+            event.super = (bits & 8) != 0;
+            bool flag = (bits & detail::kSessionInputFlag) != 0;
+
+            switch (event.type) {
+                case InputEventType::MouseMove:
+                    event.mouseX = in.f32();
+                    event.mouseY = in.f32();
+                    break;
+                case InputEventType::MouseButton:
+                    event.button = static_cast<int>(in.varint());
+                    event.pressed = flag;
+                    break;
+                case InputEventType::MouseScroll:
+                    event.scrollX = in.f32();
+                    event.scrollY = in.f32();
+                    break;
+                case InputEventType::Key:
+                    event.keyCode = static_cast<int>(in.svarint());
+                    event.keyPressed = flag;
+                    break;
+                case InputEventType::Char:
+                    event.character = static_cast<uint32_t>(in.varint());
+                    break;
+                case InputEventType::Focus:
+                    event.focused = flag;
+                    break;
+                case InputEventType::WindowResize:
+                    event.windowWidth = static_cast<int>(in.svarint());
+                    event.windowHeight = static_cast<int>(in.svarint());
+                    break;
+                default:
+                    throw std::runtime_error("SessionReplayer: unknown input event type");
+            }
+
+            if (bits & detail::kSessionInputHasTime) {
+                event.time = in.f64();
+            }
+            gui.processInput(event);
+            break;
+        }
+
+        case SessionRecordType::State: {
+            auto tag = static_cast<uint32_t>(in.varint());
+            auto size = static_cast<size_t>(in.varint());
+            SessionReader payload(in.bytes(size), size);
+            auto it = stateTypes_.find(tag);
+            if (it != stateTypes_.end()) {
+                it->second(gui, payload);
+            } else {
+                skippedRecords_++;
+            }
+            break;
+        }
+
+        case SessionRecordType::Message: {
+            int target = static_cast<int>(in.svarint());
+            auto size = static_cast<size_t>(in.varint());
+            SessionReader payload(in.bytes(size), size);
+            if (messageHandler_) {
+                messageHandler_(target, payload);
+            } else {
+                skippedRecords_++;
+            }
+            break;
+        }
+
+        default:
+            throw std::runtime_error("SessionReplayer: unknown record type " +
+                                     std::to_string(static_cast<int>(type)));
+    }
+
+    return type;
+}
+
+bool SessionReplayer::replayFrame(GuiSystem& gui, const FrameCallback& buildFrame) {
+    SessionReader in(data_.data() + pos_, data_.size() - pos_);
+    float deltaTime = 0.0f;
+
+    // Records that came in between frames, then the frame's FrameBegin
+    bool begun = false;
+    while (!in.atEnd() && !begun) {
+        begun = dispatch(gui, in, deltaTime) == SessionRecordType::FrameBegin;
+    }
+    if (!begun) {
+        pos_ = data_.size();
+        return false;
+    }
+
+    gui.beginFrame(deltaTime);
+
+    // Records logged during the frame (script messages delivered by the
+    // frame's own code, say) go in ahead of the frame callback. A log cut
+    // off mid-frame ends the frame at the next FrameBegin.
+    while (!in.atEnd()) {
+        size_t next = data_.size() - in.remaining();
+        if (static_cast<SessionRecordType>(data_[next]) == SessionRecordType::FrameBegin) {
+            break;
+        }
+        if (dispatch(gui, in, deltaTime) == SessionRecordType::FrameEnd) {
+            break;
+        }
+    }
+
+    if (buildFrame) {
+        buildFrame(deltaTime);
+    }
+    gui.endFrame();
+
+    pos_ = data_.size() - in.remaining();
+    frames_++;
+    return true;
+}
+
+uint64_t SessionReplayer::replayAll(GuiSystem& gui, const FrameCallback& buildFrame) {
+    uint64_t replayed = 0;
+    while (replayFrame(gui, buildFrame)) {
+        replayed++;
+    }
+    return replayed;
+}
+
+} // namespace finegui
@@ -0,0 +1,26 @@
+#version 450
+
+/**
+ * ImGui fragment shader for finegui (bindless mode)
+ *
+ * Samples one texture from a descriptor array, selected by push constant,
+ * and multiplies by vertex color.
+ */
+
+// Must match BindlessTextureTable::kCapacity
+#define MAX_TEXTURES 4096
+
+layout(set = 0, binding = 0) uniform sampler2D textures[MAX_TEXTURES];
+
+layout(push_constant) uniform PushConstants {
+    layout(offset = 16) uint textureIndex;  // Follows the vertex stage's scale/translate
+} pc;
+
+layout(location = 0) in vec2 inUV;
+layout(location = 1) in vec4 inColor;
+
+layout(location = 0) out vec4 outColor;
+
+void main() {
+    outColor = inColor * texture(textures[pc.textureIndex], inUV);
+}
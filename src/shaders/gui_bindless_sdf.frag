@@ -0,0 +1,32 @@
+#version 450
+
+/**
+ * ImGui fragment shader for finegui (bindless mode, SDF fonts)
+ *
+ * gui_bindless.frag with the distance-field threshold of gui_sdf.frag for
+ * font atlas draws.
+ */
+
+// Must match BindlessTextureTable::kCapacity
+#define MAX_TEXTURES 4096
+
+layout(set = 0, binding = 0) uniform sampler2D textures[MAX_TEXTURES];
+
+layout(push_constant) uniform PushConstants {
+    layout(offset = 16) uint textureIndex;  // Follows the vertex stage's scale/translate
+    uint sdf;                               // Non-zero when sampling the font atlas
+} pc;
+
+layout(location = 0) in vec2 inUV;
+layout(location = 1) in vec4 inColor;
+
+layout(location = 0) out vec4 outColor;
+
+void main() {
+    vec4 texel = texture(textures[pc.textureIndex], inUV);
+    if (pc.sdf != 0u) {
+        float halfWidth = max(0.5 * fwidth(texel.a), 1e-4);
+        texel.a = smoothstep(0.5 - halfWidth, 0.5 + halfWidth, texel.a);
+    }
+    outColor = inColor * texel;
+}
@@ -0,0 +1,28 @@
+#version 450
+
+/**
+ * ImGui vertex shader for finegui, compact vertex variant
+ *
+ * Positions arrive as 16-bit fixed point (1/4 pixel steps) relative to the
+ * display origin; UVs as unorm16. See include/finegui/compact_vertex.hpp.
+ */
+
+layout(push_constant) uniform PushConstants {
+    vec2 scale;      // 2.0 / displaySize
+    vec2 translate;  // -1.0
+} pc;
+
+layout(location = 0) in ivec2 inPos;   // R16G16_SINT
+layout(location = 1) in vec2 inUV;     // R16G16_UNORM unpacked by Vulkan
+layout(location = 2) in vec4 inColor;  // R8G8B8A8_UNORM unpacked by Vulkan
+
+layout(location = 0) out vec2 outUV;
+layout(location = 1) out vec4 outColor;
+
+const float POSITION_SCALE = 0.25;  // 1 / kCompactPositionScale
+
+void main() {
+    outUV = inUV;
+    outColor = inColor;
+    gl_Position = vec4(vec2(inPos) * POSITION_SCALE * pc.scale + pc.translate, 0.0, 1.0);
+}
@@ -0,0 +1,31 @@
+#version 450
+
+/**
+ * ImGui fragment shader for finegui (SDF fonts)
+ *
+ * Like gui.frag, but the font atlas holds distance fields in its alpha
+ * channel (see sdf_font.hpp). For atlas draws, the alpha is thresholded at
+ * the glyph edge with a one-pixel screen-space ramp, so text stays sharp at
+ * any scale. Solid atlas pixels (0 or 1) are unaffected.
+ */
+
+layout(set = 0, binding = 0) uniform sampler2D texSampler;
+
+layout(push_constant) uniform PushConstants {
+    layout(offset = 16) uint textureIndex;  // Unused without bindless textures
+    uint sdf;                               // Non-zero when sampling the font atlas
+} pc;
+
+layout(location = 0) in vec2 inUV;
+layout(location = 1) in vec4 inColor;
+
+layout(location = 0) out vec4 outColor;
+
+void main() {
+    vec4 texel = texture(texSampler, inUV);
+    if (pc.sdf != 0u) {
+        float halfWidth = max(0.5 * fwidth(texel.a), 1e-4);
+        texel.a = smoothstep(0.5 - halfWidth, 0.5 + halfWidth, texel.a);
+    }
+    outColor = inColor * texel;
+}
@@ -6,16 +6,38 @@
  * - GLFW to ImGui key code conversion
  * - InputEvent creation and conversion
  * - GuiSystem construction (without rendering)
+ * - Compact vertex encoding
+ * - SDF glyph encoding and single-size SDF font baking
+ * - Headless GuiSystem (null backend)
+ * - Glyph prewarming
+ * - Batched input coalescing and modifier de-duplication
+ * - Session recording and frame-exact replay
+ * - Triple-buffered draw data channel
+ * - Draw data capture (capacity reuse, throughput benchmark)
+ * - Lock-free input queue (multi-producer ordering, overflow)
+ * - GUI thread (threaded input, frames and draw data publishing)
  */
 
 #include <finegui/finegui.hpp>
 
 #include <finevk/finevk.hpp>
 
+#include <imgui_internal.h>
+
 #include <GLFW/glfw3.h>
 
 #include <iostream>
 #include <cassert>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstring>
+#include <limits>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
 
 using namespace finegui;
 
@@ -165,6 +187,825 @@ void test_draw_data() {
     std::cout << "PASSED\n";
 }
 
+// ============================================================================
+// Compact Vertex Tests
+// ============================================================================
+
+void test_compact_vertices() {
+    std::cout << "Testing: Compact vertex encoding... ";
+
+    // Typical GUI vertices: half-pixel AA fringes, fractional glyph
+    // positions, atlas UVs, and the extremes of the position range
+    ImVec2 origin(100.0f, -50.0f);
+    ImDrawVert src[5];
+    src[0].pos = ImVec2(100.5f, -49.5f);   src[0].uv = ImVec2(0.0f, 0.0f);        src[0].col = 0xFF336699;
+    src[1].pos = ImVec2(1337.3f, 712.9f);  src[1].uv = ImVec2(0.5f / 2048, 1.0f);  src[1].col = 0x80FFFFFF;
+    src[2].pos = ImVec2(3940.0f, 2110.0f); src[2].uv = ImVec2(1.0f, 0.123456f);    src[2].col = 0x00000000;
+    src[3].pos = ImVec2(100.0f + 8191.75f, -50.0f - 8192.0f);
+    src[3].uv = ImVec2(0.999f, 0.001f);    src[3].col = 0x12345678;
+    src[4].pos = ImVec2(-20.125f, 0.0f);   src[4].uv = ImVec2(0.25f, 0.75f);       src[4].col = 0xFFFFFFFF;
+
+    assert(fitsCompactVertices(src, 5, origin));
+
+    CompactDrawVert packed[5];
+    packCompactVertices(src, 5, origin, packed);
+
+    // Decoded vertices match the standard path to within the quantization step
+    for (int i = 0; i < 5; i++) {
+        ImDrawVert v = unpackCompactVertex(packed[i], origin);
+        assert(std::fabs(v.pos.x - src[i].pos.x) <= 0.5f / kCompactPositionScale);
+        assert(std::fabs(v.pos.y - src[i].pos.y) <= 0.5f / kCompactPositionScale);
+        assert(std::fabs(v.uv.x - src[i].uv.x) <= 0.5f / 65535.0f + 1e-7f);
+        assert(std::fabs(v.uv.y - src[i].uv.y) <= 0.5f / 65535.0f + 1e-7f);
+        assert(v.col == src[i].col);
+    }
+
+    // Quarter-pixel positions round-trip exactly
+    assert(unpackCompactVertex(packed[0], origin).pos.x == 100.5f);
+    assert(unpackCompactVertex(packed[3], origin).pos.y == -50.0f - 8192.0f);
+
+    // Anything the encoding would clamp is rejected
+    ImDrawVert far = src[0];
+    far.pos.x = origin.x + 8192.0f;
+    assert(!fitsCompactVertices(&far, 1, origin));
+
+    ImDrawVert tiled = src[0];
+    tiled.uv.y = 2.0f;
+    assert(!fitsCompactVertices(&tiled, 1, origin));
+
+    ImDrawVert nan = src[0];
+    nan.pos.y = std::numeric_limits<float>::quiet_NaN();
+    assert(!fitsCompactVertices(&nan, 1, origin));
+
+    std::cout << "PASSED\n";
+}
+
+void test_sdf_distance_field() {
+    std::cout << "Testing: SDF glyph encoding... ";
+
+    // Antialiased disk of radius 8 in a 24x24 coverage bitmap
+    const int size = 24;
+    const float center = 12.0f, radius = 8.0f;
+    uint8_t pixels[size * size];
+    for (int y = 0; y < size; y++) {
+        for (int x = 0; x < size; x++) {
+            float d = std::hypot(x + 0.5f - center, y + 0.5f - center);
+            float coverage = std::clamp(radius - d + 0.5f, 0.0f, 1.0f);
+            pixels[y * size + x] = static_cast<uint8_t>(coverage * 255.0f + 0.5f);
+        }
+    }
+
+    coverageToDistanceField(pixels, size, size, size, 1);
+
+    // Inside above the edge value, outside below, saturating past the spread
+    assert(pixels[12 * size + 12] == 255);
+    assert(pixels[0] == 0);
+    for (int y = 0; y < size; y++) {
+        for (int x = 0; x < size; x++) {
+            float d = std::hypot(x + 0.5f - center, y + 0.5f - center);
+            float expected = 0.5f + (radius - d) / (2.0f * kSdfSpread);
+            float actual = pixels[y * size + x] / 255.0f;
+            if (expected > 0.0f && expected < 1.0f) {
+                assert(std::fabs(actual - std::clamp(expected, 0.0f, 1.0f)) < 0.1f);
+            }
+        }
+    }
+
+    // Strided (RGBA alpha) regions only touch the given channel
+    uint8_t rgba[4 * 4 * 4];
+    for (int i = 0; i < 16; i++) {
+        rgba[i * 4 + 0] = rgba[i * 4 + 1] = rgba[i * 4 + 2] = 255;
+        rgba[i * 4 + 3] = (i % 4) < 2 ? 255 : 0;
+    }
+    coverageToDistanceField(rgba + 3, 4, 4, 16, 4);
+    for (int i = 0; i < 16; i++) {
+        assert(rgba[i * 4 + 0] == 255 && rgba[i * 4 + 1] == 255 && rgba[i * 4 + 2] == 255);
+    }
+    assert(rgba[3] > 128 && rgba[4 * 4 - 1] < 128);
+
+    std::cout << "PASSED\n";
+}
+
+void test_sdf_font_single_bake() {
+    std::cout << "Testing: SDF font single bake... ";
+
+    GuiConfig config;
+    config.sdfFonts = true;
+    config.sdfBakeSize = 40.0f;
+    GuiSystem gui(config);
+    gui.initializeHeadless(640, 480);
+
+    // Text at several sizes is drawn from the one bake
+    for (int frame = 0; frame < 2; frame++) {
+        gui.beginFrame(1.0f / 60.0f);
+        ImGui::Begin("SDF");
+        ImGui::Text("Default size");
+        ImGui::PushFont(nullptr, 72.0f);
+        ImGui::Text("Large");
+        ImGui::PopFont();
+        ImGui::SetWindowFontScale(0.5f);
+        ImGui::Text("Small");
+        ImGui::End();
+
+        ImFont* font = ImGui::GetFont();
+        assert(font->GetFontBaked(13.0f)->Size == 40.0f);
+        assert(font->GetFontBaked(72.0f)->Size == 40.0f);
+        gui.endFrame();
+    }
+
+    assert(gui.headlessStats().textureUploadBytes > 0);
+
+    // Glyph rects are padded by the spread, so the field falls off to
+    // (nearly) zero before the rect edge instead of being cut off there
+    ImFontAtlas* atlas = ImGui::GetIO().Fonts;
+    ImFontBaked* baked = atlas->Fonts[0]->GetFontBaked(40.0f);
+    for (ImWchar c : {ImWchar('L'), ImWchar('a'), ImWchar('g')}) {
+        ImFontGlyph* glyph = baked->FindGlyph(c);
+        assert(glyph != nullptr && glyph->Visible && glyph->PackId >= 0);
+        ImTextureRect* rect = ImFontAtlasPackGetRect(atlas, glyph->PackId);
+        assert(rect->w > 2 * kSdfSpread && rect->h > 2 * kSdfSpread);
+
+        ImTextureData* tex = atlas->TexData;
+        int alphaOffset = tex->Format == ImTextureFormat_RGBA32 ? 3 : 0;
+        auto value = [&](int x, int y) {
+            return static_cast<const uint8_t*>(tex->GetPixelsAt(rect->x + x, rect->y + y))[alphaOffset];
+        };
+        for (int x = 0; x < rect->w; x++) {
+            assert(value(x, 0) < 32 && value(x, rect->h - 1) < 32);
+        }
+        for (int y = 0; y < rect->h; y++) {
+            assert(value(0, y) < 32 && value(rect->w - 1, y) < 32);
+        }
+    }
+
+    std::cout << "PASSED\n";
+}
+
+// ============================================================================
+// Headless Tests
+// ============================================================================
+
+void test_headless_gui_system() {
+    std::cout << "Testing: Headless GuiSystem... ";
+
+    GuiConfig config;
+    config.enableDrawDataCapture = true;
+    GuiSystem gui(config);
+    assert(!gui.isHeadless());
+    assert(gui.device() == nullptr);
+
+    gui.initializeHeadless(640, 480);
+    assert(gui.isHeadless());
+    assert(!gui.isInitialized());
+
+    for (int frame = 0; frame < 3; frame++) {
+        gui.beginFrame(1.0f / 60.0f);
+        ImGui::Begin("Headless");
+        ImGui::Text("Frame %d", frame);
+        ImGui::Button("Button");
+        ImGui::End();
+        gui.endFrame();
+    }
+
+    HeadlessStats stats = gui.headlessStats();
+    assert(stats.frames == 3);
+    assert(stats.vertices > 0 && stats.indices > 0 && stats.drawCalls > 0);
+    assert(stats.totalVertices >= 3ull * stats.vertices);
+    assert(stats.vertexBytes == stats.totalVertices * sizeof(ImDrawVert));
+    assert(stats.indexBytes == stats.totalIndices * sizeof(ImDrawIdx));
+
+    // The font atlas went through the texture lifecycle
+    assert(stats.textureCreates >= 1);
+    assert(stats.texturesLive >= 1);
+    assert(stats.textureUploadBytes > 0);
+
+    // Draw commands reference the (fake) atlas texture, as after a real render
+    const GuiDrawData& data = gui.getDrawData();
+    assert(!data.empty());
+    assert(data.vertices.size() == stats.vertices);
+    assert(data.indices.size() == stats.indices);
+    assert(data.displaySize.x == 640.0f && data.displaySize.y == 480.0f);
+    for (const auto& cmd : data.commands) {
+        assert(cmd.texture.id != 0);
+    }
+
+    // Font rebuilds work headless; rendering and textures still need a device
+    gui.rebuildFontAtlas();
+    assert(gui.renderStats().drawCalls == 0);
+
+    bool threw = false;
+    try {
+        gui.registerTexture(static_cast<finevk::Texture*>(nullptr));
+    } catch (const std::runtime_error&) {
+        threw = true;
+    }
+    assert(threw);
+
+    std::cout << "PASSED\n";
+}
+
+void test_glyph_prewarming() {
+    std::cout << "Testing: Glyph prewarming... ";
+
+    GuiConfig config;
+    config.prewarmText = "Prewarm";
+    config.prewarmRanges = {{'0', '9'}};
+    GuiSystem gui(config);
+    gui.initializeHeadless(640, 480);
+
+    GlyphPrewarmStats stats = gui.glyphPrewarmStats();
+    assert(stats.pending == 7 + 10);
+    assert(stats.prewarmed == 0);
+
+    // Budgeted: a few at a time, then the rest ('r' repeats and is skipped)
+    assert(gui.prewarmGlyphs(3) == 3);
+    assert(gui.glyphPrewarmStats().pending > 0);
+    gui.prewarmGlyphs();
+    stats = gui.glyphPrewarmStats();
+    assert(stats.pending == 0);
+    assert(stats.prewarmed == 6 + 10);
+
+    // A frame showing only prewarmed glyphs rasterizes nothing new
+    ImGuiWindowFlags flags = ImGuiWindowFlags_NoDecoration | ImGuiWindowFlags_NoSavedSettings;
+    gui.beginFrame(1.0f / 60.0f);
+    ImGui::Begin("##prewarm", nullptr, flags);
+    ImGui::Text("Prewarm2048");
+    ImGui::End();
+    gui.endFrame();
+    assert(gui.glyphPrewarmStats().missed == 0);
+
+    // New glyphs are counted as misses
+    gui.beginFrame(1.0f / 60.0f);
+    ImGui::Begin("##prewarm", nullptr, flags);
+    ImGui::Text("xyz");
+    ImGui::End();
+    gui.endFrame();
+    assert(gui.glyphPrewarmStats().missed == 3);
+
+    // Prewarming in endFrame() with a per-frame budget
+    config.prewarmGlyphsPerFrame = 4;
+    GuiSystem idle(config);
+    idle.initializeHeadless(640, 480);
+    idle.beginFrame(1.0f / 60.0f);
+    idle.endFrame();
+    assert(idle.glyphPrewarmStats().prewarmed == 4);
+
+    std::cout << "PASSED\n";
+}
+
+void test_input_coalescing() {
+    std::cout << "Testing: Input coalescing... ";
+
+    GuiConfig config;
+    GuiSystem gui(config);
+    gui.initializeHeadless(640, 480);
+
+    auto move = [](float x, float y, bool ctrl = false) {
+        InputEvent e{};
+        e.type = InputEventType::MouseMove;
+        e.mouseX = x;
+        e.mouseY = y;
+        e.ctrl = ctrl;
+        return e;
+    };
+    auto button = [](bool pressed, bool ctrl) {
+        InputEvent e{};
+        e.type = InputEventType::MouseButton;
+        e.pressed = pressed;
+        e.ctrl = ctrl;
+        return e;
+    };
+    auto scroll = [](float y, bool ctrl = false) {
+        InputEvent e{};
+        e.type = InputEventType::MouseScroll;
+        e.scrollY = y;
+        e.ctrl = ctrl;
+        return e;
+    };
+
+    // A ctrl-drag at a high polling rate
+    std::vector<InputEvent> events;
+    for (int i = 0; i < 500; i++) events.push_back(move(static_cast<float>(i), 10.0f));
+    events.push_back(button(true, false));
+    for (int i = 0; i < 300; i++) events.push_back(move(static_cast<float>(i), 20.0f, true));
+    events.push_back(button(false, true));
+    for (int i = 0; i < 10; i++) events.push_back(scroll(1.0f, true));
+
+    // 4 initial modifiers, move, press, ctrl, move, release, summed scroll
+    InputStats batch = gui.processInputBatch(events);
+    assert(batch.ingested == 812);
+    assert(batch.emitted == 10);
+    assert(batch.coalesced == 499 + 299 + 9);
+    for (int frame = 0; frame < 8; frame++) {
+        gui.beginFrame(1.0f / 60.0f);
+        gui.endFrame();
+    }
+
+    // The last position survives coalescing (ctrl release, then the move)
+    events.clear();
+    for (int i = 0; i < 100; i++) events.push_back(move(static_cast<float>(i), 2.0f * i));
+    batch = gui.processInputBatch(events);
+    assert(batch.emitted == 2);
+    for (int frame = 0; frame < 2; frame++) {
+        gui.beginFrame(1.0f / 60.0f);
+        gui.endFrame();
+    }
+    assert(ImGui::GetIO().MousePos.x == 99.0f && ImGui::GetIO().MousePos.y == 198.0f);
+    assert(!ImGui::GetIO().KeyCtrl);
+
+    // Scroll deltas add up
+    events.clear();
+    for (int i = 0; i < 10; i++) events.push_back(scroll(0.5f));
+    batch = gui.processInputBatch(events);
+    assert(batch.emitted == 1);
+    gui.beginFrame(1.0f / 60.0f);
+    assert(ImGui::GetIO().MouseWheel == 5.0f);
+    gui.endFrame();
+
+    // Single events skip unchanged modifiers too
+    InputStats before = gui.inputStats();
+    gui.processInput(move(1.0f, 1.0f));
+    gui.processInput(move(2.0f, 2.0f));
+    InputStats after = gui.inputStats();
+    assert(after.ingested == before.ingested + 2);
+    assert(after.emitted == before.emitted + 2);
+    assert(after.ingested == 812 + 100 + 10 + 2);
+
+    std::cout << "PASSED\n";
+}
+
+namespace {
+
+struct SessionHealthUpdate : TypedStateUpdate<SessionHealthUpdate> {
+    float current = 0.0f;
+};
+
+// Hash of everything ImGui drew in the current context's last frame
+uint64_t drawDataHash() {
+    const ImDrawData* drawData = ImGui::GetDrawData();
+    uint64_t hash = 1469598103934665603ull;
+    auto mix = [&hash](const void* data, size_t size) {
+        const auto* bytes = static_cast<const uint8_t*>(data);
+        for (size_t i = 0; i < size; i++) {
+            hash = (hash ^ bytes[i]) * 1099511628211ull;
+        }
+    };
+    for (int n = 0; n < drawData->CmdListsCount; n++) {
+        const ImDrawList* list = drawData->CmdLists[n];
+        mix(list->VtxBuffer.Data, static_cast<size_t>(list->VtxBuffer.Size) * sizeof(ImDrawVert));
+        mix(list->IdxBuffer.Data, static_cast<size_t>(list->IdxBuffer.Size) * sizeof(ImDrawIdx));
+    }
+    mix(&drawData->DisplaySize, sizeof(drawData->DisplaySize));
+    return hash;
+}
+
+} // namespace
+
+void test_session_record_replay() {
+    std::cout << "Testing: Session record and replay... ";
+
+    // The GUI under test: shows the last health update, counts clicks
+    struct Session {
+        float health = 100.0f;
+        int clicks = 0;
+        ImVec2 buttonCenter{};
+
+        void build() {
+            ImGui::SetNextWindowPos(ImVec2(0.0f, 0.0f));
+            ImGui::Begin("Session", nullptr, ImGuiWindowFlags_NoSavedSettings);
+            ImGui::Text("Health %.1f", health);
+            if (ImGui::Button("Click")) {
+                clicks++;
+            }
+            ImVec2 min = ImGui::GetItemRectMin();
+            ImVec2 max = ImGui::GetItemRectMax();
+            buttonCenter = ImVec2((min.x + max.x) * 0.5f, (min.y + max.y) * 0.5f);
+            ImGui::End();
+        }
+    };
+
+    constexpr int kFrames = 12;
+    std::stringstream log;
+    std::vector<uint64_t> recordedHashes;
+    Session recorded;
+    uint64_t logBytes = 0;
+    {
+        GuiConfig config;
+        GuiSystem gui(config);
+        gui.initializeHeadless(640, 480);
+        gui.onStateUpdate<SessionHealthUpdate>([&](const SessionHealthUpdate& u) {
+            recorded.health = u.current;
+        });
+
+        SessionRecorder recorder(log);
+        recorder.addStateType<SessionHealthUpdate>(1, [](const SessionHealthUpdate& u, SessionWriter& out) {
+            out.f32(u.current);
+        });
+        gui.setSessionRecorder(&recorder);
+
+        for (int frame = 0; frame < kFrames; frame++) {
+            InputEvent event{};
+            if (frame == 1 || frame == 2) {
+                // Many moves onto the button, coalesced by the batch path
+                std::vector<InputEvent> moves;
+                for (int i = 0; i < 50; i++) {
+                    event.type = InputEventType::MouseMove;
+                    event.mouseX = recorded.buttonCenter.x - 49.0f + i;
+                    event.mouseY = recorded.buttonCenter.y;
+                    event.time = frame + i * 0.001;
+                    moves.push_back(event);
+                }
+                gui.processInputBatch(moves);
+            }
+            if (frame == 3 || frame == 4) {
+                event.type = InputEventType::MouseButton;
+                event.button = 0;
+                event.pressed = frame == 3;
+                gui.processInput(event);
+            }
+            if (frame == 2 || frame == 7) {
+                SessionHealthUpdate update;
+                update.current = 42.5f + frame;
+                gui.applyState(update);
+            }
+            if (frame == 9) {
+                event.type = InputEventType::WindowResize;
+                event.windowWidth = 800;
+                event.windowHeight = 600;
+                gui.processInput(event);
+            }
+
+            gui.beginFrame(1.0f / 60.0f + frame * 0.001f);
+            recorded.build();
+            gui.endFrame();
+            recordedHashes.push_back(drawDataHash());
+        }
+
+        gui.setSessionRecorder(nullptr);
+        assert(recorder.frames() == kFrames);
+        assert(recorder.unrecordedStates() == 0);
+        logBytes = recorder.bytesWritten();
+    }
+    assert(recorded.clicks == 1);
+    assert(recorded.health == 49.5f);
+
+    // A fresh GUI replays to the same draw data, frame for frame
+    GuiConfig config;
+    GuiSystem gui(config);
+    gui.initializeHeadless(640, 480);
+    Session replayed;
+    gui.onStateUpdate<SessionHealthUpdate>([&](const SessionHealthUpdate& u) {
+        replayed.health = u.current;
+    });
+
+    SessionReplayer replayer(log);
+    replayer.addStateType<SessionHealthUpdate>(1, [](SessionReader& in) {
+        SessionHealthUpdate update;
+        update.current = in.f32();
+        return update;
+    });
+
+    std::vector<uint64_t> replayedHashes;
+    while (replayer.replayFrame(gui, [&](float) { replayed.build(); })) {
+        replayedHashes.push_back(drawDataHash());
+    }
+    assert(replayer.finished());
+    assert(replayer.frames() == kFrames);
+    assert(replayer.skippedRecords() == 0);
+    assert(replayedHashes == recordedHashes);
+    assert(replayed.clicks == recorded.clicks);
+    assert(replayed.health == recorded.health);
+    assert(ImGui::GetIO().DisplaySize.x == 800.0f);
+
+    // Not a session log
+    std::stringstream junk("not a session");
+    bool threw = false;
+    try {
+        SessionReplayer bad(junk);
+    } catch (const std::runtime_error&) {
+        threw = true;
+    }
+    assert(threw);
+
+    std::cout << "(" << logBytes << " bytes) PASSED\n";
+}
+
+// ============================================================================
+// Threaded Mode Tests
+// ============================================================================
+
+void test_draw_data_channel() {
+    std::cout << "Testing: Draw data channel... ";
+
+    DrawDataChannel channel;
+
+    // Nothing published yet: an empty frame
+    bool isNew = true;
+    assert(channel.acquire(&isNew).empty());
+    assert(!isNew);
+
+    auto publishFrame = [&](uint32_t frame) {
+        GuiDrawData& data = channel.writeBuffer();
+        data.clear();
+        data.commands.push_back(DrawCommand{0, frame, 0, {}, glm::ivec4(0)});
+        channel.publish();
+    };
+
+    publishFrame(1);
+    assert(channel.acquire(&isNew).commands[0].indexCount == 1);
+    assert(isNew);
+
+    // Same frame again until something new is published
+    assert(channel.acquire(&isNew).commands[0].indexCount == 1);
+    assert(!isNew);
+
+    // The reader only sees the newest of several frames
+    publishFrame(2);
+    publishFrame(3);
+    assert(channel.acquire(&isNew).commands[0].indexCount == 3);
+    assert(channel.published() == 3);
+    assert(channel.overwritten() == 1);
+
+    // Writer and reader on separate threads: every acquired frame must be
+    // complete (all vertices carry the frame's number) and never go back
+    constexpr uint32_t kFrames = 20000;
+    DrawDataChannel threaded;
+    std::thread writer([&]() {
+        for (uint32_t frame = 1; frame <= kFrames; frame++) {
+            GuiDrawData& data = threaded.writeBuffer();
+            data.clear();
+            ImDrawVert vertex{};
+            vertex.col = frame;
+            data.vertices.assign(64 + frame % 64, vertex);
+            data.commands.push_back(DrawCommand{0, frame, 0, {}, glm::ivec4(0)});
+            threaded.publish();
+        }
+    });
+
+    uint32_t last = 0;
+    while (last < kFrames) {
+        const GuiDrawData& data = threaded.acquire();
+        if (data.empty()) {
+            continue;
+        }
+        uint32_t frame = data.commands[0].indexCount;
+        assert(frame >= last);
+        assert(data.vertices.size() == 64 + frame % 64);
+        for (const ImDrawVert& vertex : data.vertices) {
+            assert(vertex.col == frame);
+        }
+        last = frame;
+    }
+    writer.join();
+    assert(threaded.published() == kFrames);
+
+    std::cout << "PASSED\n";
+}
+
+void test_draw_data_capture() {
+    std::cout << "Testing: Draw data capture... ";
+
+    GuiConfig config;
+    config.enableDrawDataCapture = true;
+    GuiSystem gui(config);
+    gui.initializeHeadless(1920, 1080);
+
+    // A heavy frame: several windows full of text and widgets
+    gui.beginFrame(1.0f / 60.0f);
+    for (int w = 0; w < 4; w++) {
+        ImGui::SetNextWindowPos(ImVec2(w * 480.0f, 0.0f));
+        ImGui::SetNextWindowSize(ImVec2(470.0f, 1070.0f));
+        ImGui::Begin(("Capture " + std::to_string(w)).c_str(), nullptr,
+                     ImGuiWindowFlags_NoSavedSettings);
+        for (int i = 0; i < 60; i++) {
+            ImGui::Text("Row %d of window %d with a fair amount of text", i, w);
+            ImGui::Button(("Button##" + std::to_string(i)).c_str());
+        }
+        ImGui::End();
+    }
+    gui.endFrame();
+
+    const ImDrawData* drawData = ImGui::GetDrawData();
+    assert(drawData && drawData->TotalVtxCount > 0);
+
+    // Matches what endFrame() published
+    GuiDrawData captured;
+    captureDrawData(drawData, captured);
+    const GuiDrawData& published = gui.getDrawData();
+    assert(captured.vertices.size() == static_cast<size_t>(drawData->TotalVtxCount));
+    assert(captured.indices.size() == static_cast<size_t>(drawData->TotalIdxCount));
+    assert(captured.commands.size() == published.commands.size());
+    assert(std::memcmp(captured.vertices.data(), published.vertices.data(),
+                       captured.vertices.size() * sizeof(ImDrawVert)) == 0);
+    assert(captured.indices == published.indices);
+    for (size_t i = 0; i < captured.commands.size(); i++) {
+        assert(captured.commands[i].indexOffset == published.commands[i].indexOffset);
+        assert(captured.commands[i].vertexOffset == published.commands[i].vertexOffset);
+        assert(captured.commands[i].texture == published.commands[i].texture);
+    }
+
+    // Recapturing a frame of the same size reuses the buffers
+    const ImDrawVert* vertexStorage = captured.vertices.data();
+    const ImDrawIdx* indexStorage = captured.indices.data();
+    const DrawCommand* commandStorage = captured.commands.data();
+
+    constexpr int kIterations = 500;
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < kIterations; i++) {
+        captureDrawData(drawData, captured);
+    }
+    auto elapsed = std::chrono::steady_clock::now() - start;
+
+    assert(captured.vertices.data() == vertexStorage);
+    assert(captured.indices.data() == indexStorage);
+    assert(captured.commands.data() == commandStorage);
+
+    // A smaller frame keeps the capacity too
+    size_t vertexCapacity = captured.vertices.capacity();
+    captureDrawData(nullptr, captured);
+    assert(captured.empty());
+    captureDrawData(drawData, captured);
+    assert(captured.vertices.capacity() == vertexCapacity);
+
+    double bytes = static_cast<double>(captured.vertices.size() * sizeof(ImDrawVert) +
+                                       captured.indices.size() * sizeof(ImDrawIdx) +
+                                       captured.commands.size() * sizeof(DrawCommand));
+    double seconds = std::chrono::duration<double>(elapsed).count();
+    double mbPerSecond = seconds > 0.0 ? bytes * kIterations / seconds / (1024.0 * 1024.0) : 0.0;
+
+    std::cout << "(" << static_cast<size_t>(bytes / 1024) << " KB/frame, "
+              << static_cast<uint64_t>(mbPerSecond) << " MB/s) PASSED\n";
+}
+
+void test_input_queue() {
+    std::cout << "Testing: Input queue... ";
+
+    InputQueue queue(6);
+    assert(queue.capacity() == 8);
+
+    InputEvent event{};
+    assert(!queue.pop(event));
+
+    // Fills up, then rejects and counts
+    for (int i = 0; i < 8; i++) {
+        event.type = InputEventType::Char;
+        event.character = static_cast<uint32_t>(i);
+        assert(queue.push(event));
+    }
+    assert(!queue.push(event));
+    assert(queue.dropped() == 1);
+
+    for (uint32_t i = 0; i < 8; i++) {
+        assert(queue.pop(event));
+        assert(event.character == i);
+    }
+    assert(!queue.pop(event));
+
+    // Producers on several threads: nothing lost or duplicated, and each
+    // producer's events come out in the order it pushed them
+    constexpr int kProducers = 4;
+    constexpr uint32_t kEventsEach = 50000;
+    InputQueue threaded(256);
+    std::vector<std::thread> producers;
+    for (int p = 0; p < kProducers; p++) {
+        producers.emplace_back([&threaded, p]() {
+            InputEvent e{};
+            e.type = InputEventType::MouseButton;
+            e.button = p;
+            for (uint32_t i = 0; i < kEventsEach; i++) {
+                e.character = i;
+                while (!threaded.push(e)) {
+                    std::this_thread::yield();
+                }
+            }
+        });
+    }
+
+    uint32_t next[kProducers] = {};
+    uint64_t received = 0;
+    while (received < kProducers * static_cast<uint64_t>(kEventsEach)) {
+        InputEvent e{};
+        if (!threaded.pop(e)) {
+            std::this_thread::yield();
+            continue;
+        }
+        assert(e.button >= 0 && e.button < kProducers);
+        assert(e.character == next[e.button]);
+        next[e.button]++;
+        received++;
+    }
+    for (std::thread& producer : producers) {
+        producer.join();
+    }
+    assert(!threaded.pop(event));
+
+    std::cout << "PASSED\n";
+}
+
+void test_gui_thread() {
+    std::cout << "Testing: GUI thread... ";
+
+    // Frames must be captured, and a cached layer cannot be driven
+    for (int variant = 0; variant < 2; variant++) {
+        GuiConfig rejected;
+        rejected.enableDrawDataCapture = variant == 1;
+        rejected.cachedLayer = variant == 1;
+        GuiSystem rejectedGui(rejected);
+        rejectedGui.initializeHeadless(640, 480);
+        GuiThread rejectedThread(rejectedGui);
+        bool rejectedStart = false;
+        try {
+            rejectedThread.start();
+        } catch (const std::runtime_error&) {
+            rejectedStart = true;
+        }
+        assert(rejectedStart);
+        assert(!rejectedThread.running());
+    }
+
+    GuiConfig config;
+    config.enableDrawDataCapture = true;
+    GuiSystem gui(config);
+    gui.initializeHeadless(640, 480);
+
+    GuiThreadConfig threadConfig;
+    threadConfig.targetFrameRate = 240.0f;
+    GuiThread guiThread(gui, threadConfig);
+
+    std::atomic<uint32_t> callbackFrames{0};
+    guiThread.addFrameCallback([&](float deltaTime) {
+        assert(deltaTime >= 0.0f);
+        ImGui::Begin("Threaded");
+        ImGui::Text("Frame %u", callbackFrames.load());
+        ImGui::End();
+        callbackFrames++;
+    });
+
+    guiThread.start();
+    assert(guiThread.running());
+
+    bool threw = false;
+    try {
+        guiThread.addFrameCallback([](float) {});
+    } catch (const std::runtime_error&) {
+        threw = true;
+    }
+    assert(threw);
+
+    // Input from two threads while the GUI thread builds frames
+    constexpr int kEventsEach = 500;
+    std::vector<std::thread> producers;
+    for (int p = 0; p < 2; p++) {
+        producers.emplace_back([&guiThread, p]() {
+            for (int i = 0; i < kEventsEach; i++) {
+                InputEvent event{};
+                event.type = InputEventType::MouseMove;
+                event.mouseX = static_cast<float>(p * 100 + i % 100);
+                event.mouseY = static_cast<float>(i % 100);
+                guiThread.postInput(event);
+            }
+        });
+    }
+    for (std::thread& producer : producers) {
+        producer.join();
+    }
+
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(10);
+    while (guiThread.inputsProcessed() + guiThread.inputsDropped() < 2u * kEventsEach) {
+        assert(std::chrono::steady_clock::now() < deadline);
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+
+    // The render side picks up published frames
+    while (gui.getDrawData().empty()) {
+        assert(std::chrono::steady_clock::now() < deadline);
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+
+    guiThread.stop();
+    assert(!guiThread.running());
+    assert(guiThread.frames() > 0);
+    assert(guiThread.frames() == callbackFrames.load());
+    assert(guiThread.frameMicros() > 0.0f);
+
+    // An exception on the GUI thread stops it and comes back from stop()
+    GuiThread failing(gui, threadConfig);
+    failing.addFrameCallback([](float) { throw std::runtime_error("frame failed"); });
+    failing.start();
+    while (failing.running()) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    threw = false;
+    try {
+        failing.stop();
+    } catch (const std::runtime_error&) {
+        threw = true;
+    }
+    assert(threw);
+
+    std::cout << "PASSED\n";
+}
+
 // ============================================================================
 // Main
 // ============================================================================
@@ -185,6 +1026,17 @@ int main() {
         test_state_update_type_ids();
         test_texture_handle();
         test_draw_data();
+        test_compact_vertices();
+        test_sdf_distance_field();
+        test_sdf_font_single_bake();
+        test_headless_gui_system();
+        test_glyph_prewarming();
+        test_input_coalescing();
+        test_session_record_replay();
+        test_draw_data_channel();
+        test_draw_data_capture();
+        test_input_queue();
+        test_gui_thread();
 
         std::cout << "\n=== All Phase 1 tests PASSED ===\n";
     } catch (const std::exception& e) {
@@ -6,6 +6,19 @@
  * - GuiSystem initialization with SimpleRenderer
  * - Basic frame rendering
  * - Input processing
+ * - Render statistics (geometry ring)
+ * - Draw-call batching
+ * - Partial font atlas updates
+ * - Bindless texture mode
+ * - Texture registration sharing and descriptor pool growth
+ * - Unchanged-frame upload skipping
+ * - Cached secondary command buffers
+ * - Compact vertex format (equivalence with the standard path)
+ * - Persistent pipeline cache
+ * - GPU timestamp timings
+ * - Cached GUI layer
+ * - Layer render and composite sharing one frame's geometry ring slot
+ * - Asynchronous texture uploads
  */
 
 #include <finegui/finegui.hpp>
@@ -13,7 +26,12 @@
 #include <finevk/finevk.hpp>
 
 #include <iostream>
+#include <vector>
 #include <cassert>
+#include <cstdio>
+#include <atomic>
+#include <filesystem>
+#include <mutex>
 
 using namespace finegui;
 
@@ -478,6 +496,932 @@ void test_connect_disconnect_input_manager() {
     std::cout << "PASSED\n";
 }
 
+void test_geometry_ring_stats() {
+    std::cout << "Testing: Geometry ring growth and stats... ";
+
+    auto ctx = TestContext::create("test_geometry_ring_stats");
+
+    GuiConfig guiConfig;
+    guiConfig.msaaSamples = ctx->renderer->msaaSamples();
+    GuiSystem gui(ctx->renderer->device(), guiConfig);
+
+    // Stats are zeroed before initialize()
+    assert(gui.renderStats().streamCapacity == 0);
+
+    gui.initialize(ctx->renderer.get());
+    GuiRenderStats initial = gui.renderStats();
+    assert(initial.streamCapacity > 0);
+    assert(initial.streamReallocations == 0);
+
+    // Foreground primitives are never clipped away, so the rect count sets the
+    // geometry size directly (~92 bytes per rect). The frame counter keeps
+    // every frame's geometry distinct, so none is skipped as unchanged.
+    int frameNumber = 0;
+    auto runFrame = [&](int rects) {
+        if (auto frame = ctx->renderer->beginFrame()) {
+            gui.beginFrame();
+            ImGui::SetNextWindowSize(ImVec2(700, 500));
+            ImGui::Begin("Ring");
+            ImGui::Text("Frame %d: %d rects", frameNumber++, rects);
+            ImGui::End();
+            ImDrawList* fg = ImGui::GetForegroundDrawList();
+            for (int i = 0; i < rects; i++) {
+                float x = static_cast<float>(i % 100) * 6.0f;
+                float y = static_cast<float>(i / 100 % 80) * 6.0f;
+                fg->AddRectFilled(ImVec2(x, y), ImVec2(x + 4.0f, y + 4.0f),
+                                  IM_COL32(255, i & 0xFF, 0, 255));
+            }
+            gui.endFrame();
+
+            ctx->renderer->beginRenderPass({0.1f, 0.1f, 0.1f, 1.0f});
+            gui.render(frame);
+            ctx->renderer->endRenderPass();
+            ctx->renderer->endFrame();
+        }
+    };
+
+    // Light frames fit in the initial ring
+    for (int i = 0; i < 4; i++) runFrame(10);
+    GuiRenderStats light = gui.renderStats();
+    assert(light.streamUsed > 0);
+    assert(light.streamUsed <= light.streamCapacity);
+    assert(light.streamReallocations == 0);
+
+    // A heavy frame (~750 KB of geometry) forces the ring to grow
+    runFrame(8000);
+    GuiRenderStats heavy = gui.renderStats();
+    assert(heavy.streamReallocations > light.streamReallocations);
+    assert(heavy.streamCapacity > light.streamCapacity);
+    assert(heavy.streamCapacity >= heavy.streamUsed);
+    assert(heavy.streamHighWater >= heavy.streamUsed);
+
+    // Once the load drops, the decaying high-water mark trims the ring back
+    // down to its initial size
+    for (int i = 0; i < 2000 && gui.renderStats().streamCapacity > initial.streamCapacity; i++) {
+        runFrame(10);
+    }
+    GuiRenderStats trimmed = gui.renderStats();
+    assert(trimmed.streamCapacity == initial.streamCapacity);
+    assert(trimmed.streamReallocations > heavy.streamReallocations);
+    assert(trimmed.streamHighWater < heavy.streamHighWater);
+
+    ctx->renderer->waitIdle();
+    std::cout << "PASSED\n";
+}
+
+void test_draw_batching() {
+    std::cout << "Testing: Draw-call batching... ";
+
+    auto ctx = TestContext::create("test_draw_batching");
+
+    GuiConfig guiConfig;
+    guiConfig.msaaSamples = ctx->renderer->msaaSamples();
+    GuiSystem gui(ctx->renderer->device(), guiConfig);
+    gui.initialize(ctx->renderer.get());
+
+    // Two undecorated windows with identical rects share a clip rect and the
+    // font atlas, so the last draw of one list merges with the first of the next
+    ImGuiWindowFlags flags = ImGuiWindowFlags_NoDecoration |
+                             ImGuiWindowFlags_NoBackground |
+                             ImGuiWindowFlags_NoSavedSettings;
+
+    for (int f = 0; f < 3; f++) {
+        if (auto frame = ctx->renderer->beginFrame()) {
+            gui.beginFrame();
+            for (const char* name : {"BatchA", "BatchB"}) {
+                ImGui::SetNextWindowPos(ImVec2(20, 20));
+                ImGui::SetNextWindowSize(ImVec2(300, 200));
+                ImGui::Begin(name, nullptr, flags);
+                ImGui::Text("%s line 1", name);
+                ImGui::Text("%s line 2", name);
+                ImGui::End();
+            }
+            gui.endFrame();
+
+            ctx->renderer->beginRenderPass({0.1f, 0.1f, 0.1f, 1.0f});
+            gui.render(frame);
+            ctx->renderer->endRenderPass();
+            ctx->renderer->endFrame();
+        }
+    }
+
+    GuiRenderStats stats = gui.renderStats();
+    assert(stats.drawCommands > 0);
+    assert(stats.drawCalls > 0);
+    assert(stats.drawCalls < stats.drawCommands);
+    assert(stats.descriptorBinds <= stats.drawCalls);
+    assert(stats.scissorChanges <= stats.drawCalls);
+
+    ctx->renderer->waitIdle();
+    std::cout << "PASSED\n";
+}
+
+void test_partial_atlas_updates() {
+    std::cout << "Testing: Partial font atlas updates... ";
+
+    auto ctx = TestContext::create("test_partial_atlas_updates");
+
+    GuiConfig guiConfig;
+    guiConfig.msaaSamples = ctx->renderer->msaaSamples();
+    GuiSystem gui(ctx->renderer->device(), guiConfig);
+    gui.initialize(ctx->renderer.get());
+
+    auto runFrame = [&](float fontSize) {
+        if (auto frame = ctx->renderer->beginFrame()) {
+            gui.beginFrame();
+            ImGui::Begin("Atlas");
+            ImGui::PushFont(nullptr, fontSize);
+            ImGui::Text("Glyphs at %.0fpx", fontSize);
+            ImGui::PopFont();
+            ImGui::End();
+            gui.endFrame();
+
+            ctx->renderer->beginRenderPass({0.1f, 0.1f, 0.1f, 1.0f});
+            gui.render(frame);
+            ctx->renderer->endRenderPass();
+            ctx->renderer->endFrame();
+        }
+    };
+
+    runFrame(13.0f);
+    ImTextureData* atlas = ImGui::GetIO().Fonts->TexData;
+    ImTextureID atlasId = atlas->TexID;
+    uint64_t bytesBefore = gui.renderStats().textureUploadBytes;
+
+    // A new size rasterizes new glyphs into the existing atlas
+    runFrame(21.0f);
+    runFrame(21.0f);
+
+    GuiRenderStats stats = gui.renderStats();
+    assert(stats.textureRegionUpdates > 0);
+    assert(stats.textureUploadBytes > bytesBefore);
+
+    // Unless the atlas had to be resized, its descriptor did not change
+    if (ImGui::GetIO().Fonts->TexData == atlas) {
+        assert(atlas->TexID == atlasId);
+    }
+
+    ctx->renderer->waitIdle();
+    std::cout << "PASSED\n";
+}
+
+void test_bindless_textures() {
+    std::cout << "Testing: Bindless texture mode... ";
+
+    auto ctx = TestContext::create("test_bindless_textures");
+
+    GuiConfig guiConfig;
+    guiConfig.msaaSamples = ctx->renderer->msaaSamples();
+    guiConfig.bindlessTextures = true;
+    GuiSystem gui(ctx->renderer->device(), guiConfig);
+    gui.initialize(ctx->renderer.get());
+
+    auto offscreen = finevk::OffscreenSurface::create(ctx->device.get())
+        .extent(64, 64)
+        .build();
+    offscreen->beginFrame();
+    offscreen->beginRenderPass({1.0f, 0.5f, 0.0f, 1.0f});
+    offscreen->endRenderPass();
+    offscreen->endFrame();
+
+    // Handles work the same way whichever binding mode is active. The same
+    // view/sampler pair shares one slot.
+    std::vector<TextureHandle> icons;
+    for (int i = 0; i < 3; i++) {
+        icons.push_back(gui.registerTexture(offscreen->colorImageView(),
+                                            offscreen->colorSampler(), 64, 64));
+        assert(icons.back().valid());
+    }
+    assert(icons[0] == icons[1] && icons[1] == icons[2]);
+
+    for (int f = 0; f < 3; f++) {
+        if (auto frame = ctx->renderer->beginFrame()) {
+            gui.beginFrame();
+            ImGui::Begin("Hotbar");
+            for (const auto& icon : icons) {
+                ImGui::Image(icon, ImVec2(32, 32));
+                ImGui::SameLine();
+                ImGui::Text("x3");
+            }
+            ImGui::End();
+            gui.endFrame();
+
+            ctx->renderer->beginRenderPass({0.1f, 0.1f, 0.1f, 1.0f});
+            gui.render(frame);
+            ctx->renderer->endRenderPass();
+            ctx->renderer->endFrame();
+        }
+    }
+
+    GuiRenderStats stats = gui.renderStats();
+    if (stats.bindlessCapacity > 0) {
+        // Font atlas plus the shared icon; one set bind covers every texture switch
+        assert(stats.bindlessSlotsUsed == 2);
+        assert(stats.descriptorBinds == 1);
+        assert(stats.textureSwitches > 1);
+    } else {
+        assert(stats.descriptorBinds == stats.textureSwitches);
+    }
+
+    ctx->renderer->waitIdle();
+    for (const auto& icon : icons) {
+        gui.unregisterTexture(icon);
+    }
+    if (stats.bindlessCapacity > 0) {
+        assert(gui.renderStats().bindlessSlotsUsed == 1);
+    }
+    std::cout << "PASSED\n";
+}
+
+void test_texture_registration_pools() {
+    std::cout << "Testing: Texture registration sharing and pool growth... ";
+
+    auto ctx = TestContext::create("test_texture_registration_pools");
+
+    GuiConfig guiConfig;
+    guiConfig.msaaSamples = ctx->renderer->msaaSamples();
+    GuiSystem gui(ctx->renderer->device(), guiConfig);
+    gui.initialize(ctx->renderer.get());
+
+    auto offscreen = finevk::OffscreenSurface::create(ctx->device.get())
+        .extent(32, 32)
+        .build();
+
+    GuiRenderStats before = gui.renderStats();
+    assert(before.descriptorPools == 1);
+
+    // Repeated registrations of one pair share a descriptor
+    TextureHandle a = gui.registerTexture(offscreen->colorImageView(), offscreen->colorSampler(), 32, 32);
+    TextureHandle b = gui.registerTexture(offscreen->colorImageView(), offscreen->colorSampler(), 32, 32);
+    assert(a == b);
+
+    GuiRenderStats shared = gui.renderStats();
+    assert(shared.registeredTextures == 1);
+    assert(shared.textureCacheHits == 1);
+    assert(shared.descriptorSetsLive == before.descriptorSetsLive + 1);
+
+    // The descriptor survives until its last registration is released
+    gui.unregisterTexture(a);
+    assert(gui.renderStats().registeredTextures == 1);
+    gui.unregisterTexture(b);
+    assert(gui.renderStats().registeredTextures == 0);
+    assert(gui.renderStats().descriptorSetsLive == before.descriptorSetsLive);
+
+    // Distinct pairs beyond the first pool's 100 sets chain another pool
+    std::vector<finevk::SamplerPtr> samplers;
+    std::vector<TextureHandle> handles;
+    for (int i = 0; i < 150; i++) {
+        samplers.push_back(finevk::Sampler::create(ctx->device.get())
+            .filter(VK_FILTER_NEAREST)
+            .build());
+        handles.push_back(gui.registerTexture(offscreen->colorImageView(),
+                                              samplers.back().get(), 32, 32));
+    }
+
+    GuiRenderStats grown = gui.renderStats();
+    assert(grown.registeredTextures == 150);
+    assert(grown.descriptorSetsLive == before.descriptorSetsLive + 150);
+    assert(grown.descriptorPools >= 2);
+
+    ctx->renderer->waitIdle();
+    for (const auto& handle : handles) {
+        gui.unregisterTexture(handle);
+    }
+    assert(gui.renderStats().registeredTextures == 0);
+    std::cout << "PASSED\n";
+}
+
+void test_unchanged_frame_skipping() {
+    std::cout << "Testing: Unchanged-frame upload skipping... ";
+
+    auto ctx = TestContext::create("test_unchanged_frame_skipping");
+
+    GuiConfig guiConfig;
+    guiConfig.msaaSamples = ctx->renderer->msaaSamples();
+    GuiSystem gui(ctx->renderer->device(), guiConfig);
+    gui.initialize(ctx->renderer.get());
+
+    auto runFrame = [&](int counter) {
+        if (auto frame = ctx->renderer->beginFrame()) {
+            gui.beginFrame();
+            ImGui::SetNextWindowPos(ImVec2(10, 10));
+            ImGui::SetNextWindowSize(ImVec2(200, 100));
+            ImGui::Begin("HUD", nullptr, ImGuiWindowFlags_NoSavedSettings);
+            ImGui::Text("Score: %d", counter);
+            ImGui::End();
+            gui.endFrame();
+
+            ctx->renderer->beginRenderPass({0.1f, 0.1f, 0.1f, 1.0f});
+            gui.render(frame);
+            ctx->renderer->endRenderPass();
+            ctx->renderer->endFrame();
+        }
+    };
+
+    // Let layout settle, then identical frames reuse the uploaded geometry
+    for (int i = 0; i < 3; i++) runFrame(0);
+    GuiRenderStats settled = gui.renderStats();
+    for (int i = 0; i < 5; i++) runFrame(0);
+    GuiRenderStats steady = gui.renderStats();
+    assert(steady.uploadsSkipped >= settled.uploadsSkipped + 4);
+    assert(steady.uploadBytesSkipped > settled.uploadBytesSkipped);
+
+    // Changing content uploads every frame
+    for (int i = 1; i <= 4; i++) runFrame(i * 1111);
+    GuiRenderStats changing = gui.renderStats();
+    assert(changing.uploadsSkipped == steady.uploadsSkipped);
+
+    // Changed frames are still hashed in full
+    assert(changing.geometryBytesHashed > steady.geometryBytesHashed);
+
+    ctx->renderer->waitIdle();
+    std::cout << "PASSED\n";
+}
+
+void test_secondary_command_buffers() {
+    std::cout << "Testing: Cached secondary command buffers... ";
+
+    auto ctx = TestContext::create("test_secondary_command_buffers");
+
+    GuiConfig guiConfig;
+    guiConfig.msaaSamples = ctx->renderer->msaaSamples();
+    guiConfig.enableDrawDataCapture = true;
+    GuiSystem gui(ctx->renderer->device(), guiConfig);
+    gui.initialize(ctx->renderer.get());
+
+    // mode 0 renders inline (creates the font atlas), 1 records a secondary,
+    // 2 records it on the worker thread, 3 records one and replays it in a
+    // pass begun for secondary contents (SimpleRenderer's own pass is inline)
+    uint64_t replays = 0;
+    auto runFrame = [&](int counter, int mode) {
+        if (auto frame = ctx->renderer->beginFrame()) {
+            gui.beginFrame();
+            ImGui::SetNextWindowPos(ImVec2(10, 10));
+            ImGui::SetNextWindowSize(ImVec2(200, 100));
+            ImGui::Begin("HUD", nullptr, ImGuiWindowFlags_NoSavedSettings);
+            ImGui::Text("Score: %d", counter);
+            ImGui::End();
+            gui.endFrame();
+
+            if (mode == 1) {
+                gui.recordSecondary(gui.getDrawData());
+            } else if (mode == 2) {
+                gui.recordSecondaryAsync(gui.getDrawData());
+            } else if (mode == 3) {
+                // No framebuffer in the recording, so it stays reusable
+                // whichever swapchain image this slot lands on
+                gui.recordSecondary(gui.getDrawData());
+
+                VkClearValue clears[3]{};
+                clears[0].color = {{0.1f, 0.1f, 0.1f, 1.0f}};
+                clears[1].depthStencil = {1.0f, 0};
+                clears[2].color = {{0.1f, 0.1f, 0.1f, 1.0f}};
+                VkRenderPassBeginInfo passInfo{};
+                passInfo.sType = VK_STRUCTURE_TYPE_RENDER_PASS_BEGIN_INFO;
+                passInfo.renderPass = ctx->renderer->renderPass()->handle();
+                passInfo.framebuffer = ctx->renderer->currentFramebuffer()->handle();
+                passInfo.renderArea.extent = ctx->renderer->extent();
+                passInfo.clearValueCount = 3;
+                passInfo.pClearValues = clears;
+                vkCmdBeginRenderPass(frame->handle(), &passInfo,
+                                     VK_SUBPASS_CONTENTS_SECONDARY_COMMAND_BUFFERS);
+                gui.executeSecondary(*frame);
+                vkCmdEndRenderPass(frame->handle());
+                replays++;
+                ctx->renderer->endFrame();
+                return;
+            }
+
+            ctx->renderer->beginRenderPass({0.1f, 0.1f, 0.1f, 1.0f});
+            if (mode == 0) {
+                gui.render(frame);
+            }
+            ctx->renderer->endRenderPass();
+            ctx->renderer->endFrame();
+        }
+    };
+
+    for (int i = 0; i < 3; i++) runFrame(0, 0);
+
+    // Every frame-in-flight slot records once, then identical frames reuse it
+    for (int i = 0; i < 4; i++) runFrame(0, 1);
+    GuiRenderStats settled = gui.renderStats();
+    assert(settled.secondaryRecords > 0);
+    for (int i = 0; i < 6; i++) runFrame(0, 1);
+    GuiRenderStats steady = gui.renderStats();
+    assert(steady.secondaryReuses >= settled.secondaryReuses + 4);
+
+    // Changed draws are recorded again
+    for (int i = 1; i <= 3; i++) runFrame(i * 1111, 1);
+    GuiRenderStats changing = gui.renderStats();
+    assert(changing.secondaryRecords >= steady.secondaryRecords + 3);
+
+    // Worker-thread recording; renderStats() waits for it to finish
+    for (int i = 1; i <= 3; i++) runFrame(i * 2222, 2);
+    GuiRenderStats async = gui.renderStats();
+    assert(async.secondaryRecords >= changing.secondaryRecords + 3);
+    assert(async.drawCalls > 0);
+    assert(async.secondaryExecutes == 0);
+
+    // Replayed in a primary pass: every frame executes its slot's recording,
+    // and identical frames execute it without recording again
+    for (int i = 0; i < 8; i++) runFrame(4444, 3);
+    GuiRenderStats replayed = gui.renderStats();
+    assert(replays > 0 && replayed.secondaryExecutes == replays);
+    assert(replayed.secondaryReuses >= async.secondaryReuses + 4);
+    assert(replayed.secondaryRecords <= async.secondaryRecords + 4);
+    assert(replayed.drawCalls > 0);
+
+    ctx->renderer->waitIdle();
+    std::cout << "PASSED\n";
+}
+
+void test_compact_vertex_format() {
+    std::cout << "Testing: Compact vertex format... ";
+
+    auto ctx = TestContext::create("test_compact_vertex_format");
+
+    GuiConfig standardConfig;
+    standardConfig.msaaSamples = ctx->renderer->msaaSamples();
+    GuiConfig compactConfig = standardConfig;
+    compactConfig.compactVertices = true;
+
+    GuiSystem standard(ctx->renderer->device(), standardConfig);
+    standard.initialize(ctx->renderer.get());
+    GuiSystem compact(ctx->renderer->device(), compactConfig);
+    compact.initialize(ctx->renderer.get());
+
+    // Both systems build the same table-heavy frame and render it into the
+    // same pass, so their draw streams can be compared directly
+    auto buildFrame = [](GuiSystem& gui) {
+        gui.beginFrame();
+        ImGui::SetNextWindowPos(ImVec2(10, 10));
+        ImGui::SetNextWindowSize(ImVec2(400, 300));
+        ImGui::Begin("Table", nullptr, ImGuiWindowFlags_NoSavedSettings);
+        if (ImGui::BeginTable("rows", 3, ImGuiTableFlags_Borders | ImGuiTableFlags_RowBg)) {
+            for (int row = 0; row < 20; row++) {
+                ImGui::TableNextRow();
+                for (int col = 0; col < 3; col++) {
+                    ImGui::TableSetColumnIndex(col);
+                    ImGui::Text("Cell %d,%d", row, col);
+                }
+            }
+            ImGui::EndTable();
+        }
+        ImGui::End();
+        gui.endFrame();
+    };
+
+    for (int f = 0; f < 3; f++) {
+        if (auto frame = ctx->renderer->beginFrame()) {
+            buildFrame(standard);
+            buildFrame(compact);
+
+            ctx->renderer->beginRenderPass({0.1f, 0.1f, 0.1f, 1.0f});
+            standard.render(frame);
+            compact.render(frame);
+            ctx->renderer->endRenderPass();
+            ctx->renderer->endFrame();
+        }
+    }
+
+    GuiRenderStats a = standard.renderStats();
+    GuiRenderStats b = compact.renderStats();
+    assert(a.compactUploads == 0);
+    assert(b.compactUploads > 0);
+
+    // Same draws, batched the same way, from less geometry
+    assert(b.drawCommands == a.drawCommands);
+    assert(b.drawCalls == a.drawCalls);
+    assert(b.textureSwitches == a.textureSwitches);
+    assert(b.scissorChanges == a.scissorChanges);
+    assert(b.streamUsed < a.streamUsed);
+
+    ctx->renderer->waitIdle();
+    std::cout << "PASSED\n";
+}
+
+void test_pipeline_cache() {
+    std::cout << "Testing: Persistent pipeline cache... ";
+
+    auto ctx = TestContext::create("test_pipeline_cache");
+
+    std::string path = (std::filesystem::temp_directory_path() /
+                        "finegui_test_pipeline_cache.bin").string();
+    std::remove(path.c_str());
+
+    GuiConfig config;
+    config.msaaSamples = ctx->renderer->msaaSamples();
+    config.pipelineCachePath = path;
+
+    // Cold start writes the cache during initialize()
+    {
+        GuiSystem gui(ctx->renderer->device(), config);
+        gui.initialize(ctx->renderer.get());
+        GuiRenderStats stats = gui.renderStats();
+        assert(stats.pipelineCacheLoadedBytes == 0);
+        assert(std::filesystem::exists(path));
+        assert(std::filesystem::file_size(path) > 0);
+    }
+
+    // Warm start reuses it
+    {
+        GuiSystem gui(ctx->renderer->device(), config);
+        gui.initialize(ctx->renderer.get());
+        GuiRenderStats stats = gui.renderStats();
+        assert(stats.pipelineCacheLoadedBytes > 0);
+    }
+
+    // A corrupt file is ignored, and replaced by a good one
+    {
+        std::FILE* f = std::fopen(path.c_str(), "wb");
+        assert(f);
+        std::fputs("not a pipeline cache", f);
+        std::fclose(f);
+
+        GuiSystem gui(ctx->renderer->device(), config);
+        gui.initialize(ctx->renderer.get());
+        assert(gui.renderStats().pipelineCacheLoadedBytes == 0);
+        assert(std::filesystem::file_size(path) > 20);
+    }
+
+    std::remove(path.c_str());
+
+    std::cout << "PASSED\n";
+}
+
+void test_gpu_timings() {
+    std::cout << "Testing: GPU timestamp timings... ";
+
+    auto ctx = TestContext::create("test_gpu_timings");
+
+    GuiConfig config;
+    config.msaaSamples = ctx->renderer->msaaSamples();
+
+    // Off by default
+    {
+        GuiSystem gui(ctx->renderer->device(), config);
+        gui.initialize(ctx->renderer.get());
+        assert(!gui.gpuTimings().supported);
+    }
+
+    config.gpuTiming = true;
+    GuiSystem gui(ctx->renderer->device(), config);
+    gui.initialize(ctx->renderer.get());
+
+    // Devices without timestamps just report nothing
+    if (!gui.gpuTimings().supported) {
+        std::cout << "SKIPPED (no timestamp support)\n";
+        return;
+    }
+
+    SceneTexture scene(gui, 64, 64);
+
+    for (int f = 0; f < 8; f++) {
+        scene.beginScene(0.2f, 0.4f, 0.6f, 1.0f);
+        scene.endScene();
+
+        if (auto frame = ctx->renderer->beginFrame()) {
+            gui.beginFrame();
+            ImGui::SetNextWindowPos(ImVec2(10, 10));
+            ImGui::Begin("Timed", nullptr, ImGuiWindowFlags_NoSavedSettings);
+            ImGui::Text("Frame %d", f);
+            ImGui::Image(scene.textureHandle(), ImVec2(64, 64));
+            ImGui::End();
+            gui.endFrame();
+
+            gui.resetGpuTimers(frame);  // Outside the render pass
+            ctx->renderer->beginRenderPass({0.1f, 0.1f, 0.1f, 1.0f});
+            gui.render(frame);
+            ctx->renderer->endRenderPass();
+            ctx->renderer->endFrame();
+        }
+    }
+
+    GpuTimings timings = gui.gpuTimings();
+    // Results are read a few frames later, without waiting
+    assert(timings.guiSamples > 0);
+    assert(timings.guiMicros >= 0.0f);
+    assert(timings.sceneSamples > 0);
+    assert(scene.gpuMicros() >= 0.0f);
+
+    std::cout << "PASSED\n";
+}
+
+void test_cached_gui_layer() {
+    std::cout << "Testing: Cached GUI layer... ";
+
+    auto ctx = TestContext::create("test_cached_gui_layer");
+
+    GuiConfig config;
+    config.msaaSamples = ctx->renderer->msaaSamples();
+    config.cachedLayer = true;
+
+    GuiSystem gui(ctx->renderer->device(), config);
+    gui.initialize(ctx->renderer.get());
+
+    auto runFrames = [&](int count, const char* text) {
+        for (int f = 0; f < count; f++) {
+            if (auto frame = ctx->renderer->beginFrame()) {
+                gui.beginFrame(1.0f / 60.0f);
+                ImGui::SetNextWindowPos(ImVec2(10, 10));
+                ImGui::Begin("Layer", nullptr, ImGuiWindowFlags_NoSavedSettings);
+                ImGui::Text("%s", text);
+                ImGui::End();
+                gui.endFrame();
+
+                gui.recordLayer(*frame);
+                ctx->renderer->beginRenderPass({0.1f, 0.1f, 0.1f, 1.0f});
+                gui.render(frame);
+                ctx->renderer->endRenderPass();
+                ctx->renderer->endFrame();
+            }
+        }
+    };
+
+    // Warm up (font atlas upload, window layout), then settle
+    runFrames(8, "Static");
+    GuiRenderStats before = gui.renderStats();
+    assert(before.layerRenders > 0);
+
+    // Unchanged frames only composite
+    runFrames(10, "Static");
+    GuiRenderStats after = gui.renderStats();
+    assert(after.layerRenders == before.layerRenders);
+    assert(after.layerReuses >= before.layerReuses + 10);
+
+    // Changed draw data re-renders
+    runFrames(1, "Changed");
+    GuiRenderStats changed = gui.renderStats();
+    assert(changed.layerRenders == after.layerRenders + 1);
+
+    // Explicit invalidation re-renders identical content
+    runFrames(4, "Changed");
+    GuiRenderStats settled = gui.renderStats();
+    gui.invalidateLayer();
+    runFrames(1, "Changed");
+    assert(gui.renderStats().layerRenders == settled.layerRenders + 1);
+
+    // A GUI that changes every frame is drawn directly instead...
+    runFrames(4, "Changed");
+    GuiRenderStats steady = gui.renderStats();
+    for (int i = 0; i < 12; i++) {
+        runFrames(1, i % 2 == 0 ? "Tick" : "Tock");
+    }
+    GuiRenderStats busy = gui.renderStats();
+    assert(busy.layerBypasses > steady.layerBypasses);
+    assert(busy.layerRenders < steady.layerRenders + 6);
+
+    // ...and cached again once it settles
+    runFrames(80, "Settled");
+    GuiRenderStats calm = gui.renderStats();
+    assert(calm.layerRenders > busy.layerRenders);
+    assert(calm.layerReuses > busy.layerReuses);
+
+    ctx->renderer->waitIdle();
+    std::cout << "PASSED\n";
+}
+
+void test_layer_frame_geometry() {
+    std::cout << "Testing: Layer render and composite in one frame... ";
+
+    auto ctx = TestContext::create("test_layer_frame_geometry");
+
+    GuiConfig config;
+    config.msaaSamples = ctx->renderer->msaaSamples();
+    config.cachedLayer = true;
+
+    GuiSystem gui(ctx->renderer->device(), config);
+    gui.initialize(ctx->renderer.get());
+
+    // Returns the frame slot used, or -1 if no frame was rendered
+    auto runFrame = [&]() -> int {
+        auto frame = ctx->renderer->beginFrame();
+        if (!frame) return -1;
+        int slot = static_cast<int>(ctx->renderer->currentFrame());
+        gui.beginFrame(1.0f / 60.0f);
+        ImGui::SetNextWindowPos(ImVec2(10, 10));
+        ImGui::Begin("Layer", nullptr, ImGuiWindowFlags_NoSavedSettings);
+        for (int i = 0; i < 20; i++) {
+            ImGui::Text("Line %d of a layer worth keeping", i);
+        }
+        ImGui::End();
+        gui.endFrame();
+
+        gui.recordLayer(*frame);
+        ctx->renderer->beginRenderPass({0.1f, 0.1f, 0.1f, 1.0f});
+        gui.render(frame);
+        ctx->renderer->endRenderPass();
+        ctx->renderer->endFrame();
+        return slot;
+    };
+
+    // Settle: only the composite quad is uploaded (and then reused)
+    for (int i = 0; i < 10; i++) runFrame();
+    GuiRenderStats settled = gui.renderStats();
+
+    // Two frames in a row, in different slots, each re-render the layer
+    // and then composite it. Each frame's layer geometry must outlive its
+    // composite draw, and the first frame's must survive the second.
+    gui.invalidateLayer();
+    int slotA = runFrame();
+    GuiRenderStats a = gui.renderStats();
+    gui.invalidateLayer();
+    int slotB = runFrame();
+    GuiRenderStats b = gui.renderStats();
+
+    assert(slotA >= 0 && slotB >= 0 && slotA != slotB);
+    assert(a.layerRenders == settled.layerRenders + 1);
+    assert(b.layerRenders == a.layerRenders + 1);
+
+    // Frame A added its layer geometry and a quad to the settled quad;
+    // frame B retired that quad and added the same again
+    uint64_t frameBytes = a.streamUsed - settled.streamUsed;
+    assert(a.streamUsed > settled.streamUsed);
+    assert(frameBytes > settled.streamUsed);
+    assert(b.streamUsed == 2 * frameBytes);
+    assert(b.streamReallocations == settled.streamReallocations);
+
+    ctx->renderer->waitIdle();
+    std::cout << "PASSED\n";
+}
+
+void test_async_texture_uploads() {
+    std::cout << "Testing: Async texture uploads... ";
+
+    auto ctx = TestContext::create("test_async_texture_uploads");
+
+    // Budget of one 64x64 texture per frame
+    constexpr uint32_t kSize = 64;
+    constexpr uint64_t kBytes = kSize * kSize * 4;
+
+    std::mutex queueMutex;
+    GuiConfig config;
+    config.msaaSamples = ctx->renderer->msaaSamples();
+    config.asyncUploadBytesPerFrame = kBytes;
+    config.queueMutex = &queueMutex;
+
+    GuiSystem gui(ctx->renderer->device(), config);
+    gui.initialize(ctx->renderer.get());
+
+    std::vector<uint32_t> pixels(kSize * kSize, 0xFF3080C0u);
+    std::vector<TextureHandle> handles;
+    for (int i = 0; i < 3; i++) {
+        handles.push_back(gui.registerTextureAsync(pixels.data(), kSize, kSize));
+        assert(handles.back().valid());
+        assert(!gui.textureReady(handles.back()));
+    }
+
+    // Released before its upload was ever submitted
+    TextureHandle dropped = gui.registerTextureAsync(pixels.data(), kSize, kSize);
+    gui.unregisterTexture(dropped);
+    assert(gui.renderStats().pendingUploads == 3);
+
+    auto runFrame = [&]() {
+        if (auto frame = ctx->renderer->beginFrame()) {
+            gui.beginFrame(1.0f / 60.0f);
+            ImGui::Begin("Icons", nullptr, ImGuiWindowFlags_NoSavedSettings);
+            for (const TextureHandle& handle : handles) {
+                ImGui::Image(handle, ImVec2(32, 32));
+            }
+            ImGui::End();
+            gui.endFrame();
+
+            ctx->renderer->beginRenderPass({0.1f, 0.1f, 0.1f, 1.0f});
+            gui.render(frame);
+            ctx->renderer->endRenderPass();
+            ctx->renderer->endFrame();
+        }
+    };
+
+    // Nothing is submitted before a render call...
+    gui.beginFrame(1.0f / 60.0f);
+    gui.endFrame();
+    assert(gui.renderStats().asyncUploadBytes == 0);
+
+    // ...and the first frame submits exactly one texture's worth of bytes
+    runFrame();
+    assert(gui.renderStats().asyncUploadBytes == kBytes);
+
+    for (int f = 0; f < 60 && gui.renderStats().pendingUploads > 0; f++) {
+        runFrame();
+    }
+
+    GuiRenderStats stats = gui.renderStats();
+    assert(stats.pendingUploads == 0);
+    assert(stats.asyncUploadsCompleted == 3);
+    assert(stats.asyncUploadBytes == 3 * kBytes);
+    for (const TextureHandle& handle : handles) {
+        assert(gui.textureReady(handle));
+    }
+
+    // A page of icons shares one memory block rather than an allocation each
+    std::vector<TextureHandle> page;
+    for (int i = 0; i < 200; i++) {
+        page.push_back(gui.registerTextureAsync(pixels.data(), kSize, kSize));
+    }
+    assert(gui.renderStats().asyncUploadMemoryBlocks == 1);
+    for (const TextureHandle& handle : page) {
+        gui.unregisterTexture(handle);
+    }
+
+    // Ready textures draw, then retire after further frames
+    runFrame();
+    for (const TextureHandle& handle : handles) {
+        gui.unregisterTexture(handle);
+    }
+    handles.clear();
+    runFrame();
+    runFrame();
+    assert(gui.renderStats().registeredTextures == 0);
+
+    ctx->renderer->waitIdle();
+    std::cout << "PASSED\n";
+}
+
+void test_gui_thread_new_glyphs() {
+    std::cout << "Testing: GUI thread rasterizing new glyphs... ";
+
+    auto ctx = TestContext::create("test_gui_thread_new_glyphs");
+
+    GuiConfig guiConfig;
+    guiConfig.msaaSamples = ctx->renderer->msaaSamples();
+    guiConfig.enableDrawDataCapture = true;
+    GuiSystem gui(ctx->renderer->device(), guiConfig);
+    gui.initialize(ctx->renderer.get());
+
+    // No frame is rendered inline: the atlas itself is created from the
+    // GUI thread's request. Each size bakes glyphs no earlier frame used.
+    std::atomic<int> fontSize{13};
+    GuiThreadConfig threadConfig;
+    threadConfig.targetFrameRate = 120.0f;
+    GuiThread guiThread(gui, threadConfig);
+    guiThread.addFrameCallback([&](float) {
+        float size = static_cast<float>(fontSize.load());
+        ImGui::SetNextWindowPos(ImVec2(10, 10));
+        ImGui::Begin("Glyphs", nullptr, ImGuiWindowFlags_NoSavedSettings);
+        ImGui::PushFont(nullptr, size);
+        ImGui::Text("Glyphs at %.0fpx", size);
+        ImGui::PopFont();
+        ImGui::End();
+    });
+    guiThread.start();
+
+    uint64_t drawn = 0;
+    auto renderFrames = [&](int count) {
+        for (int i = 0; i < count; i++) {
+            if (auto frame = ctx->renderer->beginFrame()) {
+                const GuiDrawData& data = gui.getDrawData();
+                drawn += data.empty() ? 0 : 1;
+
+                ctx->renderer->beginRenderPass({0.1f, 0.1f, 0.1f, 1.0f});
+                gui.renderDrawData(*frame, ctx->renderer->currentFrame(), data);
+                ctx->renderer->endRenderPass();
+                ctx->renderer->endFrame();
+            }
+        }
+    };
+
+    renderFrames(30);
+    fontSize = 27;
+    renderFrames(30);
+    fontSize = 41;
+    renderFrames(30);
+    guiThread.stop();
+
+    // Glyphs baked on the GUI thread were uploaded from this one
+    GuiRenderStats stats = gui.renderStats();
+    assert(drawn > 0);
+    assert(stats.drawCommands > 0);
+    assert(stats.textureRegionUpdates > 0);
+    assert(stats.textureUploadBytes > 0);
+
+    // Once a frame has been drawn, later frames stop carrying its requests
+    gui.beginFrame(1.0f / 60.0f);
+    gui.endFrame();
+    renderFrames(1);
+    gui.beginFrame(1.0f / 60.0f);
+    gui.endFrame();
+    assert(gui.getDrawData().textureRequests.empty());
+
+    // The GUI thread needs capture, and cannot drive a cached layer
+    GuiConfig directConfig;
+    directConfig.msaaSamples = ctx->renderer->msaaSamples();
+    GuiSystem direct(ctx->renderer->device(), directConfig);
+    direct.initialize(ctx->renderer.get());
+    GuiThread directThread(direct);
+    bool threw = false;
+    try {
+        directThread.start();
+    } catch (const std::runtime_error&) {
+        threw = true;
+    }
+    assert(threw);
+
+    ctx->renderer->waitIdle();
+    std::cout << "PASSED\n";
+}
+
 // ============================================================================
 // Main
 // ============================================================================
@@ -496,6 +1440,20 @@ int main() {
         test_handle_input_event_exclusive_mode();
         test_gui_mode_switching();
         test_connect_disconnect_input_manager();
+        test_geometry_ring_stats();
+        test_draw_batching();
+        test_partial_atlas_updates();
+        test_bindless_textures();
+        test_texture_registration_pools();
+        test_unchanged_frame_skipping();
+        test_secondary_command_buffers();
+        test_compact_vertex_format();
+        test_pipeline_cache();
+        test_gpu_timings();
+        test_cached_gui_layer();
+        test_layer_frame_geometry();
+        test_async_texture_uploads();
+        test_gui_thread_new_glyphs();
 
         std::cout << "\n=== All Phase 2 tests PASSED ===\n";
     } catch (const std::exception& e) {
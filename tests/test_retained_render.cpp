@@ -242,25 +242,25 @@ void test_retained_rendering() {
     // Create inventory-style DnD widgets
     auto slot1 = WidgetNode::button("Sword");
     slot1.id = "slot1";
-    slot1.dragType = "item";
-    slot1.dragData = "sword_01";
-    slot1.dropAcceptType = "item";
+    slot1.propsMut().dragType = "item";
+    slot1.propsMut().dragData = "sword_01";
+    slot1.propsMut().dropAcceptType = "item";
 
     auto slot2 = WidgetNode::button("Empty");
     slot2.id = "slot2";
-    slot2.dragType = "item";
-    slot2.dragData = "";
-    slot2.dropAcceptType = "item";
+    slot2.propsMut().dragType = "item";
+    slot2.propsMut().dragData = "";
+    slot2.propsMut().dropAcceptType = "item";
     std::string lastDroppedData;
-    slot2.onDrop = [&lastDroppedData](WidgetNode& w) {
-        lastDroppedData = w.dragData;
+    slot2.callbacksMut().onDrop = [&lastDroppedData](WidgetNode& w) {
+        lastDroppedData = w.props().dragData;
     };
 
     auto slot3 = WidgetNode::button("Click-only Slot");
     slot3.id = "slot3";
-    slot3.dragType = "item";
-    slot3.dragData = "shield_01";
-    slot3.dragMode = 2;  // click-to-pick-up only
+    slot3.propsMut().dragType = "item";
+    slot3.propsMut().dragData = "shield_01";
+    slot3.propsMut().dragMode = 2;  // click-to-pick-up only
 
     guiRenderer.show(WidgetNode::window("Inventory DnD", {
         std::move(slot1),
@@ -326,8 +326,8 @@ void test_retained_rendering() {
     bool focusFired = false;
     auto trackedInput = WidgetNode::inputText("Tracked", "");
     trackedInput.id = "tracked_input";
-    trackedInput.onFocus = [&focusFired](WidgetNode&) { focusFired = true; };
-    trackedInput.onBlur = [](WidgetNode&) {};
+    trackedInput.callbacksMut().onFocus = [&focusFired](WidgetNode&) { focusFired = true; };
+    trackedInput.callbacksMut().onBlur = [](WidgetNode&) {};
 
     guiRenderer.show(WidgetNode::window("Focus Test", {
         std::move(focusInput),
@@ -352,12 +352,12 @@ void test_retained_rendering() {
             WidgetNode::text("Semi-transparent"),
             WidgetNode::button("Click me"),
         });
-        win.alpha = 0.5f;
+        win.propsMut().alpha = 0.5f;
         int alphaId = guiRenderer.show(std::move(win));
         runFrames(window.get(), renderer.get(), gui, guiRenderer, 3);
         auto* alphaWin = guiRenderer.get(alphaId);
         assert(alphaWin != nullptr);
-        assert(alphaWin->alpha == 0.5f);
+        assert(alphaWin->props().alpha == 0.5f);
     }
     std::cout << "ok";
 
@@ -368,14 +368,14 @@ void test_retained_rendering() {
         auto win = WidgetNode::window("Positioned", {
             WidgetNode::text("At 100,200"),
         });
-        win.windowPosX = 100.0f;
-        win.windowPosY = 200.0f;
+        win.propsMut().windowPosX = 100.0f;
+        win.propsMut().windowPosY = 200.0f;
         int posId = guiRenderer.show(std::move(win));
         runFrames(window.get(), renderer.get(), gui, guiRenderer, 3);
         auto* posWin = guiRenderer.get(posId);
         assert(posWin != nullptr);
-        assert(posWin->windowPosX == 100.0f);
-        assert(posWin->windowPosY == 200.0f);
+        assert(posWin->props().windowPosX == 100.0f);
+        assert(posWin->props().windowPosY == 200.0f);
     }
     std::cout << "ok";
 
@@ -388,7 +388,7 @@ void test_retained_rendering() {
         auto win = WidgetNode::window("Fade Test", {
             WidgetNode::text("Fading in..."),
         });
-        win.alpha = 0.0f;
+        win.propsMut().alpha = 0.0f;
         int fadeId = guiRenderer.show(std::move(win));
 
         bool fadeComplete = false;
@@ -413,7 +413,7 @@ void test_retained_rendering() {
 
         auto* fadeWin = guiRenderer.get(fadeId);
         assert(fadeWin != nullptr);
-        assert(fadeWin->alpha >= 0.99f);  // should be ~1.0
+        assert(fadeWin->props().alpha >= 0.99f);  // should be ~1.0
         assert(fadeComplete);
         assert(tweens.activeCount() == 0);
     }
@@ -428,8 +428,8 @@ void test_retained_rendering() {
         auto win = WidgetNode::window("Slide Test", {
             WidgetNode::text("Sliding..."),
         });
-        win.windowPosX = 50.0f;
-        win.windowPosY = 50.0f;
+        win.propsMut().windowPosX = 50.0f;
+        win.propsMut().windowPosY = 50.0f;
         int slideId = guiRenderer.show(std::move(win));
 
         bool slideComplete = false;
@@ -454,8 +454,8 @@ void test_retained_rendering() {
 
         auto* slideWin = guiRenderer.get(slideId);
         assert(slideWin != nullptr);
-        assert(std::abs(slideWin->windowPosX - 300.0f) < 1.0f);
-        assert(std::abs(slideWin->windowPosY - 400.0f) < 1.0f);
+        assert(std::abs(slideWin->props().windowPosX - 300.0f) < 1.0f);
+        assert(std::abs(slideWin->props().windowPosY - 400.0f) < 1.0f);
         assert(slideComplete);
         assert(tweens.activeCount() == 0);
     }
@@ -468,7 +468,7 @@ void test_retained_rendering() {
         TweenManager tweens(guiRenderer);
 
         auto win = WidgetNode::window("Cancel Test", {});
-        win.alpha = 1.0f;
+        win.propsMut().alpha = 1.0f;
         int cancelId = guiRenderer.show(std::move(win));
 
         int tweenId = tweens.fadeOut(cancelId, 10.0f);  // very long duration
@@ -490,8 +490,8 @@ void test_retained_rendering() {
         auto win = WidgetNode::window("Shake Test", {
             WidgetNode::text("Shaking!"),
         });
-        win.windowPosX = 200.0f;
-        win.windowPosY = 200.0f;
+        win.propsMut().windowPosX = 200.0f;
+        win.propsMut().windowPosY = 200.0f;
         int shakeGuiId = guiRenderer.show(std::move(win));
 
         bool shakeComplete = false;
@@ -517,8 +517,8 @@ void test_retained_rendering() {
         // After shake, position should be restored to base
         auto* shakeWin = guiRenderer.get(shakeGuiId);
         assert(shakeWin != nullptr);
-        assert(std::abs(shakeWin->windowPosX - 200.0f) < 1.0f);
-        assert(std::abs(shakeWin->windowPosY - 200.0f) < 1.0f);
+        assert(std::abs(shakeWin->props().windowPosX - 200.0f) < 1.0f);
+        assert(std::abs(shakeWin->props().windowPosY - 200.0f) < 1.0f);
         assert(shakeComplete);
         assert(tweens.activeCount() == 0);
     }
@@ -619,8 +619,8 @@ void test_retained_rendering() {
             WidgetNode::text("Scaled content"),
             WidgetNode::button("Scaled button"),
         });
-        win.scaleX = 0.5f;
-        win.scaleY = 0.5f;
+        win.propsMut().scaleX = 0.5f;
+        win.propsMut().scaleY = 0.5f;
         guiRenderer.show(std::move(win));
         runFrames(window.get(), renderer.get(), gui, guiRenderer, 3);
     }
@@ -633,7 +633,7 @@ void test_retained_rendering() {
         auto win = WidgetNode::window("Rotated Window", {
             WidgetNode::text("Flipped content"),
         });
-        win.rotationY = 1.0f;  // ~57 degrees
+        win.propsMut().rotationY = 1.0f;  // ~57 degrees
         guiRenderer.show(std::move(win));
         runFrames(window.get(), renderer.get(), gui, guiRenderer, 3);
     }
@@ -648,8 +648,8 @@ void test_retained_rendering() {
         auto win = WidgetNode::window("Zoom Test", {
             WidgetNode::text("Zooming in..."),
         });
-        win.scaleX = 0.0f;
-        win.scaleY = 0.0f;
+        win.propsMut().scaleX = 0.0f;
+        win.propsMut().scaleY = 0.0f;
         int zoomId = guiRenderer.show(std::move(win));
 
         bool zoomComplete = false;
@@ -673,8 +673,8 @@ void test_retained_rendering() {
 
         auto* zoomWin = guiRenderer.get(zoomId);
         assert(zoomWin != nullptr);
-        assert(zoomWin->scaleX >= 0.99f);
-        assert(zoomWin->scaleY >= 0.99f);
+        assert(zoomWin->props().scaleX >= 0.99f);
+        assert(zoomWin->props().scaleY >= 0.99f);
         assert(zoomComplete);
         assert(tweens.activeCount() == 0);
     }
@@ -712,7 +712,7 @@ void test_retained_rendering() {
 
         auto* flipWin = guiRenderer.get(flipId);
         assert(flipWin != nullptr);
-        assert(std::abs(flipWin->rotationY - static_cast<float>(M_PI)) < 0.1f);
+        assert(std::abs(flipWin->props().rotationY - static_cast<float>(M_PI)) < 0.1f);
         assert(flipComplete);
         assert(tweens.activeCount() == 0);
     }
@@ -750,8 +750,8 @@ void test_retained_rendering() {
 
         auto* zoomOutWin = guiRenderer.get(zoomOutId);
         assert(zoomOutWin != nullptr);
-        assert(zoomOutWin->scaleX < 0.01f);
-        assert(zoomOutWin->scaleY < 0.01f);
+        assert(zoomOutWin->props().scaleX < 0.01f);
+        assert(zoomOutWin->props().scaleY < 0.01f);
         assert(zoomOutComplete);
         assert(tweens.activeCount() == 0);
     }
@@ -951,6 +951,167 @@ void test_retained_rendering() {
     }
     std::cout << "ok";
 
+    // --- Test 36: List clipping for long Child / Table / ListBox contents ---
+    std::cout << "\n  36. List clipping (2000-row child, table, listbox)... ";
+    guiRenderer.hideAll();
+    {
+        constexpr int kRows = 2000;
+        WidgetList logRows;
+        WidgetList tableRows;
+        std::vector<std::string> items;
+        for (int i = 0; i < kRows; i++) {
+            auto line = WidgetNode::selectable("Log line " + std::to_string(i));
+            if (i == 1500) line.id = "far_row";
+            logRows.push_back(std::move(line));
+            tableRows.push_back(WidgetNode::tableRow({
+                WidgetNode::text("Item " + std::to_string(i)),
+                WidgetNode::text(std::to_string(i * 10)),
+            }));
+            items.push_back("Entry " + std::to_string(i));
+        }
+
+        bool farRowFocused = false;
+        logRows[1500].callbacksMut().onFocus = [&](WidgetNode&) { farRowFocused = true; };
+
+        guiRenderer.show(WidgetNode::window("Clipped", 600.0f, 500.0f, {
+            WidgetNode::child("##log", 0.0f, 150.0f, true, false, std::move(logRows)),
+            WidgetNode::table("##items", 2, {"Name", "Value"}, std::move(tableRows)),
+            WidgetNode::listBox("Entries", std::move(items), 0, 5),
+        }), true);
+        runFrames(window.get(), renderer.get(), gui, guiRenderer, 3);
+
+        // Only the rows in view are drawn: a few thousand vertices, not the
+        // ~250k that 6000 rows of text would take
+        ImDrawData* drawData = ImGui::GetDrawData();
+        assert(drawData != nullptr);
+        assert(drawData->TotalVtxCount < 30000);
+
+        // A clipped-away row still takes programmatic focus
+        guiRenderer.setFocus("far_row");
+        runFrames(window.get(), renderer.get(), gui, guiRenderer, 3);
+        assert(farRowFocused);
+    }
+    std::cout << "ok";
+
+    // --- Test 37: Virtual list and table over a million rows ---
+    std::cout << "\n  37. Virtual list and table (1,000,000 rows)... ";
+    guiRenderer.hideAll();
+    {
+        constexpr int kRows = 1000000;
+        int rowsBuilt = 0;
+        int sortCalls = 0;
+
+        auto listId = guiRenderer.show(WidgetNode::window("Virtual", 600.0f, 500.0f, {
+            WidgetNode::virtualList("##chat", kRows,
+                [&](int row) {
+                    rowsBuilt++;
+                    return WidgetNode::text("Message " + std::to_string(row));
+                },
+                150.0f, [](WidgetNode&) {}),
+            WidgetNode::virtualTable("##auctions", 3, {"Item", "Qty", "Price"}, kRows,
+                [&](int row) {
+                    rowsBuilt++;
+                    return WidgetNode::tableRow({
+                        WidgetNode::text("Item " + std::to_string(row)),
+                        WidgetNode::text(std::to_string(row % 100)),
+                        WidgetNode::text(std::to_string(row * 3)),
+                    });
+                },
+                0, {}, [&](WidgetNode&) { sortCalls++; }),
+        }), true);
+
+        // Per-frame work is bounded by what fits on screen, not by kRows
+        runFrames(window.get(), renderer.get(), gui, guiRenderer, 3);
+        rowsBuilt = 0;
+        runFrames(window.get(), renderer.get(), gui, guiRenderer, 1);
+        assert(rowsBuilt > 0 && rowsBuilt < 200);
+
+        ImDrawData* drawData = ImGui::GetDrawData();
+        assert(drawData != nullptr);
+        assert(drawData->TotalVtxCount < 30000);
+
+        // ImGui reports the table's initial sort order once
+        assert(sortCalls == 1);
+        auto* tree = guiRenderer.get(listId);
+        assert(tree != nullptr);
+        assert(tree->children[1].props().sortColumn == 0);
+        assert(tree->children[1].props().sortAscending);
+
+        // No row outlived its frame
+        assert(guiRenderer.escapedRowFrames() == 0);
+    }
+    std::cout << "ok";
+
+    // --- Test 38: Arena tree replaced while a node moved out of it lives ---
+    std::cout << "\n  38. Arena tree update with an escaped node... ";
+    guiRenderer.hideAll();
+    {
+        auto build = [](int n) {
+            return [n]() {
+                return WidgetNode::window("Arena", {
+                    WidgetNode::text("Frame " + std::to_string(n)),
+                    WidgetNode::slider("Volume", 0.5f, 0.0f, 1.0f),
+                });
+            };
+        };
+
+        int arenaId = guiRenderer.showInArena(build(0), true);
+        runFrames(window.get(), renderer.get(), gui, guiRenderer, 1);
+        WidgetNode kept = std::move(guiRenderer.get(arenaId)->children[1]);
+
+        // The old arena can't be reset; update() builds in a fresh one
+        for (int n = 1; n <= 4; n++) {
+            guiRenderer.updateInArena(arenaId, build(n));
+            runFrames(window.get(), renderer.get(), gui, guiRenderer, 1);
+        }
+        assert(guiRenderer.get(arenaId)->children[0].textContent == "Frame 4");
+
+        // Hiding drops the arenas; the escaped node keeps its storage
+        guiRenderer.hide(arenaId);
+        assert(kept.label == "Volume");
+        assert(kept.props().maxFloat == 1.0f);
+    }
+    std::cout << "ok";
+
+    // --- Test 39: Virtual rows kept by their provider ---
+    std::cout << "\n  39. Virtual rows that outlive their frame... ";
+    guiRenderer.hideAll();
+    {
+        // Copies made inside the provider come from the row arena
+        std::vector<WidgetNode> cache;
+        guiRenderer.show(WidgetNode::window("Caching", 400.0f, 300.0f, {
+            WidgetNode::virtualList("##cached", 100000,
+                [&](int row) {
+                    auto node = WidgetNode::group({WidgetNode::text("Row " + std::to_string(row))});
+                    if (row < 5) cache.push_back(node);
+                    return node;
+                },
+                150.0f),
+        }), true);
+
+        // Each frame's kept rows take its arena with them; drawing goes on
+        uint64_t escaped = guiRenderer.escapedRowFrames();
+        runFrames(window.get(), renderer.get(), gui, guiRenderer, 3);
+        assert(guiRenderer.escapedRowFrames() == escaped + 3);
+        assert(cache.size() >= 15);
+        assert(cache[0].children[0].textContent == "Row 0");
+
+        // Dropping the rows frees those arenas; rows that don't escape
+        // leave the count alone
+        guiRenderer.hideAll();
+        cache.clear();
+        guiRenderer.show(WidgetNode::window("Plain", 400.0f, 300.0f, {
+            WidgetNode::virtualList("##plain", 100000,
+                [](int row) {
+                    return WidgetNode::group({WidgetNode::text("Row " + std::to_string(row))});
+                },
+                150.0f),
+        }), true);
+        runFrames(window.get(), renderer.get(), gui, guiRenderer, 3);
+        assert(guiRenderer.escapedRowFrames() == escaped + 3);
+    }
+    std::cout << "ok";
+
     renderer->waitIdle();
     std::cout << "\nPASSED\n";
 }
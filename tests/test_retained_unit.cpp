@@ -9,6 +9,8 @@
  * - Visibility and enabled flags
  * - widgetTypeName() for all types
  * - GuiRenderer show/hide/update/get ID management
+ * - WidgetNode side storage and hot/cold footprint
+ * - WidgetArena tree storage (and build/teardown timing against the heap)
  */
 
 #include <finegui/widget_node.hpp>
@@ -16,10 +18,14 @@
 #include <finegui/drag_drop_manager.hpp>
 #include <finegui/texture_registry.hpp>
 #include <finegui/hotkey_manager.hpp>
+#include <finegui/widget_arena.hpp>
 #include <imgui.h>
 
+#include <algorithm>
 #include <iostream>
 #include <cassert>
+#include <chrono>
+#include <stdexcept>
 #include <string>
 
 using namespace finegui;
@@ -79,15 +85,15 @@ void test_button_builder() {
     });
     assert(b.type == WidgetNode::Type::Button);
     assert(b.label == "Press");
-    assert(b.onClick);
+    assert(b.callbacks().onClick);
 
     // Invoke callback manually
-    b.onClick(b);
+    b.callbacks().onClick(b);
     assert(clicked);
 
     // Button without callback
     auto b2 = WidgetNode::button("No callback");
-    assert(!b2.onClick);
+    assert(!b2.callbacks().onClick);
 
     std::cout << "PASSED\n";
 }
@@ -102,9 +108,9 @@ void test_checkbox_builder() {
     assert(c.type == WidgetNode::Type::Checkbox);
     assert(c.label == "Enable");
     assert(c.boolValue == true);
-    assert(c.onChange);
+    assert(c.callbacks().onChange);
 
-    c.onChange(c);
+    c.callbacks().onChange(c);
     assert(changed);
 
     std::cout << "PASSED\n";
@@ -117,8 +123,8 @@ void test_slider_builder() {
     assert(s.type == WidgetNode::Type::Slider);
     assert(s.label == "Volume");
     assert(s.floatValue == 0.5f);
-    assert(s.minFloat == 0.0f);
-    assert(s.maxFloat == 1.0f);
+    assert(s.props().minFloat == 0.0f);
+    assert(s.props().maxFloat == 1.0f);
 
     std::cout << "PASSED\n";
 }
@@ -130,8 +136,8 @@ void test_slider_int_builder() {
     assert(s.type == WidgetNode::Type::SliderInt);
     assert(s.label == "Level");
     assert(s.intValue == 5);
-    assert(s.minInt == 1);
-    assert(s.maxInt == 10);
+    assert(s.props().minInt == 1);
+    assert(s.props().maxInt == 10);
 
     std::cout << "PASSED\n";
 }
@@ -147,13 +153,13 @@ void test_input_text_builder() {
     );
     assert(i.type == WidgetNode::Type::InputText);
     assert(i.label == "Name");
-    assert(i.stringValue == "Alice");
-    assert(i.onChange);
-    assert(i.onSubmit);
+    assert(i.props().stringValue == "Alice");
+    assert(i.callbacks().onChange);
+    assert(i.callbacks().onSubmit);
 
-    i.onChange(i);
+    i.callbacks().onChange(i);
     assert(changed);
-    i.onSubmit(i);
+    i.callbacks().onSubmit(i);
     assert(submitted);
 
     std::cout << "PASSED\n";
@@ -188,9 +194,9 @@ void test_combo_builder() {
         {"1920x1080", "2560x1440", "3840x2160"}, 0);
     assert(c.type == WidgetNode::Type::Combo);
     assert(c.label == "Resolution");
-    assert(c.items.size() == 3);
-    assert(c.items[0] == "1920x1080");
-    assert(c.items[2] == "3840x2160");
+    assert(c.props().items.size() == 3);
+    assert(c.props().items[0] == "1920x1080");
+    assert(c.props().items[2] == "3840x2160");
     assert(c.selectedIndex == 0);
 
     std::cout << "PASSED\n";
@@ -227,7 +233,7 @@ void test_columns_builder() {
         WidgetNode::text("Col3"),
     });
     assert(c.type == WidgetNode::Type::Columns);
-    assert(c.columnCount == 3);
+    assert(c.props().columnCount == 3);
     assert(c.children.size() == 3);
 
     std::cout << "PASSED\n";
@@ -243,9 +249,9 @@ void test_image_builder() {
 
     auto img = WidgetNode::image(tex, 64.0f, 64.0f);
     assert(img.type == WidgetNode::Type::Image);
-    assert(img.texture.id == 99);
-    assert(img.imageWidth == 64.0f);
-    assert(img.imageHeight == 64.0f);
+    assert(img.props().texture.id == 99);
+    assert(img.props().imageWidth == 64.0f);
+    assert(img.props().imageHeight == 64.0f);
 
     std::cout << "PASSED\n";
 }
@@ -262,38 +268,38 @@ void test_field_defaults() {
     assert(n.floatValue == 0.0f);
     assert(n.intValue == 0);
     assert(n.boolValue == false);
-    assert(n.stringValue.empty());
+    assert(n.props().stringValue.empty());
     assert(n.selectedIndex == -1);
 
     // Range defaults
-    assert(n.minFloat == 0.0f);
-    assert(n.maxFloat == 1.0f);
-    assert(n.minInt == 0);
-    assert(n.maxInt == 100);
+    assert(n.props().minFloat == 0.0f);
+    assert(n.props().maxFloat == 1.0f);
+    assert(n.props().minInt == 0);
+    assert(n.props().maxInt == 100);
 
     // Layout defaults
     assert(n.width == 0.0f);
     assert(n.height == 0.0f);
-    assert(n.columnCount == 1);
+    assert(n.props().columnCount == 1);
 
     // State defaults
     assert(n.visible == true);
     assert(n.enabled == true);
 
     // No callbacks
-    assert(!n.onClick);
-    assert(!n.onChange);
-    assert(!n.onSubmit);
-    assert(!n.onClose);
+    assert(!n.callbacks().onClick);
+    assert(!n.callbacks().onChange);
+    assert(!n.callbacks().onSubmit);
+    assert(!n.callbacks().onClose);
 
     // Empty collections
-    assert(n.items.empty());
+    assert(n.props().items.empty());
     assert(n.children.empty());
 
     // Texture defaults
-    assert(!n.texture.valid());
-    assert(n.imageWidth == 0.0f);
-    assert(n.imageHeight == 0.0f);
+    assert(!n.props().texture.valid());
+    assert(n.props().imageWidth == 0.0f);
+    assert(n.props().imageHeight == 0.0f);
 
     std::cout << "PASSED\n";
 }
@@ -394,7 +400,7 @@ void test_nested_tree() {
 
     auto& cols = group.children[0];
     assert(cols.type == WidgetNode::Type::Columns);
-    assert(cols.columnCount == 2);
+    assert(cols.props().columnCount == 2);
     assert(cols.children.size() == 2);
 
     auto& rightGroup = cols.children[1];
@@ -444,18 +450,18 @@ void test_settings_panel_pattern() {
 
     // Simulate interactions via callbacks
     settings.children[1].floatValue = 0.8f;
-    settings.children[1].onChange(settings.children[1]);
+    settings.children[1].callbacks().onChange(settings.children[1]);
     assert(volumeValue == 0.8f);
 
     settings.children[2].boolValue = true;
-    settings.children[2].onChange(settings.children[2]);
+    settings.children[2].callbacks().onChange(settings.children[2]);
     assert(muteValue == true);
 
     settings.children[5].selectedIndex = 2;
-    settings.children[5].onChange(settings.children[5]);
+    settings.children[5].callbacks().onChange(settings.children[5]);
     assert(resIndex == 2);
 
-    settings.children[7].onClick(settings.children[7]);
+    settings.children[7].callbacks().onClick(settings.children[7]);
     assert(applied);
 
     std::cout << "PASSED\n";
@@ -470,10 +476,10 @@ void test_same_line_builder() {
 
     auto sl = WidgetNode::sameLine();
     assert(sl.type == WidgetNode::Type::SameLine);
-    assert(sl.offsetX == 0.0f);
+    assert(sl.props().offsetX == 0.0f);
 
     auto sl2 = WidgetNode::sameLine(100.0f);
-    assert(sl2.offsetX == 100.0f);
+    assert(sl2.props().offsetX == 100.0f);
 
     std::cout << "PASSED\n";
 }
@@ -493,10 +499,10 @@ void test_text_colored_builder() {
     auto tc = WidgetNode::textColored(1.0f, 0.3f, 0.3f, 1.0f, "Error!");
     assert(tc.type == WidgetNode::Type::TextColored);
     assert(tc.textContent == "Error!");
-    assert(tc.colorR == 1.0f);
-    assert(tc.colorG == 0.3f);
-    assert(tc.colorB == 0.3f);
-    assert(tc.colorA == 1.0f);
+    assert(tc.props().colorR == 1.0f);
+    assert(tc.props().colorG == 0.3f);
+    assert(tc.props().colorB == 0.3f);
+    assert(tc.props().colorA == 1.0f);
 
     std::cout << "PASSED\n";
 }
@@ -528,13 +534,13 @@ void test_progress_bar_builder() {
     assert(pb.type == WidgetNode::Type::ProgressBar);
     assert(pb.floatValue == 0.75f);
     assert(pb.width == 0.0f);
-    assert(pb.overlayText.empty());
+    assert(pb.props().overlayText.empty());
 
     auto pb2 = WidgetNode::progressBar(0.5f, 200.0f, 20.0f, "50%");
     assert(pb2.floatValue == 0.5f);
     assert(pb2.width == 200.0f);
     assert(pb2.height == 20.0f);
-    assert(pb2.overlayText == "50%");
+    assert(pb2.props().overlayText == "50%");
 
     std::cout << "PASSED\n";
 }
@@ -612,10 +618,10 @@ void test_hud_pattern() {
 
     assert(hud.children.size() == 7);
     assert(hud.children[0].type == WidgetNode::Type::TextColored);
-    assert(hud.children[0].colorR == 1.0f);
+    assert(hud.children[0].props().colorR == 1.0f);
     assert(hud.children[1].type == WidgetNode::Type::SameLine);
     assert(hud.children[2].type == WidgetNode::Type::ProgressBar);
-    assert(hud.children[2].overlayText == "85/100");
+    assert(hud.children[2].props().overlayText == "85/100");
     assert(hud.children[3].type == WidgetNode::Type::Spacing);
 
     std::cout << "PASSED\n";
@@ -750,11 +756,11 @@ void test_menu_item_builder() {
     }, "Ctrl+S", false);
     assert(mi.type == WidgetNode::Type::MenuItem);
     assert(mi.label == "Save");
-    assert(mi.shortcutText == "Ctrl+S");
+    assert(mi.props().shortcutText == "Ctrl+S");
     assert(mi.checked == false);
-    assert(mi.onClick);
+    assert(mi.callbacks().onClick);
 
-    mi.onClick(mi);
+    mi.callbacks().onClick(mi);
     assert(clicked);
 
     auto mi2 = WidgetNode::menuItem("Show Grid", {}, "", true);
@@ -857,21 +863,21 @@ void test_table_builder() {
     }, ImGuiTableFlags_RowBg | ImGuiTableFlags_BordersH);
     assert(tbl.type == WidgetNode::Type::Table);
     assert(tbl.id == "stats");
-    assert(tbl.columnCount == 2);
-    assert(tbl.items.size() == 2);
-    assert(tbl.items[0] == "Name");
-    assert(tbl.items[1] == "Value");
+    assert(tbl.props().columnCount == 2);
+    assert(tbl.props().items.size() == 2);
+    assert(tbl.props().items[0] == "Name");
+    assert(tbl.props().items[1] == "Value");
     assert(tbl.children.size() == 2);
     assert(tbl.children[0].type == WidgetNode::Type::TableRow);
     assert(tbl.children[0].children.size() == 2);
-    assert(tbl.tableFlags == (ImGuiTableFlags_RowBg | ImGuiTableFlags_BordersH));
+    assert(tbl.props().tableFlags == (ImGuiTableFlags_RowBg | ImGuiTableFlags_BordersH));
 
     // Minimal table
     auto tbl2 = WidgetNode::table("##grid", 4);
-    assert(tbl2.columnCount == 4);
-    assert(tbl2.items.empty());
+    assert(tbl2.props().columnCount == 4);
+    assert(tbl2.props().items.empty());
     assert(tbl2.children.empty());
-    assert(tbl2.tableFlags == 0);
+    assert(tbl2.props().tableFlags == 0);
 
     std::cout << "PASSED\n";
 }
@@ -926,15 +932,15 @@ void test_color_edit_builder() {
     auto ce = WidgetNode::colorEdit("Accent Color", 0.2f, 0.4f, 0.8f, 1.0f);
     assert(ce.type == WidgetNode::Type::ColorEdit);
     assert(ce.label == "Accent Color");
-    assert(ce.colorR == 0.2f);
-    assert(ce.colorG == 0.4f);
-    assert(ce.colorB == 0.8f);
-    assert(ce.colorA == 1.0f);
+    assert(ce.props().colorR == 0.2f);
+    assert(ce.props().colorG == 0.4f);
+    assert(ce.props().colorB == 0.8f);
+    assert(ce.props().colorA == 1.0f);
 
     // Default values
     auto ce2 = WidgetNode::colorEdit("Default");
-    assert(ce2.colorR == 1.0f);
-    assert(ce2.colorG == 1.0f);
+    assert(ce2.props().colorR == 1.0f);
+    assert(ce2.props().colorG == 1.0f);
 
     std::cout << "PASSED\n";
 }
@@ -945,8 +951,8 @@ void test_color_picker_builder() {
     auto cp = WidgetNode::colorPicker("Background", 0.1f, 0.1f, 0.15f, 1.0f);
     assert(cp.type == WidgetNode::Type::ColorPicker);
     assert(cp.label == "Background");
-    assert(cp.colorR == 0.1f);
-    assert(cp.colorB == 0.15f);
+    assert(cp.props().colorR == 0.1f);
+    assert(cp.props().colorB == 0.15f);
 
     std::cout << "PASSED\n";
 }
@@ -958,15 +964,15 @@ void test_drag_float_builder() {
     assert(df.type == WidgetNode::Type::DragFloat);
     assert(df.label == "Speed");
     assert(df.floatValue == 1.5f);
-    assert(df.dragSpeed == 0.1f);
-    assert(df.minFloat == 0.0f);
-    assert(df.maxFloat == 10.0f);
+    assert(df.props().dragSpeed == 0.1f);
+    assert(df.props().minFloat == 0.0f);
+    assert(df.props().maxFloat == 10.0f);
 
     // Default speed
     auto df2 = WidgetNode::dragFloat("X", 0.0f);
-    assert(df2.dragSpeed == 1.0f);
-    assert(df2.minFloat == 0.0f);
-    assert(df2.maxFloat == 0.0f);  // 0 = no clamp
+    assert(df2.props().dragSpeed == 1.0f);
+    assert(df2.props().minFloat == 0.0f);
+    assert(df2.props().maxFloat == 0.0f);  // 0 = no clamp
 
     std::cout << "PASSED\n";
 }
@@ -978,9 +984,9 @@ void test_drag_int_builder() {
     assert(di.type == WidgetNode::Type::DragInt);
     assert(di.label == "Count");
     assert(di.intValue == 50);
-    assert(di.dragSpeed == 1.0f);
-    assert(di.minInt == 0);
-    assert(di.maxInt == 100);
+    assert(di.props().dragSpeed == 1.0f);
+    assert(di.props().minInt == 0);
+    assert(di.props().maxInt == 100);
 
     std::cout << "PASSED\n";
 }
@@ -1016,9 +1022,9 @@ void test_data_table_pattern() {
     assert(keybinds.children.size() == 1);
     auto& table = keybinds.children[0];
     assert(table.type == WidgetNode::Type::Table);
-    assert(table.columnCount == 2);
-    assert(table.items.size() == 2);
-    assert(table.items[0] == "Action");
+    assert(table.props().columnCount == 2);
+    assert(table.props().items.size() == 2);
+    assert(table.props().items[0] == "Action");
     assert(table.children.size() == 2);
     assert(table.children[0].children[0].textContent == "Jump");
     assert(table.children[1].children[1].textContent == "LMB");
@@ -1038,8 +1044,8 @@ void test_inventory_grid_pattern() {
 
     auto grid = WidgetNode::table("##inv", 4, {}, std::move(cells));
     assert(grid.type == WidgetNode::Type::Table);
-    assert(grid.columnCount == 4);
-    assert(grid.items.empty());
+    assert(grid.props().columnCount == 4);
+    assert(grid.props().items.empty());
     assert(grid.children.size() == 16);  // 8 * (column + button)
     assert(grid.children[0].type == WidgetNode::Type::TableColumn);
     assert(grid.children[1].type == WidgetNode::Type::Button);
@@ -1057,17 +1063,17 @@ void test_listbox_builder() {
     auto lb = WidgetNode::listBox("Fruits", {"Apple", "Banana", "Cherry"}, 1, 5);
     assert(lb.type == WidgetNode::Type::ListBox);
     assert(lb.label == "Fruits");
-    assert(lb.items.size() == 3);
-    assert(lb.items[0] == "Apple");
-    assert(lb.items[1] == "Banana");
-    assert(lb.items[2] == "Cherry");
+    assert(lb.props().items.size() == 3);
+    assert(lb.props().items[0] == "Apple");
+    assert(lb.props().items[1] == "Banana");
+    assert(lb.props().items[2] == "Cherry");
     assert(lb.selectedIndex == 1);
-    assert(lb.heightInItems == 5);
+    assert(lb.props().heightInItems == 5);
 
     // Default height
     auto lb2 = WidgetNode::listBox("Colors", {"Red", "Green", "Blue"});
     assert(lb2.selectedIndex == 0);
-    assert(lb2.heightInItems == -1);
+    assert(lb2.props().heightInItems == -1);
 
     std::cout << "PASSED\n";
 }
@@ -1101,11 +1107,11 @@ void test_modal_builder() {
     assert(m.type == WidgetNode::Type::Modal);
     assert(m.label == "Confirm Delete");
     assert(m.children.size() == 3);
-    assert(m.onClose);
+    assert(m.callbacks().onClose);
     assert(m.boolValue == false);  // not open by default
 
     // Test callback
-    m.onClose(m);
+    m.callbacks().onClose(m);
     assert(closeCalled);
 
     std::cout << "PASSED\n";
@@ -1128,10 +1134,10 @@ void test_listbox_callback_pattern() {
     auto lb = WidgetNode::listBox("Items", {"A", "B", "C"}, 0, -1,
         [&selectedValue](WidgetNode& w) { selectedValue = w.selectedIndex; });
 
-    assert(lb.onChange);
+    assert(lb.callbacks().onChange);
     // Simulate selection change
     lb.selectedIndex = 2;
-    lb.onChange(lb);
+    lb.callbacks().onChange(lb);
     assert(selectedValue == 2);
 
     std::cout << "PASSED\n";
@@ -1172,19 +1178,19 @@ void test_canvas_builder() {
     assert(c.id == "##mycanvas");
     assert(c.width == 200.0f);
     assert(c.height == 150.0f);
-    assert(c.onDraw);
-    assert(c.onClick);
+    assert(c.callbacks().onDraw);
+    assert(c.callbacks().onClick);
 
     // Invoke callbacks
-    c.onDraw(c);
+    c.callbacks().onDraw(c);
     assert(drawn);
-    c.onClick(c);
+    c.callbacks().onClick(c);
     assert(clicked);
 
     // Canvas without callbacks
     auto c2 = WidgetNode::canvas("##simple", 100.0f, 100.0f);
-    assert(!c2.onDraw);
-    assert(!c2.onClick);
+    assert(!c2.callbacks().onDraw);
+    assert(!c2.callbacks().onClick);
 
     std::cout << "PASSED\n";
 }
@@ -1266,8 +1272,8 @@ void test_radio_button_builder() {
     assert(rb.type == WidgetNode::Type::RadioButton);
     assert(rb.label == "Option A");
     assert(rb.intValue == 0);   // active value
-    assert(rb.minInt == 1);     // this button's value
-    assert(rb.onChange);
+    assert(rb.props().minInt == 1);     // this button's value
+    assert(rb.callbacks().onChange);
 
     std::cout << "PASSED\n";
 }
@@ -1291,7 +1297,7 @@ void test_input_text_multiline_builder() {
 
     assert(ml.type == WidgetNode::Type::InputTextMultiline);
     assert(ml.label == "Notes");
-    assert(ml.stringValue == "Hello world");
+    assert(ml.props().stringValue == "Hello world");
     assert(ml.width == 300.0f);
     assert(ml.height == 200.0f);
 
@@ -1343,11 +1349,11 @@ void test_window_flags_builder() {
     auto w = WidgetNode::window("Flagged", std::vector<WidgetNode>{}, ImGuiWindowFlags_NoTitleBar | ImGuiWindowFlags_NoResize);
     assert(w.type == WidgetNode::Type::Window);
     assert(w.label == "Flagged");
-    assert(w.windowFlags == (ImGuiWindowFlags_NoTitleBar | ImGuiWindowFlags_NoResize));
+    assert(w.props().windowFlags == (ImGuiWindowFlags_NoTitleBar | ImGuiWindowFlags_NoResize));
 
     // Default: no flags
     auto w2 = WidgetNode::window("Normal", {});
-    assert(w2.windowFlags == 0);
+    assert(w2.props().windowFlags == 0);
 
     std::cout << "PASSED\n";
 }
@@ -1383,9 +1389,9 @@ void test_radio_button_group_pattern() {
 
     assert(tree.children.size() == 10);
     assert(tree.children[1].type == WidgetNode::Type::RadioButton);
-    assert(tree.children[1].minInt == 0);  // light = value 0
-    assert(tree.children[2].minInt == 1);  // dark = value 1
-    assert(tree.children[3].minInt == 2);  // system = value 2
+    assert(tree.children[1].props().minInt == 0);  // light = value 0
+    assert(tree.children[2].props().minInt == 1);  // dark = value 1
+    assert(tree.children[3].props().minInt == 2);  // system = value 2
 
     std::cout << "PASSED\n";
 }
@@ -1399,12 +1405,12 @@ void test_dnd_field_defaults() {
 
     WidgetNode n;
     n.type = WidgetNode::Type::Button;
-    assert(n.dragType.empty());
-    assert(n.dragData.empty());
-    assert(n.dropAcceptType.empty());
-    assert(!n.onDrop);
-    assert(!n.onDragBegin);
-    assert(n.dragMode == 0);
+    assert(n.props().dragType.empty());
+    assert(n.props().dragData.empty());
+    assert(n.props().dropAcceptType.empty());
+    assert(!n.callbacks().onDrop);
+    assert(!n.callbacks().onDragBegin);
+    assert(n.props().dragMode == 0);
 
     std::cout << "PASSED\n";
 }
@@ -1413,23 +1419,23 @@ void test_dnd_field_setting() {
     std::cout << "Testing: DnD field setting... ";
 
     auto img = WidgetNode::image({}, 48, 48);
-    img.dragType = "item";
-    img.dragData = "sword_01";
-    img.dropAcceptType = "item";
+    img.propsMut().dragType = "item";
+    img.propsMut().dragData = "sword_01";
+    img.propsMut().dropAcceptType = "item";
 
-    assert(img.dragType == "item");
-    assert(img.dragData == "sword_01");
-    assert(img.dropAcceptType == "item");
+    assert(img.props().dragType == "item");
+    assert(img.props().dragData == "sword_01");
+    assert(img.props().dropAcceptType == "item");
 
     bool dropCalled = false;
-    img.onDrop = [&dropCalled](WidgetNode& w) {
+    img.callbacksMut().onDrop = [&dropCalled](WidgetNode& w) {
         dropCalled = true;
-        assert(w.dragData == "potion_02");
+        assert(w.props().dragData == "potion_02");
     };
 
     // Simulate drop delivery
-    img.dragData = "potion_02";
-    img.onDrop(img);
+    img.propsMut().dragData = "potion_02";
+    img.callbacks().onDrop(img);
     assert(dropCalled);
 
     std::cout << "PASSED\n";
@@ -1439,15 +1445,15 @@ void test_dnd_drag_mode() {
     std::cout << "Testing: DnD drag mode... ";
 
     auto slot = WidgetNode::button("Slot");
-    slot.dragType = "item";
-    slot.dragMode = 2; // click-only
-    assert(slot.dragMode == 2);
+    slot.propsMut().dragType = "item";
+    slot.propsMut().dragMode = 2; // click-only
+    assert(slot.props().dragMode == 2);
 
-    slot.dragMode = 1; // drag-only
-    assert(slot.dragMode == 1);
+    slot.propsMut().dragMode = 1; // drag-only
+    assert(slot.props().dragMode == 1);
 
-    slot.dragMode = 0; // both (default)
-    assert(slot.dragMode == 0);
+    slot.propsMut().dragMode = 0; // both (default)
+    assert(slot.props().dragMode == 0);
 
     std::cout << "PASSED\n";
 }
@@ -1605,10 +1611,10 @@ void test_push_style_color_builder() {
     auto w = WidgetNode::pushStyleColor(21, 0.2f, 0.1f, 0.1f, 1.0f);
     assert(w.type == WidgetNode::Type::PushStyleColor);
     assert(w.intValue == 21);
-    assert(w.colorR == 0.2f);
-    assert(w.colorG == 0.1f);
-    assert(w.colorB == 0.1f);
-    assert(w.colorA == 1.0f);
+    assert(w.props().colorR == 0.2f);
+    assert(w.props().colorG == 0.1f);
+    assert(w.props().colorB == 0.1f);
+    assert(w.props().colorA == 1.0f);
 
     std::cout << "PASSED\n";
 }
@@ -1686,8 +1692,8 @@ void test_focus_field_defaults() {
     n.type = WidgetNode::Type::Button;
     assert(n.focusable == true);
     assert(n.autoFocus == false);
-    assert(!n.onFocus);
-    assert(!n.onBlur);
+    assert(!n.callbacks().onFocus);
+    assert(!n.callbacks().onBlur);
 
     std::cout << "PASSED\n";
 }
@@ -1705,16 +1711,16 @@ void test_focus_field_setting() {
 
     bool focusCalled = false;
     bool blurCalled = false;
-    input.onFocus = [&focusCalled](WidgetNode&) { focusCalled = true; };
-    input.onBlur = [&blurCalled](WidgetNode&) { blurCalled = true; };
+    input.callbacksMut().onFocus = [&focusCalled](WidgetNode&) { focusCalled = true; };
+    input.callbacksMut().onBlur = [&blurCalled](WidgetNode&) { blurCalled = true; };
 
-    assert(input.onFocus);
-    assert(input.onBlur);
+    assert(input.callbacks().onFocus);
+    assert(input.callbacks().onBlur);
 
     // Invoke callbacks manually
-    input.onFocus(input);
+    input.callbacks().onFocus(input);
     assert(focusCalled);
-    input.onBlur(input);
+    input.callbacks().onBlur(input);
     assert(blurCalled);
 
     std::cout << "PASSED\n";
@@ -1728,12 +1734,12 @@ void test_animation_field_defaults() {
     std::cout << "Testing: Animation field defaults... ";
 
     WidgetNode n;
-    assert(n.alpha == 1.0f);
-    assert(n.windowPosX == FLT_MAX);
-    assert(n.windowPosY == FLT_MAX);
-    assert(n.scaleX == 1.0f);
-    assert(n.scaleY == 1.0f);
-    assert(n.rotationY == 0.0f);
+    assert(n.props().alpha == 1.0f);
+    assert(n.props().windowPosX == FLT_MAX);
+    assert(n.props().windowPosY == FLT_MAX);
+    assert(n.props().scaleX == 1.0f);
+    assert(n.props().scaleY == 1.0f);
+    assert(n.props().rotationY == 0.0f);
 
     std::cout << "PASSED\n";
 }
@@ -1742,19 +1748,19 @@ void test_animation_field_setting() {
     std::cout << "Testing: Animation field setting... ";
 
     auto w = WidgetNode::window("Test", {});
-    w.alpha = 0.5f;
-    w.windowPosX = 100.0f;
-    w.windowPosY = 200.0f;
-    w.scaleX = 0.5f;
-    w.scaleY = 0.75f;
-    w.rotationY = 1.57f;
+    w.propsMut().alpha = 0.5f;
+    w.propsMut().windowPosX = 100.0f;
+    w.propsMut().windowPosY = 200.0f;
+    w.propsMut().scaleX = 0.5f;
+    w.propsMut().scaleY = 0.75f;
+    w.propsMut().rotationY = 1.57f;
 
-    assert(w.alpha == 0.5f);
-    assert(w.windowPosX == 100.0f);
-    assert(w.windowPosY == 200.0f);
-    assert(w.scaleX == 0.5f);
-    assert(w.scaleY == 0.75f);
-    assert(w.rotationY == 1.57f);
+    assert(w.props().alpha == 0.5f);
+    assert(w.props().windowPosX == 100.0f);
+    assert(w.props().windowPosY == 200.0f);
+    assert(w.props().scaleX == 0.5f);
+    assert(w.props().scaleY == 0.75f);
+    assert(w.props().rotationY == 1.57f);
 
     std::cout << "PASSED\n";
 }
@@ -1845,8 +1851,8 @@ void test_image_button_builder() {
     auto node = WidgetNode::imageButton("btn1", TextureHandle{}, 64.0f, 48.0f);
     assert(node.type == WidgetNode::Type::ImageButton);
     assert(node.id == "btn1");
-    assert(node.imageWidth == 64.0f);
-    assert(node.imageHeight == 48.0f);
+    assert(node.props().imageWidth == 64.0f);
+    assert(node.props().imageHeight == 48.0f);
 
     std::cout << "PASSED\n";
 }
@@ -1871,12 +1877,12 @@ void test_plot_lines_builder() {
                                        "avg: 47.5", 0.0f, 100.0f, 200.0f, 40.0f);
     assert(node.type == WidgetNode::Type::PlotLines);
     assert(node.label == "FPS");
-    assert(node.plotValues.size() == 4);
-    assert(node.plotValues[0] == 30.0f);
-    assert(node.plotValues[3] == 55.0f);
-    assert(node.overlayText == "avg: 47.5");
-    assert(node.minFloat == 0.0f);
-    assert(node.maxFloat == 100.0f);
+    assert(node.props().plotValues.size() == 4);
+    assert(node.props().plotValues[0] == 30.0f);
+    assert(node.props().plotValues[3] == 55.0f);
+    assert(node.props().overlayText == "avg: 47.5");
+    assert(node.props().minFloat == 0.0f);
+    assert(node.props().maxFloat == 100.0f);
     assert(node.width == 200.0f);
     assert(node.height == 40.0f);
 
@@ -1889,11 +1895,11 @@ void test_plot_histogram_builder() {
     auto node = WidgetNode::plotHistogram("Scores", {10.0f, 20.0f, 30.0f});
     assert(node.type == WidgetNode::Type::PlotHistogram);
     assert(node.label == "Scores");
-    assert(node.plotValues.size() == 3);
-    assert(node.plotValues[2] == 30.0f);
-    assert(node.overlayText.empty());
-    assert(node.minFloat == FLT_MAX);  // auto-scale
-    assert(node.maxFloat == FLT_MAX);
+    assert(node.props().plotValues.size() == 3);
+    assert(node.props().plotValues[2] == 30.0f);
+    assert(node.props().overlayText.empty());
+    assert(node.props().minFloat == FLT_MAX);  // auto-scale
+    assert(node.props().maxFloat == FLT_MAX);
 
     std::cout << "PASSED\n";
 }
@@ -1912,25 +1918,25 @@ void test_window_size_builder() {
 
     // Default window has zero size (auto)
     auto w1 = WidgetNode::window("Test");
-    assert(w1.windowSizeW == 0.0f);
-    assert(w1.windowSizeH == 0.0f);
+    assert(w1.props().windowSizeW == 0.0f);
+    assert(w1.props().windowSizeH == 0.0f);
 
     // Sized window builder
     auto w2 = WidgetNode::window("Sized", 400.0f, 300.0f,
                                   {WidgetNode::text("Hello")});
     assert(w2.type == WidgetNode::Type::Window);
     assert(w2.label == "Sized");
-    assert(w2.windowSizeW == 400.0f);
-    assert(w2.windowSizeH == 300.0f);
+    assert(w2.props().windowSizeW == 400.0f);
+    assert(w2.props().windowSizeH == 300.0f);
     assert(w2.children.size() == 1);
-    assert(w2.windowFlags == 0);
+    assert(w2.props().windowFlags == 0);
 
     // Sized window with flags
     auto w3 = WidgetNode::window("Flagged", 200.0f, 150.0f, {},
                                   ImGuiWindowFlags_NoResize);
-    assert(w3.windowSizeW == 200.0f);
-    assert(w3.windowSizeH == 150.0f);
-    assert(w3.windowFlags == ImGuiWindowFlags_NoResize);
+    assert(w3.props().windowSizeW == 200.0f);
+    assert(w3.props().windowSizeH == 150.0f);
+    assert(w3.props().windowFlags == ImGuiWindowFlags_NoResize);
 
     std::cout << "PASSED\n";
 }
@@ -1939,14 +1945,14 @@ void test_window_flags_no_nav_no_inputs() {
     std::cout << "Testing: Window flags no_nav, no_inputs... ";
 
     auto w1 = WidgetNode::window("Test", std::vector<WidgetNode>{}, ImGuiWindowFlags_NoNav);
-    assert(w1.windowFlags == ImGuiWindowFlags_NoNav);
+    assert(w1.props().windowFlags == ImGuiWindowFlags_NoNav);
 
     auto w2 = WidgetNode::window("Test", std::vector<WidgetNode>{}, ImGuiWindowFlags_NoInputs);
-    assert(w2.windowFlags == ImGuiWindowFlags_NoInputs);
+    assert(w2.props().windowFlags == ImGuiWindowFlags_NoInputs);
 
     auto w3 = WidgetNode::window("Test", std::vector<WidgetNode>{},
         ImGuiWindowFlags_NoNav | ImGuiWindowFlags_NoInputs);
-    assert(w3.windowFlags == (ImGuiWindowFlags_NoNav | ImGuiWindowFlags_NoInputs));
+    assert(w3.props().windowFlags == (ImGuiWindowFlags_NoNav | ImGuiWindowFlags_NoInputs));
 
     std::cout << "PASSED\n";
 }
@@ -2004,17 +2010,17 @@ void test_canvas_texture_builder() {
     assert(c.id == "##viewport");
     assert(c.width == 512.0f);
     assert(c.height == 512.0f);
-    assert(c.texture.valid());
-    assert(c.texture.id == 42);
-    assert(!c.onDraw);  // no draw callback when using texture
+    assert(c.props().texture.valid());
+    assert(c.props().texture.id == 42);
+    assert(!c.callbacks().onDraw);  // no draw callback when using texture
 
     // With click callback
     bool clicked = false;
     auto c2 = WidgetNode::canvas("##vp2", 320.0f, 240.0f, tex,
         [&clicked](WidgetNode&) { clicked = true; });
-    assert(c2.texture.valid());
-    assert(c2.onClick);
-    c2.onClick(c2);
+    assert(c2.props().texture.valid());
+    assert(c2.callbacks().onClick);
+    c2.callbacks().onClick(c2);
     assert(clicked);
 
     std::cout << "PASSED\n";
@@ -2038,10 +2044,10 @@ void test_easing_boundary_values() {
 
     // Just verify the field defaults are reasonable for animation
     WidgetNode n;
-    n.alpha = 0.0f;
-    assert(n.alpha == 0.0f);
-    n.alpha = 1.0f;
-    assert(n.alpha == 1.0f);
+    n.propsMut().alpha = 0.0f;
+    assert(n.props().alpha == 0.0f);
+    n.propsMut().alpha = 1.0f;
+    assert(n.props().alpha == 1.0f);
 
     std::cout << "PASSED\n";
 }
@@ -2497,6 +2503,37 @@ void test_hide_removes_entry() {
     std::cout << "PASSED\n";
 }
 
+// ============================================================================
+// Headless Tests
+// ============================================================================
+
+void test_headless_render_all() {
+    std::cout << "Testing: renderAll() on a headless GuiSystem... ";
+    GuiSystem gui(GuiConfig{});
+    gui.initializeHeadless();
+    GuiRenderer renderer(gui);
+
+    auto tree = WidgetNode::window("Settings", 400.0f, 300.0f);
+    tree.children.push_back(WidgetNode::text("Hello"));
+    tree.children.push_back(WidgetNode::button("Apply"));
+    tree.children.push_back(WidgetNode::checkbox("Enabled", true));
+    tree.children.push_back(WidgetNode::slider("Volume", 0.5f, 0.0f, 1.0f));
+    renderer.show(std::move(tree));
+
+    for (int frame = 0; frame < 3; frame++) {
+        gui.beginFrame(1.0f / 60.0f);
+        renderer.renderAll();
+        gui.endFrame();
+    }
+
+    HeadlessStats stats = gui.headlessStats();
+    assert(stats.frames == 3);
+    assert(stats.drawLists >= 1);
+    assert(stats.vertices > 0);
+    assert(stats.drawCalls > 0);
+    std::cout << "PASSED\n";
+}
+
 // ============================================================================
 // Format String & History Callback Tests
 // ============================================================================
@@ -2505,10 +2542,10 @@ void test_format_string_default_empty() {
     std::cout << "Testing: WidgetNode formatString default empty... ";
 
     auto slider = WidgetNode::slider("Vol", 0.5f, 0.0f, 1.0f);
-    assert(slider.formatString.empty());
+    assert(slider.props().formatString.empty());
 
     auto drag = WidgetNode::dragFloat("Speed", 1.0f);
-    assert(drag.formatString.empty());
+    assert(drag.props().formatString.empty());
 
     std::cout << "PASSED\n";
 }
@@ -2517,16 +2554,16 @@ void test_format_string_field() {
     std::cout << "Testing: WidgetNode formatString field assignment... ";
 
     auto slider = WidgetNode::slider("FOV", 90.0f, 0.0f, 180.0f);
-    slider.formatString = "%.0f";
-    assert(slider.formatString == "%.0f");
+    slider.propsMut().formatString = "%.0f";
+    assert(slider.props().formatString == "%.0f");
 
     auto sliderInt = WidgetNode::sliderInt("Count", 50, 0, 100);
-    sliderInt.formatString = "%d items";
-    assert(sliderInt.formatString == "%d items");
+    sliderInt.propsMut().formatString = "%d items";
+    assert(sliderInt.props().formatString == "%d items");
 
     auto drag = WidgetNode::dragFloat("Speed", 1.0f, 0.1f, 0.0f, 10.0f);
-    drag.formatString = "%.2f";
-    assert(drag.formatString == "%.2f");
+    drag.propsMut().formatString = "%.2f";
+    assert(drag.props().formatString == "%.2f");
 
     std::cout << "PASSED\n";
 }
@@ -2538,25 +2575,25 @@ void test_on_history_callback() {
     bool historyCalled = false;
     int historyDir = 0;
 
-    input.onHistory = [&](WidgetNode& node) {
+    input.callbacksMut().onHistory = [&](WidgetNode& node) {
         historyCalled = true;
         historyDir = node.intValue;
-        node.stringValue = "previous_command";
+        node.propsMut().stringValue = "previous_command";
     };
 
-    assert(input.onHistory != nullptr);
+    assert(input.callbacks().onHistory != nullptr);
 
     // Simulate up arrow
     input.intValue = -1;
-    input.onHistory(input);
+    input.callbacks().onHistory(input);
     assert(historyCalled);
     assert(historyDir == -1);
-    assert(input.stringValue == "previous_command");
+    assert(input.props().stringValue == "previous_command");
 
     // Simulate down arrow
     historyCalled = false;
     input.intValue = 1;
-    input.onHistory(input);
+    input.callbacks().onHistory(input);
     assert(historyCalled);
     assert(historyDir == 1);
 
@@ -2568,18 +2605,516 @@ void test_window_pivot_fields() {
 
     // Default pivot is (0, 0)
     auto win = WidgetNode::window("Test");
-    assert(win.windowPivotX == 0.0f);
-    assert(win.windowPivotY == 0.0f);
+    assert(win.props().windowPivotX == 0.0f);
+    assert(win.props().windowPivotY == 0.0f);
 
     // Set pivot to center (0.5, 0.5)
-    win.windowPivotX = 0.5f;
-    win.windowPivotY = 0.5f;
-    assert(win.windowPivotX == 0.5f);
-    assert(win.windowPivotY == 0.5f);
+    win.propsMut().windowPivotX = 0.5f;
+    win.propsMut().windowPivotY = 0.5f;
+    assert(win.props().windowPivotX == 0.5f);
+    assert(win.props().windowPivotY == 0.5f);
+
+    std::cout << "PASSED\n";
+}
+
+// ============================================================================
+// Node Footprint Tests
+// ============================================================================
+
+void test_side_storage_on_demand() {
+    std::cout << "Testing: WidgetNode side storage allocated on demand... ";
+
+    // Plain nodes carry no side storage
+    auto text = WidgetNode::text("Hello");
+    auto sep = WidgetNode::separator();
+    auto btn = WidgetNode::button("OK");
+    auto grp = WidgetNode::group({WidgetNode::text("a")});
+    assert(!text.hasProps() && !text.hasCallbacks());
+    assert(!sep.hasProps() && !sep.hasCallbacks());
+    assert(!btn.hasProps() && !btn.hasCallbacks());
+    assert(!grp.hasProps() && !grp.hasCallbacks());
+
+    // Reads see defaults without allocating
+    assert(text.props().maxFloat == 1.0f);
+    assert(text.props().windowPosX == FLT_MAX);
+    assert(text.props().dragType.empty());
+    assert(!text.callbacks().onClick);
+    assert(!text.hasProps() && !text.hasCallbacks());
+
+    // Builders allocate only what they set
+    auto clickable = WidgetNode::button("Go", [](WidgetNode&) {});
+    assert(clickable.hasCallbacks() && !clickable.hasProps());
+    auto slider = WidgetNode::slider("Vol", 0.5f, 0.0f, 2.0f);
+    assert(slider.hasProps() && !slider.hasCallbacks());
+    assert(slider.props().maxFloat == 2.0f);
+
+    // First write allocates
+    text.propsMut().dragType = "item";
+    assert(text.hasProps());
+    assert(text.props().dragType == "item");
+
+    // Copies are deep
+    WidgetNode copy = slider;
+    copy.propsMut().maxFloat = 5.0f;
+    assert(slider.props().maxFloat == 2.0f);
+    assert(copy.props().maxFloat == 5.0f);
+
+    copy = btn;
+    assert(!copy.hasProps());
+
+    std::cout << "PASSED\n";
+}
+
+// Field-for-field copy of the WidgetNode layout before the hot/cold split,
+// kept to report how much the split saves
+struct FlatWidgetNode {
+    int type;
+    std::string label, textContent, id;
+    float floatValue; int intValue; bool boolValue;
+    std::string stringValue;
+    int selectedIndex;
+    float minFloat, maxFloat; int minInt, maxInt;
+    float width, height; int columnCount;
+    std::vector<std::string> items;
+    std::vector<WidgetNode> children;
+    bool visible, enabled;
+    WidgetCallback onClick, onChange, onSubmit, onClose, onHistory;
+    TextureHandle texture; float imageWidth, imageHeight;
+    float colorR, colorG, colorB, colorA;
+    std::string overlayText;
+    float offsetX, alpha, windowPosX, windowPosY, scaleX, scaleY, rotationY;
+    bool defaultOpen, border, autoScroll, leaf;
+    std::string shortcutText;
+    bool checked; int tableFlags, windowFlags;
+    float windowSizeW, windowSizeH, windowPivotX, windowPivotY, dragSpeed;
+    std::string formatString;
+    float floatX, floatY, floatZ;
+    std::string hintText;
+    std::vector<float> plotValues;
+    int heightInItems;
+    WidgetCallback onDraw;
+    std::string dragType, dragData, dropAcceptType;
+    WidgetCallback onDrop, onDragBegin;
+    int dragMode; bool focusable, autoFocus;
+    WidgetCallback onFocus, onBlur;
+};
+
+// Bytes held by a tree's nodes and side storage (string and vector
+// contents excluded, they are the same either way)
+static size_t treeBytes(const WidgetNode& node, size_t& nodeCount) {
+    size_t bytes = sizeof(WidgetNode);
+    if (node.hasProps()) bytes += sizeof(WidgetNode::Props);
+    if (node.hasCallbacks()) bytes += sizeof(WidgetNode::Callbacks);
+    nodeCount++;
+    for (const auto& child : node.children) {
+        bytes += treeBytes(child, nodeCount);
+    }
+    return bytes;
+}
+
+// An inventory-style window: a few controls over a long table
+static WidgetNode buildInventory(int rowCount) {
+    WidgetList rows;
+    for (int i = 0; i < rowCount; i++) {
+        rows.push_back(WidgetNode::tableRow({
+            WidgetNode::text("Item " + std::to_string(i)),
+            WidgetNode::tableNextColumn(),
+            WidgetNode::text(std::to_string(i * 10)),
+            WidgetNode::tableNextColumn(),
+            WidgetNode::button("Use", [](WidgetNode&) {}),
+        }));
+    }
+    return WidgetNode::window("Inventory", {
+        WidgetNode::inputText("Filter", ""),
+        WidgetNode::checkbox("Show empty", false),
+        WidgetNode::separator(),
+        WidgetNode::table("items", 3, {"Name", "Value", ""}, std::move(rows)),
+    });
+}
+
+void test_widget_node_footprint() {
+    std::cout << "Testing: WidgetNode hot/cold footprint... ";
+
+    // An inventory-style window: a few controls over a long table
+    std::vector<WidgetNode> rows;
+    for (int i = 0; i < 500; i++) {
+        rows.push_back(WidgetNode::tableRow({
+            WidgetNode::text("Item " + std::to_string(i)),
+            WidgetNode::tableNextColumn(),
+            WidgetNode::text(std::to_string(i * 10)),
+            WidgetNode::tableNextColumn(),
+            WidgetNode::button("Use", [](WidgetNode&) {}),
+        }));
+    }
+    auto tree = WidgetNode::window("Inventory", {
+        WidgetNode::inputText("Filter", ""),
+        WidgetNode::checkbox("Show empty", false),
+        WidgetNode::separator(),
+        WidgetNode::table("items", 3, {"Name", "Value", ""}, std::move(rows)),
+    });
+
+    size_t nodes = 0;
+    size_t after = treeBytes(tree, nodes);
+    size_t before = nodes * sizeof(FlatWidgetNode);
+
+    std::cout << "\n    sizeof(WidgetNode): " << sizeof(FlatWidgetNode)
+              << " -> " << sizeof(WidgetNode)
+              << " (Props " << sizeof(WidgetNode::Props)
+              << ", Callbacks " << sizeof(WidgetNode::Callbacks) << ")\n"
+              << "    " << nodes << "-node tree: " << before << " -> " << after
+              << " bytes... ";
+
+    assert(sizeof(WidgetNode) * 2 < sizeof(FlatWidgetNode));
+    assert(after * 2 < before);
+
+    std::cout << "PASSED\n";
+}
+
+// ============================================================================
+// Widget Arena Tests
+// ============================================================================
+
+void test_widget_arena() {
+    std::cout << "Testing: WidgetArena tree storage... ";
+
+    WidgetArena arena(4096);
+    assert(WidgetArena::current() == nullptr);
+
+    WidgetNode tree;
+    {
+        WidgetArena::Scope scope(arena);
+        assert(WidgetArena::current() == &arena);
+        tree = buildInventory(50);
+    }
+    assert(WidgetArena::current() == nullptr);
+    assert(arena.liveBlocks() > 0);
+    assert(arena.bytesUsed() > 0 && arena.bytesUsed() <= arena.bytesReserved());
+    assert(tree.children[3].children.size() == 50);
+    assert(tree.children[3].children[7].children[0].textContent == "Item 7");
+    assert(tree.children[3].children[7].children[4].callbacks().onClick);
+
+    // Copies made outside a scope go to the heap
+    size_t live = arena.liveBlocks();
+    WidgetNode copy = tree;
+    assert(arena.liveBlocks() == live);
+
+    // Growing an arena list outside the scope moves it to the heap
+    auto& rows = tree.children[3].children;
+    rows.reserve(rows.capacity() + 1);
+    assert(arena.liveBlocks() == live - 1);
+
+    // Can't rewind while nodes still use the arena
+    bool threw = false;
+    try {
+        arena.reset();
+    } catch (const std::runtime_error&) {
+        threw = true;
+    }
+    assert(threw);
+
+    // Destroying the tree frees nothing, then reset() takes it all back
+    tree = WidgetNode{};
+    assert(arena.liveBlocks() == 0);
+    size_t reserved = arena.bytesReserved();
+    arena.reset();
+    assert(arena.bytesUsed() == 0);
+    assert(arena.bytesReserved() == reserved);
+
+    // The next tree reuses the chunks
+    {
+        WidgetArena::Scope scope(arena);
+        tree = buildInventory(50);
+    }
+    assert(arena.bytesReserved() == reserved);
+    assert(copy.children[3].children[7].children[0].textContent == "Item 7");
+
+    // Scopes nest
+    WidgetArena inner;
+    {
+        WidgetArena::Scope outerScope(arena);
+        {
+            WidgetArena::Scope innerScope(inner);
+            assert(WidgetArena::current() == &inner);
+        }
+        assert(WidgetArena::current() == &arena);
+    }
+    assert(WidgetArena::current() == nullptr);
+
+    tree = WidgetNode{};
+    arena.reset();
+
+    // Destroying an arena leaves its storage to the nodes still using it
+    auto scratch = std::make_unique<WidgetArena>(4096);
+    {
+        WidgetArena::Scope scope(*scratch);
+        tree = buildInventory(50);
+    }
+    scratch.reset();
+    assert(tree.children[3].children[7].children[0].textContent == "Item 7");
+    assert(tree.children[3].children[7].children[4].callbacks().onClick);
+    tree.children[3].children.push_back(WidgetNode::tableRow({}));
+    tree = WidgetNode{};
+
+    std::cout << "PASSED\n";
+}
+
+void test_widget_arena_benchmark() {
+    std::cout << "Testing: WidgetArena vs heap build/teardown... ";
+
+    using Clock = std::chrono::steady_clock;
+    constexpr int kIterations = 20;
+    constexpr int kRows = 500;
+
+    auto micros = [](Clock::duration d) {
+        return std::chrono::duration<double, std::micro>(d).count() / kIterations;
+    };
+
+    // Heap: every child list and side storage block is its own allocation
+    Clock::duration heapBuild{}, heapTeardown{};
+    size_t heapNodes = 0;
+    for (int i = 0; i < kIterations; i++) {
+        auto t0 = Clock::now();
+        WidgetNode tree = buildInventory(kRows);
+        auto t1 = Clock::now();
+        heapNodes = tree.children[3].children.size();
+        tree = WidgetNode{};
+        auto t2 = Clock::now();
+        heapBuild += t1 - t0;
+        heapTeardown += t2 - t1;
+    }
+
+    // Arena: the same tree, released with one reset() (as updateInArena does)
+    WidgetArena arena;
+    Clock::duration arenaBuild{}, arenaTeardown{};
+    size_t arenaNodes = 0;
+    for (int i = 0; i < kIterations; i++) {
+        auto t0 = Clock::now();
+        WidgetNode tree;
+        {
+            WidgetArena::Scope scope(arena);
+            tree = buildInventory(kRows);
+        }
+        auto t1 = Clock::now();
+        arenaNodes = tree.children[3].children.size();
+        tree = WidgetNode{};
+        arena.reset();
+        auto t2 = Clock::now();
+        arenaBuild += t1 - t0;
+        arenaTeardown += t2 - t1;
+    }
+
+    assert(heapNodes == static_cast<size_t>(kRows));
+    assert(arenaNodes == heapNodes);
+    assert(arena.liveBlocks() == 0);
+
+    std::cout << "\n    " << kRows << "-row inventory, build / teardown (us):"
+              << " heap " << static_cast<int>(micros(heapBuild))
+              << " / " << static_cast<int>(micros(heapTeardown))
+              << ", arena " << static_cast<int>(micros(arenaBuild))
+              << " / " << static_cast<int>(micros(arenaTeardown))
+              << " (" << arena.bytesReserved() / 1024 << " KB reserved)... ";
 
     std::cout << "PASSED\n";
 }
 
+// ============================================================================
+// Virtual list tests
+// ============================================================================
+
+void test_virtual_list_builder() {
+    std::cout << "Testing: virtualList builder... ";
+
+    std::vector<int> requested;
+    int selected = -2;
+    auto node = WidgetNode::virtualList("##log", 1000000,
+        [&](int row) {
+            requested.push_back(row);
+            return WidgetNode::text("Line " + std::to_string(row));
+        },
+        200.0f,
+        [&](WidgetNode& w) { selected = w.selectedIndex; });
+
+    assert(node.type == WidgetNode::Type::VirtualList);
+    assert(node.id == "##log");
+    assert(node.height == 200.0f);
+    assert(node.props().rowCount == 1000000);
+    assert(node.props().rowSelection);
+    assert(node.selectedIndex == -1);
+    assert(node.children.empty());
+
+    // Building the node asks for no rows; rows come one index at a time
+    assert(requested.empty());
+    WidgetNode row = node.callbacks().rowProvider(999999);
+    assert(requested.size() == 1 && requested[0] == 999999);
+    assert(row.textContent == "Line 999999");
+
+    // Selection is by index
+    node.selectedIndex = 42;
+    node.callbacks().onChange(node);
+    assert(selected == 42);
+
+    // No onSelect, no row selection
+    auto plain = WidgetNode::virtualList("##plain", 10, [](int) { return WidgetNode::separator(); });
+    assert(!plain.props().rowSelection);
+    assert(!plain.callbacks().onChange);
+
+    assert(std::string(widgetTypeName(WidgetNode::Type::VirtualList)) == "VirtualList");
+
+    std::cout << "PASSED\n";
+}
+
+void test_virtual_table_builder() {
+    std::cout << "Testing: virtualTable builder... ";
+
+    // Sorting reorders an index permutation, never the rows themselves
+    std::vector<int> prices = {30, 10, 20};
+    std::vector<int> order = {0, 1, 2};
+    auto node = WidgetNode::virtualTable("##auctions", 2, {"Item", "Price"},
+        static_cast<int>(prices.size()),
+        [&](int row) {
+            int i = order[static_cast<size_t>(row)];
+            return WidgetNode::tableRow({
+                WidgetNode::text("Item " + std::to_string(i)),
+                WidgetNode::text(std::to_string(prices[static_cast<size_t>(i)])),
+            });
+        },
+        0, {},
+        [&](WidgetNode& w) {
+            bool asc = w.props().sortAscending;
+            std::sort(order.begin(), order.end(), [&](int a, int b) {
+                return asc ? prices[a] < prices[b] : prices[a] > prices[b];
+            });
+        });
+
+    assert(node.type == WidgetNode::Type::VirtualTable);
+    assert(node.props().columnCount == 2);
+    assert(node.props().items.size() == 2);
+    assert(node.props().items[1] == "Price");
+    assert(node.props().rowCount == 3);
+    assert(node.props().sortColumn == -1);
+    assert(!node.props().rowSelection);
+    assert(node.callbacks().onSort);
+
+    node.propsMut().sortColumn = 1;
+    node.propsMut().sortAscending = false;
+    node.callbacks().onSort(node);
+    WidgetNode top = node.callbacks().rowProvider(0);
+    assert(top.type == WidgetNode::Type::TableRow);
+    assert(top.children.size() == 2);
+    assert(top.children[1].textContent == "30");
+
+    assert(std::string(widgetTypeName(WidgetNode::Type::VirtualTable)) == "VirtualTable");
+
+    std::cout << "PASSED\n";
+}
+
+// ============================================================================
+// Reconciliation tests
+// ============================================================================
+
+static WidgetNode buildScoreboard(const std::vector<std::pair<std::string, int>>& players) {
+    WidgetList rows;
+    for (const auto& [name, score] : players) {
+        auto row = WidgetNode::tableRow({
+            WidgetNode::text(name),
+            WidgetNode::text(std::to_string(score)),
+        });
+        row.id = name;
+        rows.push_back(std::move(row));
+    }
+    return WidgetNode::window("Scores", {
+        WidgetNode::text("Round 1"),
+        WidgetNode::table("##scores", 2, {"Player", "Score"}, std::move(rows)),
+    });
+}
+
+void test_reconcile_patches_in_place() {
+    std::cout << "Testing: reconcile() patches changed fields in place... ";
+
+    auto live = buildScoreboard({{"ann", 10}, {"bob", 20}, {"cid", 30}});
+    WidgetNode* table = &live.children[1];
+    WidgetNode* bobScore = &table->children[1].children[1];
+
+    // Identical tree: nothing touched
+    assert(live.reconcile(buildScoreboard({{"ann", 10}, {"bob", 20}, {"cid", 30}})) == 0);
+
+    // One score changes: one node touched, nothing moves
+    assert(live.reconcile(buildScoreboard({{"ann", 10}, {"bob", 25}, {"cid", 30}})) == 1);
+    assert(&live.children[1] == table);
+    assert(&table->children[1].children[1] == bobScore);
+    assert(bobScore->textContent == "25");
+
+    // Props and callbacks come from the new tree
+    int clicks = 0;
+    auto next = buildScoreboard({{"ann", 10}, {"bob", 25}, {"cid", 30}});
+    next.children[1].propsMut().tableFlags = 4;
+    next.children[0].callbacksMut().onClick = [&](WidgetNode&) { clicks++; };
+    assert(live.reconcile(std::move(next)) == 1);
+    assert(live.children[1].props().tableFlags == 4);
+    live.children[0].callbacks().onClick(live.children[0]);
+    assert(clicks == 1);
+
+    // A different root type is a full replacement
+    WidgetNode root = WidgetNode::group({WidgetNode::text("a")});
+    assert(root.reconcile(WidgetNode::text("b")) == 3);
+    assert(root.type == WidgetNode::Type::Text && root.textContent == "b");
+    assert(root.children.empty());
+
+    std::cout << "PASSED\n";
+}
+
+void test_reconcile_keyed_children() {
+    std::cout << "Testing: reconcile() matches children by id, then position... ";
+
+    auto live = buildScoreboard({{"ann", 10}, {"bob", 20}, {"cid", 30}});
+    assert(live.subtreeSize() == 1 + 1 + 1 + 3 * 3);
+
+    // Reorder, drop bob, add dan: kept rows are only patched where changed
+    size_t touched = live.reconcile(buildScoreboard({{"cid", 31}, {"ann", 10}, {"dan", 5}}));
+    // cid's score (1) + dan's row (3) + bob's row (3)
+    assert(touched == 7);
+    const auto& rows = live.children[1].children;
+    assert(rows.size() == 3);
+    assert(rows[0].id == "cid" && rows[0].children[1].textContent == "31");
+    assert(rows[1].id == "ann" && rows[1].children[0].textContent == "ann");
+    assert(rows[2].id == "dan" && rows[2].children[1].textContent == "5");
+
+    // Children without an id match by position; a type change replaces
+    WidgetNode group = WidgetNode::group({WidgetNode::text("a"), WidgetNode::button("b")});
+    touched = group.reconcile(WidgetNode::group({
+        WidgetNode::text("a"), WidgetNode::checkbox("b", true), WidgetNode::separator(),
+    }));
+    // button removed + checkbox added + separator added
+    assert(touched == 3);
+    assert(group.children.size() == 3);
+    assert(group.children[1].type == WidgetNode::Type::Checkbox);
+    assert(group.children[1].boolValue);
+
+    std::cout << "PASSED\n";
+}
+
+void test_renderer_reconcile() {
+    std::cout << "Testing: GuiRenderer::reconcile() keeps warmup and nodes... ";
+    GuiRenderer renderer(dummyGuiSystem());
+    int id = renderer.show(buildScoreboard({{"ann", 10}, {"bob", 20}}), /*immediate=*/true);
+    assert(!renderer.isWarmingUp(id));
+    WidgetNode* row = renderer.findById("bob");
+
+    // An auto-sized window would get its warmup frame again from update()
+    assert(renderer.reconcile(id, buildScoreboard({{"ann", 10}, {"bob", 21}})) == 1);
+    assert(!renderer.isWarmingUp(id));
+    assert(renderer.findById("bob") == row);
+    assert(row->children[1].textContent == "21");
+
+    // Staged trees stay staged
+    int staged = renderer.stage(buildScoreboard({{"ann", 1}}));
+    renderer.reconcile(staged, buildScoreboard({{"ann", 2}}));
+    assert(renderer.isStaged(staged));
+
+    assert(renderer.reconcile(9999, WidgetNode::text("x")) == 0);
+    std::cout << "PASSED\n";
+}
+
 // ============================================================================
 // Main
 // ============================================================================
@@ -2784,6 +3319,7 @@ int main() {
         test_update_through_entry();
         test_find_by_id_through_entry();
         test_hide_removes_entry();
+        test_headless_render_all();
 
         // Format string & history callback
         test_format_string_default_empty();
@@ -2793,6 +3329,23 @@ int main() {
         // Window pivot
         test_window_pivot_fields();
 
+        // Node footprint
+        test_side_storage_on_demand();
+        test_widget_node_footprint();
+
+        // Widget arena
+        test_widget_arena();
+        test_widget_arena_benchmark();
+
+        // Virtual lists
+        test_virtual_list_builder();
+        test_virtual_table_builder();
+
+        // Reconciliation
+        test_reconcile_patches_in_place();
+        test_reconcile_keyed_children();
+        test_renderer_reconcile();
+
         std::cout << "\n=== All retained-mode unit tests PASSED ===\n";
     } catch (const std::exception& e) {
         std::cerr << "\nTest FAILED with exception: " << e.what() << "\n";
@@ -21,6 +21,7 @@
 
 #include <iostream>
 #include <cassert>
+#include <string>
 
 using namespace finegui;
 
@@ -1240,6 +1241,149 @@ void test_script_rendering() {
     }
     std::cout << "ok";
 
+    // --- Test 29: List clipping for long child / table contents ---
+    std::cout << "\n  29. Script list clipping (2000-row child, table)... ";
+    {
+        using finescript::Value;
+        const auto& syms = mapRenderer.syms();
+        constexpr int kRows = 2000;
+
+        ScriptGui scriptGui(engine, mapRenderer);
+        bool ok = scriptGui.loadAndRun(R"(
+            set far_focused false
+            set on_far_focus fn [] do
+                set far_focused true
+            end
+        )", "test29");
+        assert(ok);
+        auto onFocus = engine.executeCommand("on_far_focus", *scriptGui.context());
+        assert(onFocus.success && onFocus.returnValue.isCallable());
+
+        auto widget = [&](uint32_t type, uint32_t key, std::string text) {
+            auto m = Value::map();
+            m.asMap().set(syms.type, Value::symbol(type));
+            m.asMap().set(key, Value::string(std::move(text)));
+            return m;
+        };
+
+        auto logRows = Value::array({});
+        auto tableRows = Value::array({});
+        for (int i = 0; i < kRows; i++) {
+            auto line = widget(syms.sym_selectable, syms.label, "Log line " + std::to_string(i));
+            if (i == 1500) {
+                line.asMap().set(syms.id, Value::string("far_row"));
+                line.asMap().set(syms.on_focus, onFocus.returnValue);
+            }
+            logRows.asArrayMut().push_back(std::move(line));
+
+            auto row = Value::map();
+            row.asMap().set(syms.type, Value::symbol(syms.sym_table_row));
+            row.asMap().set(syms.children, Value::array({
+                widget(syms.sym_text, syms.text, "Item " + std::to_string(i)),
+                widget(syms.sym_text, syms.text, std::to_string(i * 10)),
+            }));
+            tableRows.asArrayMut().push_back(std::move(row));
+        }
+
+        auto child = Value::map();
+        child.asMap().set(syms.type, Value::symbol(syms.sym_child));
+        child.asMap().set(syms.id, Value::string("##log"));
+        child.asMap().set(syms.size, Value::array({Value::number(0.0), Value::number(150.0)}));
+        child.asMap().set(syms.children, logRows);
+
+        auto table = Value::map();
+        table.asMap().set(syms.type, Value::symbol(syms.sym_table));
+        table.asMap().set(syms.id, Value::string("##items"));
+        table.asMap().set(syms.num_columns, Value::integer(2));
+        table.asMap().set(syms.children, tableRows);
+
+        auto win = Value::map();
+        win.asMap().set(syms.type, Value::symbol(syms.sym_window));
+        win.asMap().set(syms.title, Value::string("Clipped"));
+        win.asMap().set(syms.window_size_w, Value::number(600.0));
+        win.asMap().set(syms.window_size_h, Value::number(500.0));
+        win.asMap().set(syms.children, Value::array({child, table}));
+
+        auto showResult = scriptGui.scriptShow(win);
+        assert(showResult.isInt());
+        runFrames(window.get(), renderer.get(), gui, guiRenderer, mapRenderer, nullptr, 3);
+
+        // Only the rows in view are drawn
+        ImDrawData* drawData = ImGui::GetDrawData();
+        assert(drawData != nullptr);
+        assert(drawData->TotalVtxCount < 30000);
+
+        // A clipped-away row still takes programmatic focus
+        mapRenderer.setFocus("far_row");
+        runFrames(window.get(), renderer.get(), gui, guiRenderer, mapRenderer, nullptr, 3);
+        auto focused = engine.executeCommand("far_focused", *scriptGui.context());
+        assert(focused.success && focused.returnValue.isBool() && focused.returnValue.asBool());
+
+        // Rows edited in place: a wrapped cell turns clipping off, restoring
+        // the row turns it back on (both are picked up without a new array)
+        auto rows = table.asMap().get(syms.children);
+        auto cell = rows.asArrayMut()[2].asMap().get(syms.children).asArrayMut()[0];
+        cell.asMap().set(syms.type, Value::symbol(syms.sym_text_wrapped));
+        runFrames(window.get(), renderer.get(), gui, guiRenderer, mapRenderer, nullptr, 2);
+        cell.asMap().set(syms.type, Value::symbol(syms.sym_text));
+        runFrames(window.get(), renderer.get(), gui, guiRenderer, mapRenderer, nullptr, 2);
+        drawData = ImGui::GetDrawData();
+        assert(drawData != nullptr);
+        assert(drawData->TotalVtxCount < 30000);
+
+        scriptGui.close();
+    }
+    std::cout << "ok";
+
+    // --- Test 30: Virtual list and table over a million rows ---
+    std::cout << "\n  30. Script virtual list and table (1,000,000 rows)... ";
+    {
+        ScriptGui scriptGui(engine, mapRenderer);
+        bool ok = scriptGui.loadAndRun(R"(
+            set rows_built 0
+            set win {ui.window "Virtual" [
+                {ui.virtual_list "##chat" 1000000 fn [i] do
+                    set rows_built (rows_built + 1)
+                    {ui.text ("Message " + {to_str i})}
+                end =height 150}
+                {ui.virtual_table "##auctions" 3 1000000 fn [i] do
+                    set rows_built (rows_built + 1)
+                    {ui.table_row [
+                        {ui.text ("Item " + {to_str i})}
+                        {ui.text {to_str i}}
+                        {ui.text "-"}
+                    ]}
+                end =headers ["Item" "Qty" "Price"]}
+            ]}
+            set win.window_size_w 600
+            set win.window_size_h 500
+            ui.show win
+        )", "test30");
+        assert(ok);
+
+        auto rowsBuilt = [&]() {
+            auto result = engine.executeCommand("rows_built", *scriptGui.context());
+            assert(result.success && result.returnValue.isNumeric());
+            return static_cast<int>(result.returnValue.asNumber());
+        };
+
+        // Per-frame row_fn calls are bounded by what fits on screen, not by
+        // the row count
+        runFrames(window.get(), renderer.get(), gui, guiRenderer, mapRenderer, nullptr, 3);
+        int before = rowsBuilt();
+        assert(before > 0);
+        runFrames(window.get(), renderer.get(), gui, guiRenderer, mapRenderer, nullptr, 1);
+        int perFrame = rowsBuilt() - before;
+        assert(perFrame > 0 && perFrame < 200);
+
+        ImDrawData* drawData = ImGui::GetDrawData();
+        assert(drawData != nullptr);
+        assert(drawData->TotalVtxCount < 30000);
+
+        scriptGui.close();
+    }
+    std::cout << "ok";
+
     renderer->waitIdle();
     std::cout << "\nPASSED\n";
 
@@ -7,19 +7,23 @@
  * - Widget value extraction: WidgetNode → script Value
  * - Script bindings: ui.* functions produce correct maps
  * - ConverterSymbols interning
+ * - Session log encoding of script messages
  */
 
 #include <finegui/widget_converter.hpp>
 #include <finegui/script_bindings.hpp>
 #include <finegui/map_renderer.hpp>
 #include <finegui/widget_node.hpp>
+#include <finegui/script_session.hpp>
 #include <finescript/script_engine.h>
 #include <finescript/execution_context.h>
 #include <finescript/map_data.h>
 
 #include <iostream>
 #include <cassert>
+#include <stdexcept>
 #include <string>
+#include <vector>
 
 using namespace finegui;
 using namespace finescript;
@@ -107,8 +111,8 @@ void test_convert_slider() {
     auto node = convertToWidget(map, engine, ctx, syms);
     assert(node.type == WidgetNode::Type::Slider);
     assert(node.label == "Volume");
-    assert(node.minFloat == 0.0f);
-    assert(node.maxFloat == 1.0f);
+    assert(node.props().minFloat == 0.0f);
+    assert(node.props().maxFloat == 1.0f);
     assert(node.floatValue == 0.5f);
 
     std::cout << "PASSED\n";
@@ -194,9 +198,9 @@ void test_convert_combo() {
     auto node = convertToWidget(map, engine, ctx, syms);
     assert(node.type == WidgetNode::Type::Combo);
     assert(node.label == "Resolution");
-    assert(node.items.size() == 2);
-    assert(node.items[0] == "1920x1080");
-    assert(node.items[1] == "2560x1440");
+    assert(node.props().items.size() == 2);
+    assert(node.props().items[0] == "1920x1080");
+    assert(node.props().items[1] == "2560x1440");
     assert(node.selectedIndex == 1);
 
     std::cout << "PASSED\n";
@@ -228,10 +232,10 @@ void test_convert_with_callback() {
 
     auto node = convertToWidget(map, engine, ctx, syms);
     assert(node.type == WidgetNode::Type::Button);
-    assert(node.onClick);
+    assert(node.callbacks().onClick);
 
     // Invoke the callback
-    node.onClick(node);
+    node.callbacks().onClick(node);
 
     // Verify the script closure executed
     auto clickedVal = ctx.get("clicked");
@@ -293,7 +297,7 @@ void test_value_extraction() {
 
     WidgetNode inputText;
     inputText.type = WidgetNode::Type::InputText;
-    inputText.stringValue = "hello";
+    inputText.propsMut().stringValue = "hello";
     auto v4 = widgetValueToScriptValue(inputText);
     assert(v4.isString());
     assert(v4.asString() == "hello");
@@ -1443,10 +1447,10 @@ void test_dnd_convert_to_widget() {
 
     auto node = convertToWidget(w, engine, ctx, syms);
     assert(node.type == WidgetNode::Type::Button);
-    assert(node.dragType == "item");
-    assert(node.dragData == "sword_01");
-    assert(node.dropAcceptType == "item");
-    assert(node.dragMode == 1);
+    assert(node.props().dragType == "item");
+    assert(node.props().dragData == "sword_01");
+    assert(node.props().dropAcceptType == "item");
+    assert(node.props().dragMode == 1);
 
     std::cout << "PASSED\n";
 }
@@ -1680,14 +1684,14 @@ void test_convert_focus_callbacks() {
 
     auto node = convertToWidget(map, engine, ctx, syms);
     assert(node.type == WidgetNode::Type::InputText);
-    assert(node.onFocus);
-    assert(node.onBlur);
+    assert(node.callbacks().onFocus);
+    assert(node.callbacks().onBlur);
 
     // Invoke and verify
-    node.onFocus(node);
+    node.callbacks().onFocus(node);
     assert(ctx.get("focus_fired").asBool() == true);
 
-    node.onBlur(node);
+    node.callbacks().onBlur(node);
     assert(ctx.get("blur_fired").asBool() == true);
 
     std::cout << "PASSED\n";
@@ -2758,7 +2762,7 @@ void test_converter_reads_format() {
 
     auto node = convertToWidget(result.returnValue, engine, ctx, syms);
     assert(node.type == WidgetNode::Type::Slider);
-    assert(node.formatString == "%.1f");
+    assert(node.props().formatString == "%.1f");
 
     std::cout << "PASSED\n";
 }
@@ -2818,12 +2822,12 @@ void test_converter_reads_on_history() {
 
     auto node = convertToWidget(map, engine, ctx, syms);
     assert(node.type == WidgetNode::Type::InputText);
-    assert(node.onHistory != nullptr);
+    assert(node.callbacks().onHistory != nullptr);
 
     // Test that calling onHistory with direction updates stringValue
     node.intValue = -1;  // up arrow
-    node.onHistory(node);
-    assert(node.stringValue == "history");
+    node.callbacks().onHistory(node);
+    assert(node.props().stringValue == "history");
 
     std::cout << "PASSED\n";
 }
@@ -2872,8 +2876,8 @@ void test_converter_reads_window_pivot() {
 
     auto node = convertToWidget(map, engine, ctx, syms);
     assert(node.type == WidgetNode::Type::Window);
-    assert(node.windowPivotX == 0.5f);
-    assert(node.windowPivotY == 0.5f);
+    assert(node.props().windowPivotX == 0.5f);
+    assert(node.props().windowPivotY == 0.5f);
 
     std::cout << "PASSED\n";
 }
@@ -2900,6 +2904,154 @@ void test_window_pivot_kwarg() {
     std::cout << "PASSED\n";
 }
 
+// ============================================================================
+// Session Recording Tests
+// ============================================================================
+
+void test_script_message_session_encoding() {
+    std::cout << "Testing: Script message session encoding... ";
+
+    ScriptEngine recordEngine;
+    auto data = Value::map();
+    data.asMap().set(recordEngine.intern("hp"), Value::integer(-42));
+    data.asMap().set(recordEngine.intern("ratio"), Value::number(0.25));
+    data.asMap().set(recordEngine.intern("name"), Value::string("sword"));
+    data.asMap().set(recordEngine.intern("equipped"), Value::boolean(true));
+    data.asMap().set(recordEngine.intern("slot"), Value::symbol(recordEngine.intern("main_hand")));
+    data.asMap().set(recordEngine.intern("stats"), Value::array({
+        Value::integer(1), Value::nil(), Value::string("x")
+    }));
+
+    std::vector<uint8_t> bytes;
+    SessionWriter out(bytes);
+    writeScriptMessage(out, recordEngine, recordEngine.intern("item_changed"), data);
+
+    // Replayed in another engine, where the symbols get different IDs
+    ScriptEngine replayEngine;
+    for (int i = 0; i < 10; i++) {
+        replayEngine.intern("unrelated_" + std::to_string(i));
+    }
+    SessionReader in(bytes.data(), bytes.size());
+    auto [messageType, replayed] = readScriptMessage(in, replayEngine);
+    assert(in.atEnd());
+    assert(messageType == replayEngine.intern("item_changed"));
+    assert(replayed.isMap());
+
+    auto& m = replayed.asMap();
+    assert(m.get(replayEngine.intern("hp")).asInt() == -42);
+    assert(m.get(replayEngine.intern("ratio")).asFloat() == 0.25);
+    assert(m.get(replayEngine.intern("name")).asString() == "sword");
+    assert(m.get(replayEngine.intern("equipped")).asBool());
+    assert(m.get(replayEngine.intern("slot")).asSymbol() == replayEngine.intern("main_hand"));
+    auto stats = m.get(replayEngine.intern("stats"));
+    assert(stats.isArray() && stats.asArray().size() == 3);
+    assert(stats.asArray()[0].asInt() == 1);
+    assert(stats.asArray()[1].isNil());
+    assert(stats.asArray()[2].asString() == "x");
+
+    // Truncated payloads are rejected rather than read past the end
+    bool threw = false;
+    try {
+        SessionReader truncated(bytes.data(), bytes.size() - 1);
+        readScriptMessage(truncated, replayEngine);
+    } catch (const std::runtime_error&) {
+        threw = true;
+    }
+    assert(threw);
+
+    std::cout << "PASSED\n";
+}
+
+// ============================================================================
+// Virtual List Tests
+// ============================================================================
+
+void test_binding_ui_virtual_table() {
+    std::cout << "Testing: ui.virtual_table binding... ";
+
+    auto& engine = testEngine();
+    ExecutionContext ctx(engine);
+
+    auto rowFn = engine.executeCommand(R"(
+        fn [i] do
+            "row"
+        end
+    )", ctx);
+    assert(rowFn.success);
+    ctx.set("row_fn", rowFn.returnValue);
+
+    auto result = engine.executeCommand(
+        R"({ui.virtual_table "auctions" 3 1000000 row_fn =headers ["Item" "Qty" "Price"] =row_height 20})", ctx);
+    assert(result.success);
+    assert(result.returnValue.isMap());
+
+    auto& m = result.returnValue.asMap();
+    assert(m.get(engine.intern("type")).asSymbol() == engine.intern("virtual_table"));
+    assert(m.get(engine.intern("id")).asString() == "auctions");
+    assert(m.get(engine.intern("num_columns")).asNumber() == 3.0);
+    assert(m.get(engine.intern("row_count")).asNumber() == 1000000.0);
+    assert(m.get(engine.intern("row_fn")).isCallable());
+    assert(m.get(engine.intern("headers")).asArray().size() == 3);
+    assert(m.get(engine.intern("row_height")).asNumber() == 20.0);
+
+    std::cout << "PASSED\n";
+}
+
+void test_converter_reads_virtual_list() {
+    std::cout << "Testing: convertToWidget reads virtual_list... ";
+
+    ScriptEngine engine;
+    ConverterSymbols syms;
+    syms.intern(engine);
+    ExecutionContext ctx(engine);
+
+    ctx.set("last_row", Value::integer(-1));
+    auto rowFn = engine.executeCommand(R"(
+        fn [i] do
+            set last_row i
+            "row"
+        end
+    )", ctx);
+    assert(rowFn.success);
+
+    auto onChange = engine.executeCommand(R"(
+        fn [i] do
+            set last_row i
+        end
+    )", ctx);
+    assert(onChange.success);
+
+    auto map = Value::map();
+    auto& m = map.asMap();
+    m.set(syms.type, Value::symbol(syms.sym_virtual_list));
+    m.set(syms.id, Value::string("log"));
+    m.set(syms.row_count, Value::integer(1000000));
+    m.set(syms.row_height, Value::number(18.0));
+    m.set(syms.row_fn, rowFn.returnValue);
+    m.set(syms.on_change, onChange.returnValue);
+
+    auto node = convertToWidget(map, engine, ctx, syms);
+    assert(node.type == WidgetNode::Type::VirtualList);
+    assert(node.props().rowCount == 1000000);
+    assert(node.props().rowHeight == 18.0f);
+    assert(node.props().rowSelection);
+    assert(node.selectedIndex == -1);
+    assert(node.callbacks().rowProvider);
+
+    // The row closure gets the row index; a string result becomes text
+    WidgetNode row = node.callbacks().rowProvider(999999);
+    assert(row.type == WidgetNode::Type::Text);
+    assert(row.textContent == "row");
+    assert(ctx.get("last_row").asInt() == 999999);
+
+    // Selection reports the index
+    node.selectedIndex = 12;
+    node.callbacks().onChange(node);
+    assert(ctx.get("last_row").asInt() == 12);
+
+    std::cout << "PASSED\n";
+}
+
 // ============================================================================
 // Main
 // ============================================================================
@@ -3082,6 +3234,13 @@ int main() {
         test_converter_reads_window_pivot();
         test_window_pivot_kwarg();
 
+        // Session recording tests
+        test_script_message_session_encoding();
+
+        // Virtual list tests
+        test_binding_ui_virtual_table();
+        test_converter_reads_virtual_list();
+
         std::cout << "\n=== All script integration unit tests PASSED ===\n";
     } catch (const std::exception& e) {
         std::cerr << "\nTest FAILED with exception: " << e.what() << "\n";